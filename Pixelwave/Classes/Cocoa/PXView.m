@@ -56,6 +56,7 @@
 
 #include "PXDebug.h"
 #include "PXGLPrivate.h"
+#include "PXGLCommandBuffer.h"
 #include "PXMathUtils.h"
 
 @interface PXView(Private)
@@ -498,6 +499,7 @@
 		enableAntiAliasing = use;
 
 		PXGLFlush();
+		PXGLBeginDirect();
 
 		// TODO: Enable this
 		if (use == YES)
@@ -522,6 +524,8 @@
 		//	glBindFramebufferOES(GL_FRAMEBUFFER_OES, framebuffer);
 		//	glBindRenderbufferOES(GL_RENDERBUFFER_OES, renderbuffer);
 		}
+
+		PXGLEndDirect();
 	}
 	else
 		PXDebugLog(@"anti-aliasing not supported on this device.");
@@ -637,7 +641,10 @@
 	PXGLFlush();
 
 	boundFramebuffer = _frameBuffer;
+
+	PXGLBeginDirect();
 	glBindFramebufferOES(target, boundFramebuffer);
+	PXGLEndDirect();
 }
 
 - (GLuint) _boundFrameBuffer
@@ -717,19 +724,24 @@
 
 - (BOOL) resizeFromLayer:(CAEAGLLayer *)layer
 {
+	BOOL success = YES;
+
+	PXGLBeginDirect();
+
 	if ([eaglContext renderbufferStorage:GL_RENDERBUFFER_OES fromDrawable:layer] == NO)
 	{
 		PXDebugLog(@"PXView failed to attach a render buffer to the eagl layer.");
-		return NO;
+		success = NO;
 	}
-
-	if (glCheckFramebufferStatusOES(GL_FRAMEBUFFER_OES) != GL_FRAMEBUFFER_COMPLETE_OES)
+	else if (glCheckFramebufferStatusOES(GL_FRAMEBUFFER_OES) != GL_FRAMEBUFFER_COMPLETE_OES)
 	{
 		PXDebugLog(@"PXView failed to make complete framebuffer object %x", glCheckFramebufferStatusOES(GL_FRAMEBUFFER_OES));
-		return NO;
+		success = NO;
 	}
 
-	return YES;
+	PXGLEndDirect();
+
+	return success;
 }
 
 - (void) layoutSubviews
@@ -833,11 +845,15 @@
 // This is an expensive method
 - (UIImage *)screenshot
 {
+	PXGLBeginDirect();
+
 	// Render the current state of the display list
 	PXEngineRender();
 
 	CGImageRef cgImage = PXCGUtilsCreateCGImageFromScreenBuffer();
 
+	PXGLEndDirect();
+
 	// Figure out the orientation of the stage and use it to set the
 	// orientation of the UIImage.
 	PXStageOrientation stageOrientation = PXEngineGetStage().orientation;
@@ -74,6 +74,10 @@ extern PXVersion pxVersion;
 
 //#define PX_AL_DEBUG_MODE
 
+// Enables the zone profiler in PXProfileUtils.h. Leave this commented out to
+// have the profiling macros compile to nothing.
+//#define PX_PROFILE_MODE
+
 //#endif
 
 //////////
@@ -41,7 +41,7 @@
 
 #import "PXSoundEngine.h"
 #import "PXAL.h"
-#import "PXLinkedList.h"
+#import "PXArrayList.h"
 #import "PXSoundMixer.h"
 #import "PXSoundListener.h"
 
@@ -52,6 +52,7 @@
 
 #include "PXEngineUtils.h"
 #include "PXSettings.h"
+#include "PXProfileUtils.h"
 
 #import "PXSoundTransform.h"
 #import "PXDebug.h"
@@ -60,7 +61,7 @@
 
 ALCdevice  *pxSoundEngineDevice = nil;
 ALCcontext *pxSoundEngineContext = nil;
-PXLinkedList *pxSoundEngineListOfSounds = nil;
+PXArrayList *pxSoundEngineListOfSounds = nil;
 PXSoundListener  *pxSoundEngineSoundListener = nil;
 PXSoundTransform *pxSoundEngineSoundTransform = nil;
 
@@ -122,7 +123,7 @@ void PXSoundEngineInit( )
 
 	pxSoundEngineSoundListener = nil;
 	pxSoundEngineSoundTransform = [[PXSoundTransform alloc] init];
-	pxSoundEngineListOfSounds = [[PXLinkedList alloc] init];
+	pxSoundEngineListOfSounds = [[PXArrayList alloc] init];
 }
 
 void PXSoundEngineInitAL()
@@ -230,26 +231,24 @@ void PXSoundEngineUpdate()
 	if (pxSoundEnginePause)
 		return;
 
+	PX_PROFILE_ZONE("PXSoundEngineUpdate");
+
 	PXSoundChannel *sound;
-	PXLinkedList *removeList = PXUtilsNewPooledList();
 
-	for (sound in pxSoundEngineListOfSounds)
+	// Walk backwards so that finished sounds can be removed in place, without
+	// having to gather them up in a separate list first.
+	int index;
+	for (index = (int)(pxSoundEngineListOfSounds->_count) - 1; index >= 0; --index)
 	{
+		sound = pxSoundEngineListOfSounds->_items[index];
+
 		[sound _update];
 
 		if ([sound _done])
 		{
-			[removeList addObject:sound];
+			[pxSoundEngineListOfSounds removeObjectAtIndex:index];
 		}
 	}
-
-	[pxSoundEngineListOfSounds removeObjectsInList:removeList];
-//	for (sound in removeList)
-//	{
-//		[pxSoundEngineListOfSounds removeObject:sound];
-//	}
-
-	PXUtilsReleasePooledList(removeList);
 }
 
 void PXSoundEngineAddSound(PXSoundChannel *sound)
@@ -296,8 +295,8 @@ void PXSoundEngineSetSoundTransform(PXSoundTransform *transform)
 
 	[pxSoundEngineSoundListener _setVolume:pxSoundEngineSoundTransform.volume];
 
-	PXSoundChannel *sound;
-	for (sound in pxSoundEngineListOfSounds)
+	PXSoundChannel *sound = nil;
+	PXArrayListForEach(pxSoundEngineListOfSounds, sound)
 	{
 		if ([sound isKindOfClass:[PXAVSoundChannel class]])
 		{
@@ -319,8 +318,8 @@ void PXSoundEnginePlayAll( )
 	if (!pxSoundEngineHasBeenInitialized)
 		return;
 
-	PXSoundChannel *sound;
-	for (sound in pxSoundEngineListOfSounds)
+	PXSoundChannel *sound = nil;
+	PXArrayListForEach(pxSoundEngineListOfSounds, sound)
 	{
 		[sound play];
 	}
@@ -330,8 +329,9 @@ void PXSoundEngineStopAll( )
 	if (!pxSoundEngineHasBeenInitialized)
 		return;
 
-	PXSoundChannel *sound;
-	for (sound in pxSoundEngineListOfSounds)
+	// Stopping a channel takes it out of the list
+	PXSoundChannel *sound = nil;
+	PXArrayListForEachReverse(pxSoundEngineListOfSounds, sound)
 	{
 		[sound stop];
 	}
@@ -343,8 +343,8 @@ void PXSoundEnginePauseAll( )
 	if (!pxSoundEngineHasBeenInitialized)
 		return;
 
-	PXSoundChannel *sound;
-	for (sound in pxSoundEngineListOfSounds)
+	PXSoundChannel *sound = nil;
+	PXArrayListForEach(pxSoundEngineListOfSounds, sound)
 	{
 		[sound pause];
 	}
@@ -354,8 +354,8 @@ void PXSoundEngineRewindAll( )
 	if (!pxSoundEngineHasBeenInitialized)
 		return;
 
-	PXSoundChannel *sound;
-	for (sound in pxSoundEngineListOfSounds)
+	PXSoundChannel *sound = nil;
+	PXArrayListForEach(pxSoundEngineListOfSounds, sound)
 	{
 		[sound rewind];
 	}
@@ -366,8 +366,8 @@ void PXSoundEngineUpdateSoundTransforms()
 	if (!pxSoundEngineHasBeenInitialized)
 		return;
 
-	PXSoundChannel *sound;
-	for (sound in pxSoundEngineListOfSounds)
+	PXSoundChannel *sound = nil;
+	PXArrayListForEach(pxSoundEngineListOfSounds, sound)
 	{
 		sound.soundTransform = sound.soundTransform;
 	}
@@ -417,8 +417,8 @@ void PXSoundEngineSetDistanceModel(PXSoundMixerDistanceModel distanceModel)
 //	PXDebugALErrorCheck(@"alDistanceModel");
 //	PXDebugALEndErrorChecks();
 
-	PXSoundChannel *sound;
-	for (sound in pxSoundEngineListOfSounds)
+	PXSoundChannel *sound = nil;
+	PXArrayListForEach(pxSoundEngineListOfSounds, sound)
 	{
 		if ([sound isKindOfClass:[PXALSoundChannel class]])
 		{
@@ -57,6 +57,28 @@
 extern "C" {
 #endif
 
+// Measured timing of the main loop, reset by PXEngineResetFramePacing.
+typedef struct
+{
+	// Seconds between the last two frames, as measured
+	float frameInterval;
+	// frameInterval, smoothed over the last several frames
+	float averageFrameInterval;
+	// The longest frameInterval seen
+	float longestFrameInterval;
+
+	// Frames that came later than the main loop interval asked for
+	unsigned lateFrames;
+	// Logic steps run on the last frame
+	unsigned logicSteps;
+	// Logic steps that were dropped instead of being caught up on
+	unsigned droppedLogicSteps;
+
+	// Seconds the last frame spent in the logic and render phases
+	float logicTime;
+	float renderTime;
+} PXEngineFramePacing;
+
 //////////////
 // Creation //
 //////////////
@@ -131,6 +153,20 @@ float PXEngineGetLogicFrameRate();
 void PXEngineSetRenderFrameRate(float fps);
 float PXEngineGetRenderFrameRate();
 
+void PXEngineSetMaxLogicStepsPerFrame(unsigned count);
+unsigned PXEngineGetMaxLogicStepsPerFrame();
+float PXEngineGetLogicAlpha();
+
+PXEngineFramePacing PXEngineGetFramePacing();
+void PXEngineResetFramePacing();
+
+void PXEngineSetRenderThreadEnabled(bool enabled);
+bool PXEngineGetRenderThreadEnabled();
+
+void PXEngineSetHeadless(bool headless);
+bool PXEngineGetHeadless();
+void PXEngineStepFrame(float dt);
+
 ///////////////////////////////
 // Broadcast event listeners //
 ///////////////////////////////
@@ -139,6 +175,8 @@ void PXEngineAddFrameListener(PXDisplayObject *displayObject);
 void PXEngineRemoveFrameListener(PXDisplayObject *displayObject);
 void PXEngineAddRenderListener(PXDisplayObject *displayObject);
 void PXEngineRemoveRenderListener(PXDisplayObject *displayObject);
+void PXEngineAddPostFrameListener(PXDisplayObject *displayObject);
+void PXEngineRemovePostFrameListener(PXDisplayObject *displayObject);
 
 ///////////////
 // Rendering //
@@ -42,9 +42,18 @@
 #include "PXEnginePrivate.h"
 
 #include "PXTouchEngine.h"
+#include "PXRenderThread.h"
 
 #import "PXLinkedList.h"
 #import "PXDebug.h"
+#import "PXTextureMemory.h"
+
+#include "PXGLErrorUtils.h"
+#include "PXTimeUtils.h"
+#include "PXProfileUtils.h"
+#include "PXInputRecorder.h"
+
+#include <pthread.h>
 
 @interface PXEngine : NSObject
 {
@@ -61,14 +70,29 @@
 
 #define PX_ENGINE_MIN_FRAME_RATE 30.0f
 
+// How many logic steps may be run on a single frame to catch up with the
+// clock. Past that, the remaining time is dropped so that a slow device can't
+// fall further and further behind.
+#define PX_ENGINE_DEFAULT_MAX_LOGIC_STEPS 4
+// Frames further apart than this (e.g. right after the app was suspended) are
+// treated as if they were only this far apart.
+#define PX_ENGINE_MAX_FRAME_INTERVAL 0.25f
+// Measured intervals this close to a whole number of screen refreshes are
+// snapped onto it, so that timer jitter doesn't make a step run a frame late.
+#define PX_ENGINE_REFRESH_SNAP_TOLERANCE 0.002f
+
 const unsigned PXEngineMinBufferSize = 4;
 const float PXEngineMinFrameRate = PX_ENGINE_MIN_FRAME_RATE;
 
 PXObjectPool *pxEngineSharedObjectPool = nil;
 
-PXLinkedList *pxEngineCachedListeners = nil;			//Strongly referenced
-PXLinkedList *pxEngineFrameListeners = nil;				//Strongly referenced
-PXLinkedList *pxEngineRenderListeners = nil;			//Strongly referenced
+_PXEngineListenerRegistry pxEngineFrameListeners = {NULL, 0, 0, 0, 0, false, false};			//Weakly referenced
+_PXEngineListenerRegistry pxEngineRenderListeners = {NULL, 0, 0, 0, 0, false, true};			//Strongly referenced
+_PXEngineListenerRegistry pxEnginePostFrameListeners = {NULL, 0, 0, 0, 0, false, false};		//Weakly referenced
+// Post frame listeners added off of the main thread, moved into the registry
+// by the next dispatch
+_PXEngineListenerRegistry pxEnginePendingPostFrameListeners = {NULL, 0, 0, 0, 0, false, false};	//Weakly referenced
+pthread_mutex_t pxEnginePendingPostFrameMutex = PTHREAD_MUTEX_INITIALIZER;
 
 PXEvent *pxEngineEnterFrameEvent = nil;					//Strongly referenced
 PXEvent *pxEngineRenderEvent = nil;						//Strongly referenced
@@ -93,6 +117,24 @@ float pxEngineRenderTimeAccum = 0.0f;
 float pxEngineLogicDT = 0.0f;
 float pxEngineLogicTimeAccum = 0.0f;
 
+// The time that passed since the last frame, as measured by the monotonic
+// clock. Drives both the logic and render accumulators.
+float pxEngineFrameDT = 0.0f;
+double pxEngineLastFrameTime = 0.0;
+unsigned pxEngineMaxLogicSteps = PX_ENGINE_DEFAULT_MAX_LOGIC_STEPS;
+PXEngineFramePacing pxEngineFramePacing;
+
+// When headless, nothing drives the loop but PXEngineStepFrame, and frames are
+// recorded into a command buffer that gets thrown away instead of drawn.
+bool pxEngineHeadless = false;
+PXGLCommandBuffer *pxEngineHeadlessCommandBuffer = NULL;
+// The interval given to PXEngineStepFrame, negative when the clock is used
+float pxEngineSteppedFrameDT = -1.0f;
+
+// Set while recording a frame that has a custom display object which didn't
+// opt in to rendering on the render thread
+bool pxEngineFrameNeedsRenderSync = false;
+
 // The size of the view in POINTS. Always in PORTRAIT
 CGSize pxEngineViewSize;
 PXColor4f pxEngineClearColor = {1.0f, 1.0f, 1.0f, 1.0f}; // Initialize to white
@@ -107,13 +149,14 @@ float pxEngineTimeWaiting = 0.0f;
 #endif
 
 #if (PX_ENGINE_IDLE_TIME_INCLUDES_BETWEEN_SYSTEM_CALLS)
-NSTimeInterval pxEngineInterval = 0.0f;
+double pxEngineInterval = 0.0;
 #endif
 
 PXEngine *pxEngine = nil; //Strongly referenced
 
 void PXEngineUpdateMainLoopInterval();
 
+void PXEngineMeasureFrame();
 void PXEngineOnFrame();
 void PXEngineRenderStage();
 
@@ -124,6 +167,7 @@ void PXEngineInit(PXView *view)
 
 #ifdef PIXELWAVE_DEBUG
 	PXDebug.logErrors = YES;
+	PXDebug.checksGLErrorsSynchronously = YES;
 #endif
 
 	///////////////
@@ -171,13 +215,10 @@ void PXEngineInit(PXView *view)
 	// Events //
 	////////////
 
-	// Initialized with weak references so that DisplayObjects with an
+	// The frame listeners are weakly referenced so that DisplayObjects with an
 	// ENTER_FRAME listener can get deallocated when they leave the Display
 	// list. It's the object's responsibility to remove all of the event
 	// listeners it added once it gets deallocated.
-	pxEngineFrameListeners = [[PXLinkedList alloc] initWithWeakReferences:YES];
-
-	pxEngineCachedListeners = [[PXLinkedList alloc] init];
 
 	// Create a reusable enter frame event instead of creating one every frame.
 	pxEngineEnterFrameEvent = [[PXEvent alloc] initWithType:PXEvent_EnterFrame bubbles:NO cancelable:NO];
@@ -216,6 +257,9 @@ void PXEngineInit(PXView *view)
 
 void PXEngineDealloc()
 {
+	// Anything still in flight has to be presented before gl goes away.
+	PXRenderThreadStop();
+
 	PXSoundEngineDealloc();
 	PXTouchEngineDealloc();
 
@@ -235,18 +279,26 @@ void PXEngineDealloc()
 	[pxEngineRenderEvent release];
 	pxEngineRenderEvent = nil;
 
-	[pxEngineCachedListeners release];
-	pxEngineCachedListeners = nil;
-	[pxEngineFrameListeners release];
-	pxEngineFrameListeners = nil;
-	[pxEngineRenderListeners release];
-	pxEngineRenderListeners = nil;
+	_PXEngineListenerRegistryFree(&pxEngineFrameListeners);
+	_PXEngineListenerRegistryFree(&pxEngineRenderListeners);
+	_PXEngineListenerRegistryFree(&pxEnginePostFrameListeners);
+
+	pthread_mutex_lock(&pxEnginePendingPostFrameMutex);
+	_PXEngineListenerRegistryFree(&pxEnginePendingPostFrameListeners);
+	pthread_mutex_unlock(&pxEnginePendingPostFrameMutex);
 
 	// Get rid of the render-to-texture buffer
 	if (pxEngineRTTFBO != 0)
 		glDeleteFramebuffersOES(1, &pxEngineRTTFBO);
 	pxEngineRTTFBO = 0;
 
+	if (pxEngineHeadlessCommandBuffer)
+	{
+		PXGLCommandBufferFree(pxEngineHeadlessCommandBuffer);
+		pxEngineHeadlessCommandBuffer = NULL;
+	}
+	pxEngineHeadless = false;
+
 	PXGLDealloc();
 
 	[pxEngine dealloc];
@@ -425,6 +477,9 @@ void PXEngineUpdateMainLoopInterval()
 	else if (pxEngineMainDT < minDT)
 		pxEngineMainDT = minDT;	
 
+	// The loop starts over, so the time it was stopped for isn't counted
+	pxEngineLastFrameTime = 0.0;
+
 	[pxEngine updateMainLoopInterval];
 }
 
@@ -486,6 +541,134 @@ float PXEngineGetRenderFrameRate()
 	return 1.0f / pxEngineRenderDT;
 }
 
+/**
+ * Sets how many logic steps may be run on a single frame when the engine is
+ * catching up after a slow frame. Anything past that is dropped.
+ */
+void PXEngineSetMaxLogicStepsPerFrame(unsigned count)
+{
+	if (count < 1)
+		count = 1;
+
+	pxEngineMaxLogicSteps = count;
+}
+
+unsigned PXEngineGetMaxLogicStepsPerFrame()
+{
+	return pxEngineMaxLogicSteps;
+}
+
+/**
+ * When enabled, each frame is recorded on the main thread and replayed and
+ * presented on a render thread, while the main thread moves on to the next
+ * frame. Off by default.
+ *
+ * While enabled, display objects using PXRenderMode_Custom have their
+ * _renderGL called on the render thread, and may only make gl calls from it.
+ * By default the main thread then waits for that frame to be presented before
+ * running any more logic, so _renderGL can read the object's state safely.
+ * Objects whose _renderGL doesn't read anything the logic changes (or which
+ * keep their own copy of it) can enable
+ * _PXDisplayObjectFlags_rendersOnRenderThread to let the two overlap.
+ *
+ * Any other code calling gl directly must do so between PXGLBeginDirect and
+ * PXGLEndDirect.
+ */
+void PXEngineSetRenderThreadEnabled(bool enabled)
+{
+	if (enabled)
+	{
+		if (pxEngineView)
+			PXRenderThreadStart(pxEngineView);
+	}
+	else
+	{
+		PXRenderThreadStop();
+	}
+}
+
+bool PXEngineGetRenderThreadEnabled()
+{
+	return PXRenderThreadIsRunning();
+}
+
+/**
+ * Headless mode takes the engine off the display link; frames only happen
+ * when PXEngineStepFrame is called. They still go through the whole render
+ * phase, but what gets drawn is recorded and thrown away rather than sent to
+ * gl, so the time spent is the engine's own. Textures are still uploaded, so a
+ * view is still needed. Turning it on stops the render thread.
+ */
+void PXEngineSetHeadless(bool headless)
+{
+	if (pxEngineHeadless == headless)
+		return;
+
+	if (headless)
+	{
+		PXRenderThreadStop();
+	}
+	else if (pxEngineHeadlessCommandBuffer)
+	{
+		PXGLCommandBufferFree(pxEngineHeadlessCommandBuffer);
+		pxEngineHeadlessCommandBuffer = NULL;
+	}
+
+	pxEngineHeadless = headless;
+
+	// The loop starts over, so the time spent headless isn't counted
+	pxEngineLastFrameTime = 0.0;
+
+	[pxEngine updateMainLoopInterval];
+}
+
+bool PXEngineGetHeadless()
+{
+	return pxEngineHeadless;
+}
+
+/**
+ * Runs a single frame as if dt seconds had passed since the previous one. The
+ * interval is used as is, without being clamped or snapped to the screen
+ * refresh, so the same intervals always give the same logic and render steps.
+ */
+void PXEngineStepFrame(float dt)
+{
+	if (!pxEngineInitialized)
+		return;
+
+	if (dt < 0.0f)
+		dt = 0.0f;
+
+	pxEngineSteppedFrameDT = dt;
+	PXEngineOnFrame();
+	pxEngineSteppedFrameDT = -1.0f;
+}
+
+/**
+ * How far, between 0 and 1, the clock has moved past the last logic step
+ * towards the next one. Renderers can use this to interpolate between the
+ * previous and current logic states.
+ */
+float PXEngineGetLogicAlpha()
+{
+	if (PXMathIsZero(pxEngineLogicDT))
+		return 0.0f;
+
+	float alpha = pxEngineLogicTimeAccum / pxEngineLogicDT;
+	return PXMathClamp(alpha, 0.0f, 1.0f);
+}
+
+PXEngineFramePacing PXEngineGetFramePacing()
+{
+	return pxEngineFramePacing;
+}
+
+void PXEngineResetFramePacing()
+{
+	memset(&pxEngineFramePacing, 0, sizeof(PXEngineFramePacing));
+}
+
 /**
  * Plays and pauses the engine
  */
@@ -504,129 +687,210 @@ bool PXEngineGetRunning()
 
 void PXEngineAddFrameListener(PXDisplayObject *displayObject)
 {
-	if (!pxEngineFrameListeners)
+	if (!pxEngineInitialized)
 		return;
 
-	[pxEngineFrameListeners addObject:displayObject];
+	_PXEngineListenerRegistryAdd(&pxEngineFrameListeners, displayObject);
 }
 
 void PXEngineRemoveFrameListener(PXDisplayObject *displayObject)
 {
-	if (!pxEngineFrameListeners)
+	_PXEngineListenerRegistryRemove(&pxEngineFrameListeners, displayObject);
+}
+
+/*
+ * Display objects that have work to do after the frame's logic, such as
+ * rebuilding their graphics, register here instead of having the whole display
+ * list walked every frame. They get a single _postFrame once they're on the
+ * stage, unless they keep the registration (see
+ * _PXDisplayObjectFlags_keepsPostFrameListener). Adding an object that's
+ * already registered does nothing.
+ *
+ * The registry itself is only touched on the main thread. Objects created or
+ * changed on another thread (by a loader, for example) are queued under a lock
+ * and moved into it at the start of the next dispatch. An object that made it
+ * into the registry must be deallocated on the main thread.
+ */
+void PXEngineAddPostFrameListener(PXDisplayObject *displayObject)
+{
+	if (!displayObject)
+		return;
+
+	if (!pthread_main_np())
+	{
+		pthread_mutex_lock(&pxEnginePendingPostFrameMutex);
+
+		if (!PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_isPostFrameListener))
+		{
+			PX_ENABLE_BIT(displayObject->_flags, _PXDisplayObjectFlags_isPostFrameListener);
+			_PXEngineListenerRegistryAdd(&pxEnginePendingPostFrameListeners, displayObject);
+		}
+
+		pthread_mutex_unlock(&pxEnginePendingPostFrameMutex);
+		return;
+	}
+
+	if (PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_isPostFrameListener))
 		return;
 
-	[pxEngineFrameListeners removeObject:displayObject];
+	PX_ENABLE_BIT(displayObject->_flags, _PXDisplayObjectFlags_isPostFrameListener);
+	_PXEngineListenerRegistryAdd(&pxEnginePostFrameListeners, displayObject);
 }
 
-void PXEngineDispatchPostFrameEvents(PXDisplayObject *displayObject)
+void PXEngineRemovePostFrameListener(PXDisplayObject *displayObject)
 {
-	if (displayObject == NULL)
+	if (!displayObject || !PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_isPostFrameListener))
 		return;
 
-	displayObject->_impPostFrame(displayObject, nil);
+	PX_DISABLE_BIT(displayObject->_flags, _PXDisplayObjectFlags_isPostFrameListener);
 
-	if (PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_isContainer))
+	// It may still be waiting in the queue
+	pthread_mutex_lock(&pxEnginePendingPostFrameMutex);
+	_PXEngineListenerRegistryRemove(&pxEnginePendingPostFrameListeners, displayObject);
+	pthread_mutex_unlock(&pxEnginePendingPostFrameMutex);
+
+	if (pthread_main_np())
+		_PXEngineListenerRegistryRemove(&pxEnginePostFrameListeners, displayObject);
+}
+
+/*
+ * Moves the listeners queued by other threads into the registry.
+ */
+PXInline void _PXEngineAddPendingPostFrameListeners()
+{
+	pthread_mutex_lock(&pxEnginePendingPostFrameMutex);
+
+	_PXEngineListener *listener = pxEnginePendingPostFrameListeners.array;
+	_PXEngineListener *end = listener + pxEnginePendingPostFrameListeners.size;
+
+	for (; listener < end; ++listener)
 	{
-		PXDisplayObjectContainer *container = (PXDisplayObjectContainer *)displayObject;
+		_PXEngineListenerRegistryAdd(&pxEnginePostFrameListeners, listener->displayObject);
+	}
 
-		PXDisplayObject *child;
-		unsigned index;
+	pxEnginePendingPostFrameListeners.size = 0;
+
+	pthread_mutex_unlock(&pxEnginePendingPostFrameMutex);
+}
+
+void PXEngineDispatchPostFrameEvents()
+{
+	// Read without the lock, anything queued meanwhile waits for the next frame
+	if (pxEnginePendingPostFrameListeners.size > 0)
+		_PXEngineAddPendingPostFrameListeners();
+
+	if (pxEnginePostFrameListeners.size == 0)
+		return;
 
-		for (index = 0, child = container->_childrenHead; index < container->_numChildren; ++index, child = child->_next)
+	PXDisplayObject *displayObject;
+	unsigned index;
+
+	_PXEngineListenerRegistryBeginDispatch(&pxEnginePostFrameListeners);
+
+	_PXEngineListenerRegistryForEachAtIndex(&pxEnginePostFrameListeners, index, displayObject)
+	{
+		// Only objects on the display list get the post frame, the rest wait
+		// for it until they're added to the stage.
+		if (!PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_isOnStage))
+			continue;
+
+		// Taken out before the call, so that changing the graphics again inside
+		// of it registers the object for the next frame.
+		if (!PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_keepsPostFrameListener))
 		{
-			PXEngineDispatchPostFrameEvents(child);
+			PX_DISABLE_BIT(displayObject->_flags, _PXDisplayObjectFlags_isPostFrameListener);
+			_PXEngineListenerRegistryRemoveAtIndex(&pxEnginePostFrameListeners, index);
 		}
+
+		displayObject->_impPostFrame(displayObject, nil);
 	}
+
+	_PXEngineListenerRegistryEndDispatch(&pxEnginePostFrameListeners);
 }
 
 void PXEngineDispatchFrameEvents()
 {
-	if (pxEngineFrameListeners.count != 0)
+	PX_PROFILE_ZONE("PXEngineDispatchFrameEvents");
+
+	if (pxEngineFrameListeners.size != 0)
 	{
 		PXDisplayObject *child = nil;
 
 		// Dispatch it on all listeners (listeners must be PXDisplayObject's, but
 		// aren't necessarily on the display list, don't have to have a non-nil
 		// 'parent')
-		PXLinkedListForEach(pxEngineFrameListeners, child)
-		{
-			[pxEngineCachedListeners addObject:child];
-		}
+		_PXEngineListenerRegistryBeginDispatch(&pxEngineFrameListeners);
 
 		// From Flash API:
 		// Note:	This event has neither a "capture phase" nor a "bubble phase",
 		//			which means that event listeners must be added directly to any
 		//			potential targets, whether the target is on the display list or
 		//			not.
-		PXLinkedListForEach(pxEngineCachedListeners, child)
+		_PXEngineListenerRegistryForEach(&pxEngineFrameListeners, child)
 		{
+			PX_PROFILE_OBJECT_ZONE(child);
+
+			// Kept alive for the length of its own dispatch, in case a listener
+			// lets go of the last reference to it.
+			[child retain];
+
 			// The enterFrame event doesn't follow the event flow, even though it's
 			// dispatched into the display list in some cases
 			[child _dispatchEventNoFlow:pxEngineEnterFrameEvent];
+
+			[child release];
 		}
 
-		[pxEngineCachedListeners removeAllObjects];
+		_PXEngineListenerRegistryEndDispatch(&pxEngineFrameListeners);
 	}
 
-	PXEngineDispatchPostFrameEvents(pxEngineStage);
+	PXEngineDispatchPostFrameEvents();
 }
 
 // MARK: Registering Render Event Listeners
 
 void PXEngineAddRenderListener(PXDisplayObject *displayObject)
 {
-	if (pxEngineRenderListeners == nil)
+	if (pxEngineRenderEvent == nil)
 	{
-		pxEngineRenderListeners = [[PXLinkedList alloc] init];
 		pxEngineRenderEvent = [[PXEvent alloc] initWithType:PXEvent_Render bubbles:NO cancelable:NO];
 	}
 
-	[pxEngineRenderListeners addObject:displayObject];
+	_PXEngineListenerRegistryAdd(&pxEngineRenderListeners, displayObject);
 }
 
 void PXEngineRemoveRenderListener(PXDisplayObject *displayObject)
 {
-	if (pxEngineRenderListeners == nil)
-		return;
-
-	[pxEngineRenderListeners removeObject:displayObject];
-
-	// If that was the last listener, get rid of the list
-	// and the shared event object.
-	if (pxEngineRenderListeners.count == 0)
-	{
-		[pxEngineRenderListeners release];
-		pxEngineRenderListeners = nil;
-
-		[pxEngineRenderEvent release];
-		pxEngineRenderEvent = nil;
-	}
+	_PXEngineListenerRegistryRemove(&pxEngineRenderListeners, displayObject);
 }
 
 void PXEngineDispatchRenderEvents()
 {
-	if (pxEngineRenderEvent == nil)
+	if (pxEngineRenderListeners.size == 0)
 		return;
 
+	PX_PROFILE_ZONE("PXEngineDispatchRenderEvents");
+
 	PXDisplayObject *child = nil;
 
 	// Dispatch it on all listeners (listeners must be PXDisplayObjects, but
 	// aren't necessarily on the display list, don't have to have a non-nil
 	// 'parent').
-	PXLinkedListForEach(pxEngineRenderListeners, child)
-	{
-		[pxEngineCachedListeners addObject:child];
-	}
+	_PXEngineListenerRegistryBeginDispatch(&pxEngineRenderListeners);
 
-	PXLinkedListForEach(pxEngineCachedListeners, child)
+	_PXEngineListenerRegistryForEach(&pxEngineRenderListeners, child)
 	{
+		[child retain];
+
 		// The enterFrame event doesn't follow the usual event flow
 		// (capture, target, bubble), even though it's dispatched
 		// into the display list in some cases.
 		[child _dispatchEventNoFlow:pxEngineRenderEvent];
+
+		[child release];
 	}
 
-	[pxEngineCachedListeners removeAllObjects];
+	_PXEngineListenerRegistryEndDispatch(&pxEngineRenderListeners);
 }
 
 /**
@@ -661,8 +925,8 @@ void PXEngineRender()
 
 	if (pxEngineShouldClear)
 	{
-		glClearColor(pxEngineClearColor.r, pxEngineClearColor.g, pxEngineClearColor.b, pxEngineClearColor.a);
-		glClear(GL_COLOR_BUFFER_BIT);
+		PXGLCmdClearColor(pxEngineClearColor.r, pxEngineClearColor.g, pxEngineClearColor.b, pxEngineClearColor.a);
+		PXGLCmdClear(GL_COLOR_BUFFER_BIT);
 	}
 
 	PXGLPreRender();
@@ -818,6 +1082,13 @@ void PXEngineRender()
 	PXGLPostRender();
 	PXGLConsolidateBuffers();
 
+	pxGLStatistics.touchBufferSize = pxEngineDOBuffer.size;
+	PXGLEndFrameStatistics();
+
+	// Keep texture memory within its budget, now that everything drawn this
+	// frame is known
+	PXTextureMemoryFrameEnded();
+
 	/*
 #ifdef PX_DEBUG_MODE
 	if (PXDebugIsEnabled(PXDebugSetting_HalveStage))
@@ -839,52 +1110,134 @@ void PXEngineRender()
  pxEngineRenderDTAccum = 0.0f;
  */
 
-void PXEngineLogicPhase()
+void PXEngineMeasureFrame()
 {
-	PXTouchEngineDispatchTouchEvents(); //Touch
+	if (pxEngineSteppedFrameDT >= 0.0f)
+	{
+		pxEngineFramePacing.frameInterval = pxEngineSteppedFrameDT;
+		pxEngineFrameDT = pxEngineSteppedFrameDT;
+		return;
+	}
+
+	double now = PXTimeGetSeconds();
+	float interval;
+
+	if (pxEngineLastFrameTime == 0.0)
+	{
+		// Nothing to measure against yet, assume the frame came on time
+		interval = pxEngineMainDT;
+	}
+	else
+	{
+		interval = (float)(now - pxEngineLastFrameTime);
+		if (interval < 0.0f)
+			interval = 0.0f;
+
+		pxEngineFramePacing.frameInterval = interval;
+
+		if (PXMathIsZero(pxEngineFramePacing.averageFrameInterval))
+			pxEngineFramePacing.averageFrameInterval = interval;
+		else
+			pxEngineFramePacing.averageFrameInterval += (interval - pxEngineFramePacing.averageFrameInterval) * 0.1f;
+
+		if (interval > pxEngineFramePacing.longestFrameInterval)
+			pxEngineFramePacing.longestFrameInterval = interval;
+
+		// More than half a refresh late
+		if (interval > pxEngineMainDT + (0.5f / pxEngineMaxFrameRate))
+			++pxEngineFramePacing.lateFrames;
+	}
 
-	pxEngineLogicTimeAccum += pxEngineMainDT;
+	pxEngineLastFrameTime = now;
 
-	if (pxEngineLogicTimeAccum >= pxEngineLogicDT)
+	if (interval > PX_ENGINE_MAX_FRAME_INTERVAL)
+		interval = PX_ENGINE_MAX_FRAME_INTERVAL;
+
+	// Snap onto the screen refresh
+	float refreshDT = 1.0f / pxEngineMaxFrameRate;
+	float refreshes = roundf(interval / refreshDT);
+
+	if (refreshes >= 1.0f && fabsf(interval - (refreshes * refreshDT)) < PX_ENGINE_REFRESH_SNAP_TOLERANCE)
 	{
+		interval = refreshes * refreshDT;
+	}
+
+	pxEngineFrameDT = interval;
+}
+
+void PXEngineLogicPhase()
+{
+	PX_PROFILE_ZONE("PXEngineLogicPhase");
+
+	PXTouchEngineDispatchTouchEvents(); //Touch
+
 #ifdef PX_DEBUG_MODE
-		NSTimeInterval start = 0;
+	double start = 0.0;
 
-		if (PXDebugIsEnabled(PXDebugSetting_CalculateFrameRate))
-		{
-			start = [NSDate timeIntervalSinceReferenceDate];
-		}
+	if (PXDebugIsEnabled(PXDebugSetting_CalculateFrameRate))
+	{
+		start = PXTimeGetSeconds();
+	}
 #endif
 
+	unsigned steps = 0;
+
+	if (PXMathIsZero(pxEngineLogicDT))
+	{
+		// No fixed step, run once per frame
 		PXEngineDispatchFrameEvents(); //Frame
-		pxEngineLogicTimeAccum -= pxEngineLogicDT;
+		steps = 1;
+	}
+	else
+	{
+		pxEngineLogicTimeAccum += pxEngineFrameDT;
 
-#ifdef PX_DEBUG_MODE
-		if (PXDebugIsEnabled(PXDebugSetting_CalculateFrameRate))
+		// Catch up with the clock, one fixed step at a time
+		while (pxEngineLogicTimeAccum >= pxEngineLogicDT && steps < pxEngineMaxLogicSteps)
 		{
-			NSTimeInterval end = [NSDate timeIntervalSinceReferenceDate];
-			pxEngineTimeBetweenLogic = end - start;
+			PXEngineDispatchFrameEvents(); //Frame
+			pxEngineLogicTimeAccum -= pxEngineLogicDT;
+
+			++steps;
+		}
+
+		// Still behind; rather than carrying the debt over (and trying to
+		// run even more steps next frame), drop it.
+		if (pxEngineLogicTimeAccum >= pxEngineLogicDT)
+		{
+			pxEngineFramePacing.droppedLogicSteps += (unsigned)(pxEngineLogicTimeAccum / pxEngineLogicDT);
+			pxEngineLogicTimeAccum = fmodf(pxEngineLogicTimeAccum, pxEngineLogicDT);
 		}
-#endif
 	}
+
+	pxEngineFramePacing.logicSteps = steps;
+
+#ifdef PX_DEBUG_MODE
+	if (steps > 0 && PXDebugIsEnabled(PXDebugSetting_CalculateFrameRate))
+	{
+		pxEngineTimeBetweenLogic = PXTimeGetSeconds() - start;
+	}
+#endif
 }
 
 void PXEngineRenderPhase()
 {
+	PX_PROFILE_ZONE("PXEngineRenderPhase");
+
 	// If we don't have a render change in time, and 
 	if (!PXMathIsZero(pxEngineRenderDT))
 	{
-		pxEngineRenderTimeAccum += pxEngineMainDT;
+		pxEngineRenderTimeAccum += pxEngineFrameDT;
 		if (pxEngineRenderTimeAccum >= pxEngineRenderDT)
 		{
 		//	[pxEngineView _setCurrentContext];
 
 #ifdef PX_DEBUG_MODE
-			NSTimeInterval start = 0;
+			double start = 0.0;
 
 			if (PXDebugIsEnabled(PXDebugSetting_CalculateFrameRate))
 			{
-				start = [NSDate timeIntervalSinceReferenceDate];
+				start = PXTimeGetSeconds();
 			}
 #endif
 			// We only dispatch render events if [stage invalidate] was called.
@@ -896,38 +1249,95 @@ void PXEngineRenderPhase()
 				// is the behavior exhibited by Flash.
 				pxStageWasInvalidated = NO;
 			}
-			PXEngineRender(); //Render
+
+			bool threaded = PXRenderThreadIsRunning();
+
+			if (pxEngineHeadless)
+			{
+				if (!pxEngineHeadlessCommandBuffer)
+					pxEngineHeadlessCommandBuffer = PXGLCommandBufferCreate();
+
+				PXGLBeginRecording(pxEngineHeadlessCommandBuffer);
+				PXEngineRender(); //Render
+				PXGLEndRecording();
+
+				// The draws are dropped, but the deferred work recorded
+				// during the render (like deleting the gl names of textures
+				// that went away) still has to happen.
+				PXGLCommandBufferInvokeCallbacks(pxEngineHeadlessCommandBuffer);
+				PXGLCommandBufferReset(pxEngineHeadlessCommandBuffer);
+			}
+			else if (threaded)
+			{
+				// Record the frame, then let the render thread draw and
+				// present it while we move on.
+				pxEngineFrameNeedsRenderSync = false;
+
+				PXGLBeginRecording(PXRenderThreadBeginFrame());
+				PXEngineRender(); //Render
+				PXGLEndRecording();
+
+				PXRenderThreadCommitFrame();
+
+				// A custom display object reads its state from the render
+				// thread, so the logic can't change it until that's done.
+				if (pxEngineFrameNeedsRenderSync)
+					PXRenderThreadSync();
+			}
+			else
+			{
+				PXEngineRender(); //Render
+			}
 
 			// DO NOT glFlush or glFinish.
 			//	- glFinish will yield in much slower times
 			//	- glFlush will yield inconsistant times - swap will take care of
 			//		this.
 
+			// Frames that were missed are skipped, never drawn back to back
 			pxEngineRenderTimeAccum -= pxEngineRenderDT;
+			if (pxEngineRenderTimeAccum >= pxEngineRenderDT)
+				pxEngineRenderTimeAccum = fmodf(pxEngineRenderTimeAccum, pxEngineRenderDT);
 
 #ifdef PX_DEBUG_MODE
 			if (PXDebugIsEnabled(PXDebugSetting_CalculateFrameRate))
 			{
-				NSTimeInterval end = [NSDate timeIntervalSinceReferenceDate];
-				pxEngineTimeBetweenRendering = end - start;
+				pxEngineTimeBetweenRendering = PXTimeGetSeconds() - start;
 			}
 #endif
 			// Don't include swap buffer in render timings, it results in
 			// inconsistant time thus useless info.
 			// Result:	logicTime + renderTime = frameTime != time from start of
 			//			frameA to start of frameB.
-			[pxEngineView _swapBuffers];
+			if (!threaded && !pxEngineHeadless)
+			{
+				[pxEngineView _swapBuffers];
+
+				// Now that the frame has been handed over, asking gl for the
+				// errors it raised doesn't hold anything up.
+				PXGLErrorFlush();
+			}
 		}
 	}
 }
 
 void PXEngineOnFrame()
 {
+	PX_PROFILE_FRAME();
+
+	PXEngineMeasureFrame();
+	PXInputRecorderRecordFrame(pxEngineFrameDT);
+
 	PXSoundEngineUpdate();
 
+	double phaseStart = PXTimeGetSeconds();
 	PXEngineLogicPhase();
+	double logicEnd = PXTimeGetSeconds();
 	PXEngineRenderPhase();
 
+	pxEngineFramePacing.logicTime = (float)(logicEnd - phaseStart);
+	pxEngineFramePacing.renderTime = (float)(PXTimeGetSeconds() - logicEnd);
+
 #ifdef PX_DEBUG_MODE
 	if (PXDebugIsEnabled(PXDebugSetting_CalculateFrameRate))
 	{
@@ -940,8 +1350,24 @@ void PXEngineOnFrame()
 // MARK: RENDER
 // MARK: -
 
+void PXEngineRenderRecordedDisplayObject(void *userData)
+{
+	PXDisplayObject *displayObject = (PXDisplayObject *)userData;
+	displayObject->_impRenderGL(displayObject, nil);
+}
+
+void PXEngineReleaseRecordedDisplayObject(void *userData)
+{
+	[(PXDisplayObject *)userData release];
+}
+
 void PXEngineRenderDisplayObject(PXDisplayObject *displayObject, bool transformationsEnabled, bool canBeUsedForTouches)
 {
+	// Children are drawn from within, so each zone includes its subtree.
+	PX_PROFILE_OBJECT_ZONE(displayObject);
+
+	++pxGLStatistics.nodesTraversed;
+
 	//////////////////////
 	// Quick exit tests //
 	//////////////////////
@@ -956,14 +1382,14 @@ void PXEngineRenderDisplayObject(PXDisplayObject *displayObject, bool transforma
 		doScaleY = displayObject->_scaleY;
 		doAlpha = displayObject->_colorTransform.alphaMultiplier;
 
-		if (!PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_visible))
-			return;
-
-		if (PXMathIsZero(doScaleX))
-			return;
-
-		if (PXMathIsZero(doScaleY))
+		// Culled objects take their children with them, but only count once.
+		if (!PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_visible) ||
+		    PXMathIsZero(doScaleX) ||
+		    PXMathIsZero(doScaleY))
+		{
+			++pxGLStatistics.nodesCulled;
 			return;
+		}
 
 		// This has been commented out so that display objects with
 		// an alpha of 0.0 can get clicked
@@ -984,7 +1410,7 @@ void PXEngineRenderDisplayObject(PXDisplayObject *displayObject, bool transforma
 
 	if (isCustomOrManaged)
 	{
-		PXGLFlush();
+		PXGLFlushWithCause(PXGLFlushCause_CustomRenderMode);
 	}
 
 	if (transformationsEnabled)
@@ -1065,7 +1491,21 @@ void PXEngineRenderDisplayObject(PXDisplayObject *displayObject, bool transforma
 			}
 
 			PXGLResetStates(displayObject->_glState);
-			displayObject->_impRenderGL(displayObject, nil);
+
+			// Custom rendering calls gl directly, so when recording, it has to
+			// happen when the frame is replayed.
+			if (isCustom && PXGLIsRecording())
+			{
+				if (!PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_rendersOnRenderThread))
+					pxEngineFrameNeedsRenderSync = true;
+
+				PXGLFlushWithCause(PXGLFlushCause_CustomRenderMode);
+				PXGLRecordCallback(PXEngineRenderRecordedDisplayObject, PXEngineReleaseRecordedDisplayObject, [displayObject retain]);
+			}
+			else
+			{
+				displayObject->_impRenderGL(displayObject, nil);
+			}
 
 			// Popping the matrix, please see the above comment.
 			if (isCustomOrManaged)
@@ -1164,17 +1604,13 @@ void PXEngineRenderDisplayObject(PXDisplayObject *displayObject, bool transforma
 	if (PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_isContainer))
 	{
 		PXDisplayObjectContainer *container = (PXDisplayObjectContainer *)displayObject;
-		PXDisplayObject *child = container->_childrenHead;
+		PXDisplayObject *child;
 
 		container->_impPreChildRenderGL(container, nil);
 
-		unsigned index;
-
-		for (index = 0; index < container->_numChildren; ++index)
+		PXArrayListForEach(container->_children, child)
 		{
 			PXEngineRenderDisplayObject(child, true, canBeUsedForTouches);
-
-			child = child->_next;
 		}
 
 		container->_impPostChildRenderGL(container, nil);
@@ -1208,6 +1644,10 @@ void PXEngineRenderToTexture(PXTextureData *textureData, PXDisplayObject *source
 	// Finish any rendering queued up to the main buffer
 	PXGLFlush();
 
+	// The texture is drawn into right away, even if the frame around it is
+	// being recorded.
+	PXGLBeginDirect();
+
 	////////////////////////////////////////
 	// Set up the texture rendering state //
 	////////////////////////////////////////
@@ -1217,6 +1657,7 @@ void PXEngineRenderToTexture(PXTextureData *textureData, PXDisplayObject *source
 
 	// Bind the texture to the buffer
 	glFramebufferTexture2DOES(GL_FRAMEBUFFER_OES, GL_COLOR_ATTACHMENT0_OES, GL_TEXTURE_2D, textureData->_glName, 0);
+	PXGLErrorTag("renderToTexture", textureData->_glName);
 
 #ifdef PX_DEBUG_MODE
 	// Make sure the buffer is bound properly
@@ -1244,6 +1685,7 @@ void PXEngineRenderToTexture(PXTextureData *textureData, PXDisplayObject *source
 				break;
 		}
 
+		PXGLEndDirect();
 		PXThrow(PXGLException, @"Framebuffer object is not complete. renderToTexture could not be completed");
 
 		return;
@@ -1373,6 +1815,8 @@ void PXEngineRenderToTexture(PXTextureData *textureData, PXDisplayObject *source
 
 	// Switch back to main buffer
 	[pxEngineView _bindFrameBufferDefault];
+
+	PXGLEndDirect();
 }
 
 // MARK: Extracting Pixel Data
@@ -1392,6 +1836,8 @@ void PXTextureDataReadPixels(PXTextureData *textureData, int x, int y, int width
 	if (!textureData)
 		return;
 
+	PXGLBeginDirect();
+
 	// Change the state
 
 	// Bind the Texture FBO
@@ -1423,6 +1869,8 @@ void PXTextureDataReadPixels(PXTextureData *textureData, int x, int y, int width
 
 	// Bind the screen buffer back
 	[pxEngineView _bindFrameBufferDefault];
+
+	PXGLEndDirect();
 }
 
 /**
@@ -1454,10 +1902,12 @@ void PXEngineGetScreenBufferPixels(int x, int y, int width, int height, void *pi
 
 	// Bind the screen buffer back
 	//PXGLBindFramebuffer(GL_FRAMEBUFFER_OES, pxEngineView->_framebuffer);
+	PXGLBeginDirect();
 	glReadPixels(x, y,
 				 width, height,
 				 GL_RGBA, GL_UNSIGNED_BYTE,
-				 pixels);	
+				 pixels);
+	PXGLEndDirect();
 }
 
 // MARK: Misc
@@ -1577,7 +2027,7 @@ float _PXEngineDBGGetTimeWaiting()
 	if (PXDebugIsEnabled(PXDebugSetting_CalculateFrameRate))
 	{
 	#if (PX_ENGINE_IDLE_TIME_INCLUDES_BETWEEN_SYSTEM_CALLS)
-		NSTimeInterval end = [NSDate timeIntervalSinceReferenceDate];
+		double end = PXTimeGetSeconds();
 		float delta = end - pxEngineInterval;
 
 		if (PXMathIsZero(pxEngineInterval) || PXMathIsZero(delta) || delta < 0.0f || delta > 2700.0f)
@@ -1626,7 +2076,7 @@ float _PXEngineDBGGetTimeWaiting()
 		animationTimer = nil;
 	}
 
-	if (!pxEngineIsRunning)
+	if (!pxEngineIsRunning || pxEngineHeadless)
 	{
 		return;
 	}
@@ -28,6 +28,7 @@
 #import "PXView.h"
 #import "PXDisplayObject.h"
 #import "PXTextureData.h"
+#import "PXArrayList.h"
 #import "PXLinkedList.h"
 #import "PXObjectPool.h"
 #import "PXSoundEngine.h"
@@ -137,6 +138,63 @@ typedef struct
 	PXDisplayObject **array;
 } _PXEngineDisplayObjectBuffer;
 
+typedef struct
+{
+	PXDisplayObject *displayObject;
+	// The dispatch generation the listener was added in
+	unsigned generation;
+} _PXEngineListener;
+
+/*
+ * A list of display objects the engine dispatches to every frame. It is walked
+ * in place rather than copied: listeners added during a dispatch are stamped
+ * with its generation and skipped by it, and listeners removed during a
+ * dispatch are set to nil and compacted away once it ends.
+ */
+typedef struct
+{
+	_PXEngineListener *array;
+	unsigned size;
+	unsigned maxSize;
+
+	unsigned generation;
+	unsigned dispatchDepth;
+
+	bool hasRemovedListeners;
+	bool retainsListeners;
+} _PXEngineListenerRegistry;
+
+/*
+ * Walks the listeners that were in the registry when the dispatch began and
+ * haven't been removed since. The registry may grow inside of the loop, so the
+ * array is looked up again on every step.
+ *
+ *	PXDisplayObject *displayObject;
+ *
+ *	_PXEngineListenerRegistryBeginDispatch(&registry);
+ *	_PXEngineListenerRegistryForEach(&registry, displayObject)
+ *	{
+ *		...
+ *	}
+ *	_PXEngineListenerRegistryEndDispatch(&registry);
+ */
+#define _PXEngineListenerRegistryForEach(_registry_, _obj_) \
+		for (unsigned PX_UNIQUE_VAR(_i_) = 0; PX_UNIQUE_VAR(_i_) < (_registry_)->size; ++PX_UNIQUE_VAR(_i_)) \
+			if ((_registry_)->array[PX_UNIQUE_VAR(_i_)].displayObject != nil && \
+			    (_registry_)->array[PX_UNIQUE_VAR(_i_)].generation != (_registry_)->generation && \
+			    ((_obj_) = (_registry_)->array[PX_UNIQUE_VAR(_i_)].displayObject, YES))
+
+/*
+ * The same as _PXEngineListenerRegistryForEach, but the position of the
+ * listener is kept in `_index_` so it can be passed to
+ * _PXEngineListenerRegistryRemoveAtIndex.
+ */
+#define _PXEngineListenerRegistryForEachAtIndex(_registry_, _index_, _obj_) \
+		for ((_index_) = 0; (_index_) < (_registry_)->size; ++(_index_)) \
+			if ((_registry_)->array[(_index_)].displayObject != nil && \
+			    (_registry_)->array[(_index_)].generation != (_registry_)->generation && \
+			    ((_obj_) = (_registry_)->array[(_index_)].displayObject, YES))
+
 // MARK: -
 // MARK: Variables
 // MARK: -
@@ -151,8 +209,18 @@ PXExtern PXDisplayObject **pxEngineDOBufferCurrentObject;
 PXExtern unsigned pxEngineDOBufferMaxSize;
 PXExtern unsigned pxEngineDOBufferOldMaxSize;
 
+PXExtern float pxEngineLogicTimeAccum;
+PXExtern float pxEngineRenderTimeAccum;
+
 PXExtern void PXTouchEngineDispatchTouchEvents();
 
+PXExtern void _PXEngineListenerRegistryAdd(_PXEngineListenerRegistry *registry, PXDisplayObject *displayObject);
+PXExtern void _PXEngineListenerRegistryRemove(_PXEngineListenerRegistry *registry, PXDisplayObject *displayObject);
+PXExtern void _PXEngineListenerRegistryRemoveAtIndex(_PXEngineListenerRegistry *registry, unsigned index);
+PXExtern void _PXEngineListenerRegistryBeginDispatch(_PXEngineListenerRegistry *registry);
+PXExtern void _PXEngineListenerRegistryEndDispatch(_PXEngineListenerRegistry *registry);
+PXExtern void _PXEngineListenerRegistryFree(_PXEngineListenerRegistry *registry);
+
 PXExtern PXGLAABB PXEngineAABBStageToGL(PXGLAABB aabb, PXStage *stage);
 PXExtern PXGLAABB PXEngineAABBGLToStage(PXGLAABB aabb, PXStage *stage);
 PXExtern PXGLAABBf PXEngineAABBfStageToGL(PXGLAABBf aabb, PXStage *stage);
@@ -18,6 +18,132 @@ PXDisplayObject **pxEngineDOBufferCurrentObject = NULL;
 unsigned pxEngineDOBufferMaxSize = 0;
 unsigned pxEngineDOBufferOldMaxSize = 0;
 
+// MARK: Listener registries
+
+PXInline void _PXEngineListenerRegistryCompact(_PXEngineListenerRegistry *registry)
+{
+	_PXEngineListener *listener = registry->array;
+	_PXEngineListener *end = registry->array + registry->size;
+	_PXEngineListener *kept = registry->array;
+
+	for (; listener < end; ++listener)
+	{
+		if (listener->displayObject == nil)
+			continue;
+
+		*kept = *listener;
+		++kept;
+	}
+
+	registry->size = kept - registry->array;
+	registry->hasRemovedListeners = false;
+}
+
+void _PXEngineListenerRegistryAdd(_PXEngineListenerRegistry *registry, PXDisplayObject *displayObject)
+{
+	if (displayObject == nil)
+		return;
+
+	if (registry->size == registry->maxSize)
+	{
+		registry->maxSize = (registry->maxSize == 0) ? 16 : (registry->maxSize << 1);
+		registry->array = realloc(registry->array, sizeof(_PXEngineListener) * registry->maxSize);
+	}
+
+	_PXEngineListener *listener = registry->array + registry->size;
+	++(registry->size);
+
+	listener->displayObject = displayObject;
+	listener->generation = registry->generation;
+
+	if (registry->retainsListeners)
+		[displayObject retain];
+}
+
+void _PXEngineListenerRegistryRemove(_PXEngineListenerRegistry *registry, PXDisplayObject *displayObject)
+{
+	if (displayObject == nil)
+		return;
+
+	unsigned index;
+
+	for (index = 0; index < registry->size; ++index)
+	{
+		if (registry->array[index].displayObject == displayObject)
+		{
+			_PXEngineListenerRegistryRemoveAtIndex(registry, index);
+			return;
+		}
+	}
+}
+
+void _PXEngineListenerRegistryRemoveAtIndex(_PXEngineListenerRegistry *registry, unsigned index)
+{
+	if (index >= registry->size)
+		return;
+
+	_PXEngineListener *listener = registry->array + index;
+	PXDisplayObject *displayObject = listener->displayObject;
+
+	if (displayObject == nil)
+		return;
+
+	// Moving the listeners down in the middle of a dispatch would make it
+	// skip one, so the slot is left empty until the dispatch ends.
+	if (registry->dispatchDepth > 0)
+	{
+		listener->displayObject = nil;
+		registry->hasRemovedListeners = true;
+	}
+	else
+	{
+		memmove(listener, listener + 1, sizeof(_PXEngineListener) * (registry->size - index - 1));
+		--(registry->size);
+	}
+
+	if (registry->retainsListeners)
+		[displayObject release];
+}
+
+void _PXEngineListenerRegistryBeginDispatch(_PXEngineListenerRegistry *registry)
+{
+	if (registry->dispatchDepth == 0)
+		++(registry->generation);
+
+	++(registry->dispatchDepth);
+}
+
+void _PXEngineListenerRegistryEndDispatch(_PXEngineListenerRegistry *registry)
+{
+	if (registry->dispatchDepth == 0)
+		return;
+
+	--(registry->dispatchDepth);
+
+	if (registry->dispatchDepth == 0 && registry->hasRemovedListeners)
+		_PXEngineListenerRegistryCompact(registry);
+}
+
+void _PXEngineListenerRegistryFree(_PXEngineListenerRegistry *registry)
+{
+	if (registry->retainsListeners)
+	{
+		_PXEngineListener *listener = registry->array;
+		_PXEngineListener *end = registry->array + registry->size;
+
+		for (; listener < end; ++listener)
+			[listener->displayObject release];
+	}
+
+	free(registry->array);
+
+	registry->array = NULL;
+	registry->size = 0;
+	registry->maxSize = 0;
+	registry->dispatchDepth = 0;
+	registry->hasRemovedListeners = false;
+}
+
 PXGLAABB PXEngineAABBStageToGL(PXGLAABB aabb, PXStage *stage)
 {
 	aabb = PXEngineAABBGLToStage(aabb, stage);
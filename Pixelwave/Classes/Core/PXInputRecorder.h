@@ -0,0 +1,83 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef PX_INPUT_RECORDER_H
+#define PX_INPUT_RECORDER_H
+
+#include <stdbool.h>
+
+#include <CoreGraphics/CGGeometry.h>
+
+@class UITouch;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Records a session's input, so that it can be played back exactly. The file
+ * holds the random seed the session ran with, followed by every touch handed
+ * to the touch engine and the interval of every frame, in the order they
+ * happened. Values are written in the device's byte order.
+ *
+ * Playing back steps the engine by hand (see PXEngineStepFrame), feeding it
+ * the recorded touches before each recorded frame. For the session to come
+ * out the same, playback should start from the same state the recording did,
+ * usually right after launch. Playing back in headless mode (see
+ * PXEngineSetHeadless) measures the engine's own logic and render time, frame
+ * by frame, through PXEngineGetFramePacing.
+ */
+
+bool PXInputRecorderStart(const char *path);
+void PXInputRecorderStop();
+bool PXInputRecorderIsRecording();
+
+void PXInputRecorderRecordFrame(float dt);
+void PXInputRecorderRecordTouch(UITouch *touch, CGPoint *pos, NSString *type);
+
+bool PXInputReplayStart(const char *path);
+void PXInputReplayStop();
+bool PXInputReplayIsPlaying();
+bool PXInputReplayStepFrame();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,460 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXInputRecorder.h"
+
+#include "PXEngine.h"
+#include "PXEnginePrivate.h"
+#include "PXTouchEngine.h"
+#include "PXMathUtils.h"
+
+#import <UIKit/UITouch.h>
+
+#import "PXTouchEvent.h"
+#import "PXDebug.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define PX_INPUT_RECORDER_MAGIC "PXIR"
+#define PX_INPUT_RECORDER_VERSION 1
+
+// More touches than UIKit ever reports at once
+#define PX_INPUT_RECORDER_MAX_TOUCHES 16
+
+typedef enum
+{
+	_PXInputRecordKind_Frame = 0,
+	_PXInputRecordKind_TouchDown,
+	_PXInputRecordKind_TouchMove,
+	_PXInputRecordKind_TouchUp,
+	_PXInputRecordKind_TouchCancel
+} _PXInputRecordKind;
+
+typedef struct
+{
+	// Weakly referenced while recording, strongly while playing back
+	UITouch *touch;
+	uint16_t touchID;
+} _PXInputTouchSlot;
+
+/*
+ * A touch that stands in for a recorded UITouch while playing back. The touch
+ * engine only asks a touch where it is and how many times it was tapped.
+ */
+@interface PXInputReplayTouch : UITouch
+{
+@public
+	CGPoint location;
+	CGPoint previousLocation;
+	NSUInteger tapCount;
+}
+@end
+
+@implementation PXInputReplayTouch
+
+- (CGPoint) locationInView:(UIView *)view
+{
+	return location;
+}
+
+- (CGPoint) previousLocationInView:(UIView *)view
+{
+	return previousLocation;
+}
+
+- (NSUInteger) tapCount
+{
+	return tapCount;
+}
+
+@end
+
+// MARK: -
+// MARK: Variables
+// MARK: -
+
+FILE *pxInputRecorderFile = NULL;
+_PXInputTouchSlot pxInputRecorderTouches[PX_INPUT_RECORDER_MAX_TOUCHES];
+uint16_t pxInputRecorderNextTouchID = 0;
+
+uint8_t *pxInputReplayData = NULL;
+size_t pxInputReplaySize = 0;
+size_t pxInputReplayOffset = 0;
+_PXInputTouchSlot pxInputReplayTouches[PX_INPUT_RECORDER_MAX_TOUCHES];
+
+// MARK: -
+// MARK: Touch slots
+// MARK: -
+
+PXInline _PXInputTouchSlot *_PXInputFindSlot(_PXInputTouchSlot *slots, UITouch *touch)
+{
+	unsigned index;
+	for (index = 0; index < PX_INPUT_RECORDER_MAX_TOUCHES; ++index)
+	{
+		if (slots[index].touch == touch)
+			return slots + index;
+	}
+
+	return NULL;
+}
+
+PXInline _PXInputTouchSlot *_PXInputFindSlotWithID(_PXInputTouchSlot *slots, uint16_t touchID)
+{
+	unsigned index;
+	for (index = 0; index < PX_INPUT_RECORDER_MAX_TOUCHES; ++index)
+	{
+		if (slots[index].touch != nil && slots[index].touchID == touchID)
+			return slots + index;
+	}
+
+	return NULL;
+}
+
+// MARK: -
+// MARK: Recording
+// MARK: -
+
+PXInline void _PXInputWrite(const void *value, size_t size)
+{
+	fwrite(value, size, 1, pxInputRecorderFile);
+}
+
+/*
+ * Starts writing the session's input to the file at the given path, replacing
+ * it. The random number generator is seeded here, so that the seed can be
+ * saved along with the input.
+ */
+bool PXInputRecorderStart(const char *path)
+{
+	PXInputRecorderStop();
+
+	if (path == NULL)
+		return false;
+
+	pxInputRecorderFile = fopen(path, "wb");
+
+	if (pxInputRecorderFile == NULL)
+	{
+		PXDebugLog(@"PXInputRecorder: Couldn't open %s for writing", path);
+		return false;
+	}
+
+	uint32_t version = PX_INPUT_RECORDER_VERSION;
+	uint32_t seed = (uint32_t)time(NULL);
+
+	PXMathSeedRandomWithValue(seed);
+
+	_PXInputWrite(PX_INPUT_RECORDER_MAGIC, 4);
+	_PXInputWrite(&version, sizeof(uint32_t));
+	_PXInputWrite(&seed, sizeof(uint32_t));
+	_PXInputWrite(&pxEngineLogicTimeAccum, sizeof(float));
+	_PXInputWrite(&pxEngineRenderTimeAccum, sizeof(float));
+
+	memset(pxInputRecorderTouches, 0, sizeof(pxInputRecorderTouches));
+	pxInputRecorderNextTouchID = 0;
+
+	return true;
+}
+
+void PXInputRecorderStop()
+{
+	if (pxInputRecorderFile == NULL)
+		return;
+
+	fclose(pxInputRecorderFile);
+	pxInputRecorderFile = NULL;
+}
+
+bool PXInputRecorderIsRecording()
+{
+	return pxInputRecorderFile != NULL;
+}
+
+void PXInputRecorderRecordFrame(float dt)
+{
+	if (pxInputRecorderFile == NULL)
+		return;
+
+	uint8_t kind = _PXInputRecordKind_Frame;
+
+	_PXInputWrite(&kind, sizeof(uint8_t));
+	_PXInputWrite(&dt, sizeof(float));
+}
+
+void PXInputRecorderRecordTouch(UITouch *touch, CGPoint *pos, NSString *type)
+{
+	if (pxInputRecorderFile == NULL || touch == nil)
+		return;
+
+	uint8_t kind;
+
+	if ([type isEqualToString:PXTouchEvent_TouchMove])
+		kind = _PXInputRecordKind_TouchMove;
+	else if ([type isEqualToString:PXTouchEvent_TouchDown])
+		kind = _PXInputRecordKind_TouchDown;
+	else if ([type isEqualToString:PXTouchEvent_TouchUp])
+		kind = _PXInputRecordKind_TouchUp;
+	else if ([type isEqualToString:PXTouchEvent_TouchCancel])
+		kind = _PXInputRecordKind_TouchCancel;
+	else
+		return;
+
+	// Touches are told apart by id in the file. A touch that isn't known yet
+	// (including one that began before recording did) gets a new one.
+	_PXInputTouchSlot *slot = _PXInputFindSlot(pxInputRecorderTouches, touch);
+
+	if (slot == NULL)
+	{
+		slot = _PXInputFindSlot(pxInputRecorderTouches, nil);
+
+		if (slot == NULL)
+			return;
+
+		slot->touch = touch;
+		slot->touchID = pxInputRecorderNextTouchID;
+		++pxInputRecorderNextTouchID;
+	}
+
+	uint16_t touchID = slot->touchID;
+	uint16_t tapCount = (uint16_t)touch.tapCount;
+	float x = (pos != NULL) ? pos->x : 0.0f;
+	float y = (pos != NULL) ? pos->y : 0.0f;
+
+	_PXInputWrite(&kind, sizeof(uint8_t));
+	_PXInputWrite(&touchID, sizeof(uint16_t));
+	_PXInputWrite(&tapCount, sizeof(uint16_t));
+	_PXInputWrite(&x, sizeof(float));
+	_PXInputWrite(&y, sizeof(float));
+
+	if (kind == _PXInputRecordKind_TouchUp || kind == _PXInputRecordKind_TouchCancel)
+		slot->touch = nil;
+}
+
+// MARK: -
+// MARK: Playing back
+// MARK: -
+
+PXInline bool _PXInputRead(void *value, size_t size)
+{
+	if (pxInputReplayOffset + size > pxInputReplaySize)
+		return false;
+
+	memcpy(value, pxInputReplayData + pxInputReplayOffset, size);
+	pxInputReplayOffset += size;
+
+	return true;
+}
+
+/*
+ * Loads the recording at the given path and puts the random seed and the
+ * engine's clock back to what they were when it was made. Frames are then
+ * played back one at a time with PXInputReplayStepFrame.
+ */
+bool PXInputReplayStart(const char *path)
+{
+	PXInputReplayStop();
+
+	if (path == NULL)
+		return false;
+
+	FILE *file = fopen(path, "rb");
+
+	if (file == NULL)
+	{
+		PXDebugLog(@"PXInputRecorder: Couldn't open %s for reading", path);
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	if (size > 0)
+	{
+		pxInputReplayData = malloc(size);
+
+		if (pxInputReplayData && fread(pxInputReplayData, size, 1, file) == 1)
+			pxInputReplaySize = size;
+	}
+
+	fclose(file);
+
+	char magic[4];
+	uint32_t version = 0;
+	uint32_t seed = 0;
+	float logicTimeAccum = 0.0f;
+	float renderTimeAccum = 0.0f;
+
+	if (!_PXInputRead(magic, 4) ||
+	    memcmp(magic, PX_INPUT_RECORDER_MAGIC, 4) != 0 ||
+	    !_PXInputRead(&version, sizeof(uint32_t)) ||
+	    version != PX_INPUT_RECORDER_VERSION ||
+	    !_PXInputRead(&seed, sizeof(uint32_t)) ||
+	    !_PXInputRead(&logicTimeAccum, sizeof(float)) ||
+	    !_PXInputRead(&renderTimeAccum, sizeof(float)))
+	{
+		PXDebugLog(@"PXInputRecorder: %s isn't a recording this version can play", path);
+		PXInputReplayStop();
+		return false;
+	}
+
+	PXMathSeedRandomWithValue(seed);
+	pxEngineLogicTimeAccum = logicTimeAccum;
+	pxEngineRenderTimeAccum = renderTimeAccum;
+
+	memset(pxInputReplayTouches, 0, sizeof(pxInputReplayTouches));
+
+	return true;
+}
+
+void PXInputReplayStop()
+{
+	unsigned index;
+	for (index = 0; index < PX_INPUT_RECORDER_MAX_TOUCHES; ++index)
+	{
+		[pxInputReplayTouches[index].touch release];
+		pxInputReplayTouches[index].touch = nil;
+	}
+
+	free(pxInputReplayData);
+	pxInputReplayData = NULL;
+	pxInputReplaySize = 0;
+	pxInputReplayOffset = 0;
+}
+
+bool PXInputReplayIsPlaying()
+{
+	return pxInputReplayData != NULL;
+}
+
+PXInline void _PXInputReplayTouch(uint8_t kind, uint16_t touchID, uint16_t tapCount, CGPoint pos)
+{
+	_PXInputTouchSlot *slot = _PXInputFindSlotWithID(pxInputReplayTouches, touchID);
+
+	if (slot == NULL)
+	{
+		slot = _PXInputFindSlot(pxInputReplayTouches, nil);
+
+		if (slot == NULL)
+			return;
+
+		PXInputReplayTouch *newTouch = [[PXInputReplayTouch alloc] init];
+		newTouch->location = pos;
+
+		slot->touch = newTouch;
+		slot->touchID = touchID;
+	}
+
+	PXInputReplayTouch *touch = (PXInputReplayTouch *)(slot->touch);
+
+	touch->previousLocation = touch->location;
+	touch->location = pos;
+	touch->tapCount = tapCount;
+
+	switch (kind)
+	{
+		case _PXInputRecordKind_TouchDown:
+			PXTouchEngineInvokeTouchDown(touch, &pos);
+			break;
+		case _PXInputRecordKind_TouchMove:
+			PXTouchEngineInvokeTouchMove(touch, &pos);
+			break;
+		case _PXInputRecordKind_TouchUp:
+			PXTouchEngineInvokeTouchUp(touch, &pos);
+			break;
+		case _PXInputRecordKind_TouchCancel:
+			PXTouchEngineInvokeTouchCancel(touch, &pos);
+			break;
+		default:
+			break;
+	}
+
+	// The touch engine holds on to the touch for as long as it needs it
+	if (kind == _PXInputRecordKind_TouchUp || kind == _PXInputRecordKind_TouchCancel)
+	{
+		[touch release];
+		slot->touch = nil;
+	}
+}
+
+/*
+ * Hands the touch engine the touches that came before the next recorded
+ * frame, then runs that frame with its recorded interval.
+ *
+ * @return - false once the recording has run out of frames.
+ */
+bool PXInputReplayStepFrame()
+{
+	if (pxInputReplayData == NULL)
+		return false;
+
+	uint8_t kind;
+
+	while (_PXInputRead(&kind, sizeof(uint8_t)))
+	{
+		if (kind == _PXInputRecordKind_Frame)
+		{
+			float dt;
+
+			if (!_PXInputRead(&dt, sizeof(float)))
+				break;
+
+			PXEngineStepFrame(dt);
+			return true;
+		}
+
+		uint16_t touchID;
+		uint16_t tapCount;
+		float x;
+		float y;
+
+		if (!_PXInputRead(&touchID, sizeof(uint16_t)) ||
+		    !_PXInputRead(&tapCount, sizeof(uint16_t)) ||
+		    !_PXInputRead(&x, sizeof(float)) ||
+		    !_PXInputRead(&y, sizeof(float)))
+		{
+			break;
+		}
+
+		_PXInputReplayTouch(kind, touchID, tapCount, CGPointMake(x, y));
+	}
+
+	return false;
+}
@@ -0,0 +1,298 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXRenderThread.h"
+
+#import "PXView.h"
+#include "PXGLErrorUtils.h"
+#include "PXDebugUtils.h"
+#include "PXProfileUtils.h"
+
+#include <pthread.h>
+
+// MARK: -
+// MARK: Variables
+// MARK: -
+
+pthread_t pxRenderThread;
+pthread_mutex_t pxRenderThreadMutex;
+pthread_cond_t pxRenderThreadCondition;
+
+// Not retained, the view owns the engine which owns the thread
+PXView *pxRenderThreadView = nil;
+PXGLCommandBuffer *pxRenderThreadBuffers[2] = {NULL, NULL};
+unsigned pxRenderThreadBackIndex = 0;
+
+// The buffer waiting to be replayed, NULL when there is none
+PXGLCommandBuffer *pxRenderThreadPendingBuffer = NULL;
+
+bool pxRenderThreadRunning = false;
+bool pxRenderThreadShouldExit = false;
+// Set from the moment a frame is committed until it has been presented
+bool pxRenderThreadBusy = false;
+// Set when the render thread was the last to make the context current
+bool pxRenderThreadOwnsContext = false;
+
+// MARK: -
+// MARK: Functions
+// MARK: -
+
+void *PXRenderThreadMain(void *userData);
+
+// Must be called with the mutex locked.
+PXInline void PXRenderThreadWaitUntilIdle()
+{
+	while (pxRenderThreadBusy)
+		pthread_cond_wait(&pxRenderThreadCondition, &pxRenderThreadMutex);
+}
+
+/*
+ * Starts replaying frames on a thread of their own. Returns false if the
+ * thread could not be made, in which case rendering stays on the main thread.
+ */
+bool PXRenderThreadStart(PXView *view)
+{
+	if (pxRenderThreadRunning)
+		return true;
+
+	if (!view)
+		return false;
+
+	pxRenderThreadBuffers[0] = PXGLCommandBufferCreate();
+	pxRenderThreadBuffers[1] = PXGLCommandBufferCreate();
+
+	if (!pxRenderThreadBuffers[0] || !pxRenderThreadBuffers[1])
+	{
+		PXGLCommandBufferFree(pxRenderThreadBuffers[0]);
+		PXGLCommandBufferFree(pxRenderThreadBuffers[1]);
+		pxRenderThreadBuffers[0] = NULL;
+		pxRenderThreadBuffers[1] = NULL;
+
+		return false;
+	}
+
+	pxRenderThreadView = view;
+	pxRenderThreadBackIndex = 0;
+	pxRenderThreadPendingBuffer = NULL;
+	pxRenderThreadShouldExit = false;
+	pxRenderThreadBusy = false;
+	pxRenderThreadOwnsContext = false;
+
+	pthread_mutex_init(&pxRenderThreadMutex, NULL);
+	pthread_cond_init(&pxRenderThreadCondition, NULL);
+
+	if (pthread_create(&pxRenderThread, NULL, PXRenderThreadMain, NULL) != 0)
+	{
+		PXDebugLog(@"PXRenderThread couldn't create a thread, rendering on the main thread instead\n");
+
+		pthread_cond_destroy(&pxRenderThreadCondition);
+		pthread_mutex_destroy(&pxRenderThreadMutex);
+
+		PXGLCommandBufferFree(pxRenderThreadBuffers[0]);
+		PXGLCommandBufferFree(pxRenderThreadBuffers[1]);
+		pxRenderThreadBuffers[0] = NULL;
+		pxRenderThreadBuffers[1] = NULL;
+
+		pxRenderThreadView = nil;
+
+		return false;
+	}
+
+	pxRenderThreadRunning = true;
+	PXGLSetDirectSyncFunction(PXRenderThreadSync);
+
+	return true;
+}
+
+/*
+ * Waits for the frame in flight to be presented, then stops the thread and
+ * hands the context back to the main thread.
+ */
+void PXRenderThreadStop()
+{
+	if (!pxRenderThreadRunning)
+		return;
+
+	pthread_mutex_lock(&pxRenderThreadMutex);
+	PXRenderThreadWaitUntilIdle();
+	pxRenderThreadShouldExit = true;
+	pthread_cond_broadcast(&pxRenderThreadCondition);
+	pthread_mutex_unlock(&pxRenderThreadMutex);
+
+	pthread_join(pxRenderThread, NULL);
+
+	pxRenderThreadRunning = false;
+	PXGLSetDirectSyncFunction(NULL);
+
+	if (pxRenderThreadOwnsContext)
+	{
+		pxRenderThreadOwnsContext = false;
+		[pxRenderThreadView _setCurrentContext];
+	}
+
+	pthread_cond_destroy(&pxRenderThreadCondition);
+	pthread_mutex_destroy(&pxRenderThreadMutex);
+
+	// Resetting lets go of anything the recorded callbacks held on to.
+	PXGLCommandBufferFree(pxRenderThreadBuffers[0]);
+	PXGLCommandBufferFree(pxRenderThreadBuffers[1]);
+	pxRenderThreadBuffers[0] = NULL;
+	pxRenderThreadBuffers[1] = NULL;
+	pxRenderThreadPendingBuffer = NULL;
+
+	pxRenderThreadView = nil;
+}
+
+bool PXRenderThreadIsRunning()
+{
+	return pxRenderThreadRunning;
+}
+
+/*
+ * Returns an empty buffer to record the next frame into. The render thread
+ * never touches this buffer until it is committed.
+ */
+PXGLCommandBuffer *PXRenderThreadBeginFrame()
+{
+	if (!pxRenderThreadRunning)
+		return NULL;
+
+	PXGLCommandBuffer *buffer = pxRenderThreadBuffers[pxRenderThreadBackIndex];
+	PXGLCommandBufferReset(buffer);
+
+	return buffer;
+}
+
+/*
+ * Hands the recorded frame over to the render thread. If the previous frame is
+ * still being replayed, this waits for it first.
+ */
+void PXRenderThreadCommitFrame()
+{
+	if (!pxRenderThreadRunning)
+		return;
+
+	PX_PROFILE_ZONE("PXRenderThreadCommitFrame");
+
+	pthread_mutex_lock(&pxRenderThreadMutex);
+	PXRenderThreadWaitUntilIdle();
+
+	// Let go of the context, so that stray gl calls on the main thread can't
+	// land in the middle of the frame being replayed.
+	if (!pxRenderThreadOwnsContext)
+		[pxRenderThreadView _clearCurrentContext];
+
+	pxRenderThreadPendingBuffer = pxRenderThreadBuffers[pxRenderThreadBackIndex];
+	pxRenderThreadBackIndex = 1 - pxRenderThreadBackIndex;
+	pxRenderThreadBusy = true;
+	pxRenderThreadOwnsContext = true;
+
+	pthread_cond_broadcast(&pxRenderThreadCondition);
+	pthread_mutex_unlock(&pxRenderThreadMutex);
+
+	PXGLSetNeedsDirectSync();
+}
+
+/*
+ * Waits for the frame in flight to be presented and makes the context current
+ * on the main thread again. PXGL calls this before touching gl directly.
+ */
+void PXRenderThreadSync()
+{
+	if (!pxRenderThreadRunning)
+		return;
+
+	pthread_mutex_lock(&pxRenderThreadMutex);
+	PXRenderThreadWaitUntilIdle();
+	pthread_mutex_unlock(&pxRenderThreadMutex);
+
+	if (pxRenderThreadOwnsContext)
+	{
+		pxRenderThreadOwnsContext = false;
+		[pxRenderThreadView _setCurrentContext];
+	}
+}
+
+void *PXRenderThreadMain(void *userData)
+{
+	PXGLCommandBuffer *buffer;
+
+	PX_PROFILE_THREAD_NAME("Render");
+
+	while (true)
+	{
+		pthread_mutex_lock(&pxRenderThreadMutex);
+
+		while (!pxRenderThreadPendingBuffer && !pxRenderThreadShouldExit)
+			pthread_cond_wait(&pxRenderThreadCondition, &pxRenderThreadMutex);
+
+		buffer = pxRenderThreadPendingBuffer;
+		pxRenderThreadPendingBuffer = NULL;
+
+		pthread_mutex_unlock(&pxRenderThreadMutex);
+
+		if (!buffer)
+			break;
+
+		NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+		PX_PROFILE_ZONE("PXRenderThreadFrame");
+
+		// The main thread let go of the context when it committed the frame,
+		// and won't take it back until the frame has been presented.
+		[pxRenderThreadView _setCurrentContext];
+
+		PXGLCommandBufferReplay(buffer);
+		[pxRenderThreadView _swapBuffers];
+
+		// Now that the frame has been handed over, asking gl for the errors it
+		// raised doesn't hold anything up.
+		PXGLErrorFlush();
+
+		[pxRenderThreadView _clearCurrentContext];
+
+		[pool release];
+
+		pthread_mutex_lock(&pxRenderThreadMutex);
+		pxRenderThreadBusy = false;
+		pthread_cond_broadcast(&pxRenderThreadCondition);
+		pthread_mutex_unlock(&pxRenderThreadMutex);
+	}
+
+	return NULL;
+}
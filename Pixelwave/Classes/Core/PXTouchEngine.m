@@ -10,6 +10,7 @@
 
 #include "PXEngine.h"
 #include "PXEnginePrivate.h"
+#include "PXInputRecorder.h"
 
 // MARK: -
 // MARK: Variables
@@ -345,7 +346,15 @@ void PXTouchEngineDispatchTouchEvents()
 		}
 	}
 
-	[pxTouchEngineTouchEvents removeAllObjects];
+	// Hand the events back to the pool. The list lets go of each one first, so
+	// that the pool can tell whether a listener kept it.
+	while (pxTouchEngineTouchEvents.count > 0)
+	{
+		event = [pxTouchEngineTouchEvents.lastObject retain];
+		[pxTouchEngineTouchEvents removeLastObject];
+
+		[event _releaseToPool];
+	}
 }
 
 // MARK: -
@@ -378,7 +387,7 @@ void PXTouchEngineCancelTouch(UITouch *touch)
 	// Send out the cancel event.
 	PXTouchEvent *event = PXTouchEngineNewTouchEventWithTouch(touch, &point, PXTouchEvent_TouchCancel, NO);
 	[object dispatchEvent:event];
-	[event release];
+	[event _releaseToPool];
 }
 
 // A recursive method that will fill the 'addList' with any display object in
@@ -411,11 +420,10 @@ bool PXTouchEngineGetTouchDisplayHierarchy(PXDisplayObject *object, PXLinkedList
 	{
 		PXDisplayObjectContainer *container = (PXDisplayObjectContainer *)object;
 
-		unsigned index;
 		PXDisplayObject *child;
 
 		// Loop through each of the children and add them to the list if needed.
-		for (index = 0, child = container->_childrenHead; index < container->_numChildren; ++index, child = child->_next)
+		PXArrayListForEach(container->_children, child)
 		{
 			// If we returned false, then it means we are done looking and can
 			// just return. This will trickle up through the call stack
@@ -641,11 +649,13 @@ PXTouchEvent *PXTouchEngineNewTouchEventWithTouch(UITouch *touch, CGPoint *pos,
 #endif
 	}
 
-	return [[PXTouchEvent alloc] initWithType:type nativeTouch:touch stageX:location.x stageY:location.y tapCount:touch.tapCount];
+	return [PXTouchEvent _newPooledEventWithType:type nativeTouch:touch stageX:location.x stageY:location.y tapCount:touch.tapCount];
 }
 
 void PXTouchEngineInvokeTouch(UITouch *touch, CGPoint *pos, NSString *type)
 {
+	PXInputRecorderRecordTouch(touch, pos, type);
+
 	// Add the event to the queue.
 	PXTouchEvent *event = PXTouchEngineNewTouchEventWithTouch(touch, pos, type, YES);
 	[pxTouchEngineTouchEvents addObject:event];
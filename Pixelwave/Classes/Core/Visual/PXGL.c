@@ -47,6 +47,7 @@
 
 #include "PXGLUtils.h"
 #include "PXGLStatePrivate.h"
+#include "PXGLCommandBuffer.h"
 #include <limits.h>
 
 #define PX_GL_MATRIX_STACK_SIZE 16
@@ -66,9 +67,13 @@ PXGLColorTransform *pxGLCurrentColor = pxGLColors;
 unsigned short pxGLCurrentMatrixIndex = 0;
 unsigned short pxGLCurrentColorIndex = 0;
 
-#ifdef PX_DEBUG_MODE
-GLuint pxGLRenderCallCount;
-#endif
+// The frame being rendered, the last finished one, and a ring of the last
+// PX_GL_STATISTICS_WINDOW finished frames.
+PXGLRenderStatistics pxGLStatistics;
+PXGLRenderStatistics pxGLStatisticsLastFrame;
+PXGLRenderStatistics pxGLStatisticsWindow[PX_GL_STATISTICS_WINDOW];
+unsigned pxGLStatisticsWindowIndex = 0;
+unsigned pxGLStatisticsWindowCount = 0;
 
 float pxGLScaleFactor = 1.0f;
 float pxGLOne_ScaleFactor = 1.0f;
@@ -92,6 +97,10 @@ GLfloat pxGLLineWidth = 0.0f;
 
 GLuint pxGLTexture = 0;
 
+// Read once gl is set up, so that other threads can check for extensions
+const char *pxGLExtensions = NULL;
+GLint pxGLMaxTextureSize = 0;
+
 _PXGLArrayPointer pxGLPointSizePointer;
 _PXGLArrayPointer pxGLVertexPointer;
 _PXGLArrayPointer pxGLColorPointer;
@@ -130,6 +139,9 @@ void PXGLInit(unsigned width, unsigned height, float scaleFactor)
 	pxGLDefaultState.blendSource = GL_SRC_ALPHA;
 	pxGLDefaultState.blendDestination = GL_ONE_MINUS_SRC_ALPHA;
 
+	pxGLExtensions = (const char *)glGetString(GL_EXTENSIONS);
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &pxGLMaxTextureSize);
+
 	glBlendFunc(pxGLDefaultState.blendSource, pxGLDefaultState.blendDestination);
 	// TODO:	This function should be used to make rendering to texture work
 	//			better. It doesn't really make a difference when just rendering
@@ -139,8 +151,8 @@ void PXGLInit(unsigned width, unsigned height, float scaleFactor)
 	//			So we need to check if (glBlendFuncSeparateOES != NULL) before
 	//			calling it. Otherwise, glBlendFunc could just be used.
 
-	// NOTE:	Could use glGetString(GL_EXTENSIONS) to figure out which
-	//			extensions are available.
+	// NOTE:	Could use PXGLIsExtensionSupported to figure out if this is
+	//			available.
 	//glBlendFuncSeparateOES(pxGLDefaultState.blendSource, pxGLDefaultState.blendDestination, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
 	glDisable(GL_DEPTH_TEST);
@@ -149,6 +161,11 @@ void PXGLInit(unsigned width, unsigned height, float scaleFactor)
 	// Set defaults
 	glDisable(GL_TEXTURE_2D);
 	glDisable(GL_POINT_SMOOTH);
+	glDisable(GL_ALPHA_TEST);
+
+	// Alpha testing is only used to draw distance fields, where the edge is
+	// at half of the alpha range.
+	glAlphaFunc(GL_GEQUAL, 0.5f);
 
 	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 	glDisableClientState(GL_POINT_SIZE_ARRAY_OES);
@@ -205,6 +222,14 @@ void PXGLFlush()
 	PXGLFlushBuffer();
 }
 
+/*
+ * Flushes the buffer, recording why in the render statistics.
+ */
+void PXGLFlushWithCause(PXGLFlushCause cause)
+{
+	PXGLFlushBufferWithCause(cause);
+}
+
 /*
  * This method returns the texture id for the render to texture buffer.
  *
@@ -320,7 +345,7 @@ void PXGLSyncPXToGL()
 
 	// If any of our values have changed, then we should flush the buffer
 	if (changed)
-		PXGLFlushBuffer();
+		PXGLFlushBufferWithCause(PXGLFlushCause_StateChange);
 }
 
 /*
@@ -334,9 +359,9 @@ void PXGLSyncState(GLenum cap)
 	GLuint state = PXGLGLStateToPXState(cap);
 
 	if (PX_IS_BIT_ENABLED(pxGLStateInGL.state, state))
-		glEnable(cap);
+		PXGLCmdEnable(cap);
 	else
-		glDisable(cap);
+		PXGLCmdDisable(cap);
 }
 
 /*
@@ -350,9 +375,9 @@ void PXGLSyncClientState(GLenum array)
 	GLuint state = PXGLGLClientStateToPXClientState(array);
 
 	if (PX_IS_BIT_ENABLED(pxGLStateInGL.clientState, state))
-		glEnableClientState(array);
+		PXGLCmdEnableClientState(array);
 	else
-		glDisableClientState(array);
+		PXGLCmdDisableClientState(array);
 }
 
 /*
@@ -363,7 +388,7 @@ void PXGLSyncClientState(GLenum array)
 void PXGLSyncGLToPX()
 {
 	// Lets make sure vertex array is on... we do wish to draw stuff after all.
-	glEnableClientState(GL_VERTEX_ARRAY);
+	PXGLCmdEnableClientState(GL_VERTEX_ARRAY);
 
 	// Lets synchronize the rest of our states,
 	PXGLSyncState(GL_POINT_SPRITE_OES);
@@ -374,27 +399,68 @@ void PXGLSyncGLToPX()
 	PXGLSyncClientState(GL_POINT_SIZE_ARRAY_OES);
 
 	// Bind the texture, color, line width and point size we are currently using,
-	glBindTexture(GL_TEXTURE_2D, pxGLTexture);
-	glColor4ub(pxGLRed, pxGLGreen, pxGLBlue, pxGLAlpha);
-	glLineWidth(pxGLLineWidth);
-	glPointSize(pxGLPointSize);
+	PXGLCmdBindTexture(GL_TEXTURE_2D, pxGLTexture);
+	PXGLCmdColor4ub(pxGLRed, pxGLGreen, pxGLBlue, pxGLAlpha);
+	PXGLCmdLineWidth(pxGLLineWidth);
+	PXGLCmdPointSize(pxGLPointSize);
 
 	// and enable the color array.
 	PXGLEnableColorArray();
-	glEnableClientState(GL_COLOR_ARRAY);
+	PXGLCmdEnableClientState(GL_COLOR_ARRAY);
 
 	if (PX_IS_BIT_ENABLED(pxGLStateInGL.state, PX_GL_SHADE_MODEL_FLAT))
-		glShadeModel(GL_FLAT);
+		PXGLCmdShadeModel(GL_FLAT);
 	else
-		glShadeModel(GL_SMOOTH);
+		PXGLCmdShadeModel(GL_SMOOTH);
+}
+
+/*
+ * Like PXGLSyncGLToPX, but also sets the alpha test and blend function. Used
+ * when gl may have been left in a state PXGL knows nothing about.
+ */
+void PXGLSyncAllGLToPX()
+{
+	PXGLSyncGLToPX();
+	PXGLSyncState(GL_ALPHA_TEST);
+	PXGLCmdBlendFunc(pxGLStateInGL.blendSource, pxGLStateInGL.blendDestination);
+}
+
+/*
+ * Starts recording gl calls into the given buffer instead of making them. As
+ * the buffer may be replayed long after gl was last touched, it starts off by
+ * setting every state PXGL keeps track of.
+ */
+void PXGLBeginRecording(PXGLCommandBuffer *buffer)
+{
+	if (!buffer)
+		return;
+
+	PXGLFlushBuffer();
+
+	pxGLRecordingCommandBuffer = buffer;
+
+	PXGLSyncAllGLToPX();
+}
+
+/*
+ * Records whatever is left in the batch and goes back to calling gl directly.
+ */
+void PXGLEndRecording()
+{
+	if (!pxGLRecordingCommandBuffer)
+		return;
+
+	PXGLFlushBuffer();
+
+	pxGLRecordingCommandBuffer = NULL;
 }
 
 void PXGLSyncTransforms()
 {
-	glPushMatrix();
+	PXGLCmdPushMatrix();
 	PXGLLoadMatrixToGL();
 
-	glColor4ub(pxGLRed, pxGLGreen, pxGLBlue, pxGLAlpha);
+	PXGLCmdColor4ub(pxGLRed, pxGLGreen, pxGLBlue, pxGLAlpha);
 }
 void PXGLUnSyncTransforms()
 {
@@ -402,7 +468,7 @@ void PXGLUnSyncTransforms()
 	// upon rendering.
 
 	// Pops the matrix which was pushed in sync transforms above.
-	glPopMatrix();
+	PXGLCmdPopMatrix();
 }
 
 /*
@@ -415,8 +481,8 @@ void PXGLPreRender()
 	PXGLResetColorTransformStack();
 	PXGLResetMatrixStack();
 
-	glPushMatrix();
-	glLoadIdentity();
+	PXGLCmdPushMatrix();
+	PXGLCmdLoadIdentity();
 	//glTranslatef(100.0f, -0.0f, 0.0f);
 	PXGLRendererPreRender();
 }
@@ -428,14 +494,88 @@ void PXGLPreRender()
 void PXGLPostRender()
 {
 	PXGLRendererPostRender();
-	glPopMatrix();
+	PXGLCmdPopMatrix();
+}
 
-#ifdef PX_DEBUG_MODE
-	if (PXDebugIsEnabled(PXDebugSetting_CountGLCalls))
+/*
+ * Closes the statistics of the frame being rendered; they become the last
+ * frame's and are added to the rolling window. This is only called once per
+ * screen frame, so rendering to a texture counts towards the frame it happens
+ * in.
+ */
+void PXGLEndFrameStatistics()
+{
+	pxGLStatisticsLastFrame = pxGLStatistics;
+
+	pxGLStatisticsWindow[pxGLStatisticsWindowIndex] = pxGLStatistics;
+	pxGLStatisticsWindowIndex = (pxGLStatisticsWindowIndex + 1) % PX_GL_STATISTICS_WINDOW;
+	if (pxGLStatisticsWindowCount < PX_GL_STATISTICS_WINDOW)
+		++pxGLStatisticsWindowCount;
+
+	memset(&pxGLStatistics, 0, sizeof(PXGLRenderStatistics));
+}
+
+/*
+ * Copies the statistics of the last fully rendered frame.
+ *
+ * @param PXGLRenderStatistics *statistics - Where to store the statistics.
+ */
+void PXGLGetFrameStatistics(PXGLRenderStatistics *statistics)
+{
+	if (!statistics)
+		return;
+
+	*statistics = pxGLStatisticsLastFrame;
+}
+
+/*
+ * Sums the statistics of the frames in the rolling window; divide by the
+ * returned frame count for per frame averages.
+ *
+ * @param PXGLRenderStatistics *statistics - Where to store the sums.
+ *
+ * @return - The number of frames that were summed, up to
+ * PX_GL_STATISTICS_WINDOW.
+ */
+unsigned PXGLGetWindowStatistics(PXGLRenderStatistics *statistics)
+{
+	if (!statistics)
+		return 0;
+
+	memset(statistics, 0, sizeof(PXGLRenderStatistics));
+
+	unsigned index;
+	unsigned causeIndex;
+	PXGLRenderStatistics *frame;
+
+	for (index = 0, frame = pxGLStatisticsWindow; index < pxGLStatisticsWindowCount; ++index, ++frame)
 	{
-		pxGLRenderCallCount = PXGLGetDrawCountThenResetIt();
+		statistics->drawCalls       += frame->drawCalls;
+		statistics->vertices        += frame->vertices;
+		statistics->indices         += frame->indices;
+		statistics->vertexBytes     += frame->vertexBytes;
+		statistics->flushes         += frame->flushes;
+		statistics->nodesTraversed  += frame->nodesTraversed;
+		statistics->nodesCulled     += frame->nodesCulled;
+		statistics->touchBufferSize += frame->touchBufferSize;
+
+		for (causeIndex = 0; causeIndex < PXGLFlushCause_Count; ++causeIndex)
+			statistics->flushesByCause[causeIndex] += frame->flushesByCause[causeIndex];
 	}
-#endif
+
+	return pxGLStatisticsWindowCount;
+}
+
+/*
+ * Clears the last frame, the rolling window and the frame in progress.
+ */
+void PXGLResetStatistics()
+{
+	memset(&pxGLStatistics, 0, sizeof(PXGLRenderStatistics));
+	memset(&pxGLStatisticsLastFrame, 0, sizeof(PXGLRenderStatistics));
+
+	pxGLStatisticsWindowIndex = 0;
+	pxGLStatisticsWindowCount = 0;
 }
 
 /*
@@ -461,7 +601,7 @@ GLuint PXGLDBGGetRenderCallCount()
 #ifdef PX_DEBUG_MODE
 	if (PXDebugIsEnabled(PXDebugSetting_CountGLCalls))
 	{
-		return pxGLRenderCallCount;
+		return pxGLStatisticsLastFrame.drawCalls;
 	}
 #endif
 
@@ -548,6 +688,45 @@ bool PXGLIsAABBVisible(PXGLAABB *aabb)
 	return true;
 }
 
+/*
+ * PXGLIsExtensionSupported returns whether gl lists the given extension. It
+ * returns false before gl is initialized.
+ *
+ * @param name The name of the extension, such as
+ * "GL_OES_compressed_ETC1_RGB8_texture".
+ */
+bool PXGLIsExtensionSupported(const char *name)
+{
+	if (!pxGLExtensions || !name)
+		return false;
+
+	size_t length = strlen(name);
+	const char *extension = pxGLExtensions;
+
+	// The names are separated by spaces, and some are prefixes of others.
+	while ((extension = strstr(extension, name)))
+	{
+		if ((extension == pxGLExtensions || extension[-1] == ' ') &&
+			(extension[length] == ' ' || extension[length] == '\0'))
+		{
+			return true;
+		}
+
+		extension += length;
+	}
+
+	return false;
+}
+
+/*
+ * PXGLMaxTextureSize returns the largest width or height gl accepts for a
+ * texture. It returns 0 before gl is initialized.
+ */
+GLint PXGLMaxTextureSize()
+{
+	return pxGLMaxTextureSize;
+}
+
 /*
  * PXGLBoundTexture returns the currently bound texture to gl.
  *
@@ -577,9 +756,9 @@ void PXGLBindTexture(GLenum target, GLuint texture)
 	if (target != GL_TEXTURE_2D || pxGLTexture == texture)
 		return;
 
-	PXGLFlushBuffer();
+	PXGLFlushBufferWithCause(PXGLFlushCause_TextureBind);
 	pxGLTexture = texture;
-	glBindTexture(target, texture);
+	PXGLCmdBindTexture(target, texture);
 }
 
 /*
@@ -749,10 +928,10 @@ void PXGLDisableClientState(GLenum array)
 void PXGLTexParameteri(GLenum target, GLenum pname, GLint param)
 {
 	// If the value has changed, we need to flush the buffer before changing it.
-	PXGLFlushBuffer();
+	PXGLFlushBufferWithCause(PXGLFlushCause_StateChange);
 
 	// then update gl.
-	glTexParameteri(target, pname, param);
+	PXGLCmdTexParameteri(target, pname, param);
 }
 
 /*
@@ -784,11 +963,11 @@ void PXGLLineWidth(GLfloat width)
 
 	// Lets flush the buffer, as we do not know what is yet to come, and need to
 	// have the buffer use the current gl state rather then the chagned one.
-	PXGLFlushBuffer();
+	PXGLFlushBufferWithCause(PXGLFlushCause_StateChange);
 	pxGLLineWidth = width;
 
 	// Lets actually change the gl state.
-	glLineWidth(width);
+	PXGLCmdLineWidth(width);
 }
 
 /*
@@ -814,12 +993,12 @@ void PXGLPointSize(GLfloat size)
 
 	// Lets flush the buffer, as we do not know what is yet to come, and need to
 	// have the buffer use the current gl state rather then the chagned one.
-	PXGLFlushBuffer();
+	PXGLFlushBufferWithCause(PXGLFlushCause_StateChange);
 	pxGLPointSize = size;
 	pxGLHalfPointSize = pxGLPointSize * 0.5f;
 
 	// Lets actually change the gl state.
-	glPointSize(size);
+	PXGLCmdPointSize(size);
 }
 
 /*
@@ -973,6 +1152,28 @@ void PXGLShadeModel(GLenum mode)
 	}
 }
 
+/*
+ * While a frame is being recorded gl lags behind PXGL, so the values PXGL
+ * keeps track of itself are answered without asking gl.
+ */
+PXInline bool PXGLGetRecordedFloat(GLenum pname, GLfloat *value)
+{
+	if (!pxGLRecordingCommandBuffer)
+		return false;
+
+	switch (pname)
+	{
+		case GL_LINE_WIDTH:
+			*value = pxGLLineWidth;
+			return true;
+		case GL_POINT_SIZE:
+			*value = pxGLPointSize;
+			return true;
+		default:
+			return false;
+	}
+}
+
 void PXGLGetBooleanv(GLenum pname, GLboolean *params)
 {
 	if (params == NULL)
@@ -980,7 +1181,9 @@ void PXGLGetBooleanv(GLenum pname, GLboolean *params)
 
 	PXGLFlush();
 
+	PXGLBeginDirect();
 	glGetBooleanv(pname, params);
+	PXGLEndDirect();
 }
 
 void PXGLGetFloatv(GLenum pname, GLfloat *params)
@@ -990,7 +1193,12 @@ void PXGLGetFloatv(GLenum pname, GLfloat *params)
 
 	PXGLFlush();
 
+	if (PXGLGetRecordedFloat(pname, params))
+		return;
+
+	PXGLBeginDirect();
 	glGetFloatv(pname, params);
+	PXGLEndDirect();
 }
 
 void PXGLGetIntegerv(GLenum pname, GLint *params)
@@ -1000,7 +1208,18 @@ void PXGLGetIntegerv(GLenum pname, GLint *params)
 
 	PXGLFlush();
 
+	GLfloat value;
+	if (PXGLGetRecordedFloat(pname, &value))
+	{
+		*params = value;
+		return;
+	}
+
+	// Beginning a direct section binds PXGL's texture in gl, so
+	// GL_TEXTURE_BINDING_2D is right even while recording.
+	PXGLBeginDirect();
 	glGetIntegerv(pname, params);
+	PXGLEndDirect();
 }
 
 void PXGLGetTexParameteriv(GLenum target, GLenum pname, GLint *params)
@@ -1010,44 +1229,46 @@ void PXGLGetTexParameteriv(GLenum target, GLenum pname, GLint *params)
 
 	PXGLFlush();
 
+	PXGLBeginDirect();
 	glGetTexParameteriv(target, pname, params);
+	PXGLEndDirect();
 }
 
 void PXGLTexEnvf(GLenum target, GLenum pname, GLfloat param)
 {
-	PXGLFlush();
+	PXGLFlushWithCause(PXGLFlushCause_StateChange);
 
-	glTexEnvf(target, pname, param);
+	PXGLCmdTexEnvf(target, pname, param);
 }
 void PXGLTexEnvi(GLenum target, GLenum pname, GLint param)
 {
-	PXGLFlush();
+	PXGLFlushWithCause(PXGLFlushCause_StateChange);
 
-	glTexEnvi(target, pname, param);
+	PXGLCmdTexEnvi(target, pname, param);
 }
 void PXGLTexEnvx(GLenum target, GLenum pname, GLfixed param)
 {
-	PXGLFlush();
+	PXGLFlushWithCause(PXGLFlushCause_StateChange);
 
-	glTexEnvx(target, pname, param);
+	PXGLCmdTexEnvx(target, pname, param);
 }
 void PXGLTexEnvfv(GLenum target, GLenum pname, const GLfloat *params)
 {
-	PXGLFlush();
+	PXGLFlushWithCause(PXGLFlushCause_StateChange);
 
-	glTexEnvfv(target, pname, params);
+	PXGLCmdTexEnvfv(target, pname, params);
 }
 void PXGLTexEnviv(GLenum target, GLenum pname, const GLint *params)
 {
-	PXGLFlush();
+	PXGLFlushWithCause(PXGLFlushCause_StateChange);
 
-	glTexEnviv(target, pname, params);
+	PXGLCmdTexEnviv(target, pname, params);
 }
 void PXGLTexEnvxv(GLenum target, GLenum pname, const GLfixed *params)
 {
-	PXGLFlush();
+	PXGLFlushWithCause(PXGLFlushCause_StateChange);
 
-	glTexEnvxv(target, pname, params);
+	PXGLCmdTexEnvxv(target, pname, params);
 }
 
 PXInline void PXGLDefineVertex(PXGLColoredTextureVertex *point,
@@ -1401,7 +1622,7 @@ void PXGLDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *ids
 
 	if (oldIndex + count >= maxSize)
 	{
-		PXGLFlushBuffer();
+		PXGLFlushBufferWithCause(PXGLFlushCause_BufferFull);
 		oldIndex = PXGLGetCurrentIndex();
 	}
 
@@ -1761,7 +1982,7 @@ void PXGLLoadMatrixToGL()
 	pxGLMatrix[12] = pxGLCurrentMatrix->tx;
 	pxGLMatrix[13] = pxGLCurrentMatrix->ty;
 
-	glLoadMatrixf(pxGLMatrix);
+	PXGLCmdLoadMatrixf(pxGLMatrix);
 }
 
 /*
@@ -2045,16 +2266,16 @@ PXInline_c void PXGLSetupEnables()
 
 	if (breakBatch)
 	{
-		PXGLFlushBuffer();
+		PXGLFlushBufferWithCause(blendModeNotEqual ? PXGLFlushCause_BlendChange : PXGLFlushCause_StateChange);
 
 #define PXGLCompareAndSetClientState(_px_state_, _gl_state_) \
 { \
 	if (!PX_IS_BIT_ENABLED_IN_BOTH(pxGLState.clientState, pxGLStateInGL.clientState, _px_state_)) \
 	{ \
 		if (PX_IS_BIT_ENABLED(pxGLState.clientState, _px_state_)) \
-			glEnableClientState(_gl_state_); \
+			PXGLCmdEnableClientState(_gl_state_); \
 		else \
-			glDisableClientState(_gl_state_); \
+			PXGLCmdDisableClientState(_gl_state_); \
 	} \
 }
 #define PXGLCompareAndSetState(_px_state_, _gl_state_) \
@@ -2062,9 +2283,9 @@ PXInline_c void PXGLSetupEnables()
 	if (!PX_IS_BIT_ENABLED_IN_BOTH(pxGLState.state, pxGLStateInGL.state, _px_state_)) \
 	{ \
 		if (PX_IS_BIT_ENABLED(pxGLState.state, _px_state_)) \
-			glEnable(_gl_state_); \
+			PXGLCmdEnable(_gl_state_); \
 		else \
-			glDisable(_gl_state_); \
+			PXGLCmdDisable(_gl_state_); \
 	} \
 }
 
@@ -2076,26 +2297,27 @@ PXInline_c void PXGLSetupEnables()
 		PXGLCompareAndSetState(PX_GL_LINE_SMOOTH, GL_LINE_SMOOTH);
 		PXGLCompareAndSetState(PX_GL_POINT_SMOOTH, GL_POINT_SMOOTH);
 		PXGLCompareAndSetState(PX_GL_TEXTURE_2D, GL_TEXTURE_2D);
+		PXGLCompareAndSetState(PX_GL_ALPHA_TEST, GL_ALPHA_TEST);
 
 		/*if (PX_IS_BIT_ENABLED_IN_BOTH(pxGLState, pxGLStateInGL, PX_GL_SHADE_MODEL_FLAT))
 		{
 			if (PX_IS_BIT_ENABLED(pxGLState, PX_GL_SHADE_MODEL_FLAT))
-				glShadeModel(GL_FLAT);
+				PXGLCmdShadeModel(GL_FLAT);
 			else
-				glShadeModel(GL_SMOOTH);
+				PXGLCmdShadeModel(GL_SMOOTH);
 		}*/
 
 		if (PX_IS_BIT_ENABLED_IN_BOTH(pxGLState.state, pxGLStateInGL.state, PX_GL_SHADE_MODEL_FLAT))
 		{
 			if (PX_IS_BIT_ENABLED(pxGLState.state, PX_GL_SHADE_MODEL_FLAT))
-				glShadeModel(GL_FLAT);
+				PXGLCmdShadeModel(GL_FLAT);
 			else
-				glShadeModel(GL_SMOOTH);
+				PXGLCmdShadeModel(GL_SMOOTH);
 		}
 
 		if (blendModeNotEqual)
 		{
-			glBlendFunc(pxGLState.blendSource, pxGLState.blendDestination);
+			PXGLCmdBlendFunc(pxGLState.blendSource, pxGLState.blendDestination);
 
 			// glBlendFuncSeparateOES(pxGLState.blendSource, pxGLState.blendDestination,
 			//					   GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
@@ -2167,6 +2389,8 @@ PXInline_c bool _PXGLStateIsEnabled(PXGLState *state, GLenum cap)
 			return PX_IS_BIT_ENABLED(state->state, PX_GL_POINT_SMOOTH);
 		case GL_TEXTURE_2D:
 			return PX_IS_BIT_ENABLED(state->state, PX_GL_TEXTURE_2D);
+		case GL_ALPHA_TEST:
+			return PX_IS_BIT_ENABLED(state->state, PX_GL_ALPHA_TEST);
 		default:
 			return false;
 	}
@@ -2201,6 +2425,8 @@ PXInline GLuint PXGLGLStateToPXState(GLenum cap)
 		return PX_GL_POINT_SMOOTH;
 	case GL_TEXTURE_2D:
 		return PX_GL_TEXTURE_2D;
+	case GL_ALPHA_TEST:
+		return PX_GL_ALPHA_TEST;
 	}
 
 	return 0;
@@ -2218,6 +2444,8 @@ PXInline GLenum PXGLPXStateToGLState(GLuint cap)
 		return GL_POINT_SMOOTH;
 	case PX_GL_TEXTURE_2D:
 		return GL_TEXTURE_2D;
+	case PX_GL_ALPHA_TEST:
+		return GL_ALPHA_TEST;
 	}
 
 	return 0;
@@ -2290,19 +2518,19 @@ void PXGLSetViewSize(unsigned width, unsigned height, float scaleFactor, bool or
 	pxGLHeightInPoints = height;
 
 	// in PIXELS
-	glViewport(0.0f,									// x
-			   0.0f,									// y
-			   pxGLWidthInPoints  * pxGLScaleFactor,	// width
-			   pxGLHeightInPoints * pxGLScaleFactor);	// height
-	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
+	PXGLCmdViewport(0.0f,									// x
+	                0.0f,									// y
+	                pxGLWidthInPoints  * pxGLScaleFactor,	// width
+	                pxGLHeightInPoints * pxGLScaleFactor);	// height
+	PXGLCmdMatrixMode(GL_PROJECTION);
+	PXGLCmdLoadIdentity();
 
 	// in POINTS
-	glOrthof(0,						// xMin
-			 pxGLWidthInPoints,		// xMax
-			 pxGLHeightInPoints,	// yMin
-			 0,						// yMax
-			 -100.0f,				// zMin
-			  100.0f);				// zMax
-	glMatrixMode(GL_MODELVIEW);
+	PXGLCmdOrthof(0,						// xMin
+	              pxGLWidthInPoints,		// xMax
+	              pxGLHeightInPoints,	// yMin
+	              0,						// yMax
+	              -100.0f,				// zMin
+	               100.0f);				// zMax
+	PXGLCmdMatrixMode(GL_MODELVIEW);
 }
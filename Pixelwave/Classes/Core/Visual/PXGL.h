@@ -44,11 +44,56 @@
 #include "PXGLState.h"
 #include "PXHeaderUtils.h"
 
+// The number of frames kept for the rolling statistics window
+#define PX_GL_STATISTICS_WINDOW 60
+
+/*
+ * Why the batch was broken. A flush with nothing in the buffer is not counted.
+ */
+typedef enum
+{
+	PXGLFlushCause_Explicit = 0,
+	PXGLFlushCause_TextureBind,
+	PXGLFlushCause_BlendChange,
+	PXGLFlushCause_StateChange,
+	PXGLFlushCause_DrawMode,
+	PXGLFlushCause_LineLoopOrFan,
+	PXGLFlushCause_CustomRenderMode,
+	PXGLFlushCause_BufferFull,
+
+	PXGLFlushCause_Count
+} PXGLFlushCause;
+
+/*
+ * Counters gathered while rendering. They are always on; updating them costs a
+ * few additions per flush and per display object.
+ */
+typedef struct
+{
+	unsigned drawCalls;
+	unsigned vertices;
+	unsigned indices;
+	unsigned vertexBytes;
+
+	unsigned flushes;
+	unsigned flushesByCause[PXGLFlushCause_Count];
+
+	unsigned nodesTraversed;
+	unsigned nodesCulled;
+	unsigned touchBufferSize;
+} PXGLRenderStatistics;
+
 PXExtern GLfloat PXGLGetContentScaleFactor();
 PXExtern GLfloat PXGLGetOneOverContentScaleFactor();
 PXExtern GLuint PXGLDBGGetRenderCallCount();
 
+PXExtern void PXGLGetFrameStatistics(PXGLRenderStatistics *statistics);
+PXExtern unsigned PXGLGetWindowStatistics(PXGLRenderStatistics *statistics);
+PXExtern void PXGLResetStatistics();
+
 PXExtern GLuint PXGLBoundTexture();
+PXExtern bool PXGLIsExtensionSupported(const char *name);
+PXExtern GLint PXGLMaxTextureSize();
 
 PXExtern void PXGLBindTexture(GLenum target, GLuint texture);
 PXExtern void PXGLColor4f(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
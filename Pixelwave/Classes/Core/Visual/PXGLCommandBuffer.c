@@ -0,0 +1,558 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXGLCommandBuffer.h"
+#include "PXGLPrivate.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define PX_GL_COMMAND_BUFFER_MIN_COMMANDS 256
+#define PX_GL_COMMAND_BUFFER_MIN_DATA_SIZE 0x10000
+
+// Payloads are kept 4 byte aligned so that they can be handed to gl as is.
+#define PX_GL_COMMAND_BUFFER_ALIGN(_size_) (((_size_) + 3) & ~3)
+
+typedef struct
+{
+	unsigned short type;
+
+	union
+	{
+		GLint i[4];
+		GLfloat f[4];
+
+		struct
+		{
+			GLint a, b;
+			unsigned offset;
+		} data;
+
+		struct
+		{
+			PXGLCommandCallback invoke;
+			PXGLCommandCallback release;
+			void *userData;
+		} callback;
+	} args;
+} _PXGLCommand;
+
+// Stored in the data arena in front of the vertices, indices and point sizes
+// of a recorded draw.
+typedef struct
+{
+	GLenum mode;
+	GLubyte textured;
+	GLubyte colored;
+	unsigned vertexCount;
+	unsigned indexCount;
+	unsigned pointSizeCount;
+} _PXGLDrawRecord;
+
+struct _PXGLCommandBuffer
+{
+	_PXGLCommand *commands;
+	unsigned count;
+	unsigned capacity;
+
+	GLubyte *data;
+	unsigned dataSize;
+	unsigned dataCapacity;
+};
+
+PXGLCommandBuffer *pxGLRecordingCommandBuffer = NULL;
+bool pxGLNeedsDirectSync = false;
+
+PXGLCommandBuffer *pxGLSuspendedCommandBuffer = NULL;
+unsigned pxGLDirectDepth = 0;
+void (*pxGLDirectSyncFunction)() = NULL;
+
+// MARK: Buffer
+
+PXGLCommandBuffer *PXGLCommandBufferCreate()
+{
+	PXGLCommandBuffer *buffer = calloc(1, sizeof(PXGLCommandBuffer));
+
+	if (!buffer)
+		return NULL;
+
+	buffer->capacity = PX_GL_COMMAND_BUFFER_MIN_COMMANDS;
+	buffer->commands = malloc(sizeof(_PXGLCommand) * buffer->capacity);
+
+	buffer->dataCapacity = PX_GL_COMMAND_BUFFER_MIN_DATA_SIZE;
+	buffer->data = malloc(buffer->dataCapacity);
+
+	return buffer;
+}
+
+void PXGLCommandBufferFree(PXGLCommandBuffer *buffer)
+{
+	if (!buffer)
+		return;
+
+	PXGLCommandBufferReset(buffer);
+
+	free(buffer->commands);
+	free(buffer->data);
+	free(buffer);
+}
+
+/*
+ * Empties the buffer, keeping its memory around for the next frame. Any
+ * recorded callbacks get their release function called.
+ */
+void PXGLCommandBufferReset(PXGLCommandBuffer *buffer)
+{
+	_PXGLCommand *command = buffer->commands;
+	unsigned index;
+
+	for (index = 0; index < buffer->count; ++index, ++command)
+	{
+		if (command->type == _PXGLCommand_Callback && command->args.callback.release)
+			command->args.callback.release(command->args.callback.userData);
+	}
+
+	buffer->count = 0;
+	buffer->dataSize = 0;
+}
+
+unsigned PXGLCommandBufferGetCount(PXGLCommandBuffer *buffer)
+{
+	return buffer->count;
+}
+
+PXInline _PXGLCommand *PXGLCommandBufferNextCommand(PXGLCommandBuffer *buffer, _PXGLCommandType type)
+{
+	if (buffer->count == buffer->capacity)
+	{
+		buffer->capacity <<= 1;
+		buffer->commands = realloc(buffer->commands, sizeof(_PXGLCommand) * buffer->capacity);
+	}
+
+	_PXGLCommand *command = buffer->commands + buffer->count;
+	++(buffer->count);
+
+	command->type = type;
+	return command;
+}
+
+// Returns the offset of the reserved bytes, as the arena may move when it
+// grows.
+PXInline unsigned PXGLCommandBufferReserveData(PXGLCommandBuffer *buffer, unsigned byteCount)
+{
+	unsigned offset = buffer->dataSize;
+	unsigned newSize = offset + PX_GL_COMMAND_BUFFER_ALIGN(byteCount);
+
+	if (newSize > buffer->dataCapacity)
+	{
+		while (newSize > buffer->dataCapacity)
+			buffer->dataCapacity <<= 1;
+
+		buffer->data = realloc(buffer->data, buffer->dataCapacity);
+	}
+
+	buffer->dataSize = newSize;
+	return offset;
+}
+
+PXInline void PXGLCommandBufferReplayDraw(PXGLCommandBuffer *buffer, unsigned offset)
+{
+	const GLubyte *data = buffer->data + offset;
+	const _PXGLDrawRecord *record = (const _PXGLDrawRecord *)data;
+	data += PX_GL_COMMAND_BUFFER_ALIGN(sizeof(_PXGLDrawRecord));
+
+	const PXGLColoredTextureVertex *vertices = (const PXGLColoredTextureVertex *)data;
+	data += PX_GL_COMMAND_BUFFER_ALIGN(sizeof(PXGLColoredTextureVertex) * record->vertexCount);
+
+	const PXGLElementsType *indices = NULL;
+	if (record->indexCount > 0)
+	{
+		indices = (const PXGLElementsType *)data;
+		data += PX_GL_COMMAND_BUFFER_ALIGN(sizeof(PXGLElementsType) * record->indexCount);
+	}
+
+	const GLfloat *pointSizes = NULL;
+	if (record->pointSizeCount > 0)
+		pointSizes = (const GLfloat *)data;
+
+	PXGLRendererDrawRecorded(record->mode,
+	                         record->textured,
+	                         record->colored,
+	                         vertices,
+	                         record->vertexCount,
+	                         indices,
+	                         record->indexCount,
+	                         pointSizes);
+}
+
+/*
+ * Makes every recorded call, in order, on the calling thread. The context must
+ * be current on the calling thread.
+ */
+void PXGLCommandBufferReplay(PXGLCommandBuffer *buffer)
+{
+	_PXGLCommand *command = buffer->commands;
+	_PXGLCommand *end = command + buffer->count;
+
+	GLint *i;
+	GLfloat *f;
+	const void *data;
+
+	for (; command < end; ++command)
+	{
+		i = command->args.i;
+		f = command->args.f;
+		data = buffer->data + command->args.data.offset;
+
+		switch (command->type)
+		{
+			case _PXGLCommand_Enable:
+				glEnable(i[0]);
+				break;
+			case _PXGLCommand_Disable:
+				glDisable(i[0]);
+				break;
+			case _PXGLCommand_EnableClientState:
+				glEnableClientState(i[0]);
+				break;
+			case _PXGLCommand_DisableClientState:
+				glDisableClientState(i[0]);
+				break;
+			case _PXGLCommand_ShadeModel:
+				glShadeModel(i[0]);
+				break;
+			case _PXGLCommand_BlendFunc:
+				glBlendFunc(i[0], i[1]);
+				break;
+			case _PXGLCommand_AlphaFunc:
+				glAlphaFunc(command->args.data.a, *((const GLclampf *)data));
+				break;
+			case _PXGLCommand_BindTexture:
+				glBindTexture(i[0], i[1]);
+				break;
+			case _PXGLCommand_TexParameteri:
+				glTexParameteri(i[0], i[1], i[2]);
+				break;
+			case _PXGLCommand_TexEnvf:
+				glTexEnvf(command->args.data.a, command->args.data.b, *((const GLfloat *)data));
+				break;
+			case _PXGLCommand_TexEnvi:
+				glTexEnvi(i[0], i[1], i[2]);
+				break;
+			case _PXGLCommand_TexEnvx:
+				glTexEnvx(i[0], i[1], i[2]);
+				break;
+			case _PXGLCommand_TexEnvfv:
+				glTexEnvfv(command->args.data.a, command->args.data.b, (const GLfloat *)data);
+				break;
+			case _PXGLCommand_TexEnviv:
+				glTexEnviv(command->args.data.a, command->args.data.b, (const GLint *)data);
+				break;
+			case _PXGLCommand_TexEnvxv:
+				glTexEnvxv(command->args.data.a, command->args.data.b, (const GLfixed *)data);
+				break;
+			case _PXGLCommand_LineWidth:
+				glLineWidth(f[0]);
+				break;
+			case _PXGLCommand_PointSize:
+				glPointSize(f[0]);
+				break;
+			case _PXGLCommand_Color4ub:
+				glColor4ub(i[0], i[1], i[2], i[3]);
+				break;
+			case _PXGLCommand_MatrixMode:
+				glMatrixMode(i[0]);
+				break;
+			case _PXGLCommand_PushMatrix:
+				glPushMatrix();
+				break;
+			case _PXGLCommand_PopMatrix:
+				glPopMatrix();
+				break;
+			case _PXGLCommand_LoadIdentity:
+				glLoadIdentity();
+				break;
+			case _PXGLCommand_LoadMatrixf:
+				glLoadMatrixf((const GLfloat *)data);
+				break;
+			case _PXGLCommand_Orthof:
+			{
+				const GLfloat *values = (const GLfloat *)data;
+				glOrthof(values[0], values[1], values[2], values[3], values[4], values[5]);
+			}
+				break;
+			case _PXGLCommand_Viewport:
+				glViewport(i[0], i[1], i[2], i[3]);
+				break;
+			case _PXGLCommand_ClearColor:
+				glClearColor(f[0], f[1], f[2], f[3]);
+				break;
+			case _PXGLCommand_Clear:
+				glClear(i[0]);
+				break;
+			case _PXGLCommand_Draw:
+				PXGLCommandBufferReplayDraw(buffer, command->args.data.offset);
+				break;
+			case _PXGLCommand_Callback:
+				command->args.callback.invoke(command->args.callback.userData);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+/*
+ * Runs only the recorded callbacks, in order, without making any of the gl
+ * calls. For buffers that are thrown away instead of replayed, so that the
+ * work deferred to the callbacks (such as deleting textures) still happens.
+ */
+void PXGLCommandBufferInvokeCallbacks(PXGLCommandBuffer *buffer)
+{
+	_PXGLCommand *command = buffer->commands;
+	_PXGLCommand *end = command + buffer->count;
+
+	for (; command < end; ++command)
+	{
+		if (command->type == _PXGLCommand_Callback)
+			command->args.callback.invoke(command->args.callback.userData);
+	}
+}
+
+// MARK: Recording
+
+bool PXGLIsRecording()
+{
+	return pxGLRecordingCommandBuffer != NULL;
+}
+
+void _PXGLRecordi(_PXGLCommandType type, GLint a, GLint b, GLint c, GLint d)
+{
+	_PXGLCommand *command = PXGLCommandBufferNextCommand(pxGLRecordingCommandBuffer, type);
+
+	command->args.i[0] = a;
+	command->args.i[1] = b;
+	command->args.i[2] = c;
+	command->args.i[3] = d;
+}
+
+void _PXGLRecordf(_PXGLCommandType type, GLfloat a, GLfloat b, GLfloat c, GLfloat d)
+{
+	_PXGLCommand *command = PXGLCommandBufferNextCommand(pxGLRecordingCommandBuffer, type);
+
+	command->args.f[0] = a;
+	command->args.f[1] = b;
+	command->args.f[2] = c;
+	command->args.f[3] = d;
+}
+
+void _PXGLRecordData(_PXGLCommandType type, GLint a, GLint b, const void *data, unsigned byteCount)
+{
+	PXGLCommandBuffer *buffer = pxGLRecordingCommandBuffer;
+
+	unsigned offset = PXGLCommandBufferReserveData(buffer, byteCount);
+	memcpy(buffer->data + offset, data, byteCount);
+
+	_PXGLCommand *command = PXGLCommandBufferNextCommand(buffer, type);
+
+	command->args.data.a = a;
+	command->args.data.b = b;
+	command->args.data.offset = offset;
+}
+
+/*
+ * Copies a batch into the buffer. The renderer's own arrays get reused as soon
+ * as this returns, so the copy is what gets drawn when replaying.
+ */
+void _PXGLRecordDraw(GLenum mode,
+                     bool textured,
+                     bool colored,
+                     const PXGLColoredTextureVertex *vertices,
+                     unsigned vertexCount,
+                     const PXGLElementsType *indices,
+                     unsigned indexCount,
+                     const GLfloat *pointSizes,
+                     unsigned pointSizeCount)
+{
+	PXGLCommandBuffer *buffer = pxGLRecordingCommandBuffer;
+
+	if (!indices)
+		indexCount = 0;
+	if (!pointSizes)
+		pointSizeCount = 0;
+
+	unsigned recordSize = PX_GL_COMMAND_BUFFER_ALIGN(sizeof(_PXGLDrawRecord));
+	unsigned verticesSize = PX_GL_COMMAND_BUFFER_ALIGN(sizeof(PXGLColoredTextureVertex) * vertexCount);
+	unsigned indicesSize = PX_GL_COMMAND_BUFFER_ALIGN(sizeof(PXGLElementsType) * indexCount);
+	unsigned pointSizesSize = sizeof(GLfloat) * pointSizeCount;
+
+	unsigned offset = PXGLCommandBufferReserveData(buffer, recordSize + verticesSize + indicesSize + pointSizesSize);
+	GLubyte *data = buffer->data + offset;
+
+	_PXGLDrawRecord *record = (_PXGLDrawRecord *)data;
+	record->mode = mode;
+	record->textured = textured;
+	record->colored = colored;
+	record->vertexCount = vertexCount;
+	record->indexCount = indexCount;
+	record->pointSizeCount = pointSizeCount;
+	data += recordSize;
+
+	memcpy(data, vertices, sizeof(PXGLColoredTextureVertex) * vertexCount);
+	data += verticesSize;
+
+	if (indexCount > 0)
+	{
+		memcpy(data, indices, sizeof(PXGLElementsType) * indexCount);
+		data += indicesSize;
+	}
+
+	if (pointSizeCount > 0)
+		memcpy(data, pointSizes, pointSizesSize);
+
+	_PXGLCommand *command = PXGLCommandBufferNextCommand(buffer, _PXGLCommand_Draw);
+	command->args.data.offset = offset;
+}
+
+/*
+ * Records a function to call when the buffer is replayed, on the thread doing
+ * the replaying. release is called when the buffer gets reset, whether or not
+ * the buffer was replayed, and may be NULL.
+ */
+void PXGLRecordCallback(PXGLCommandCallback invoke, PXGLCommandCallback release, void *userData)
+{
+	if (!invoke)
+		return;
+
+	if (!pxGLRecordingCommandBuffer)
+	{
+		PXGLBeginDirect();
+		invoke(userData);
+		PXGLEndDirect();
+
+		if (release)
+			release(userData);
+
+		return;
+	}
+
+	_PXGLCommand *command = PXGLCommandBufferNextCommand(pxGLRecordingCommandBuffer, _PXGLCommand_Callback);
+
+	command->args.callback.invoke = invoke;
+	command->args.callback.release = release;
+	command->args.callback.userData = userData;
+}
+
+// MARK: Direct access
+
+/*
+ * Sets the function used to wait for the other thread to let go of the
+ * context. It is called on the main thread, and should make the context
+ * current on it before returning.
+ */
+void PXGLSetDirectSyncFunction(void (*syncFunction)())
+{
+	pxGLDirectSyncFunction = syncFunction;
+}
+
+/*
+ * Lets PXGL know that another thread may now be using the context.
+ */
+void PXGLSetNeedsDirectSync()
+{
+	pxGLNeedsDirectSync = true;
+}
+
+void _PXGLDirectSync()
+{
+	pxGLNeedsDirectSync = false;
+
+	if (pxGLDirectSyncFunction)
+		pxGLDirectSyncFunction();
+}
+
+/*
+ * Begins a section of code that talks to gl directly. The context is waited
+ * for if needed, and if a frame is being recorded the pending batch is
+ * recorded and recording is paused until PXGLEndDirect. Sections can be
+ * nested.
+ */
+void PXGLBeginDirect()
+{
+	++pxGLDirectDepth;
+
+	if (pxGLDirectDepth > 1)
+		return;
+
+	if (pxGLNeedsDirectSync)
+		_PXGLDirectSync();
+
+	if (pxGLRecordingCommandBuffer)
+	{
+		PXGLFlushBuffer();
+
+		pxGLSuspendedCommandBuffer = pxGLRecordingCommandBuffer;
+		pxGLRecordingCommandBuffer = NULL;
+
+		// gl is in whatever state the last replayed frame left it in, so bring
+		// it in line with what PXGL thinks it is.
+		PXGLSyncAllGLToPX();
+	}
+}
+
+void PXGLEndDirect()
+{
+	if (pxGLDirectDepth == 0)
+		return;
+
+	--pxGLDirectDepth;
+
+	if (pxGLDirectDepth > 0)
+		return;
+
+	if (pxGLSuspendedCommandBuffer)
+	{
+		pxGLRecordingCommandBuffer = pxGLSuspendedCommandBuffer;
+		pxGLSuspendedCommandBuffer = NULL;
+
+		// The direct code may have changed states through PXGL, which the
+		// recording never saw.
+		PXGLSyncAllGLToPX();
+	}
+}
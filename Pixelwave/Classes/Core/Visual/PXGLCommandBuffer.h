@@ -0,0 +1,294 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_GL_COMMAND_BUFFER_H_
+#define _PX_GL_COMMAND_BUFFER_H_
+
+#include "PXHeaderUtils.h"
+#include "PXGLRenderer.h"
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A command buffer records the gl calls PXGL would have made, so that they can
+ * be made later on another thread. Between PXGLBeginRecording and
+ * PXGLEndRecording the PXGLCmd functions below append to the buffer instead of
+ * calling gl, and batches are copied into it instead of being drawn. The rest
+ * of the time they call straight through to gl.
+ *
+ * While a buffer may be replaying on another thread, the main thread must not
+ * talk to gl behind PXGL's back. Code that calls gl directly (uploading
+ * textures, deleting them, binding frame buffers...) has to be wrapped in
+ * PXGLBeginDirect and PXGLEndDirect, which wait for the other thread to let go
+ * of the context first. The PXGLCmd functions do this on their own.
+ */
+
+typedef struct _PXGLCommandBuffer PXGLCommandBuffer;
+
+typedef void (*PXGLCommandCallback)(void *userData);
+
+typedef enum
+{
+	_PXGLCommand_Enable = 0,
+	_PXGLCommand_Disable,
+	_PXGLCommand_EnableClientState,
+	_PXGLCommand_DisableClientState,
+	_PXGLCommand_ShadeModel,
+	_PXGLCommand_BlendFunc,
+	_PXGLCommand_AlphaFunc,
+	_PXGLCommand_BindTexture,
+	_PXGLCommand_TexParameteri,
+	_PXGLCommand_TexEnvf,
+	_PXGLCommand_TexEnvi,
+	_PXGLCommand_TexEnvx,
+	_PXGLCommand_TexEnvfv,
+	_PXGLCommand_TexEnviv,
+	_PXGLCommand_TexEnvxv,
+	_PXGLCommand_LineWidth,
+	_PXGLCommand_PointSize,
+	_PXGLCommand_Color4ub,
+	_PXGLCommand_MatrixMode,
+	_PXGLCommand_PushMatrix,
+	_PXGLCommand_PopMatrix,
+	_PXGLCommand_LoadIdentity,
+	_PXGLCommand_LoadMatrixf,
+	_PXGLCommand_Orthof,
+	_PXGLCommand_Viewport,
+	_PXGLCommand_ClearColor,
+	_PXGLCommand_Clear,
+	_PXGLCommand_Draw,
+	_PXGLCommand_Callback,
+} _PXGLCommandType;
+
+// The buffer being recorded into, NULL when not recording.
+PXExtern PXGLCommandBuffer *pxGLRecordingCommandBuffer;
+// Set while another thread may be using the context.
+PXExtern bool pxGLNeedsDirectSync;
+
+PXExtern PXGLCommandBuffer *PXGLCommandBufferCreate();
+PXExtern void PXGLCommandBufferFree(PXGLCommandBuffer *buffer);
+PXExtern void PXGLCommandBufferReset(PXGLCommandBuffer *buffer);
+PXExtern unsigned PXGLCommandBufferGetCount(PXGLCommandBuffer *buffer);
+PXExtern void PXGLCommandBufferReplay(PXGLCommandBuffer *buffer);
+PXExtern void PXGLCommandBufferInvokeCallbacks(PXGLCommandBuffer *buffer);
+
+PXExtern void PXGLBeginRecording(PXGLCommandBuffer *buffer);
+PXExtern void PXGLEndRecording();
+PXExtern bool PXGLIsRecording();
+
+PXExtern void PXGLRecordCallback(PXGLCommandCallback invoke, PXGLCommandCallback release, void *userData);
+
+PXExtern void PXGLSetDirectSyncFunction(void (*syncFunction)());
+PXExtern void PXGLSetNeedsDirectSync();
+PXExtern void PXGLBeginDirect();
+PXExtern void PXGLEndDirect();
+
+PXExtern void _PXGLDirectSync();
+PXExtern void _PXGLRecordi(_PXGLCommandType type, GLint a, GLint b, GLint c, GLint d);
+PXExtern void _PXGLRecordf(_PXGLCommandType type, GLfloat a, GLfloat b, GLfloat c, GLfloat d);
+PXExtern void _PXGLRecordData(_PXGLCommandType type, GLint a, GLint b, const void *data, unsigned byteCount);
+PXExtern void _PXGLRecordDraw(GLenum mode,
+                              bool textured,
+                              bool colored,
+                              const PXGLColoredTextureVertex *vertices,
+                              unsigned vertexCount,
+                              const PXGLElementsType *indices,
+                              unsigned indexCount,
+                              const GLfloat *pointSizes,
+                              unsigned pointSizeCount);
+
+// MARK: Recordable gl calls
+
+#define PX_GL_CMD_DIRECT(_call_) \
+{ \
+	if (pxGLNeedsDirectSync) \
+		_PXGLDirectSync(); \
+	_call_; \
+}
+
+PXInline void PXGLCmdEnable(GLenum cap)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_Enable, cap, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glEnable(cap));
+}
+PXInline void PXGLCmdDisable(GLenum cap)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_Disable, cap, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glDisable(cap));
+}
+PXInline void PXGLCmdEnableClientState(GLenum array)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_EnableClientState, array, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glEnableClientState(array));
+}
+PXInline void PXGLCmdDisableClientState(GLenum array)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_DisableClientState, array, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glDisableClientState(array));
+}
+PXInline void PXGLCmdShadeModel(GLenum mode)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_ShadeModel, mode, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glShadeModel(mode));
+}
+PXInline void PXGLCmdBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_BlendFunc, sfactor, dfactor, 0, 0);
+	else PX_GL_CMD_DIRECT(glBlendFunc(sfactor, dfactor));
+}
+PXInline void PXGLCmdAlphaFunc(GLenum func, GLclampf ref)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordData(_PXGLCommand_AlphaFunc, func, 0, &ref, sizeof(GLclampf));
+	else PX_GL_CMD_DIRECT(glAlphaFunc(func, ref));
+}
+PXInline void PXGLCmdBindTexture(GLenum target, GLuint texture)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_BindTexture, target, texture, 0, 0);
+	else PX_GL_CMD_DIRECT(glBindTexture(target, texture));
+}
+PXInline void PXGLCmdTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_TexParameteri, target, pname, param, 0);
+	else PX_GL_CMD_DIRECT(glTexParameteri(target, pname, param));
+}
+PXInline void PXGLCmdTexEnvf(GLenum target, GLenum pname, GLfloat param)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordData(_PXGLCommand_TexEnvf, target, pname, &param, sizeof(GLfloat));
+	else PX_GL_CMD_DIRECT(glTexEnvf(target, pname, param));
+}
+PXInline void PXGLCmdTexEnvi(GLenum target, GLenum pname, GLint param)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_TexEnvi, target, pname, param, 0);
+	else PX_GL_CMD_DIRECT(glTexEnvi(target, pname, param));
+}
+PXInline void PXGLCmdTexEnvx(GLenum target, GLenum pname, GLfixed param)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_TexEnvx, target, pname, param, 0);
+	else PX_GL_CMD_DIRECT(glTexEnvx(target, pname, param));
+}
+// GL_TEXTURE_ENV_COLOR takes the most values, 4
+PXInline void PXGLCmdTexEnvfv(GLenum target, GLenum pname, const GLfloat *params)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordData(_PXGLCommand_TexEnvfv, target, pname, params, sizeof(GLfloat) * 4);
+	else PX_GL_CMD_DIRECT(glTexEnvfv(target, pname, params));
+}
+PXInline void PXGLCmdTexEnviv(GLenum target, GLenum pname, const GLint *params)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordData(_PXGLCommand_TexEnviv, target, pname, params, sizeof(GLint) * 4);
+	else PX_GL_CMD_DIRECT(glTexEnviv(target, pname, params));
+}
+PXInline void PXGLCmdTexEnvxv(GLenum target, GLenum pname, const GLfixed *params)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordData(_PXGLCommand_TexEnvxv, target, pname, params, sizeof(GLfixed) * 4);
+	else PX_GL_CMD_DIRECT(glTexEnvxv(target, pname, params));
+}
+PXInline void PXGLCmdLineWidth(GLfloat width)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordf(_PXGLCommand_LineWidth, width, 0.0f, 0.0f, 0.0f);
+	else PX_GL_CMD_DIRECT(glLineWidth(width));
+}
+PXInline void PXGLCmdPointSize(GLfloat size)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordf(_PXGLCommand_PointSize, size, 0.0f, 0.0f, 0.0f);
+	else PX_GL_CMD_DIRECT(glPointSize(size));
+}
+PXInline void PXGLCmdColor4ub(GLubyte red, GLubyte green, GLubyte blue, GLubyte alpha)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_Color4ub, red, green, blue, alpha);
+	else PX_GL_CMD_DIRECT(glColor4ub(red, green, blue, alpha));
+}
+PXInline void PXGLCmdMatrixMode(GLenum mode)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_MatrixMode, mode, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glMatrixMode(mode));
+}
+PXInline void PXGLCmdPushMatrix()
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_PushMatrix, 0, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glPushMatrix());
+}
+PXInline void PXGLCmdPopMatrix()
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_PopMatrix, 0, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glPopMatrix());
+}
+PXInline void PXGLCmdLoadIdentity()
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_LoadIdentity, 0, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glLoadIdentity());
+}
+PXInline void PXGLCmdLoadMatrixf(const GLfloat *m)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordData(_PXGLCommand_LoadMatrixf, 0, 0, m, sizeof(GLfloat) * 16);
+	else PX_GL_CMD_DIRECT(glLoadMatrixf(m));
+}
+PXInline void PXGLCmdOrthof(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar)
+{
+	if (pxGLRecordingCommandBuffer)
+	{
+		GLfloat values[6] = {left, right, bottom, top, zNear, zFar};
+		_PXGLRecordData(_PXGLCommand_Orthof, 0, 0, values, sizeof(GLfloat) * 6);
+	}
+	else PX_GL_CMD_DIRECT(glOrthof(left, right, bottom, top, zNear, zFar));
+}
+PXInline void PXGLCmdViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_Viewport, x, y, width, height);
+	else PX_GL_CMD_DIRECT(glViewport(x, y, width, height));
+}
+PXInline void PXGLCmdClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordf(_PXGLCommand_ClearColor, red, green, blue, alpha);
+	else PX_GL_CMD_DIRECT(glClearColor(red, green, blue, alpha));
+}
+PXInline void PXGLCmdClear(GLbitfield mask)
+{
+	if (pxGLRecordingCommandBuffer) _PXGLRecordi(_PXGLCommand_Clear, mask, 0, 0, 0);
+	else PX_GL_CMD_DIRECT(glClear(mask));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -42,6 +42,7 @@
 
 #include "inkGL.h"
 
+#include "PXGL.h"
 #include "PXGLUtils.h"
 #include "PXGLState.h"
 
@@ -52,10 +53,15 @@ extern "C" {
 void PXGLInit(unsigned width, unsigned height, float scaleFactor);
 void PXGLDealloc();
 
+extern PXGLRenderStatistics pxGLStatistics;
+
 void PXGLFlush();
+void PXGLFlushWithCause(PXGLFlushCause cause);
+void PXGLEndFrameStatistics();
 //GLuint PXGLGetTextureBuffer();
 void PXGLSyncPXToGL();
 void PXGLSyncGLToPX();
+void PXGLSyncAllGLToPX();
 
 void PXGLSyncTransforms();
 void PXGLUnSyncTransforms();
@@ -43,6 +43,8 @@
 
 #include "PXPrivateUtils.h"
 #include "PXGLStatePrivate.h"
+#include "PXGLCommandBuffer.h"
+#include "PXProfileUtils.h"
 
 #define PX_GL_RENDERER_MAX_VERTICES 0xFFFF
 #define PX_GL_RENDERER_MAX_VERTICES_MINUS_2 0xFFFD
@@ -125,10 +127,6 @@ GLubyte pxGLBufferLastVertexGreen = 0xFF;
 GLubyte pxGLBufferLastVertexBlue  = 0xFF;
 GLubyte pxGLBufferLastVertexAlpha = 0xFF;
 
-#ifdef PX_DEBUG_MODE
-int pxGLDrawCallCount = 0;
-#endif
-
 #ifdef PX_RENDER_VBO
 GLuint PXGLBufferVertexID = 0;
 unsigned PXGLLastMaxBufferVertexSize = 0;
@@ -221,11 +219,15 @@ void PXGLSetDrawMode(GLenum mode)
 {
 	// Check to see if our mode has changed, or if we are equal to line loop or
 	// strip; if so, then we need to flush the buffer and change modes.
-	if (mode != pxGLDrawMode || mode == GL_LINE_LOOP || mode == GL_LINE_STRIP || mode == GL_TRIANGLE_FAN)
+	if (mode != pxGLDrawMode)
 	{
-		PXGLFlushBuffer();
+		PXGLFlushBufferWithCause(PXGLFlushCause_DrawMode);
 		pxGLDrawMode = mode;
 	}
+	else if (mode == GL_LINE_LOOP || mode == GL_LINE_STRIP || mode == GL_TRIANGLE_FAN)
+	{
+		PXGLFlushBufferWithCause(PXGLFlushCause_LineLoopOrFan);
+	}
 }
 
 /*
@@ -271,7 +273,7 @@ void PXGLEnableColorArray()
 		return;
 
 	//Actually set the state in GL
-	glEnableClientState(GL_COLOR_ARRAY);
+	PXGLCmdEnableClientState(GL_COLOR_ARRAY);
 	pxGLIsColorArrayEnabled = true;
 }
 
@@ -286,7 +288,7 @@ void PXGLDisableColorArray()
 		return;
 
 	//Actually set the state in GL
-	glDisableClientState(GL_COLOR_ARRAY);
+	PXGLCmdDisableClientState(GL_COLOR_ARRAY);
 	pxGLIsColorArrayEnabled = false;
 }
 
@@ -621,7 +623,7 @@ void PXGLConsolidateBuffer()
 	pxGLHadDrawnElements = false;
 }
 
-PXInline void PXGLDraw()
+PXInline void PXGLDrawChunks(GLenum mode, bool drawElements, const PXGLElementsType *indices, int amountToDraw)
 {
 	// If the array is larger then max vertices, we should flush it in chunks.
 	// This is best done by flushing up until MAX_VERTICES - 2, then again from
@@ -630,9 +632,8 @@ PXInline void PXGLDraw()
 
 	// HAVE TO BE SIGNED
 	int start;
-	int amountToDraw = pxGLDrawElements ? pxGLIndexBuffer.size : pxGLVertexBuffer.size;
 
-	if (pxGLDrawElements)
+	if (drawElements)
 	{
 		GLenum type;
 		switch(sizeof(PXGLElementsType))
@@ -650,15 +651,52 @@ PXInline void PXGLDraw()
 		}
 
 		for (start = 0; amountToDraw > 0; start += PX_GL_RENDERER_MAX_VERTICES_MINUS_2, amountToDraw -= PX_GL_RENDERER_MAX_VERTICES_MINUS_2)
-			glDrawElements(pxGLDrawMode, ((amountToDraw < PX_GL_RENDERER_MAX_VERTICES) ? amountToDraw : PX_GL_RENDERER_MAX_VERTICES), type, pxGLIndexBuffer.array + start);
+			glDrawElements(mode, ((amountToDraw < PX_GL_RENDERER_MAX_VERTICES) ? amountToDraw : PX_GL_RENDERER_MAX_VERTICES), type, indices + start);
 	}
 	else
 	{
 		for (start = 0; amountToDraw > 0; start += PX_GL_RENDERER_MAX_VERTICES_MINUS_2, amountToDraw -= PX_GL_RENDERER_MAX_VERTICES_MINUS_2)
-			glDrawArrays(pxGLDrawMode, start, ((amountToDraw < PX_GL_RENDERER_MAX_VERTICES) ? amountToDraw : PX_GL_RENDERER_MAX_VERTICES));
+			glDrawArrays(mode, start, ((amountToDraw < PX_GL_RENDERER_MAX_VERTICES) ? amountToDraw : PX_GL_RENDERER_MAX_VERTICES));
 	}
 }
 
+PXInline void PXGLDraw()
+{
+	PXGLDrawChunks(pxGLDrawMode,
+	               pxGLDrawElements,
+	               pxGLIndexBuffer.array,
+	               pxGLDrawElements ? pxGLIndexBuffer.size : pxGLVertexBuffer.size);
+}
+
+/*
+ * This method draws a batch that was copied into a command buffer while
+ * recording. The client states were recorded ahead of it, so only the
+ * pointers need to be set.
+ */
+void PXGLRendererDrawRecorded(GLenum mode,
+                              bool textured,
+                              bool colored,
+                              const PXGLColoredTextureVertex *vertices,
+                              unsigned vertexCount,
+                              const PXGLElementsType *indices,
+                              unsigned indexCount,
+                              const GLfloat *pointSizes)
+{
+	if (pointSizes)
+		glPointSizePointerOES(GL_FLOAT, 0, pointSizes);
+
+	glVertexPointer(2, GL_FLOAT, sizeof(PXGLColoredTextureVertex), &(vertices->x));
+	if (textured)
+		glTexCoordPointer(2, GL_FLOAT, sizeof(PXGLColoredTextureVertex), &(vertices->s));
+	if (colored)
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(PXGLColoredTextureVertex), &(vertices->r));
+
+	if (indices)
+		PXGLDrawChunks(mode, true, indices, indexCount);
+	else
+		PXGLDrawChunks(mode, false, NULL, vertexCount);
+}
+
 /*
  * This method flushes the buffer to GL, meaning that it takes whatever the
  * buffer status is right now, and calls the appropriate methods in gl to
@@ -677,21 +715,40 @@ void PXGLFlushBufferToGL()
 	else
 	{
 		PXGLDisableColorArray();
-		glColor4ub(pxGLBufferLastVertexRed,
-				   pxGLBufferLastVertexGreen,
-				   pxGLBufferLastVertexBlue,
-				   pxGLBufferLastVertexAlpha);
+		PXGLCmdColor4ub(pxGLBufferLastVertexRed,
+		                pxGLBufferLastVertexGreen,
+		                pxGLBufferLastVertexBlue,
+		                pxGLBufferLastVertexAlpha);
 	}
 
-	// If the point size array is enabled, then lets set the pointer for it.
-	if (PX_IS_BIT_ENABLED(pxGLStateInGL.clientState, PX_GL_POINT_SIZE_ARRAY))
-	//if (PX_IS_BIT_ENABLED(pxGLClientStateInGL, PX_GL_POINT_SIZE_ARRAY))
-		glPointSizePointerOES(GL_FLOAT, 0, pxGLPointSizeBuffer.array);
+	bool hasPointSizes = PX_IS_BIT_ENABLED(pxGLStateInGL.clientState, PX_GL_POINT_SIZE_ARRAY);
 
 	// shorts even though it is actually a boolean, for alignment
 	int isTextured = PX_IS_BIT_ENABLED(pxGLStateInGL.clientState, PX_GL_TEXTURE_COORD_ARRAY);
 	//int isTextured = PX_IS_BIT_ENABLED(pxGLClientStateInGL, PX_GL_TEXTURE_COORD_ARRAY);
 
+	// When recording, the batch is copied into the command buffer and drawn
+	// when the buffer gets replayed.
+	if (pxGLRecordingCommandBuffer)
+	{
+		_PXGLRecordDraw(pxGLDrawMode,
+		                isTextured,
+		                pxGLIsColorArrayEnabled,
+		                pxGLVertexBuffer.array,
+		                pxGLVertexBuffer.size,
+		                pxGLDrawElements ? pxGLIndexBuffer.array : NULL,
+		                pxGLDrawElements ? pxGLIndexBuffer.size : 0,
+		                hasPointSizes ? pxGLPointSizeBuffer.array : NULL,
+		                hasPointSizes ? pxGLPointSizeBuffer.size : 0);
+
+		return;
+	}
+
+	// If the point size array is enabled, then lets set the pointer for it.
+	if (hasPointSizes)
+	//if (PX_IS_BIT_ENABLED(pxGLClientStateInGL, PX_GL_POINT_SIZE_ARRAY))
+		glPointSizePointerOES(GL_FLOAT, 0, pxGLPointSizeBuffer.array);
+
 #ifdef PX_RENDER_VBO
 	if (PXGLBufferVertexID)
 	{
@@ -838,16 +895,23 @@ void PXGLFlushBufferToGL()
 #endif // PX_GL_RENDERER_SEND_CORRECTED_SIZE
 
 #endif // PX_RENDER_VBO
-
-#ifdef PX_DEBUG_MODE
-	++pxGLDrawCallCount;
-#endif
 }
 
 /*
  * This method flushes the buffer, if the buffer is empty then nothing occurs.
  */
 void PXGLFlushBuffer()
+{
+	PXGLFlushBufferWithCause(PXGLFlushCause_Explicit);
+}
+
+/*
+ * This method flushes the buffer like PXGLFlushBuffer, counting the flush
+ * towards the given cause in the render statistics.
+ *
+ * @param PXGLFlushCause cause - Why the batch is being broken.
+ */
+void PXGLFlushBufferWithCause(PXGLFlushCause cause)
 {
 	//If the buffer is empty, lets just return.
 	if (pxGLVertexBuffer.size == 0)
@@ -861,6 +925,24 @@ void PXGLFlushBuffer()
 	if (pxGLDrawElements && pxGLIndexBuffer.size == 0)
 		return;
 
+	PX_PROFILE_ZONE("PXGLFlushBuffer");
+
+	unsigned drawAmount = pxGLDrawElements ? pxGLIndexBuffer.size : pxGLVertexBuffer.size;
+	bool hasPointSizes = PX_IS_BIT_ENABLED(pxGLStateInGL.clientState, PX_GL_POINT_SIZE_ARRAY);
+
+	// Batches too big for one draw are split into chunks that overlap by two,
+	// see PXGLDrawChunks.
+	pxGLStatistics.drawCalls += (drawAmount + PX_GL_RENDERER_MAX_VERTICES_MINUS_2 - 1) / PX_GL_RENDERER_MAX_VERTICES_MINUS_2;
+	pxGLStatistics.vertices += pxGLVertexBuffer.size;
+	if (pxGLDrawElements)
+		pxGLStatistics.indices += pxGLIndexBuffer.size;
+	pxGLStatistics.vertexBytes += pxGLVertexBuffer.size * sizeof(PXGLColoredTextureVertex);
+	if (hasPointSizes)
+		pxGLStatistics.vertexBytes += pxGLPointSizeBuffer.size * sizeof(GLfloat);
+
+	++pxGLStatistics.flushes;
+	++pxGLStatistics.flushesByCause[cause];
+
 	//Flush the buffer to gl
 	PXGLFlushBufferToGL();
 
@@ -901,14 +983,3 @@ void PXGLFlushBuffer()
 	else
 		pxGLHadDrawnArrays = true;
 }
-
-PXInline_c int PXGLGetDrawCountThenResetIt()
-{
-#ifdef PX_DEBUG_MODE
-	int drawCount = pxGLDrawCallCount;
-	pxGLDrawCallCount = 0;
-	return drawCount;
-#else
-	return 0;
-#endif
-}
@@ -104,8 +104,17 @@ void PXGLRendererPostRender();
 void PXGLConsolidateBuffer();
 
 void PXGLFlushBuffer();
+void PXGLFlushBufferWithCause(PXGLFlushCause cause);
+
+void PXGLRendererDrawRecorded(GLenum mode,
+                              bool textured,
+                              bool colored,
+                              const PXGLColoredTextureVertex *vertices,
+                              unsigned vertexCount,
+                              const PXGLElementsType *indices,
+                              unsigned indexCount,
+                              const GLfloat *pointSizes);
 
 PXInline_h void PXGLSetupEnables();
-PXInline_h int PXGLGetDrawCountThenResetIt();
 
 #endif
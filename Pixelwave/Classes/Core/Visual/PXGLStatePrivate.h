@@ -41,16 +41,18 @@
 #define _PX_GL_STATE_PRIVATE_H_
 
 /*	              STATE					*
- * EF0000000000SLPT - 16 bits, 6 used	*
+ * EF000000000ASLPT - 16 bits, 7 used	*
  * ----------------------------------	*
  * E = Draw elements			1 bit	*
  * F = Shade Model Flat		1 bit	*
+ * A = Alpha test				1 bit	*
  * S = Point sprite			1 bit	*
  * L = Line smooth				1 bit	*
  * P = Point smooth			1 bit	*
  * T = Texture 2D				1 bit	*/
 #define PX_GL_DRAW_ELEMENTS				0x8000
 #define PX_GL_SHADE_MODEL_FLAT			0x4000
+#define PX_GL_ALPHA_TEST				0x0010
 #define PX_GL_POINT_SPRITE				0x0008
 #define PX_GL_LINE_SMOOTH				0x0004
 #define PX_GL_POINT_SMOOTH				0x0002
@@ -95,6 +95,10 @@ typedef enum
 	PXGraphicsBuildStyle buildStyle;
 	bool wasBuilt;
 	bool justBuilt;
+
+	// The shape or sprite the graphics belong to, registered for a post frame
+	// whenever they change. Weakly referenced.
+	PXDisplayObject *owner;
 	//bool convertTrianglesIntoStrips;
 }
 
@@ -40,11 +40,13 @@
 #import "PXGraphics.h"
 
 #import "PXTextureData.h"
+#import "PXTextureMemory.h"
 #import "PXMatrix.h"
 
 #include "PXDebug.h"
 
 #include "PXGL.h"
+#include "PXProfileUtils.h"
 
 #include "inkVectorGraphics.h"
 #include "inkVectorGraphicsUtils.h"
@@ -145,6 +147,15 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 - (inkPoint) pxPointToInkPoint:(inkPoint)point displayObject:(PXDisplayObject *)displayObject;
 @end
 
+// The graphics need building again, which the owner gets done after the frame
+PXInline void PXGraphicsInvalidate(PXGraphics *graphics)
+{
+	graphics->wasBuilt = false;
+
+	if (graphics->owner)
+		PXEngineAddPostFrameListener(graphics->owner);
+}
+
 @implementation PXGraphics
 
 @synthesize vertexCount;
@@ -171,6 +182,7 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 	}
 
 	wasBuilt = false;
+	owner = nil;
 	buildStyle = PXGraphicsBuildStyle_Hybrid;
 	scaleRebuildEpsilon = 0.001f;
 	//scaleRebuildEpsilon = 0.05f;
@@ -195,7 +207,7 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 	if (buildStyle != _buildStyle)
 	{
 		buildStyle = _buildStyle;
-		wasBuilt = false;
+		PXGraphicsInvalidate(self);
 	}
 }
 
@@ -204,7 +216,7 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 	if (scaleRebuildEpsilon != _scaleRebuildEpsilon)
 	{
 		scaleRebuildEpsilon = _scaleRebuildEpsilon;
-		wasBuilt = false;
+		PXGraphicsInvalidate(self);
 	}
 }
 
@@ -214,7 +226,7 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 	{
 		curvePrecision = _curvePrecision;
 		inkSetCurveMultiplier((inkCanvas*)vCanvas, curvePrecision);
-		wasBuilt = false;
+		PXGraphicsInvalidate(self);
 	}
 }
 
@@ -301,13 +313,13 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 
 - (void) lineToX:(float)x y:(float)y
 {
-	wasBuilt = false;
+	PXGraphicsInvalidate(self);
 	inkLineTo((inkCanvas*)vCanvas, inkPointMake(x, y));
 }
 
 - (void) curveToControlX:(float)controlX controlY:(float)controlY anchorX:(float)anchorX anchorY:(float)anchorY
 {
-	wasBuilt = false;
+	PXGraphicsInvalidate(self);
 	inkCurveTo((inkCanvas*)vCanvas, inkPointMake(controlX, controlY), inkPointMake(anchorX, anchorY));
 }
 
@@ -348,7 +360,7 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 
 - (void) clear
 {
-	wasBuilt = false;
+	PXGraphicsInvalidate(self);
 	inkClear((inkCanvas*)vCanvas);
 
 	[textureDataList removeAllObjects];
@@ -360,7 +372,7 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 
 - (void) drawRectWithX:(float)x y:(float)y width:(float)width height:(float)height
 {
-	wasBuilt = false;
+	PXGraphicsInvalidate(self);
 	inkDrawRect((inkCanvas*)vCanvas, inkRectMakef(x, y, width, height));
 }
 
@@ -371,19 +383,19 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 
 - (void) drawRoundRectWithX:(float)x y:(float)y width:(float)width height:(float)height ellipseWidth:(float)ellipseWidth ellipseHeight:(float)ellipseHeight
 {
-	wasBuilt = false;
+	PXGraphicsInvalidate(self);
 	inkDrawRoundRect((inkCanvas*)vCanvas, inkRectMakef(x, y, width, height), inkSizeMake(ellipseWidth, ellipseHeight));
 }
 
 - (void) drawCircleWithX:(float)x y:(float)y radius:(float)radius
 {
-	wasBuilt = false;
+	PXGraphicsInvalidate(self);
 	inkDrawCircle((inkCanvas*)vCanvas, inkPointMake(x, y), radius);
 }
 
 - (void) drawEllipseWithX:(float)x y:(float)y width:(float)width height:(float)height
 {
-	wasBuilt = false;
+	PXGraphicsInvalidate(self);
 	inkDrawEllipse((inkCanvas*)vCanvas, inkRectMakef(x, y, width, height));
 }
 
@@ -475,7 +487,10 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 	//	inkSetPixelsPerPoint((inkCanvas*)vCanvas, 0.01f);
 		inkPushMatrix((inkCanvas*)vCanvas);
 		inkMultMatrix((inkCanvas*)vCanvas, iMatrix);
-		inkBuild((inkCanvas*)vCanvas);
+		{
+			PX_PROFILE_ZONE("inkBuild");
+			inkBuild((inkCanvas*)vCanvas);
+		}
 		inkPopMatrix((inkCanvas*)vCanvas);
 
 		return true;
@@ -578,6 +593,15 @@ inkGradientFill PXGraphicsGradientInfoMake(inkCanvas* canvas, PXGradientType typ
 	else
 		justBuilt = false;
 
+	// The fills only hold on to the GL names of their textures, so mark the
+	// textures as used here. One that was evicted is loaded again before it's
+	// drawn.
+	PXTextureData *textureData;
+	for (textureData in textureDataList)
+	{
+		PXTextureMemoryUse(textureData);
+	}
+
 	if (buildStyle == PXGraphicsBuildStyle_GL)
 	{
 		vertexCount = inkDrawv((inkCanvas*)vCanvas, (inkRenderer*)&pxGraphicsInkRenderer);
@@ -64,6 +64,8 @@ typedef enum
 
 	//@ For custom you use normal gl calls. The matrix and color transform will
 	//@ be set in gl so that your _renderGL method begins in the correct place.
+	//@ With the render thread enabled, _renderGL is called on it; see
+	//@ _PXDisplayObjectFlags_rendersOnRenderThread.
 	PXRenderMode_Custom,
 
 	//@ The initial state of _renderGL for PXDisplayObjectContainers. No
@@ -79,15 +81,21 @@ typedef enum
 	_PXDisplayObjectFlags_isInteractive				= 0x08,
 	_PXDisplayObjectFlags_useCustomHitArea			= 0x10,
 	_PXDisplayObjectFlags_forceAddToDisplayHitList	= 0x20,
+	// Kept up to date by the containers, so that the engine doesn't have to
+	// walk up to the stage.
+	_PXDisplayObjectFlags_isOnStage					= 0x40,
+	_PXDisplayObjectFlags_isPostFrameListener		= 0x80,
+	// Gets _postFrame every frame, rather than once per registration
+	_PXDisplayObjectFlags_keepsPostFrameListener	= 0x100,
+	// Set by PXRenderMode_Custom objects whose _renderGL doesn't read anything
+	// the logic changes, so the render thread may call it while the next
+	// frame's logic runs (see PXEngineSetRenderThreadEnabled).
+	_PXDisplayObjectFlags_rendersOnRenderThread		= 0x200,
 } _PXDisplayObjectFlags;
 
 @interface PXDisplayObject : PXEventDispatcher
 {
 @public
-	// Linked List
-	PXDisplayObject *_next;
-	PXDisplayObject *_prev;
-
 	PXRenderMode _renderMode;
 	// NEVER set this variable directly, always use _PXGLState... to change it!
 	PXGLState _glState;
@@ -337,6 +345,9 @@ typedef enum
 
 @interface PXDisplayObject (Override)
 - (void) _renderGL;
+// Only called on objects registered with PXEngineAddPostFrameListener, while
+// they're on the stage. Subclasses which override it are registered for every
+// frame when they're created.
 - (void) _postFrame;
 - (BOOL) _containsPointWithLocalX:(float)x localY:(float)y shapeFlag:(BOOL)shapeFlag;
 - (BOOL) _containsPointWithLocalX:(float)x localY:(float)y shapeFlag:(BOOL)shapeFlag useStroke:(BOOL)useStroke;
@@ -62,11 +62,28 @@
 #include "PXDebugUtils.h"
 
 #import "PXStage.h"
+#import "PXShape.h"
+#import "PXSprite.h"
 #include "PXSettings.h"
 
 // Used for naming instances
 static unsigned int _pxDisplayObjectCount = 0;
 
+// The _postFrame implementations that don't need to be called every frame,
+// filled in once by +initialize
+static IMP _pxDisplayObjectBaseImpPostFrame = NULL;
+static IMP _pxDisplayObjectShapeImpPostFrame = NULL;
+static IMP _pxDisplayObjectSpriteImpPostFrame = NULL;
+
+PXInline BOOL _PXDisplayObjectOverridesPostFrame(void (*impPostFrame)(id, SEL))
+{
+	IMP imp = (IMP)impPostFrame;
+
+	return imp != _pxDisplayObjectBaseImpPostFrame &&
+	       imp != _pxDisplayObjectShapeImpPostFrame &&
+	       imp != _pxDisplayObjectSpriteImpPostFrame;
+}
+
 /**
  * The base class for all elements drawn to the stage.
  * PXDisplayObject is an abstract class that represent a single element in the
@@ -115,6 +132,18 @@ static unsigned int _pxDisplayObjectCount = 0;
 @synthesize name = _name;
 @synthesize parent = _parent;
 
++ (void) initialize
+{
+	// The runtime runs this once, before any display object is made and
+	// without letting other threads through until it's done.
+	if (self != [PXDisplayObject class])
+		return;
+
+	_pxDisplayObjectBaseImpPostFrame = [PXDisplayObject instanceMethodForSelector:@selector(_postFrame)];
+	_pxDisplayObjectShapeImpPostFrame = [PXShape instanceMethodForSelector:@selector(_postFrame)];
+	_pxDisplayObjectSpriteImpPostFrame = [PXSprite instanceMethodForSelector:@selector(_postFrame)];
+}
+
 - (id) init
 {
 	self = [super init];
@@ -130,6 +159,14 @@ static unsigned int _pxDisplayObjectCount = 0;
 		PX_ENABLE_BIT(_flags, _PXDisplayObjectFlags_shouldRenderAABB);
 		PX_ENABLE_BIT(_flags, _PXDisplayObjectFlags_visible);
 
+		// A subclass with its own _postFrame gets it every frame. The shapes
+		// and sprites register themselves whenever their graphics change.
+		if (_PXDisplayObjectOverridesPostFrame(_impPostFrame))
+		{
+			PX_ENABLE_BIT(_flags, _PXDisplayObjectFlags_keepsPostFrameListener);
+			PXEngineAddPostFrameListener(self);
+		}
+
 		_renderMode = PXRenderMode_BatchAndManageStates;
 		_glState = _PXGLDefaultState();
 
@@ -148,9 +185,6 @@ static unsigned int _pxDisplayObjectCount = 0;
 		// break for a generic use.
 		_name = [[NSString alloc] initWithFormat:@"instance%u", _pxDisplayObjectCount++];
 
-		_next = nil;
-		_prev = nil;
-
 		_aabb.xMin = 0;
 		_aabb.xMax = 0;
 		_aabb.yMin = 0;
@@ -173,6 +207,8 @@ static unsigned int _pxDisplayObjectCount = 0;
 		PXEngineRemoveRenderListener(self);
 	}
 
+	PXEngineRemovePostFrameListener(self);
+
 	// Have to manually do this because setName forces name to be a value - it
 	// can not be null.
 	[_name release];
@@ -1080,7 +1116,9 @@ static unsigned int _pxDisplayObjectCount = 0;
 
 	// Get a retain on the event, or copy it if it's currently being used.
 	// Either way we increment the retain count
-	if (event->_isBeingDispatched)
+	BOOL isCopy = event->_isBeingDispatched;
+
+	if (isCopy)
 		event = [event copy];
 	else
 		[event retain];
@@ -1196,8 +1234,12 @@ static unsigned int _pxDisplayObjectCount = 0;
 
 	BOOL defaultPrevented = event->_defaultPrevented;
 
-	// Release hold on the event
-	[event release];
+	// Release hold on the event. A copy is ours alone, so it can go back to
+	// the pool.
+	if (isCopy)
+		[event _releaseToPool];
+	else
+		[event release];
 
 	return !defaultPrevented;
 }
@@ -40,16 +40,16 @@
 #import "PXInteractiveObject.h"
 
 @class PXDisplayObject;
+@class PXArrayList;
 
 @interface PXDisplayObjectContainer : PXInteractiveObject<NSFastEnumeration>
 {
 @public
 	BOOL _touchChildren;
-	unsigned short _numChildren;
 
-	// Linked List
-	PXDisplayObject *_childrenHead; // Linked List Head
-	PXDisplayObject *_childrenTail; // Tail
+	// Doesn't retain the children, the container keeps its own retain on each
+	// one.
+	PXArrayList *_children;
 
 	void (*_impPreChildRenderGL)(id, SEL);
 	void (*_impPostChildRenderGL)(id, SEL);
@@ -86,7 +86,7 @@
 //-- ScriptName: contains
 - (BOOL) containsChild:(PXDisplayObject *)child;
 
-// O(n)
+// O(1)
 //-- ScriptName: getChildAt
 - (PXDisplayObject *)childAtIndex:(int)index;
 // O(n)
@@ -98,7 +98,7 @@
 
 // child isn't returned in remove functions, unlike flash API, since we don't
 // want the child to get autoreleased (for performance reasons)
-// O(1)
+// O(n)
 //-- ScriptName: removeChild
 - (void) removeChild:(PXDisplayObject *)child;
 // O(n)
@@ -107,10 +107,10 @@
 
 //-- ScriptName: setChildIndex
 - (void) setIndex:(int)index ofChild:(PXDisplayObject *)child;
-// O(1)
+// O(n)
 //-- ScriptName: swapChildren
 - (void) swapChild:(PXDisplayObject *)child1 withChild:(PXDisplayObject *)child2;
-// O(n + 1)
+// O(1)
 //-- ScriptName: swapChildrenAt
 - (void) swapChildAtIndex:(int)index1 withChildAtIndex:(int)index2;
 
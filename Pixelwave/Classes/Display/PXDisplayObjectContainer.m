@@ -50,12 +50,7 @@
 
 #import "PXPoint.h"
 #import "PXDebug.h"
-
-/*
- * DEFINEs for looping the linked list.
- * If needed, make sure to use PX_CONTINUE_CHILD_LOOP and not just 'continue'.
- * Variables 'i' and 'child' are available within the START and END tags
- */
+#import "PXArrayList.h"
 
 #define PXThrowDispNotChild PXThrow(PXArgumentException, @"The supplied DisplayObject must be a child of the caller.");
 
@@ -64,6 +59,8 @@
 - (void) removeChild:(PXDisplayObject *)child dispatchEvents:(BOOL)dispatchEvents;
 @end
 
+void PXDisplayObjectContainerSetOnStage(PXDisplayObject *displayObject, BOOL onStage);
+
 /**
  * A PXDisplayObjectContainer is the abstract base class for setting up the
  * display list.  A PXDisplayObjectContainer is a display object that can hold
@@ -83,7 +80,6 @@
 @implementation PXDisplayObjectContainer
 
 @synthesize touchChildren = _touchChildren;
-@synthesize numChildren = _numChildren;
 
 - (id) init
 {
@@ -91,10 +87,8 @@
 
 	if (self)
 	{
-		_childrenHead = nil;
-		_childrenTail = nil;
+		_children = [[PXArrayList alloc] initWithWeakReferences:YES];
 
-		_numChildren = 0;
 		PX_ENABLE_BIT(_flags, _PXDisplayObjectFlags_isContainer);
 
 		_renderMode = PXRenderMode_Off;
@@ -117,6 +111,9 @@
 	// Remove all of my children
 	[self removeAllChildren];
 
+	[_children release];
+	_children = nil;
+
 	_impPreChildRenderGL = NULL;
 	_impPostChildRenderGL = NULL;
 
@@ -148,79 +145,34 @@
 		[child->_parent removeChild:child];
 	}
 
-	/////////////////
-	// Linked List //
-	/////////////////
+	//////////
+	// List //
+	//////////
 
-	//_children and _childrenTail must both be null or both be non-null
-	NSAssert((_childrenHead && _childrenTail) || (!_childrenHead && !_childrenTail), @"Head and Tail must both be either null or non-null");
+	// The index is looked up after the child was taken off of its old parent,
+	// since that may have been me.
+	int index = childToAddBefore ? [_children indexOfObject:childToAddBefore] : -1;
 
-	if (!childToAddBefore)  //The last index was picked, add it to the tail
+	if (index < 0)  //The last index was picked, add it to the end
 	{
-		if (_childrenTail)  //The list isn't empty
-		{
-			_childrenTail->_next = child;
-			child->_prev = _childrenTail;
-			child->_next = nil;
-
-			_childrenTail = child;
-		}
-		else   //The list is empty
-		{
-			_childrenHead = child;
-			_childrenTail = child;
-
-			child->_next = nil;
-			child->_prev = nil;
-		}
+		[_children addObject:child];
 	}
-	else   //Insert 'child' into the list
-
-	{       //Assume that the list isn't empty at this point
-		NSAssert(_numChildren > 0, @"The list must have at least one item at this point");
-
-		/*
-		                                Inserted here
-		   \/
-		   [prevChild] <----> [child] <----> [childToAddBefore]
-		        ^
-		   (may be null,
-		   making child
-		   the new head)
-
-		 */
-
-		//Add child right before 'childToAddBefore' (on the left)
-		PXDisplayObject *prevChild = childToAddBefore->_prev; //The node to be on the left of 'child'
-
-		//Create the right hand link
-		childToAddBefore->_prev = child;
-		child->_next = childToAddBefore;
-
-		//Create the left hand link
-		if (prevChild)
-		{
-			//Add me after the prev child
-			prevChild->_next = child;
-			child->_prev = prevChild;
-		}
-		else   //This is the new head
-		{
-			NSAssert(childToAddBefore == _childrenHead, @"Assuming that childToAddBefore is the head of the list");
-
-			child->_prev = nil;
-			_childrenHead = child;
-		}
+	else   //Insert 'child' right before 'childToAddBefore'
+	{
+		[_children insertObject:child atIndex:index];
 	}
 
-	++_numChildren;
-
 	///////////
 	// Child //
 	///////////
 
 	child->_parent = self;
 
+	if (PX_IS_BIT_ENABLED(_flags, _PXDisplayObjectFlags_isOnStage))
+	{
+		PXDisplayObjectContainerSetOnStage(child, YES);
+	}
+
 	// According to the API docs added events come after the child's been added	
 	if (dispatchEvents)
 	{
@@ -230,11 +182,11 @@
 		PXEvent *e = nil;
 
 		// ADDED event
-		e = [[PXEvent alloc] initWithType:PXEvent_Added
-							   bubbles:YES
-							 cancelable:NO];
+		e = [PXEvent _newPooledEventWithType:PXEvent_Added
+									 bubbles:YES
+								  cancelable:NO];
 		[child dispatchEvent:e];
-		[e release];
+		[e _releaseToPool];
 
 		// If the child is still on the display list
 		if (child.stage)
@@ -244,15 +196,15 @@
 			// Yay this new child is going to be on the on stage display list!			
 			// dispatch ADDED_TO_STAGE event
 
-			e = [[PXEvent alloc] initWithType:PXEvent_AddedToStage
-											bubbles:NO
-										  cancelable:NO];
+			e = [PXEvent _newPooledEventWithType:PXEvent_AddedToStage
+										 bubbles:NO
+									  cancelable:NO];
 
 			[child _dispatchAndPropegateEvent:e];
 			// Note child is not guaranteed to be in the display list, or even
 			// exist at this point
 
-			[e release];
+			[e _releaseToPool];
 		}
 
 		// Release the child
@@ -325,7 +277,7 @@
 		return child;
 	}
 
-	if (index < 0 || index > _numChildren)
+	if (index < 0 || index > _children->_count)
 	{
 		PXThrowIndexOutOfBounds;
 		return child;
@@ -335,20 +287,9 @@
 
 	PXDisplayObject *childToAddBefore = nil;
 
-	if (index < _numChildren)
+	if (index < _children->_count)
 	{
-		PXDisplayObject *loopChild;
-		unsigned loopIndex;
-		for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
-		{
-			if (loopIndex == index)
-			{
-				childToAddBefore = loopChild;
-				break;
-			}
-		}
-
-		NSAssert(child != nil, @"Assuming that the child was found and there are no holes in the linked list chain");
+		childToAddBefore = _children->_items[index];
 	}
 
 	_impAddChildBefore(self, nil, child, childToAddBefore, PXEngineGetStage().dispatchesDisplayListEvents);
@@ -364,18 +305,11 @@
 - (void) removeChild:(PXDisplayObject *)child dispatchEvents:(BOOL)dispatchEvents
 {	
 	// I don't have any children, so none can be removed
-	if (!_childrenHead || !child)
+	if (_children->_count == 0 || !child)
 	{
 		return;
 	}
 
-	/////////////////
-	// Linked List //
-	/////////////////
-
-	//_childrenHead and _childrenTail must both be null or both be non-null
-	NSAssert((_childrenHead && _childrenTail) || (!_childrenHead && !_childrenTail), @"_childrenHead and _childrenTail must both be null or both be non-null");
-
 	////////////
 	// Events //
 	////////////
@@ -393,12 +327,12 @@
 		PXEvent *event = nil;
 
 		// REMOVED event
-		event = [[PXEvent alloc] initWithType:PXEvent_Removed
-								   bubbles:YES
-								 cancelable:NO];
+		event = [PXEvent _newPooledEventWithType:PXEvent_Removed
+										 bubbles:YES
+									  cancelable:NO];
 
 		[child dispatchEvent:event];
-		[event release];
+		[event _releaseToPool];
 
 		// If the child hasn't been removed while we dispatched the remove event
 		// on it, dispatch the next event
@@ -406,13 +340,13 @@
 		{
 			// REMOVED_FROM_STAGE event
 
-			event = [[PXEvent alloc] initWithType:PXEvent_RemovedFromStage
-									   bubbles:NO
-									 cancelable:NO];
+			event = [PXEvent _newPooledEventWithType:PXEvent_RemovedFromStage
+											 bubbles:NO
+										  cancelable:NO];
 
 			[child _dispatchAndPropegateEvent:event];
 
-			[event release];
+			[event _releaseToPool];
 		}
 
 		// Is the child still MY child?
@@ -428,47 +362,12 @@
 		[child release];
 	}
 
-	/////////////////
-	// Linked List //
-	/////////////////
+	//////////
+	// List //
+	//////////
 
 	//Remove me from the list
-	if (child == _childrenHead && child == _childrenTail)
-	{
-		//I'm the only one...
-		_childrenHead = nil;
-		_childrenTail = nil;
-	}
-	else if (child == _childrenTail) //I'm the tail, and there's a (different) head
-	{
-		_childrenTail = _childrenTail->_prev;
-		_childrenTail->_next = nil;
-	}
-	else if (child == _childrenHead) //I'm the head, and there's a (different) tail
-	{
-		_childrenHead = _childrenHead->_next;
-		_childrenHead->_prev = nil;
-	}
-	else
-	{
-		//I'm somewhere in the middle, there's a (different) head and tail
-		//I must have a next and a prev
-		NSAssert(child->_next && child->_prev, @"Assuming that this node has children");
-
-		PXDisplayObject *childPrev = child->_prev;
-		PXDisplayObject *childNext = child->_next;
-
-		childPrev->_next = childNext;
-		childNext->_prev = childPrev;
-
-		//child->_prev->_next = child->_next;
-		//child->_next->_prev = child->_prev;
-	}
-
-	child->_next = nil;
-	child->_prev = nil;
-
-	--_numChildren;
+	[_children removeObject:child];
 
 	///////////
 	// Child //
@@ -476,6 +375,11 @@
 
 	child->_parent = nil;
 
+	if (PX_IS_BIT_ENABLED(child->_flags, _PXDisplayObjectFlags_isOnStage))
+	{
+		PXDisplayObjectContainerSetOnStage(child, NO);
+	}
+
 	[child release]; //release my real hold
 }
 
@@ -542,18 +446,23 @@
  */
 - (void) removeChildAtIndex:(int)index
 {
-	if (index < 0 || index >= _numChildren)
+	if (index < 0 || index >= _children->_count)
 	{
 		PXThrowIndexOutOfBounds;
 		return;
 	}
 
-	PXDisplayObject *child = [self childAtIndex:index];
+	PXDisplayObject *child = _children->_items[index];
 	[self removeChild:child];
 }
 
 // MARK: Querying
 
+- (unsigned short) numChildren
+{
+	return _children->_count;
+}
+
 /**
  * Determines whether the specified object is a child of this container or any
  * of its children.
@@ -580,8 +489,7 @@
 	}
 
 	PXDisplayObject *loopChild;
-	unsigned loopIndex;
-	for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
+	PXArrayListForEach(_children, loopChild)
 	{
 		if (loopChild == childToCheck)
 			return YES;
@@ -636,20 +544,16 @@
 		return -1;
 	}
 
-	PXDisplayObject *loopChild;
-	unsigned loopIndex;
-	for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
+	int index = [_children indexOfObject:childToCheck];
+
+	// The index should always be found.. if the parent of childToCheck is
+	// self, it is in the list
+	if (index < 0)
 	{
-		if (loopChild == childToCheck)
-			return loopIndex;
+		PXDebugLog (@"There was a weird error in getChildIndex");
 	}
 
-	// The code should never get here.. if the parent of childToCheck is self,
-	// it should be found in the above loop
-
-	PXDebugLog (@"There was a weird error in getChildIndex");
-
-	return -1;
+	return index;
 }
 
 // MARK: Retrieving Children
@@ -672,31 +576,13 @@
  */
 - (PXDisplayObject *)childAtIndex:(int)index
 {
-	if (index < 0 || index >= _numChildren)
+	if (index < 0 || index >= _children->_count)
 	{
 		PXThrowIndexOutOfBounds;
 		return nil;
 	}
 
-	PXDisplayObject *loopChild;
-	unsigned loopIndex;
-	for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
-	{
-		if (loopIndex == index)
-			return loopChild;
-	}
-
-	// The code should never get here.. if the parent of childToCheck is self,
-	// it should be found in the above loop
-
-	PXDebugLog (@"There was a weird error in getChildAt");
-
-	return nil;
-
-	/* //NSArray method
-	   if ([_children count] <= 0) return nil;
-	   return [_children objectAtIndex:index];
-	 */
+	return _children->_items[index];
 }
 
 /**
@@ -724,8 +610,7 @@
 	}
 
 	PXDisplayObject *loopChild;
-	unsigned loopIndex;
-	for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
+	PXArrayListForEach(_children, loopChild)
 	{
 		if ([loopChild.name isEqualToString:name])
 		{
@@ -774,7 +659,7 @@
 		return;
 	}
 
-	if (index < 0 || index >= _numChildren)
+	if (index < 0 || index >= _children->_count)
 	{
 		PXThrowIndexOutOfBounds;
 		return;
@@ -786,35 +671,9 @@
 		return;
 	}
 
-	// Make the switch //
-
-	// First remove the child from the list, but without dispatching events
-	_impRemoveChild(self, nil, child, NO);
-
-	if (index == _numChildren)
-	{
-		// An optimization: Add it back at the end of the list
-		_impAddChildBefore(self, nil, child, nil, NO);
-	}
-	else
-	{
-		// Add it before the child at 'index' to take its place
-		PXDisplayObject *childAtIndex = nil;
-
-		PXDisplayObject *loopChild;
-		unsigned loopIndex;
-		for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
-		{
-			if (loopIndex == index)
-			{
-				childAtIndex = loopChild;
-				break;
-			}
-		}
-
-		// Now add it back at the right index
-		_impAddChildBefore(self, nil, child, childAtIndex, NO);
-	}
+	// Make the switch. The children in between slide over by one, the child
+	// never leaves the list.
+	[_children setIndex:index ofObject:child];
 }
 
 /**
@@ -853,82 +712,7 @@
 	if (child1 == child2)
 		return;
 
-	// Grab the next and previous of the children
-	PXDisplayObject *next1 = child1->_next;
-	PXDisplayObject *prev1 = child1->_prev;
-
-	PXDisplayObject *next2 = child2->_next;
-	PXDisplayObject *prev2 = child2->_prev;
-
-	// Set their next and previous to the other child's next and previous (this
-	// does the initial swap).
-	child1->_next = next2;
-	child1->_prev = prev2;
-	child2->_next = next1;
-	child2->_prev = prev1;
-
-	// Special Case:	If the children are next to eachother, then they would
-	//					be pointing back at themselves from the previous swap.
-	//					This must be corrected, or it would cause an infinite
-	//					loop when looping through the children.
-	if (next1 == child2)
-	{
-		// Case 1:		The RIGHT side swap. This is when the first child's next
-		//				is equal to the second child. The other case is when the
-		//				second child's next is equal to the first child, this
-		//				would be called the LEFT swap.
-
-		// If the next of the first child is equal to the second, then they are
-		// next to eachother and we must set their next and previous to the
-		// other child rather then themselves (which they would be currently
-		// set to).
-		child2->_next = child1;
-		child1->_prev = child2;
-	}
-	else
-	{
-		// If they are not next to eachother on the RIGHT side, then we can set
-		// the next's previous and the previous's next normally.
-		if (next1)
-			next1->_prev = child2;
-		if (prev2)
-			prev2->_next = child1;
-	}
-	if (next2 == child1)
-	{
-		// Case 2:		The LEFT side swap. This is when the second child's next
-		//				is equal to the first child. The other case is when the
-		//				first child's next is equal to the second child, this
-		//				would be called the RIGHT swap.
-
-		// If the next of the second child is equal to the first, then they are
-		// next to eachother and we must set their next and previous to the
-		// other child rather then themselves (which they would be currently
-		// set to).
-		child2->_prev = child1;
-		child1->_next = child2;
-	}
-	else
-	{
-		// If they are not next to eachother on the LEFT side, then we can set
-		// the next's previous and the previous's next normally.
-		if (prev1)
-			prev1->_next = child2;
-		if (next2)
-			next2->_prev = child1;
-	}
-
-	// Special Case:	If our head or tail pointer points to either of the
-	//					children, we must update it to point to the other now.
-	if (_childrenHead == child1)
-		_childrenHead = child2;
-	else if (_childrenHead == child2)
-		_childrenHead = child1;
-
-	if (_childrenTail == child1)
-		_childrenTail = child2;
-	else if (_childrenTail == child2)
-		_childrenTail = child1;
+	[_children swapObject:child1 withObject:child2];
 }
 
 /**
@@ -957,19 +741,14 @@
  */
 - (void) swapChildAtIndex:(int)index1 withChildAtIndex:(int)index2
 {
-	if (index1 >= _numChildren || index2 >= _numChildren ||
+	if (index1 >= _children->_count || index2 >= _children->_count ||
 	    index1 < 0 || index2 < 0)
 	{
 		PXThrowIndexOutOfBounds;
 		return;
 	}
 
-	PXDisplayObject *child1 = [self childAtIndex:index1];
-	PXDisplayObject *child2 = [self childAtIndex:index2];
-
-	NSAssert(child1 && child2, @"child1 and child2 must be non-nil");
-
-	[self swapChild:child1 withChild:child2];
+	[_children swapObjectAtIndex:index1 withObjectAtIndex:index2];
 }
 
 /**
@@ -994,15 +773,11 @@
  */
 - (void) removeAllChildren
 {
-	unsigned short len = _numChildren;
-	for (unsigned short i = 0; i < len; ++i)
+	unsigned len = _children->_count;
+	for (unsigned i = 0; i < len && _children->_count > 0; ++i)
 	{
-		[self removeChild:_childrenHead];
+		[self removeChild:_children->_items[0]];
 	}
-
-	_childrenHead = nil;
-	_childrenTail = nil;
-	_numChildren = 0;
 }
 
 /**
@@ -1054,8 +829,7 @@
 	PXDisplayObjectContainer *container;
 
 	PXDisplayObject *loopChild;
-	unsigned loopIndex;
-	for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
+	PXArrayListForEach(_children, loopChild)
 	{
 		// If the point is within the child, then add the child.  This also adds
 		// the child if it is a display object container when the point is
@@ -1093,7 +867,7 @@
 	[super _dispatchAndPropegateEvent:event];
 
 	// If I have no children, don't bother
-	if (_numChildren <= 0)
+	if (_children->_count == 0)
 		return;
 
 	// Loop through the children.
@@ -1131,7 +905,7 @@
 		childIndex = [self indexOfChild:child];
 
 		// If that was the last child, you're done
-		if (childIndex >= _numChildren - 1)
+		if (childIndex >= (int)(_children->_count) - 1)
 			break;
 
 		child = [self childAtIndex:childIndex + 1];
@@ -1147,7 +921,7 @@
 
 - (void) _measureGlobalBounds:(CGRect *)retBounds useStroke:(BOOL)useStroke
 {
-	if (_numChildren == 0)
+	if (_children->_count == 0)
 	{
 		if (useStroke == YES) // For backwards compatability
 			[self _measureLocalBounds:retBounds];
@@ -1186,9 +960,8 @@
 	float x4; float y4;
 
 	PXDisplayObject *loopChild;
-	unsigned loopIndex;
 
-	for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
+	PXArrayListForEach(_children, loopChild)
 	{
 		_bounds = CGRectZero;
 		if (useStroke == YES) // For backwards compatability
@@ -1234,8 +1007,7 @@
 					   shapeFlag:(BOOL)shapeFlag
 {
 	PXDisplayObject *loopChild;
-	unsigned loopIndex;
-	for (loopIndex = 0, loopChild = _childrenHead; loopIndex < _numChildren; ++loopIndex, loopChild = loopChild->_next)
+	PXArrayListForEach(_children, loopChild)
 	{
 		if ([loopChild _hitTestPointWithParentX:x parentY:y shapeFlag:shapeFlag])
 			return YES;
@@ -1248,50 +1020,7 @@
 
 - (NSUInteger) countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id *)stackbuf count:(NSUInteger)count
 {
-	PXDisplayObject *current;
-	if (state->state == 0)
-	{
-		// Set the starting point. _startOfListNode is assumed to be our
-		// object's instance variable that points to the start of the list.
-		current = _childrenHead;
-	}
-	else if (state->state == 1) //No more items left
-	{
-		return 0;
-	}
-	else
-	{
-		// Subsequent iterations, get the current progress out of state->state
-		current = (PXDisplayObject *)state->state;
-	}
-
-	unsigned index;
-	for (index = 0; index < count; ++index)
-	{
-		if (current)
-		{
-			stackbuf[index] = current;
-			current = current->_next;
-		}
-		else
-		{
-			break;
-		}
-	}
-
-	if (current)
-	{
-		state->state = (unsigned long)current;
-	}
-	else
-	{
-		state->state = 1;
-	}
-
-	state->itemsPtr = stackbuf;
-	state->mutationsPtr = (unsigned long *)self;
-
-	return index;
+	return [_children countByEnumeratingWithState:state objects:stackbuf count:count];
 }
 
 - (void) _preChildRenderGL
@@ -1302,3 +1031,25 @@
 }
 
 @end
+
+/*
+ * Sets whether the display object, and everything inside of it, is on the
+ * stage.
+ */
+void PXDisplayObjectContainerSetOnStage(PXDisplayObject *displayObject, BOOL onStage)
+{
+	if (onStage)
+		PX_ENABLE_BIT(displayObject->_flags, _PXDisplayObjectFlags_isOnStage);
+	else
+		PX_DISABLE_BIT(displayObject->_flags, _PXDisplayObjectFlags_isOnStage);
+
+	if (!PX_IS_BIT_ENABLED(displayObject->_flags, _PXDisplayObjectFlags_isContainer))
+		return;
+
+	PXDisplayObject *child = nil;
+
+	PXArrayListForEach(((PXDisplayObjectContainer *)displayObject)->_children, child)
+	{
+		PXDisplayObjectContainerSetOnStage(child, onStage);
+	}
+}
@@ -182,16 +182,16 @@
 		UITouch *touch = ((PXTouchEvent *)event).nativeTouch;
 
 		// Make the tap event
-		PXTouchEvent *tapEvent = [[PXTouchEvent alloc] initWithType:PXTouchEvent_Tap
-														 nativeTouch:touch
-															  stageX:touchPosition.x
-															  stageY:touchPosition.y
-															tapCount:tapCount];
+		PXTouchEvent *tapEvent = [PXTouchEvent _newPooledEventWithType:PXTouchEvent_Tap
+														   nativeTouch:touch
+																stageX:touchPosition.x
+																stageY:touchPosition.y
+															  tapCount:tapCount];
 
 		// Target of course is ourself
 		tapEvent->_target = self;
 		[self dispatchEvent:tapEvent];
-		[tapEvent release];
+		[tapEvent _releaseToPool];
 	}
 
 	// Release ourselves after dispatching the event
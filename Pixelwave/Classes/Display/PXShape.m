@@ -56,7 +56,10 @@
 - (void) dealloc
 {
 	if (_graphics)
+	{
+		_graphics->owner = nil;
 		[_graphics release];
+	}
 
 	_graphics = nil;
 
@@ -70,6 +73,10 @@
 		_graphics = [[PXGraphics alloc] init];
 		_renderMode = PXRenderMode_BatchAndManageStates;
 		//_renderMode = PXRenderMode_Custom;
+
+		// Whenever they change, the graphics get built after the frame's
+		// logic, before rendering.
+		_graphics->owner = self;
 	}
 
 	return _graphics;
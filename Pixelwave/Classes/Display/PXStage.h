@@ -174,6 +174,12 @@ typedef enum
  * due to the iPhone's screen refresh rate being 60hz.
  */
 @property (nonatomic) float renderFrameRate;
+/**
+ * How far, between 0 and 1, the clock has moved from the last enterFrame event
+ * towards the next one. When rendering more often than #frameRate, this can be
+ * used to interpolate between the last two states of a moving object.
+ */
+@property (nonatomic, readonly) float frameAlpha;
 
 /**
  * Defines whether or not the engine is currently running. To pause the engine
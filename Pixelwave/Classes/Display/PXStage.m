@@ -47,6 +47,7 @@
 #include "PXColorUtils.h"
 #include "PXEngine.h"
 #include "PXMathUtils.h"
+#include "PXPrivateUtils.h"
 
 @interface PXStage (Private)
 - (void) onUnsettablePropertyAccess;
@@ -107,6 +108,8 @@
 
 		_captureTouches = NO;
 
+		PX_ENABLE_BIT(_flags, _PXDisplayObjectFlags_isOnStage);
+
 	//	self.orientation = PXStageOrientation_Portrait;
 	}
 
@@ -205,6 +208,11 @@
 	return PXEngineGetRenderFrameRate();
 }
 
+- (float) frameAlpha
+{
+	return PXEngineGetLogicAlpha();
+}
+
 - (float) contentScaleFactor
 {
 	return PXEngineGetContentScaleFactor();
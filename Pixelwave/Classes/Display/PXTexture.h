@@ -71,7 +71,7 @@
 	unsigned char numVerts;
 	PXGLTextureVertex *verts;
 
-	// Either GL_LINEAR or GL_NEAREST
+	// Either GL_LINEAR, GL_NEAREST or GL_LINEAR_MIPMAP_LINEAR
 	unsigned short smoothingType;
 	// Either GL_REPEAT or GL_CLAMP_TO_EDGE
 	unsigned short wrapType;
@@ -118,6 +118,14 @@
  * Note that while smoothing looks better it is also more taxing on the gpu.
  */
 @property (nonatomic, assign) BOOL smoothing;
+/**
+ * Determines whether the texture data's mipmaps are used when the texture is
+ * scaled down. Turning this on also turns on #smoothing. If the texture data
+ * has no mipmaps, regular smoothing is used instead.
+ *
+ * @see [PXTextureData setGeneratesMipmaps:]
+ */
+@property (nonatomic, assign) BOOL mipmapSmoothing;
 /**
  * Determines how pixels outside of the texture's boundaries should be handled.
  * If the clipRect of the texture is outside of the bounds of the texture,
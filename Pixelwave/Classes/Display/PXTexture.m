@@ -39,6 +39,7 @@
 
 #import "PXRectangle.h"
 #import "PXTextureData.h"
+#import "PXTextureMemory.h"
 
 #import "PXTextureLoader.h"
 
@@ -304,14 +305,26 @@ PXGLAABBf PXTextureCalcAABB(PXGLTextureVertex *verts, unsigned numVerts, _PXText
 
 - (void) setSmoothing:(BOOL)smoothing
 {
-	if (smoothing)
-		smoothingType = GL_LINEAR;
-	else
+	if (!smoothing)
 		smoothingType = GL_NEAREST;
+	else if (smoothingType == GL_NEAREST)
+		smoothingType = GL_LINEAR;
 }
 - (BOOL) smoothing
 {
-	return (smoothingType == GL_LINEAR);
+	return (smoothingType != GL_NEAREST);
+}
+
+- (void) setMipmapSmoothing:(BOOL)mipmapSmoothing
+{
+	if (mipmapSmoothing)
+		smoothingType = GL_LINEAR_MIPMAP_LINEAR;
+	else if (smoothingType == GL_LINEAR_MIPMAP_LINEAR)
+		smoothingType = GL_LINEAR;
+}
+- (BOOL) mipmapSmoothing
+{
+	return (smoothingType == GL_LINEAR_MIPMAP_LINEAR);
 }
 
 - (void) setRepeat:(BOOL)repeat
@@ -583,14 +596,20 @@ PXGLAABBf PXTextureCalcAABB(PXGLTextureVertex *verts, unsigned numVerts, _PXText
 		// </COPY>
 	}
 
+	PXTextureMemoryUse(textureData);
 	PXGLBindTexture(GL_TEXTURE_2D, textureData->_glName);
 
-	// Validate the smoothing
-	if (smoothingType != textureData->_smoothingType)
+	// Validate the smoothing. Without mipmaps the texture would be incomplete,
+	// so fall back to regular smoothing.
+	unsigned short minFilter = smoothingType;
+	if (minFilter == GL_LINEAR_MIPMAP_LINEAR && !textureData->_hasMipmaps)
+		minFilter = GL_LINEAR;
+
+	if (minFilter != textureData->_smoothingType)
 	{
-		PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, smoothingType);
-		PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, smoothingType);
-		textureData->_smoothingType = smoothingType;
+		PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+		PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (minFilter == GL_NEAREST) ? GL_NEAREST : GL_LINEAR);
+		textureData->_smoothingType = minFilter;
 	}
 	// Validate the wrapping
 	if (wrapType != textureData->_wrapType)
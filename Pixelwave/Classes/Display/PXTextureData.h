@@ -67,10 +67,26 @@
 	// Fill color
 	unsigned _fillColor;
 
-	// Either GL_LINEAR or GL_NEAREST
+	// The min filter. Either GL_LINEAR, GL_NEAREST or GL_LINEAR_MIPMAP_LINEAR
 	unsigned short _smoothingType;
 	// Either GL_REPEAT or GL_CLAMP_TO_EDGE
 	unsigned short _wrapType;
+	// Whether every level below the base one was uploaded
+	BOOL _hasMipmaps;
+
+	// Texture memory bookkeeping, owned by PXTextureMemory
+	unsigned _memoryByteCount;
+	unsigned _memoryFrame;
+	BOOL _isMemoryTracked;
+	BOOL _isEvicted;
+	PXTextureData *_memoryPrev;
+	PXTextureData *_memoryNext;
+
+	// Where the pixels can be loaded from again after an eviction. nil if they
+	// can't be, in which case the texture data is never evicted.
+	NSString *_reloadOrigin;
+	BOOL _reloadOriginIsURL;
+	id<PXTextureModifier> _reloadModifier;
 @private
 	// Pixel format in memory
 	PXTextureDataPixelFormat pixelFormat;
@@ -149,6 +165,12 @@
  * @see PXTextureDataPixelFormat
  */
 @property (nonatomic, readonly) PXTextureDataPixelFormat pixelFormat;
+/**
+ * Whether the texture has a full chain of mipmaps in gl memory.
+ *
+ * @see [PXTextureData setGeneratesMipmaps:]
+ */
+@property (nonatomic, readonly) BOOL hasMipmaps;
 
 //-- ScriptIgnore
 - (id) initWithData:(NSData *)data;
@@ -223,6 +245,12 @@
 //-- ScriptName: expandEdges
 + (BOOL) expandEdges;
 
+//-- ScriptName: setGeneratesMipmaps
+//-- ScriptArg[0]: required
++ (void) setGeneratesMipmaps:(BOOL)generatesMipmaps;
+//-- ScriptName: generatesMipmaps
++ (BOOL) generatesMipmaps;
+
 //-- ScriptIgnore
 + (PXTextureData *)textureDataWithContentsOfFile:(NSString *)path;
 //-- ScriptName: makeWithContentsOfFile
@@ -274,6 +302,9 @@
 						   contentHeight:(unsigned)contentHeight
 					  contentScaleFactor:(float)contentScaleFactor
 								  format:(PXTextureDataPixelFormat)pixelFormat;
+- (void) _setReloadOrigin:(NSString *)origin
+					isURL:(BOOL)isURL
+				 modifier:(id<PXTextureModifier>)modifier;
 @end
 
 /**
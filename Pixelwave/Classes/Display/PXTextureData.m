@@ -52,15 +52,26 @@
 #import "PXTextureParser.h"
 
 #import "PXTextureLoader.h"
+#import "PXAssetCache.h"
+#import "PXTextureMemory.h"
+#import "PXTextureModifier.h"
 
 #import "PXRectangle.h"
 #include <CoreGraphics/CGGeometry.h>
 #include "PXColorUtils.h"
+#include "PXGLCommandBuffer.h"
 
 // For drawTextureData
 #import "PXTexture.h"
 
 BOOL pxTextureDataExpandEdges = YES;
+BOOL pxTextureDataGeneratesMipmaps = NO;
+
+void PXTextureDataDeleteGLName(void *userData)
+{
+	GLuint glName = (GLuint)((uintptr_t)userData);
+	glDeleteTextures(1, &glName);
+}
 
 /**
  * Represents a texture in GPU memory. To draw the image represented by a
@@ -90,6 +101,7 @@ BOOL pxTextureDataExpandEdges = YES;
 @synthesize contentScaleFactor = _contentScaleFactor;
 @synthesize glTextureWidth = textureWidth;
 @synthesize glTextureHeight = textureHeight;
+@synthesize hasMipmaps = _hasMipmaps;
 
 - (id) init
 {
@@ -137,13 +149,35 @@ BOOL pxTextureDataExpandEdges = YES;
 	return self;
 }
 
+- (oneway void) release
+{
+	// Cached objects are released under the cache's lock, so a lookup on
+	// another thread can't retain one that's being deallocated.
+	bool locked = PXAssetCacheWillReleaseObject(self);
+
+	[super release];
+
+	if (locked)
+		PXAssetCacheDidReleaseObject();
+}
+
 - (void) dealloc
 {
+	PXTextureMemoryRemove(self);
+	PXAssetCacheRemoveObject(self);
+
+	[_reloadOrigin release];
+	_reloadOrigin = nil;
+	[_reloadModifier release];
+	_reloadModifier = nil;
+
 	if (_glName > 0)
 	{
 		PXGLBindTexture(GL_TEXTURE_2D, 0);
 
-		glDeleteTextures(1, &_glName);
+		// The frame being recorded may still draw with the texture, so it
+		// isn't deleted until that frame has been drawn.
+		PXGLRecordCallback(PXTextureDataDeleteGLName, NULL, (void *)((uintptr_t)_glName));
 	}
 
 	[super dealloc];
@@ -151,6 +185,8 @@ BOOL pxTextureDataExpandEdges = YES;
 
 - (BOOL) _makeGLName
 {
+	PXGLBeginDirect();
+
 	if (_glName > 0)
 	{
 		PXGLBindTexture(GL_TEXTURE_2D, 0);
@@ -162,6 +198,7 @@ BOOL pxTextureDataExpandEdges = YES;
 
 	if (_glName == 0)
 	{
+		PXGLEndDirect();
 		return NO;
 	}
 
@@ -176,6 +213,8 @@ BOOL pxTextureDataExpandEdges = YES;
 	}
 	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
 
+	PXGLEndDirect();
+
 	return YES;
 }
 
@@ -346,6 +385,8 @@ BOOL pxTextureDataExpandEdges = YES;
 			}
 		}
 
+		PXGLBeginDirect();
+
 		GLuint boundTex = PXGLBoundTexture();
 		PXGLBindTexture(GL_TEXTURE_2D, _glName);
 
@@ -365,6 +406,8 @@ BOOL pxTextureDataExpandEdges = YES;
 		// Bring back the previously bound texture
 		PXGLBindTexture(GL_TEXTURE_2D, boundTex);
 
+		PXGLEndDirect();
+
 		[self _setInternalPropertiesWithWidth:powerOfTwoWidth
 									   height:powerOfTwoHeight
 							usingContentWidth:width
@@ -470,6 +513,8 @@ BOOL pxTextureDataExpandEdges = YES;
 	}
 	UIGraphicsPopContext();
 
+	PXGLBeginDirect();
+
 	GLuint boundTex = PXGLBoundTexture();
 
     PXGLBindTexture(GL_TEXTURE_2D, _glName);
@@ -479,6 +524,8 @@ BOOL pxTextureDataExpandEdges = YES;
 	}
 	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
 
+	PXGLEndDirect();
+
 	CGContextRelease(context);
 	free(data);
 
@@ -513,6 +560,27 @@ BOOL pxTextureDataExpandEdges = YES;
 
 	_sPerPixel = _maxS / (float)_contentWidth;
 	_tPerPixel = _maxT / (float)_contentHeight;
+
+	PXTextureMemorySetByteCount(self, PXTextureMemoryGetByteCount(textureWidth, textureHeight, pixelFormat));
+}
+
+/*
+ * Remembers where the pixels of this texture data came from, which lets
+ * PXTextureMemory evict it and load it again the next time it's drawn.
+ */
+- (void) _setReloadOrigin:(NSString *)origin
+					isURL:(BOOL)isURL
+				 modifier:(id<PXTextureModifier>)modifier
+{
+	NSString *newOrigin = [origin copy];
+	[_reloadOrigin release];
+	_reloadOrigin = newOrigin;
+
+	[modifier retain];
+	[_reloadModifier release];
+	_reloadModifier = modifier;
+
+	_reloadOriginIsURL = isURL;
 }
 
 /**
@@ -637,6 +705,14 @@ BOOL pxTextureDataExpandEdges = YES;
 	}
 
 	PXEngineRenderToTexture(self, source, matPtr, ctPtr, rectPtr, smoothing, clearTexture);
+
+	// The pixels no longer match the origin, so they can't be reloaded from it,
+	// and later loads of the same file shouldn't share them either
+	[self _setReloadOrigin:nil isURL:NO modifier:nil];
+	PXAssetCacheRemoveObject(self);
+
+	// Only the base level was drawn to, the rest are stale now
+	_hasMipmaps = NO;
 }
 
 - (PXRectangle *)rect
@@ -666,6 +742,24 @@ BOOL pxTextureDataExpandEdges = YES;
 	return pxTextureDataExpandEdges;
 }
 
+/**
+ * Sets whether textures loaded from now on get a full chain of mipmaps,
+ * filtered on the cpu while the image is loaded. The mipmaps are only used
+ * when a PXTexture's #mipmapSmoothing is turned on, and they take up an
+ * extra third of the memory of the base image. The default is `NO`.
+ *
+ * This can be changed per load with PXTextureLoader#generatesMipmaps.
+ */
++ (void) setGeneratesMipmaps:(BOOL)generatesMipmaps
+{
+	pxTextureDataGeneratesMipmaps = generatesMipmaps;
+}
+
++ (BOOL) generatesMipmaps
+{
+	return pxTextureDataGeneratesMipmaps;
+}
+
 /**
  * A utility method for quickly loading an image from file and placing it into a
  * PXTextureData object.
@@ -682,18 +776,7 @@ BOOL pxTextureDataExpandEdges = YES;
 
 + (PXTextureData *)textureDataWithContentsOfFile:(NSString *)path modifier:(id<PXTextureModifier>)modifier
 {
-	PXTextureLoader *textureLoader = [[PXTextureLoader alloc] initWithContentsOfFile:path modifier:modifier];
-
-	if (!textureLoader)
-	{
-		PXDebugLog (@"PXTextureData: Couldn't resolve file at path %@", path);
-		return nil;
-	}
-
-	PXTextureData *textureData = [textureLoader newTextureData];
-	[textureLoader release];
-
-	return [textureData autorelease];
+	return [PXAssetCache textureDataWithContentsOfFile:path modifier:modifier];
 }
 
 + (PXTextureData *)textureDataWithContentsOfURL:(NSURL *)url
@@ -703,11 +786,7 @@ BOOL pxTextureDataExpandEdges = YES;
 
 + (PXTextureData *)textureDataWithContentsOfURL:(NSURL *)url modifier:(id<PXTextureModifier>)modifier
 {
-	PXTextureLoader *textureLoader = [[PXTextureLoader alloc] initWithContentsOfURL:url modifier:modifier];
-	PXTextureData *textureData = [textureLoader newTextureData];
-	[textureLoader release];
-
-	return [textureData autorelease];
+	return [PXAssetCache textureDataWithContentsOfURL:url modifier:modifier];
 }
 
 + (PXTextureData *)textureDataWithData:(NSData *)data
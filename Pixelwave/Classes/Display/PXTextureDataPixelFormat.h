@@ -69,7 +69,9 @@ typedef enum
 	/// PVR is a special encoding
 	PXTextureDataPixelFormat_RGBA_PVRTC2,
 	/// PVR is a special encoding
-	PXTextureDataPixelFormat_RGBA_PVRTC4
+	PXTextureDataPixelFormat_RGBA_PVRTC4,
+	/// ETC1 is a special encoding, 4 bits per pixel and no alpha
+	PXTextureDataPixelFormat_RGB_ETC1
 } PXTextureDataPixelFormat;
 
 #endif
@@ -0,0 +1,516 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXTextureMemory.h"
+
+#import "PXTextureData.h"
+#import "PXTextureLoader.h"
+#import "PXAssetCache.h"
+#import "PXEventDispatcher.h"
+#import "PXTextureMemoryEvent.h"
+
+#import "PXGL.h"
+#include "PXGLCommandBuffer.h"
+#import "PXDebug.h"
+
+#include "PXPrivateUtils.h"
+
+// Most recently used first
+PXTextureData *pxTextureMemoryHead = nil;					//Weakly referenced
+PXTextureData *pxTextureMemoryTail = nil;					//Weakly referenced
+
+// 0 means no budget
+unsigned pxTextureMemoryBudget = 0;
+
+unsigned pxTextureMemoryResidentByteCount = 0;
+unsigned pxTextureMemoryResidentTextureCount = 0;
+
+// Starts at 1 so that nothing counts as used before the first frame
+unsigned pxTextureMemoryFrame = 1;
+
+unsigned pxTextureMemoryHitCount = 0;
+unsigned pxTextureMemoryMissCount = 0;
+unsigned pxTextureMemoryEvictionCount = 0;
+
+PXEventDispatcher *pxTextureMemoryEventDispatcher = nil;	//Strongly referenced
+
+PXInline void _PXTextureMemoryUnlink(PXTextureData *textureData);
+PXInline void _PXTextureMemoryPushFront(PXTextureData *textureData);
+PXInline void _PXTextureMemoryEvict(PXTextureData *textureData);
+PXInline BOOL _PXTextureMemoryReload(PXTextureData *textureData);
+PXInline void _PXTextureMemoryDispatchEvent(NSString *type, PXTextureData *textureData);
+void _PXTextureMemoryEvictUnused(BOOL stopAtBudget);
+
+/**
+ * Keeps track of how much texture memory every PXTextureData takes up, and
+ * keeps the total within a #budget.
+ *
+ * The memory of a texture data is worked out from its size and
+ * PXTextureDataPixelFormat. Whenever the texture datas that are resident go
+ * over the budget, the least recently drawn ones are evicted: their pixels are
+ * released from texture memory, but the texture data object (and its GL
+ * texture name) stays around. The next time an evicted texture data is drawn,
+ * it's loaded again from the file or URL it was originally loaded from.
+ *
+ * Only texture datas made by a PXTextureLoader (including the
+ * [PXTextureData textureDataWithContentsOfFile:] family) can be evicted.
+ * Texture datas made at runtime, or drawn into with
+ * [PXTextureData drawDisplayObject:], count towards the total but are never
+ * evicted, since their pixels couldn't be brought back. Texture datas drawn in
+ * the current frame are never evicted either.
+ *
+ * The budget is checked once at the end of every frame, and whenever a
+ * texture data is created or reloaded. Reloading happens in the middle of
+ * rendering, and is as slow as loading the image was in the first place.
+ *
+ * **Example:**
+ *	// Keep textures within 24MB
+ *	[PXTextureMemory setBudget:24 * 1024 * 1024];
+ *
+ *	[[PXTextureMemory eventDispatcher] addEventListenerOfType:PXTextureMemoryEvent_Evict
+ *	                                                   listener:PXListener(onTextureEvict:)];
+ *
+ *	// ...
+ *
+ *	PXDebugLog(@"hits:%u misses:%u evictions:%u resident:%u bytes",
+ *	           [PXTextureMemory hitCount],
+ *	           [PXTextureMemory missCount],
+ *	           [PXTextureMemory evictionCount],
+ *	           [PXTextureMemory residentByteCount]);
+ *
+ * @see PXTextureMemoryEvent
+ */
+@implementation PXTextureMemory
+
+- (id) init
+{
+	PXDebugLog(@"PXTextureMemory can't be instantiated, use its class methods instead");
+	[self release];
+	return nil;
+}
+
+/**
+ * Sets the most texture memory, in bytes, the resident texture datas may take
+ * up. Pass 0 to remove the budget.
+ *
+ * **Default:** 0
+ */
++ (void) setBudget:(unsigned)budget
+{
+	pxTextureMemoryBudget = budget;
+
+	_PXTextureMemoryEvictUnused(YES);
+}
+
+/**
+ * The most texture memory, in bytes, the resident texture datas may take up.
+ * 0 when there's no budget.
+ */
++ (unsigned) budget
+{
+	return pxTextureMemoryBudget;
+}
+
+/**
+ * The texture memory, in bytes, taken up by every texture data that hasn't
+ * been evicted.
+ */
++ (unsigned) residentByteCount
+{
+	return pxTextureMemoryResidentByteCount;
+}
+
+/**
+ * The amount of texture datas that haven't been evicted.
+ */
++ (unsigned) residentTextureCount
+{
+	return pxTextureMemoryResidentTextureCount;
+}
+
+/**
+ * The amount of times a texture data was drawn while it was resident.
+ */
++ (unsigned) hitCount
+{
+	return pxTextureMemoryHitCount;
+}
+
+/**
+ * The amount of times a texture data had to be reloaded because it was drawn
+ * after being evicted.
+ */
++ (unsigned) missCount
+{
+	return pxTextureMemoryMissCount;
+}
+
+/**
+ * The amount of times a texture data was evicted.
+ */
++ (unsigned) evictionCount
+{
+	return pxTextureMemoryEvictionCount;
+}
+
+/**
+ * Sets the #hitCount, #missCount and #evictionCount back to 0.
+ */
++ (void) resetStatistics
+{
+	pxTextureMemoryHitCount = 0;
+	pxTextureMemoryMissCount = 0;
+	pxTextureMemoryEvictionCount = 0;
+}
+
+/**
+ * Evicts every texture data that can be evicted and wasn't drawn in the
+ * current frame, regardless of the budget. Useful when the application
+ * receives a memory warning.
+ */
++ (void) evictUnusedTextures
+{
+	_PXTextureMemoryEvictUnused(NO);
+}
+
+/**
+ * The event dispatcher on which PXTextureMemoryEvent events are dispatched.
+ */
++ (PXEventDispatcher *)eventDispatcher
+{
+	if (!pxTextureMemoryEventDispatcher)
+	{
+		pxTextureMemoryEventDispatcher = [[PXEventDispatcher alloc] init];
+	}
+
+	return pxTextureMemoryEventDispatcher;
+}
+
+@end
+
+// MARK: -
+// MARK: Bookkeeping
+// MARK: -
+
+PXInline_c unsigned PXTextureMemoryGetByteCount(unsigned width, unsigned height, PXTextureDataPixelFormat pixelFormat)
+{
+	unsigned pixelCount = width * height;
+
+	switch (pixelFormat)
+	{
+		case PXTextureDataPixelFormat_RGBA8888:
+			return pixelCount << 2;
+		case PXTextureDataPixelFormat_RGB888:
+			return pixelCount * 3;
+		case PXTextureDataPixelFormat_RGBA4444:
+		case PXTextureDataPixelFormat_RGBA5551:
+		case PXTextureDataPixelFormat_RGB565:
+		case PXTextureDataPixelFormat_LA88:
+			return pixelCount << 1;
+		case PXTextureDataPixelFormat_L8:
+		case PXTextureDataPixelFormat_A8:
+			return pixelCount;
+		case PXTextureDataPixelFormat_RGB_PVRTC2:
+		case PXTextureDataPixelFormat_RGBA_PVRTC2:
+			return pixelCount >> 2;
+		case PXTextureDataPixelFormat_RGB_PVRTC4:
+		case PXTextureDataPixelFormat_RGBA_PVRTC4:
+		case PXTextureDataPixelFormat_RGB_ETC1:
+			return pixelCount >> 1;
+		default:
+			break;
+	}
+
+	return pixelCount << 2;
+}
+
+/*
+ * Called whenever the pixels of a texture data are (re)specified. Starts
+ * tracking the texture data if it wasn't already, and counts it as resident.
+ */
+void PXTextureMemorySetByteCount(PXTextureData *textureData, unsigned byteCount)
+{
+	if (!textureData)
+		return;
+
+	if (!textureData->_isMemoryTracked)
+	{
+		textureData->_isMemoryTracked = YES;
+		_PXTextureMemoryPushFront(textureData);
+	}
+	else if (!textureData->_isEvicted)
+	{
+		pxTextureMemoryResidentByteCount -= textureData->_memoryByteCount;
+		--pxTextureMemoryResidentTextureCount;
+	}
+
+	textureData->_isEvicted = NO;
+	textureData->_memoryByteCount = byteCount;
+	// Don't let a brand new texture data get evicted before it's ever drawn
+	textureData->_memoryFrame = pxTextureMemoryFrame;
+
+	pxTextureMemoryResidentByteCount += byteCount;
+	++pxTextureMemoryResidentTextureCount;
+
+	_PXTextureMemoryEvictUnused(YES);
+}
+
+/*
+ * Called when a texture data is deallocated.
+ */
+void PXTextureMemoryRemove(PXTextureData *textureData)
+{
+	if (!textureData || !textureData->_isMemoryTracked)
+		return;
+
+	if (!textureData->_isEvicted)
+	{
+		pxTextureMemoryResidentByteCount -= textureData->_memoryByteCount;
+		--pxTextureMemoryResidentTextureCount;
+	}
+
+	_PXTextureMemoryUnlink(textureData);
+	textureData->_isMemoryTracked = NO;
+}
+
+/*
+ * Called right before a texture data is bound to be drawn. Marks it as the
+ * most recently used one, and loads it again if it was evicted.
+ */
+void PXTextureMemoryUse(PXTextureData *textureData)
+{
+	if (!textureData || !textureData->_isMemoryTracked)
+		return;
+
+	textureData->_memoryFrame = pxTextureMemoryFrame;
+
+	if (pxTextureMemoryHead != textureData)
+	{
+		_PXTextureMemoryUnlink(textureData);
+		_PXTextureMemoryPushFront(textureData);
+	}
+
+	if (!textureData->_isEvicted)
+	{
+		++pxTextureMemoryHitCount;
+		return;
+	}
+
+	// A texture data whose reload failed stays empty
+	if (!textureData->_reloadOrigin)
+		return;
+
+	++pxTextureMemoryMissCount;
+
+	if (_PXTextureMemoryReload(textureData))
+	{
+		textureData->_isEvicted = NO;
+
+		pxTextureMemoryResidentByteCount += textureData->_memoryByteCount;
+		++pxTextureMemoryResidentTextureCount;
+
+		_PXTextureMemoryDispatchEvent(PXTextureMemoryEvent_Reload, textureData);
+
+		_PXTextureMemoryEvictUnused(YES);
+	}
+	else
+	{
+		PXDebugLog(@"PXTextureMemory: Couldn't reload texture data from %@", textureData->_reloadOrigin);
+
+		// Don't try again every time it's drawn. It stays empty, so it can't
+		// be handed out by the asset cache anymore either.
+		[textureData _setReloadOrigin:nil isURL:NO modifier:nil];
+		PXAssetCacheRemoveObject(textureData);
+
+		_PXTextureMemoryDispatchEvent(PXTextureMemoryEvent_ReloadError, textureData);
+	}
+}
+
+/*
+ * Called by the engine once the stage has been rendered.
+ */
+void PXTextureMemoryFrameEnded()
+{
+	_PXTextureMemoryEvictUnused(YES);
+
+	++pxTextureMemoryFrame;
+}
+
+// MARK: -
+// MARK: Private
+// MARK: -
+
+PXInline void _PXTextureMemoryUnlink(PXTextureData *textureData)
+{
+	PXTextureData *prev = textureData->_memoryPrev;
+	PXTextureData *next = textureData->_memoryNext;
+
+	if (prev)
+		prev->_memoryNext = next;
+	else if (pxTextureMemoryHead == textureData)
+		pxTextureMemoryHead = next;
+
+	if (next)
+		next->_memoryPrev = prev;
+	else if (pxTextureMemoryTail == textureData)
+		pxTextureMemoryTail = prev;
+
+	textureData->_memoryPrev = nil;
+	textureData->_memoryNext = nil;
+}
+
+PXInline void _PXTextureMemoryPushFront(PXTextureData *textureData)
+{
+	textureData->_memoryPrev = nil;
+	textureData->_memoryNext = pxTextureMemoryHead;
+
+	if (pxTextureMemoryHead)
+		pxTextureMemoryHead->_memoryPrev = textureData;
+	else
+		pxTextureMemoryTail = textureData;
+
+	pxTextureMemoryHead = textureData;
+}
+
+/*
+ * Releases the pixels of the texture data by giving its GL texture an empty
+ * image. The GL name is kept so anything that refers to it stays valid.
+ */
+PXInline void _PXTextureMemoryEvict(PXTextureData *textureData)
+{
+	PXGLBeginDirect();
+
+	GLuint boundTex = PXGLBoundTexture();
+	PXGLBindTexture(GL_TEXTURE_2D, textureData->_glName);
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, 0, 0, 0, GL_ALPHA, GL_UNSIGNED_BYTE, NULL);
+	}
+	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
+
+	PXGLEndDirect();
+
+	textureData->_isEvicted = YES;
+
+	pxTextureMemoryResidentByteCount -= textureData->_memoryByteCount;
+	--pxTextureMemoryResidentTextureCount;
+
+	++pxTextureMemoryEvictionCount;
+}
+
+PXInline BOOL _PXTextureMemoryReload(PXTextureData *textureData)
+{
+	PXTextureLoader *loader;
+
+	if (textureData->_reloadOriginIsURL)
+	{
+		loader = [[PXTextureLoader alloc] initWithContentsOfURL:[NSURL URLWithString:textureData->_reloadOrigin]
+													   modifier:textureData->_reloadModifier];
+	}
+	else
+	{
+		loader = [[PXTextureLoader alloc] initWithContentsOfFile:textureData->_reloadOrigin
+														modifier:textureData->_reloadModifier];
+	}
+
+	// Bring the mipmaps back only if they were there before
+	loader.generatesMipmaps = textureData->_hasMipmaps;
+
+	BOOL success = [loader _reloadTextureData:textureData];
+
+	[loader release];
+
+	return success;
+}
+
+PXInline void _PXTextureMemoryDispatchEvent(NSString *type, PXTextureData *textureData)
+{
+	if (![pxTextureMemoryEventDispatcher hasEventListenerOfType:type])
+		return;
+
+	PXTextureMemoryEvent *event = [[PXTextureMemoryEvent alloc] initWithType:type
+																 textureData:textureData
+																   byteCount:textureData->_memoryByteCount];
+	[pxTextureMemoryEventDispatcher dispatchEvent:event];
+	[event release];
+}
+
+/*
+ * Walks from the least recently used texture data towards the most recent one,
+ * evicting everything that can be evicted and wasn't used in this frame. When
+ * `stopAtBudget` is set, stops as soon as the resident memory fits in the
+ * budget (and does nothing if there's no budget).
+ */
+void _PXTextureMemoryEvictUnused(BOOL stopAtBudget)
+{
+	if (stopAtBudget && (pxTextureMemoryBudget == 0 || pxTextureMemoryResidentByteCount <= pxTextureMemoryBudget))
+		return;
+
+	// Draw anything that's queued up before its texture goes away
+	PXGLFlush();
+
+	// Events are sent once the walk is done, since listeners could release
+	// texture datas that are still in the list.
+	BOOL hasListeners = [pxTextureMemoryEventDispatcher hasEventListenerOfType:PXTextureMemoryEvent_Evict];
+	NSMutableArray *evicted = hasListeners ? [[NSMutableArray alloc] init] : nil;
+
+	PXTextureData *textureData = pxTextureMemoryTail;
+
+	while (textureData)
+	{
+		if (stopAtBudget && pxTextureMemoryResidentByteCount <= pxTextureMemoryBudget)
+			break;
+
+		if (!textureData->_isEvicted &&
+			textureData->_reloadOrigin &&
+			textureData->_memoryFrame != pxTextureMemoryFrame)
+		{
+			_PXTextureMemoryEvict(textureData);
+			[evicted addObject:textureData];
+		}
+
+		textureData = textureData->_memoryPrev;
+	}
+
+	for (textureData in evicted)
+	{
+		_PXTextureMemoryDispatchEvent(PXTextureMemoryEvent_Evict, textureData);
+	}
+
+	[evicted release];
+}
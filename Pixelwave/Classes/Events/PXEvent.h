@@ -39,6 +39,7 @@
 
 #include "PXSettings.h"
 #include "PXHeaderUtils.h"
+#include "PXEventTypeUtils.h"
 
 #import "PXPooledObject.h"
 
@@ -81,6 +82,8 @@ typedef enum
 	// The object on which dispatchEvent() was called.
 	id _target;
 	NSString *_type;
+	// The interned form of _type, which is what listeners are looked up by
+	PXEventTypeID _typeID;
 
 	// These 2 change throughout the event flow, depending on who the event is
 	// dispatched on
@@ -102,6 +105,9 @@ typedef enum
 	// These 3 remain constant for the lifetime of the event
 	BOOL _bubbles;
 	BOOL _cancelable;
+
+	// The next unused event while this one sits in its class's freelist
+	PXEvent *_poolNext;
 }
 
 /**
@@ -159,3 +165,11 @@ typedef enum
 + (id) eventWithType:(NSString *)type bubbles:(BOOL)bubbles cancelable:(BOOL)cancelable;
 
 @end
+
+@interface PXEvent(PrivateButPublic)
++ (id) _newPooledEventWithType:(NSString *)type bubbles:(BOOL)bubbles cancelable:(BOOL)cancelable;
+- (void) _releaseToPool;
+@end
+
+PXExtern id _PXEventPoolDequeue(Class eventClass);
+PXExtern BOOL _PXEventPoolEnqueue(PXEvent *event);
@@ -45,6 +45,9 @@
 #import "PXDebugUtils.h"
 #import "PXDebug.h"
 
+#include <pthread.h>
+#include <libkern/OSAtomic.h>
+
 NSString * const PXEvent_EnterFrame = @"enterFrame";
 NSString * const PXEvent_Added = @"added";
 NSString * const PXEvent_Removed = @"removed";
@@ -53,6 +56,25 @@ NSString * const PXEvent_RemovedFromStage = @"removedFromStage";
 NSString * const PXEvent_Render = @"render";
 NSString * const PXEvent_SoundComplete = @"soundComplete";
 
+// How many unused events of each class are kept around. Every finger on the
+// screen makes an event or two per frame.
+#define PX_EVENT_POOL_MAX_COUNT 32
+// How many event classes can have a freelist
+#define PX_EVENT_POOL_MAX_CLASS_COUNT 8
+
+typedef struct
+{
+	Class eventClass;
+	PXEvent * volatile head;
+	volatile int32_t count;
+} _PXEventFreeList;
+
+// Entries are only ever appended, and only by the main thread.
+_PXEventFreeList pxEventFreeLists[PX_EVENT_POOL_MAX_CLASS_COUNT];
+volatile int32_t pxEventFreeListCount = 0;
+
+_PXEventFreeList *PXEventFreeListFind(Class eventClass, bool create);
+
 @interface PXEvent(Private)
 - (void) setType:(NSString *)type;
 @end
@@ -156,7 +178,7 @@ NSString * const PXEvent_SoundComplete = @"soundComplete";
 
 - (id) copyWithZone:(NSZone *)zone
 {
-	PXEvent *e = [[[self class] allocWithZone:zone] initWithType:_type bubbles:_bubbles cancelable:_cancelable];
+	PXEvent *e = [[self class] _newPooledEventWithType:_type bubbles:_bubbles cancelable:_cancelable];
 	e->_currentTarget = _currentTarget;
 	e->_target = _target;
 	e->_eventPhase = _eventPhase;
@@ -181,7 +203,8 @@ NSString * const PXEvent_SoundComplete = @"soundComplete";
 
 - (void) reset
 {
-	[self setType:nil];
+	// The type is kept, it's replaced when the event is taken out of the pool
+	// again, and only released in dealloc.
 
 	_bubbles = NO;
 	_cancelable = NO;
@@ -198,9 +221,17 @@ NSString * const PXEvent_SoundComplete = @"soundComplete";
 
 - (void) setType:(NSString *)type
 {
+	// Event types are almost always constants, and a pooled event keeps its
+	// type while it's in the pool, so it tends to get the same string back
+	// when it's reused; its interned ID can then be kept too.
+	if (type == _type)
+		return;
+
 	NSString *copy = [type copy];
 	[_type release];
 	_type = copy;
+
+	_typeID = PXEventTypeIntern(_type);
 }
 
 /**
@@ -280,3 +311,153 @@ NSString * const PXEvent_SoundComplete = @"soundComplete";
 }
 
 @end
+
+@implementation PXEvent(PrivateButPublic)
+
+// MARK: Pooling
+
+/*
+ * Returns a retained event of the given properties, reusing one from the
+ * class's freelist if one is available. Events made this way should be handed
+ * back with _releaseToPool once they have been dispatched.
+ */
++ (id) _newPooledEventWithType:(NSString *)type bubbles:(BOOL)bubbles cancelable:(BOOL)cancelable
+{
+	if (!type)
+	{
+		PXThrowNilParam(type);
+		return nil;
+	}
+
+	PXEvent *event = _PXEventPoolDequeue(self);
+
+	if (!event)
+	{
+		return [[self alloc] initWithType:type bubbles:bubbles cancelable:cancelable];
+	}
+
+	[event setType:type];
+	event->_bubbles = bubbles;
+	event->_cancelable = cancelable;
+
+	return event;
+}
+
+/*
+ * Gives up the caller's ownership of the event, putting it back in its class's
+ * freelist if nobody else has a hold of it.
+ */
+- (void) _releaseToPool
+{
+	// A listener held onto the event. Reusing it would change it under the
+	// listener's feet, so it is left to be deallocated normally instead.
+	if ([self retainCount] > 1)
+	{
+		PXDebugLog(@"PXEvent: %@ was retained by a listener after being dispatched and can't be reused. Events are recycled by the engine, keep a copy of them instead.", self);
+
+		[self release];
+		return;
+	}
+
+	[self reset];
+
+	if (!_PXEventPoolEnqueue(self))
+	{
+		[self release];
+	}
+}
+
+@end
+
+// MARK: Freelists
+
+/*
+ * Each freelist is a stack linked through _poolNext. Events may be put back
+ * from any thread, but are only taken out on the main thread. With a single
+ * thread popping, the head can't be popped and pushed back between reading it
+ * and swapping it out, so a plain compare and swap is safe without a lock.
+ */
+
+_PXEventFreeList *PXEventFreeListFind(Class eventClass, bool create)
+{
+	int32_t count = pxEventFreeListCount;
+	_PXEventFreeList *list = pxEventFreeLists;
+	_PXEventFreeList *end = pxEventFreeLists + count;
+
+	for (; list < end; ++list)
+	{
+		if (list->eventClass == eventClass)
+			return list;
+	}
+
+	if (!create || count >= PX_EVENT_POOL_MAX_CLASS_COUNT)
+		return NULL;
+
+	list->eventClass = eventClass;
+	list->head = nil;
+	list->count = 0;
+
+	// Publish the new list only once it's filled in
+	OSAtomicIncrement32Barrier(&pxEventFreeListCount);
+
+	return list;
+}
+
+/*
+ * Takes an unused event out of the freelist of the given class. Returns nil
+ * when the freelist is empty, or when not called on the main thread.
+ */
+id _PXEventPoolDequeue(Class eventClass)
+{
+	if (!pthread_main_np())
+		return nil;
+
+	_PXEventFreeList *list = PXEventFreeListFind(eventClass, true);
+
+	if (!list)
+		return nil;
+
+	PXEvent *head;
+
+	do
+	{
+		head = list->head;
+
+		if (!head)
+			return nil;
+	} while (!OSAtomicCompareAndSwapPtrBarrier(head, head->_poolNext, (void * volatile *)&list->head));
+
+	OSAtomicDecrement32Barrier(&list->count);
+
+	head->_poolNext = nil;
+	return head;
+}
+
+/*
+ * Puts an unused, already reset event into the freelist of its class, taking
+ * over the caller's retain. Returns NO if the event wasn't taken, either
+ * because its class was never pooled or because the freelist is full.
+ */
+BOOL _PXEventPoolEnqueue(PXEvent *event)
+{
+	_PXEventFreeList *list = PXEventFreeListFind([event class], false);
+
+	if (!list)
+		return NO;
+
+	if (OSAtomicIncrement32Barrier(&list->count) > PX_EVENT_POOL_MAX_COUNT)
+	{
+		OSAtomicDecrement32Barrier(&list->count);
+		return NO;
+	}
+
+	PXEvent *head;
+
+	do
+	{
+		head = list->head;
+		event->_poolNext = head;
+	} while (!OSAtomicCompareAndSwapPtrBarrier(head, event, (void * volatile *)&list->head));
+
+	return YES;
+}
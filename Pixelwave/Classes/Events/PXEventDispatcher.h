@@ -184,16 +184,16 @@
 // Event Dispatcher
 //
 
-// TODO Later: Keep all the capture phase listeners in a separate
-// dictionary instead of doing string contcatenation with the keys
-// of a single dictionary.
-
 @interface PXEventDispatcher : NSObject <PXEventDispatcher>
 {
 @private
 	id<PXEventDispatcher> target;
 
-	NSMutableDictionary *eventListeners;
+	// One slot per event type with listeners, each holding the capture and
+	// the target/bubbling phase listeners of that type.
+	struct _PXEventListenerSlot *listenerSlots;
+	unsigned short listenerSlotCount;
+	unsigned short listenerSlotCapacity;
 
 	BOOL dispatchEvents;
 }
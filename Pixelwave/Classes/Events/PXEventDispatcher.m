@@ -47,6 +47,7 @@
 #import "PXObjectPool.h"
 
 #import "PXExceptionUtils.h"
+#import "PXEventTypeUtils.h"
 
 // DELETE
 #import "PXTouchEvent.h"
@@ -54,9 +55,19 @@
 // More info about the Event Flow:
 // http://livedocs.adobe.com/flex/3/html/help.html?content=events_08.html#203937
 
-// This string gets tagged at the end of capture event dictionary keys
-#define PX_CAPTURE_STRING @"_CAP_"
-#define PX_GET_EVENT_CAPTURE_KEY(_type_) [NSString stringWithFormat:@"%@%@", (_type_), PX_CAPTURE_STRING]
+// Which of a slot's lists the listeners of a phase are kept in
+#define PX_EVENT_LISTENERS_INDEX(_useCapture_) ((_useCapture_) ? 1 : 0)
+
+typedef struct _PXEventListenerSlot
+{
+	PXEventTypeID typeID;
+	// Target/bubbling phase listeners first, then capture phase listeners.
+	// Either one is nil when there are no listeners for it.
+	PXLinkedList *listeners[2];
+} _PXEventListenerSlot;
+
+PXInline _PXEventListenerSlot *PXEventListenerSlotFind(_PXEventListenerSlot *slots, unsigned short count, PXEventTypeID typeID);
+void PXEventListenerSlotsRelease(_PXEventListenerSlot *slots, unsigned short count);
 
 PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *list);
 
@@ -137,10 +148,11 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 - (void) dealloc
 {
 	// Remove all my event listeners
-	if (eventListeners)
+	if (listenerSlots)
 	{
-		[eventListeners release];
-		eventListeners = nil;
+		PXEventListenerSlotsRelease(listenerSlots, listenerSlotCount);
+		free(listenerSlots);
+		listenerSlots = NULL;
 	}
 
 	[super dealloc];
@@ -203,27 +215,37 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 		return NO;
 	}
 
-	if (!eventListeners)
-	{
-		// Initialize the dictionary
-		eventListeners = [[NSMutableDictionary alloc] init];
-	}
+	PXEventTypeID typeID = PXEventTypeIntern(type);
 
-	// The capture phase events are stored in a different array
-	if (useCapture)
+	// Find the slot for this type. If it doesn't exist, create it
+	_PXEventListenerSlot *slot = PXEventListenerSlotFind(listenerSlots, listenerSlotCount, typeID);
+	if (!slot)
 	{
-		type = PX_GET_EVENT_CAPTURE_KEY(type);
+		if (listenerSlotCount >= listenerSlotCapacity)
+		{
+			// Most objects only ever listen to a couple of types
+			listenerSlotCapacity = listenerSlotCapacity ? listenerSlotCapacity << 1 : 2;
+			listenerSlots = realloc(listenerSlots, sizeof(_PXEventListenerSlot) * listenerSlotCapacity);
+		}
+
+		slot = &listenerSlots[listenerSlotCount];
+		++listenerSlotCount;
+
+		slot->typeID = typeID;
+		slot->listeners[0] = nil;
+		slot->listeners[1] = nil;
 	}
 
-	// Get the array of event listeners. If it doesn't exist, create it
-	PXLinkedList *listenersArray = [eventListeners valueForKey:type];
-	if (!listenersArray)
+	// The capture phase events are stored in a different list. If it doesn't
+	// exist, create it
+	PXLinkedList **listenersPtr = &slot->listeners[PX_EVENT_LISTENERS_INDEX(useCapture)];
+	if (!*listenersPtr)
 	{
-		listenersArray = [[PXLinkedList alloc] initWithPooledNodes:PX_LINKED_LISTS_USE_POOLED_NODES];
-		[eventListeners setValue:listenersArray forKey:type];
-		[listenersArray release];
+		*listenersPtr = [[PXLinkedList alloc] initWithPooledNodes:PX_LINKED_LISTS_USE_POOLED_NODES];
 	}
 
+	PXLinkedList *listenersArray = *listenersPtr;
+
 	// If there is already an identical listener (ie with the exact same
 	// function), don't do anything.  Similar behavior seen (but not officially
 	// documented) in the Flash player
@@ -306,17 +328,18 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 	}
 
 	// Can't remove an event listeners if there aren't any
-	if (!eventListeners)
+	if (listenerSlotCount == 0)
 		return NO;
 
-	if (useCapture)
-	{
-		type = PX_GET_EVENT_CAPTURE_KEY(type);
-	}
-
-	PXLinkedList *listenersArray = [eventListeners valueForKey:type];
+	_PXEventListenerSlot *slot = PXEventListenerSlotFind(listenerSlots, listenerSlotCount, PXEventTypeFind(type));
 
 	// Can't remove an event listener if there aren't any for that type
+	if (!slot)
+		return NO;
+
+	PXLinkedList **listenersPtr = &slot->listeners[PX_EVENT_LISTENERS_INDEX(useCapture)];
+	PXLinkedList *listenersArray = *listenersPtr;
+
 	if (!listenersArray)
 		return NO;
 
@@ -330,17 +353,19 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 
 	[listenersArray removeObject:realListener];
 
-	// If the array is empty now, dispose of it
+	// If the list is empty now, dispose of it
 	if ([listenersArray count] <= 0)
 	{
-		[eventListeners removeObjectForKey:type];
+		[listenersArray release];
+		*listenersPtr = nil;
 	}
 
-	// If the dictionary is empty, get rid of it
-	if ([eventListeners count] <= 0)
+	// If neither phase has listeners left, give up the slot. The last slot
+	// takes its place, order doesn't matter.
+	if (!slot->listeners[0] && !slot->listeners[1])
 	{
-		[eventListeners release];
-		eventListeners = nil;
+		--listenerSlotCount;
+		*slot = listenerSlots[listenerSlotCount];
 	}
 
 	return YES;
@@ -355,8 +380,15 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
  */
 - (void) removeAllEventListeners
 {
-	[eventListeners release];
-	eventListeners = nil;
+	if (listenerSlots)
+	{
+		PXEventListenerSlotsRelease(listenerSlots, listenerSlotCount);
+		free(listenerSlots);
+		listenerSlots = NULL;
+	}
+
+	listenerSlotCount = 0;
+	listenerSlotCapacity = 0;
 
 	/*if (!eventListeners)
 	{
@@ -428,18 +460,11 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 		return NO;
 	}
 
-	if (!eventListeners)
+	if (listenerSlotCount == 0)
 		return NO;
 
-	// Check the non-capture phase
-	if ([eventListeners valueForKey:type] != nil)
-		return YES;
-
-	// Check the capture phase
-	if ([eventListeners valueForKey:PX_GET_EVENT_CAPTURE_KEY(type)] != nil)
-		return YES;
-
-	return NO;
+	// Slots are only kept while they have listeners in one of the phases
+	return PXEventListenerSlotFind(listenerSlots, listenerSlotCount, PXEventTypeFind(type)) != NULL;
 }
 
 /**
@@ -518,7 +543,9 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 	// dispatch that.
 	// This behavior is kind of documented in the Event.clone() Flash API
 	// description.
-	if (event->_isBeingDispatched)
+	BOOL isCopy = event->_isBeingDispatched;
+
+	if (isCopy)
 		event = [event copy];
 	else
 		[event retain];
@@ -553,8 +580,11 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 	event->_isBeingDispatched = NO;
 	BOOL defaultPrevented = event->_defaultPrevented;
 
-	// Release the event
-	[event release];
+	// Release the event. A copy is ours alone, so it can go back to the pool.
+	if (isCopy)
+		[event _releaseToPool];
+	else
+		[event release];
 
 	return !defaultPrevented;
 }
@@ -569,23 +599,23 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 - (void) _invokeEvent:(PXEvent *)event withCurrentTarget:(id)currentTarget eventPhase:(char)phase
 {
 	// No reason to dispatch events if there are no event listeners
-	if (!eventListeners)
+	if (listenerSlotCount == 0)
 		return;            // YES;
 
-	NSString *type = event.type;
+	PXEventTypeID typeID = event->_typeID;
 
-	if (type == nil)
+	if (typeID == PXEventTypeNone)
 	{
 		return;
 	}
 
-	// If in the capture phase, only invoke the capture phase listeners
-	if (phase == PXEventPhase_Capture)
-	{
-		type = PX_GET_EVENT_CAPTURE_KEY(type);
-	}
+	_PXEventListenerSlot *slot = PXEventListenerSlotFind(listenerSlots, listenerSlotCount, typeID);
 
-	PXLinkedList *listeners = [eventListeners valueForKey:type];
+	if (!slot)
+		return;
+
+	// If in the capture phase, only invoke the capture phase listeners
+	PXLinkedList *listeners = slot->listeners[PX_EVENT_LISTENERS_INDEX(phase == PXEventPhase_Capture)];
 
 	// There's no reason to try to dispatch an event if no one is listening to
 	// the event's type.
@@ -651,6 +681,32 @@ PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *l
 @end
 
 //Private//
+PXInline _PXEventListenerSlot *PXEventListenerSlotFind(_PXEventListenerSlot *slots, unsigned short count, PXEventTypeID typeID)
+{
+	_PXEventListenerSlot *slot = slots;
+	_PXEventListenerSlot *end = slots + count;
+
+	for (; slot < end; ++slot)
+	{
+		if (slot->typeID == typeID)
+			return slot;
+	}
+
+	return NULL;
+}
+
+void PXEventListenerSlotsRelease(_PXEventListenerSlot *slots, unsigned short count)
+{
+	_PXEventListenerSlot *slot = slots;
+	_PXEventListenerSlot *end = slots + count;
+
+	for (; slot < end; ++slot)
+	{
+		[slot->listeners[0] release];
+		[slot->listeners[1] release];
+	}
+}
+
 // Matches the passed listener object with each one in the array to see if their
 // properties are equal
 PXEventListener *PXGetSimilarListener(PXEventListener *listener, PXLinkedList *list)
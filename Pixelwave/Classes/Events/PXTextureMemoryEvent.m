@@ -0,0 +1,129 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXTextureMemoryEvent.h"
+
+#import "PXTextureData.h"
+
+#include "PXPrivateUtils.h"
+
+NSString * const PXTextureMemoryEvent_Evict = @"textureEvict";
+NSString * const PXTextureMemoryEvent_Reload = @"textureReload";
+NSString * const PXTextureMemoryEvent_ReloadError = @"textureReloadError";
+
+/**
+ * Dispatched by [PXTextureMemory eventDispatcher] whenever a texture data is
+ * evicted from texture memory to stay within the budget, or is reloaded from
+ * its origin because it was about to be drawn.
+ *
+ * Reload events are dispatched while the stage is being rendered, so
+ * listeners shouldn't change the display list.
+ *
+ * @see PXTextureMemory
+ */
+@implementation PXTextureMemoryEvent
+
+@synthesize textureData;
+@synthesize byteCount;
+
+/**
+ * Creates a texture memory event.
+ *
+ * @param type A string representing the type of the event.
+ * @param textureData The texture data that was evicted or reloaded.
+ * @param byteCount The amount of texture memory the texture data takes up
+ * when resident.
+ */
+- (id) initWithType:(NSString *)type
+		textureData:(PXTextureData *)_textureData
+		  byteCount:(unsigned)_byteCount
+{
+	self = [super initWithType:type bubbles:NO cancelable:NO];
+
+	if (self)
+	{
+		textureData = [_textureData retain];
+		byteCount = _byteCount;
+	}
+
+	return self;
+}
+
+- (void) dealloc
+{
+	[textureData release];
+	textureData = nil;
+
+	[super dealloc];
+}
+
+// MARK: NSObject overrides
+
+- (id) copyWithZone:(NSZone *)zone
+{
+	PXTextureMemoryEvent *event = [super copyWithZone:zone];
+
+	event->textureData = [textureData retain];
+	event->byteCount = byteCount;
+
+	return event;
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"[Event type=\"%@\" bubbles=%@ cancelable=%@ textureData=%@ byteCount=%u]",
+			_type,
+			PX_BOOL_TO_STRING(_bubbles),
+			PX_BOOL_TO_STRING(_cancelable),
+			textureData,
+			byteCount];
+}
+
+// MARK: Pooled Reset
+
+- (void) reset
+{
+	[super reset];
+
+	[textureData release];
+	textureData = nil;
+	byteCount = 0;
+}
+
+@end
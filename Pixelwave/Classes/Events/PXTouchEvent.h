@@ -122,3 +122,11 @@ PXExtern NSString * const PXTouchEvent_TouchCancel;
 			 stageY:(float)stageY
 		   tapCount:(unsigned)tapCount;
 @end
+
+@interface PXTouchEvent(PrivateButPublic)
++ (id) _newPooledEventWithType:(NSString *)type
+				   nativeTouch:(UITouch *)touch
+						stageX:(float)stageX
+						stageY:(float)stageY
+					  tapCount:(unsigned)tapCount;
+@end
@@ -112,7 +112,7 @@ NSString * const PXTouchEvent_TouchCancel = @"touchCancel";
 
 - (id) copyWithZone:(NSZone *)zone
 {
-	PXEvent *event = [[[self class] allocWithZone:zone] initWithType:_type nativeTouch:_nativeTouch stageX:_stageX stageY:_stageY tapCount:_tapCount];
+	PXEvent *event = [[self class] _newPooledEventWithType:_type nativeTouch:_nativeTouch stageX:_stageX stageY:_stageY tapCount:_tapCount];
 	event->_currentTarget = _currentTarget;
 	event->_target = _target;
 	event->_eventPhase = _eventPhase;
@@ -211,3 +211,31 @@ NSString * const PXTouchEvent_TouchCancel = @"touchCancel";
 }
 
 @end
+
+@implementation PXTouchEvent(PrivateButPublic)
+
+/*
+ * Returns a retained touch event, reusing one from the freelist if one is
+ * available. Hand it back with _releaseToPool once it has been dispatched.
+ */
++ (id) _newPooledEventWithType:(NSString *)type
+				   nativeTouch:(UITouch *)touch
+						stageX:(float)stageX
+						stageY:(float)stageY
+					  tapCount:(unsigned)tapCount
+{
+	PXTouchEvent *event = [self _newPooledEventWithType:type bubbles:YES cancelable:NO];
+
+	if (event)
+	{
+		[event setNativeTouch:touch];
+
+		event->_stageX = stageX;
+		event->_stageY = stageY;
+		event->_tapCount = tapCount;
+	}
+
+	return event;
+}
+
+@end
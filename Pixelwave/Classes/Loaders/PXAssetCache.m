@@ -0,0 +1,478 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXAssetCache.h"
+
+#import "PXLoader.h"
+#import "PXTextureLoader.h"
+#import "PXSoundLoader.h"
+#import "PXTextureData.h"
+#import "PXSound.h"
+
+#include "PXPrivateUtils.h"
+
+#include <pthread.h>
+
+typedef id (*_PXAssetCacheLoadFunction)(NSString *path, NSURL *url, id modifier);
+
+// Implemented by the built in modifiers, describes the modifier's class and
+// parameters so that equal modifiers share their assets.
+@protocol _PXAssetCacheKeyedModifier
+- (NSString *)_assetCacheKey;
+@end
+
+@interface _PXAssetCacheEntry : NSObject
+{
+@public
+	// Weakly referenced, the object takes itself out of the cache when it's
+	// deallocated.
+	id object;
+	// Retained so its address (which is part of the key of modifiers that
+	// don't describe themselves) can't be reused by a different modifier while
+	// the entry exists.
+	id modifier;
+	// Another thread is loading the object.
+	BOOL isLoading;
+}
+@end
+
+@implementation _PXAssetCacheEntry
+
+- (void) dealloc
+{
+	[modifier release];
+	modifier = nil;
+
+	[super dealloc];
+}
+
+@end
+
+BOOL pxAssetCacheEnabled = YES;
+
+unsigned pxAssetCacheHitCount = 0;
+unsigned pxAssetCacheMissCount = 0;
+
+// Key -> _PXAssetCacheEntry
+NSMutableDictionary *pxAssetCacheEntries = nil;				//Strongly referenced
+// Object -> Key, the object isn't retained
+CFMutableDictionaryRef pxAssetCacheKeys = NULL;
+
+pthread_mutex_t pxAssetCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+// Signaled whenever a load finishes
+pthread_cond_t pxAssetCacheLoadCondition = PTHREAD_COND_INITIALIZER;
+
+id _PXAssetCacheGet(NSString *type, NSString *location, NSString *path, NSURL *url, id modifier, _PXAssetCacheLoadFunction load);
+
+PXInline id _PXAssetCacheNewTextureData(NSString *path, NSURL *url, id modifier);
+PXInline id _PXAssetCacheNewSound(NSString *path, NSURL *url, id modifier);
+
+/**
+ * A process wide cache of the assets loaded through the
+ * [PXTextureData textureDataWithContentsOfFile:] and
+ * [PXSound soundWithContentsOfFile:] families of methods.
+ *
+ * Assets are looked up by their resolved location (the absolute path of the
+ * file that would actually be loaded, after the extension and retina
+ * resolution done by the loaders, or the absolute string of the URL) and the
+ * modifier they're loaded with. The built in modifiers are compared by their
+ * class and parameters, so two equal modifiers share the same assets; any
+ * other modifier is compared by identity. As long as an asset is alive,
+ * loading it again returns the same object instead of reading and decoding
+ * the file again.
+ *
+ * The cache only holds weak references, so it never keeps an asset alive by
+ * itself. If several threads ask for the same asset at once, it's only loaded
+ * by the first one; the others wait for it and share the result.
+ *
+ * Since cached assets are shared, they shouldn't be changed in place. Drawing
+ * into a cached PXTextureData takes it out of the cache, so later loads get
+ * the original pixels, but everything already sharing it sees the change. Use
+ * a PXTextureLoader or PXSoundLoader to get an asset of your own. Cached assets may be released on
+ * any thread; an asset is taken out of the cache before it's deallocated, so a
+ * lookup on another thread never hands it out.
+ *
+ * @see PXTextureLoader
+ * @see PXSoundLoader
+ */
+@implementation PXAssetCache
+
+- (id) init
+{
+	PXDebugLog(@"PXAssetCache can't be instantiated, use its class methods instead");
+	[self release];
+	return nil;
+}
+
+/**
+ * Sets whether assets are shared through the cache. When disabled, every
+ * request loads a new asset.
+ *
+ * **Default:** YES
+ */
++ (void) setEnabled:(BOOL)enabled
+{
+	pxAssetCacheEnabled = enabled;
+}
+
+/**
+ * Whether assets are shared through the cache.
+ */
++ (BOOL) isEnabled
+{
+	return pxAssetCacheEnabled;
+}
+
+/**
+ * The amount of live assets in the cache.
+ */
++ (unsigned) assetCount
+{
+	pthread_mutex_lock(&pxAssetCacheMutex);
+	unsigned count = pxAssetCacheKeys ? CFDictionaryGetCount(pxAssetCacheKeys) : 0;
+	pthread_mutex_unlock(&pxAssetCacheMutex);
+
+	return count;
+}
+
+/**
+ * The amount of requests that were handed an asset which was already loaded,
+ * or being loaded.
+ */
++ (unsigned) hitCount
+{
+	return pxAssetCacheHitCount;
+}
+
+/**
+ * The amount of requests that had to load their asset.
+ */
++ (unsigned) missCount
+{
+	return pxAssetCacheMissCount;
+}
+
+/**
+ * Returns the texture data loaded from the given file with the given
+ * modifier, loading it only if it isn't already alive.
+ *
+ * @param path The path of the image to load, as given to PXTextureLoader.
+ * @param modifier The modifier to load the image with, or `nil`.
+ *
+ * @return The shared, `autoreleased`, PXTextureData object, or `nil` if it
+ * couldn't be loaded.
+ */
++ (PXTextureData *)textureDataWithContentsOfFile:(NSString *)path modifier:(id<PXTextureModifier>)modifier
+{
+	if (!path)
+		return nil;
+
+	// Resolve the path the same way the loader will
+	NSString *resolvedPath = [PXTextureLoader resolvePathForImageFile:path];
+
+	if (!resolvedPath)
+		resolvedPath = path;
+
+	float scaleFactor;
+	resolvedPath = [PXLoader pathForRetinaVersionOfFile:resolvedPath retScale:&scaleFactor];
+
+	return _PXAssetCacheGet(@"texture", [PXLoader absolutePathFromPath:resolvedPath], path, nil, modifier, _PXAssetCacheNewTextureData);
+}
+
+/**
+ * Returns the texture data loaded from the given url with the given modifier,
+ * loading it only if it isn't already alive.
+ *
+ * @param url The url of the image to load.
+ * @param modifier The modifier to load the image with, or `nil`.
+ *
+ * @return The shared, `autoreleased`, PXTextureData object, or `nil` if it
+ * couldn't be loaded.
+ */
++ (PXTextureData *)textureDataWithContentsOfURL:(NSURL *)url modifier:(id<PXTextureModifier>)modifier
+{
+	if (!url)
+		return nil;
+
+	return _PXAssetCacheGet(@"texture", [url absoluteString], nil, url, modifier, _PXAssetCacheNewTextureData);
+}
+
+/**
+ * Returns the sound loaded from the given file with the given modifier,
+ * loading it only if it isn't already alive.
+ *
+ * @param path The path of the sound to load, as given to PXSoundLoader.
+ * @param modifier The modifier to load the sound with, or `nil`.
+ *
+ * @return The shared, `autoreleased`, PXSound object, or `nil` if it couldn't
+ * be loaded.
+ */
++ (PXSound *)soundWithContentsOfFile:(NSString *)path modifier:(id<PXSoundModifier>)modifier
+{
+	if (!path)
+		return nil;
+
+	return _PXAssetCacheGet(@"sound", [PXLoader absolutePathFromPath:path], path, nil, modifier, _PXAssetCacheNewSound);
+}
+
+/**
+ * Returns the sound loaded from the given url with the given modifier,
+ * loading it only if it isn't already alive.
+ *
+ * @param url The url of the sound to load.
+ * @param modifier The modifier to load the sound with, or `nil`.
+ *
+ * @return The shared, `autoreleased`, PXSound object, or `nil` if it couldn't
+ * be loaded.
+ */
++ (PXSound *)soundWithContentsOfURL:(NSURL *)url modifier:(id<PXSoundModifier>)modifier
+{
+	if (!url)
+		return nil;
+
+	return _PXAssetCacheGet(@"sound", [url absoluteString], nil, url, modifier, _PXAssetCacheNewSound);
+}
+
+@end
+
+// MARK: -
+// MARK: Private
+// MARK: -
+
+/*
+ * Returns the live object for the key made from the type, location and
+ * modifier, or loads it with `load` and remembers it. Only one thread loads
+ * any given key at a time; the others wait for its result. The returned object
+ * is autoreleased.
+ */
+id _PXAssetCacheGet(NSString *type, NSString *location, NSString *path, NSURL *url, id modifier, _PXAssetCacheLoadFunction load)
+{
+	// A file that couldn't be located can't be cached, let the loader report
+	// it.
+	if (!location || !pxAssetCacheEnabled)
+	{
+		return [load(path, url, modifier) autorelease];
+	}
+
+	NSString *key = [NSString stringWithFormat:@"%@|%@|%@", type, PXAssetCacheKeyForModifier(modifier), location];
+
+	_PXAssetCacheEntry *entry;
+	id object = nil;
+
+	pthread_mutex_lock(&pxAssetCacheMutex);
+	{
+		if (!pxAssetCacheEntries)
+		{
+			pxAssetCacheEntries = [[NSMutableDictionary alloc] init];
+			pxAssetCacheKeys = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+		}
+
+		while ((entry = [pxAssetCacheEntries objectForKey:key]) && entry->isLoading)
+		{
+			pthread_cond_wait(&pxAssetCacheLoadCondition, &pxAssetCacheMutex);
+		}
+
+		if (entry)
+		{
+			object = [entry->object retain];
+			++pxAssetCacheHitCount;
+		}
+		else
+		{
+			// Claim the key so that other threads wait for this load
+			entry = [[_PXAssetCacheEntry alloc] init];
+			entry->modifier = [modifier retain];
+			entry->isLoading = YES;
+
+			[pxAssetCacheEntries setObject:entry forKey:key];
+			[entry release];
+
+			++pxAssetCacheMissCount;
+		}
+	}
+	pthread_mutex_unlock(&pxAssetCacheMutex);
+
+	if (object)
+	{
+		return [object autorelease];
+	}
+
+	// Load without holding the lock, so other keys can be looked up meanwhile
+	object = load(path, url, modifier);
+
+	pthread_mutex_lock(&pxAssetCacheMutex);
+	{
+		if (object)
+		{
+			entry->object = object;
+			entry->isLoading = NO;
+
+			CFDictionarySetValue(pxAssetCacheKeys, object, key);
+		}
+		else
+		{
+			// Let the next request try again
+			[pxAssetCacheEntries removeObjectForKey:key];
+		}
+
+		pthread_cond_broadcast(&pxAssetCacheLoadCondition);
+	}
+	pthread_mutex_unlock(&pxAssetCacheMutex);
+
+	return [object autorelease];
+}
+
+/*
+ * Returns the part of the cache key describing the modifier. The built in
+ * modifiers describe their class and parameters, anything else is keyed by
+ * its address.
+ */
+NSString *PXAssetCacheKeyForModifier(id modifier)
+{
+	if (!modifier)
+		return @"-";
+
+	if ([modifier respondsToSelector:@selector(_assetCacheKey)])
+		return [(id<_PXAssetCacheKeyedModifier>)modifier _assetCacheKey];
+
+	return [NSString stringWithFormat:@"%p", modifier];
+}
+
+/*
+ * Called by cacheable objects before they're released, so that releasing the
+ * last reference can't race with a lookup retaining the object on another
+ * thread.
+ *
+ * If the release is about to deallocate the object it's taken out of the
+ * cache, and false is returned; the object is then deallocated without
+ * holding the lock. Otherwise, if the object is cached, the lock is kept
+ * until PXAssetCacheDidReleaseObject is called after the release and true is
+ * returned.
+ */
+bool PXAssetCacheWillReleaseObject(id object)
+{
+	if (!pxAssetCacheKeys)
+		return false;
+
+	pthread_mutex_lock(&pxAssetCacheMutex);
+
+	NSString *key = (NSString *)CFDictionaryGetValue(pxAssetCacheKeys, object);
+
+	if (!key)
+	{
+		pthread_mutex_unlock(&pxAssetCacheMutex);
+		return false;
+	}
+
+	if ([object retainCount] == 1)
+	{
+		[pxAssetCacheEntries removeObjectForKey:key];
+		CFDictionaryRemoveValue(pxAssetCacheKeys, object);
+
+		pthread_mutex_unlock(&pxAssetCacheMutex);
+		return false;
+	}
+
+	return true;
+}
+
+void PXAssetCacheDidReleaseObject()
+{
+	pthread_mutex_unlock(&pxAssetCacheMutex);
+}
+
+/*
+ * Called by cacheable objects when they're deallocated, or when their contents
+ * change so they no longer match what loading them again would give. When
+ * deallocating they've normally already been taken out by
+ * PXAssetCacheWillReleaseObject.
+ */
+void PXAssetCacheRemoveObject(id object)
+{
+	if (!pxAssetCacheKeys)
+		return;
+
+	pthread_mutex_lock(&pxAssetCacheMutex);
+	{
+		NSString *key = (NSString *)CFDictionaryGetValue(pxAssetCacheKeys, object);
+
+		if (key)
+		{
+			[pxAssetCacheEntries removeObjectForKey:key];
+			CFDictionaryRemoveValue(pxAssetCacheKeys, object);
+		}
+	}
+	pthread_mutex_unlock(&pxAssetCacheMutex);
+}
+
+PXInline id _PXAssetCacheNewTextureData(NSString *path, NSURL *url, id modifier)
+{
+	PXTextureLoader *loader;
+
+	if (path)
+		loader = [[PXTextureLoader alloc] initWithContentsOfFile:path modifier:modifier];
+	else
+		loader = [[PXTextureLoader alloc] initWithContentsOfURL:url modifier:modifier];
+
+	if (!loader)
+	{
+		PXDebugLog(@"PXTextureData: Couldn't resolve file at path %@", path ? path : [url absoluteString]);
+		return nil;
+	}
+
+	PXTextureData *textureData = [loader newTextureData];
+	[loader release];
+
+	return textureData;
+}
+
+PXInline id _PXAssetCacheNewSound(NSString *path, NSURL *url, id modifier)
+{
+	PXSoundLoader *loader;
+
+	if (path)
+		loader = [[PXSoundLoader alloc] initWithContentsOfFile:path modifier:modifier];
+	else
+		loader = [[PXSoundLoader alloc] initWithContentsOfURL:url modifier:modifier];
+
+	PXSound *sound = [loader newSound];
+	[loader release];
+
+	return sound;
+}
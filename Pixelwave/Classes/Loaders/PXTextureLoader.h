@@ -61,6 +61,14 @@
  * **Default:** `nil`
  */
 @property (nonatomic, retain) id<PXTextureModifier> modifier;
+/**
+ * Whether a full chain of mipmaps is filtered from the loaded image. The
+ * filtering happens here, on the thread the loader is used from, so making
+ * the texture data only has to upload the levels.
+ *
+ * **Default:** [PXTextureData generatesMipmaps]
+ */
+@property (nonatomic) BOOL generatesMipmaps;
 
 //-- ScriptName: TextureLoader
 //-- ScriptArg[0]: required
@@ -108,3 +116,7 @@
 + (PXTextureLoader *)textureLoaderWithContentsOfURL:(NSURL *)url modifier:(id<PXTextureModifier>)modifier;
 
 @end
+
+@interface PXTextureLoader(PrivateButPublic)
+- (BOOL) _reloadTextureData:(PXTextureData *)textureData;
+@end
@@ -304,6 +304,16 @@ id<PXTextureModifier> pxTextureLoaderDefaultModifier = nil;
 	return textureParser.modifier;
 }
 
+- (void) setGeneratesMipmaps:(BOOL)generatesMipmaps
+{
+	textureParser.generatesMipmaps = generatesMipmaps;
+}
+
+- (BOOL) generatesMipmaps
+{
+	return textureParser.generatesMipmaps;
+}
+
 /*
  * Auto-completes the extension of the file if one wasn't provided.
  * This method also checks for a file with the @2x extension in it and returns
@@ -338,7 +348,24 @@ id<PXTextureModifier> pxTextureLoaderDefaultModifier = nil;
  */
 - (PXTextureData *)newTextureData
 {
-	return [textureParser newTextureData];
+	PXTextureData *textureData = [textureParser newTextureData];
+
+	// Lets PXTextureMemory evict the texture data and load it again later
+	[textureData _setReloadOrigin:origin
+							isURL:(originType == PXLoaderOriginType_URL)
+						 modifier:textureParser.modifier];
+
+	return textureData;
+}
+
+/*
+ * Uploads the loaded image into the GL texture of an existing texture data,
+ * rather than making a new one. Used by PXTextureMemory to bring back an
+ * evicted texture data.
+ */
+- (BOOL) _reloadTextureData:(PXTextureData *)textureData
+{
+	return [textureParser _reloadTextureData:textureData];
 }
 
 // MARK: Utility Methods
@@ -0,0 +1,298 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXALADPCMSoundChannel.h"
+
+#import "PXAL.h"
+#import "PXALADPCMSound.h"
+
+#include "PXMathUtils.h"
+
+@interface PXALADPCMSoundChannel(Private)
+- (void) _queueFromFrame:(unsigned)frame;
+- (unsigned) _fillStagingBuffer:(unsigned)index;
+@end
+
+/*
+ * Plays a PXALADPCMSound by decoding it into a ring of
+ * PX_AL_ADPCM_STAGING_BUFFER_COUNT staging buffers. Each time the source
+ * finishes one, it is refilled with the next part of the sound (wrapping
+ * around for loops) and queued again.
+ */
+@implementation PXALADPCMSoundChannel
+
+- (BOOL) _initBuffers
+{
+	PXALADPCMSound *adpcmSound = (PXALADPCMSound *)sound;
+	unsigned frameCount = adpcmSound->_frameCount;
+
+	if (frameCount == 0 || !(adpcmSound->_bytes))
+	{
+		return NO;
+	}
+
+	// Playback always begins at the start of the queue, so there is no
+	// byte offset to seek to.
+	byteOffset = 0;
+	startFrame = 0;
+
+	if (startTime != 0)
+	{
+		float percent = (float)startTime / (float)sound.length;
+		percent = PXMathClamp(percent, 0.0f, 1.0f);
+		startFrame = percent * frameCount;
+
+		if (startFrame >= frameCount)
+		{
+			startFrame = frameCount - 1;
+		}
+	}
+
+	playsLeft = playCount;
+
+	stagingBytes = malloc(PX_AL_ADPCM_STAGING_BUFFER_FRAMES * adpcmSound->_channelCount * sizeof(int16_t));
+
+	if (!stagingBytes)
+	{
+		return NO;
+	}
+
+	alGenBuffers(PX_AL_ADPCM_STAGING_BUFFER_COUNT, stagingNames);
+
+	if ([self errorOccured])
+	{
+		return NO;
+	}
+
+	hasStagingNames = YES;
+
+	[self _queueFromFrame:startFrame];
+
+	return ![self errorOccured];
+}
+
+- (void) _freeBuffers
+{
+	if (_sourceID)
+	{
+		alSourceStop(_sourceID);
+		alSourcei(_sourceID, AL_BUFFER, 0);
+	}
+
+	if (hasStagingNames)
+	{
+		alDeleteBuffers(PX_AL_ADPCM_STAGING_BUFFER_COUNT, stagingNames);
+		hasStagingNames = NO;
+	}
+
+	if (stagingBytes)
+	{
+		free(stagingBytes);
+		stagingBytes = NULL;
+	}
+}
+
+- (void) _queueFromFrame:(unsigned)frame
+{
+	decodeFrame = frame;
+	playedFrames = 0;
+	isDecodeDone = NO;
+
+	unsigned index;
+
+	for (index = 0; index < PX_AL_ADPCM_STAGING_BUFFER_COUNT; ++index)
+	{
+		stagingFrameCounts[index] = 0;
+	}
+
+	for (index = 0; index < PX_AL_ADPCM_STAGING_BUFFER_COUNT; ++index)
+	{
+		if ([self _fillStagingBuffer:index] == 0)
+		{
+			break;
+		}
+
+		alSourceQueueBuffers(_sourceID, 1, stagingNames + index);
+	}
+}
+
+// Decodes the next part of the sound into the given staging buffer, returns
+// the number of frames it now holds.
+- (unsigned) _fillStagingBuffer:(unsigned)index
+{
+	PXALADPCMSound *adpcmSound = (PXALADPCMSound *)sound;
+
+	unsigned channelCount = adpcmSound->_channelCount;
+	unsigned frameCount = adpcmSound->_frameCount;
+
+	unsigned filled = 0;
+	unsigned count;
+
+	while (!isDecodeDone && filled < PX_AL_ADPCM_STAGING_BUFFER_FRAMES)
+	{
+		if (decodeFrame >= frameCount)
+		{
+			// Every loop starts back at the start time.
+			if (loopCount != PX_SOUND_INFINITE_LOOPS)
+			{
+				--playsLeft;
+
+				if (playsLeft <= 0)
+				{
+					isDecodeDone = YES;
+					break;
+				}
+			}
+
+			decodeFrame = startFrame;
+		}
+
+		count = frameCount - decodeFrame;
+
+		if (count > PX_AL_ADPCM_STAGING_BUFFER_FRAMES - filled)
+		{
+			count = PX_AL_ADPCM_STAGING_BUFFER_FRAMES - filled;
+		}
+
+		PXADPCMDecode(adpcmSound->_bytes, channelCount, decodeFrame, count, stagingBytes + filled * channelCount);
+
+		decodeFrame += count;
+		filled += count;
+	}
+
+	stagingFrameCounts[index] = filled;
+
+	if (filled == 0)
+	{
+		return 0;
+	}
+
+	alBufferData(stagingNames[index], sound->_format, stagingBytes, filled * channelCount * sizeof(int16_t), sound->_freq);
+
+	return filled;
+}
+
+- (void) _update
+{
+	ALint processed = 0;
+	alGetSourcei(_sourceID, AL_BUFFERS_PROCESSED, &processed);
+
+	ALuint name;
+	unsigned index;
+
+	for (; processed > 0; --processed)
+	{
+		alSourceUnqueueBuffers(_sourceID, 1, &name);
+
+		for (index = 0; index < PX_AL_ADPCM_STAGING_BUFFER_COUNT; ++index)
+		{
+			if (stagingNames[index] == name)
+			{
+				break;
+			}
+		}
+
+		if (index == PX_AL_ADPCM_STAGING_BUFFER_COUNT)
+		{
+			continue;
+		}
+
+		playedFrames += stagingFrameCounts[index];
+
+		if ([self _fillStagingBuffer:index] > 0)
+		{
+			alSourceQueueBuffers(_sourceID, 1, &name);
+		}
+	}
+
+	ALint queued = 0;
+	alGetSourcei(_sourceID, AL_BUFFERS_QUEUED, &queued);
+
+	if (queued == 0)
+	{
+		if (isDecodeDone)
+		{
+			[self _setDone:YES];
+		}
+
+		return;
+	}
+
+	// If the update came too late the source will have run dry and stopped,
+	// start it back up with the newly queued data.
+	if (soundState == _PXSoundChannelState_Playing)
+	{
+		ALint state;
+		alGetSourcei(_sourceID, AL_SOURCE_STATE, &state);
+
+		if (state == AL_STOPPED)
+		{
+			alSourcePlay(_sourceID);
+		}
+	}
+}
+
+- (void) _rewind
+{
+	alSourceStop(_sourceID);
+	alSourcei(_sourceID, AL_BUFFER, 0);
+
+	[self _queueFromFrame:startFrame];
+}
+
+- (unsigned) position
+{
+	PXALADPCMSound *adpcmSound = (PXALADPCMSound *)sound;
+	unsigned frameCount = adpcmSound->_frameCount;
+
+	if (frameCount == 0)
+	{
+		return 0;
+	}
+
+	ALint sampleOffset = 0;
+	alGetSourcei(_sourceID, AL_SAMPLE_OFFSET, &sampleOffset);
+
+	unsigned loopFrameCount = frameCount - startFrame;
+	unsigned frame = startFrame + ((playedFrames + sampleOffset) % loopFrameCount);
+
+	return ((uint64_t)frame * sound.length) / frameCount;
+}
+
+@end
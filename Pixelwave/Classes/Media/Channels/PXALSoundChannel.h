@@ -46,7 +46,7 @@
 {
 @public
 	unsigned _sourceID;
-@private
+@protected
 	PXALSound *sound;
 
 	unsigned totalProcessed;
@@ -74,3 +74,11 @@
 
 - (void) _updateDistanceModel;
 @end
+
+@interface PXALSoundChannel(Protected)
+- (BOOL) _initBuffers;
+- (void) _freeBuffers;
+
+- (BOOL) errorOccured;
+- (void) _setDone:(BOOL)done;
+@end
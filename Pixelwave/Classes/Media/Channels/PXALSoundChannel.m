@@ -50,11 +50,6 @@
 #import "PXDebugUtils.h"
 #import "PXDebug.h"
 
-@interface PXALSoundChannel(Private)
-- (BOOL) errorOccured;
-- (void) _setDone:(BOOL)done;
-@end
-
 @implementation PXALSoundChannel
 
 - (id) init
@@ -92,45 +87,17 @@
 		}
 
 		playCount = loopCount + 1;
+		byteOffset = 0;
 
-		if (startTime != 0)
-		{
-			float percent = (float)startTime / (float)sound.length;
-			PXMathClamp(percent, 0.0f, 1.0f);
-			byteOffset = percent * sound->_bytesTotal;
-		}
-		else
-			byteOffset = 0;
-
-		if (loopCount == PX_SOUND_INFINITE_LOOPS)
-			bufferCount = 16;
-		else
-			bufferCount = fabsf(playCount);
-		buffers = calloc(bufferCount, sizeof(unsigned));
-
-		if (!buffers)
-		{
-			PXDebugLog (@"SoundChannel error! ID:0x%X - info:'%@'.", AL_OUT_OF_MEMORY, @"out of memory");
-		}
-
-		unsigned index;
-		unsigned *buffer;
-
-		for (index = 0, buffer = buffers; index < bufferCount; ++index, ++buffer)
-			*buffer = sound->_alName;
-
-		alSourceQueueBuffers(_sourceID, bufferCount, buffers);
-
-		if ([self errorOccured])
+		if (![self _initBuffers])
 		{
 			alDeleteSources(1, &_sourceID);
+			_sourceID = 0;
 
 			[self release];
 			return nil;
 		}
 
-		bufferID = 0;
-
 		distanceModel = -1;
 
 		alSourcei(_sourceID, AL_BYTE_OFFSET, byteOffset);
@@ -154,6 +121,62 @@
 	if (_sourceID)
 		[self _stop];
 
+	[self _freeBuffers];
+
+	if (_sourceID)
+	{
+		alDeleteSources(1, &_sourceID);
+	}
+
+	[sound release];
+
+	[super dealloc];
+}
+
+// Queues the sound's buffer once per play, the source then runs through all
+// of the loops on its own.
+- (BOOL) _initBuffers
+{
+	if (startTime != 0)
+	{
+		float percent = (float)startTime / (float)sound.length;
+		PXMathClamp(percent, 0.0f, 1.0f);
+		byteOffset = percent * sound->_bytesTotal;
+	}
+	else
+		byteOffset = 0;
+
+	if (loopCount == PX_SOUND_INFINITE_LOOPS)
+		bufferCount = 16;
+	else
+		bufferCount = fabsf(playCount);
+	buffers = calloc(bufferCount, sizeof(unsigned));
+
+	if (!buffers)
+	{
+		PXDebugLog (@"SoundChannel error! ID:0x%X - info:'%@'.", AL_OUT_OF_MEMORY, @"out of memory");
+	}
+
+	unsigned index;
+	unsigned *buffer;
+
+	for (index = 0, buffer = buffers; index < bufferCount; ++index, ++buffer)
+		*buffer = sound->_alName;
+
+	alSourceQueueBuffers(_sourceID, bufferCount, buffers);
+
+	if ([self errorOccured])
+	{
+		return NO;
+	}
+
+	bufferID = 0;
+
+	return YES;
+}
+
+- (void) _freeBuffers
+{
 	if (buffers)
 	{
 		if (_sourceID && bufferID < bufferCount - 1)
@@ -166,15 +189,6 @@
 
 	buffers = 0;
 	bufferCount = 0;
-
-	if (_sourceID)
-	{
-		alDeleteSources(1, &_sourceID);
-	}
-
-	[sound release];
-
-	[super dealloc];
 }
 
 - (BOOL) errorOccured
@@ -256,9 +270,9 @@
 
 	if (isDone)
 	{
-		PXEvent *event = [[PXEvent alloc] initWithType:PXEvent_SoundComplete bubbles:NO cancelable:NO];
+		PXEvent *event = [PXEvent _newPooledEventWithType:PXEvent_SoundComplete bubbles:NO cancelable:NO];
 		[self dispatchEvent:event];
-		[event release];
+		[event _releaseToPool];
 	}
 }
 
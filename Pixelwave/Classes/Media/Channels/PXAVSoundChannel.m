@@ -105,9 +105,9 @@
 
 	if (isDone)
 	{
-		PXEvent *event = [[PXEvent alloc] initWithType:PXEvent_SoundComplete bubbles:NO cancelable:NO];
+		PXEvent *event = [PXEvent _newPooledEventWithType:PXEvent_SoundComplete bubbles:NO cancelable:NO];
 		[self dispatchEvent:event];
-		[event release];
+		[event _releaseToPool];
 
 		player.delegate = nil;
 		[player release];
@@ -47,6 +47,7 @@
 #import "PXSoundChannel.h"
 #import "PXSoundTransform.h"
 #import "PXSoundLoader.h"
+#import "PXAssetCache.h"
 
 #include "PXSoundModifier.h"
 #import "PXSoundParser.h"
@@ -82,6 +83,25 @@
 	return self;
 }
 
+- (oneway void) release
+{
+	// Cached objects are released under the cache's lock, so a lookup on
+	// another thread can't retain one that's being deallocated.
+	bool locked = PXAssetCacheWillReleaseObject(self);
+
+	[super release];
+
+	if (locked)
+		PXAssetCacheDidReleaseObject();
+}
+
+- (void) dealloc
+{
+	PXAssetCacheRemoveObject(self);
+
+	[super dealloc];
+}
+
 /**
  * Creates a sound using the data given. The data is parsed into a usable
  * format.
@@ -258,11 +278,7 @@
  */
 + (PXSound *)soundWithContentsOfFile:(NSString *)path modifier:(id<PXSoundModifier>)modifier
 {
-	PXSoundLoader *soundLoader = [[PXSoundLoader alloc] initWithContentsOfFile:path modifier:modifier];
-	PXSound *sound = [soundLoader newSound];
-	[soundLoader release];
-
-	return [sound autorelease];
+	return [PXAssetCache soundWithContentsOfFile:path modifier:modifier];
 }
 
 /**
@@ -298,11 +314,7 @@
  */
 + (PXSound *)soundWithContentsOfURL:(NSURL *)url modifier:(id<PXSoundModifier>)modifier
 {
-	PXSoundLoader *soundLoader = [[PXSoundLoader alloc] initWithContentsOfURL:url modifier:modifier];
-	PXSound *sound = [soundLoader newSound];
-	[soundLoader release];
-
-	return [sound autorelease];
+	return [PXAssetCache soundWithContentsOfURL:url modifier:modifier];
 }
 
 /**
@@ -0,0 +1,115 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXALADPCMSound.h"
+
+#import "PXAL.h"
+#import "PXALADPCMSoundChannel.h"
+
+/*
+ * A sound which keeps its samples compressed in memory, at roughly a quarter
+ * of the size of 16 bit PCM. Rather than one AL buffer holding the whole
+ * sound, each channel playing it decodes a little at a time into a small set
+ * of staging buffers queued on its source.
+ *
+ * Made by the sound parser when the sound data has been compressed with
+ * [PXSoundModifiers soundModifierToADPCM].
+ */
+@implementation PXALADPCMSound
+
+- (id) initWithBytes:(const void *)bytes
+		   byteCount:(unsigned)byteCount
+		  frameCount:(unsigned)frameCount
+		   frequency:(int)frequency
+			  length:(unsigned)_length
+		channelCount:(unsigned)channelCount
+{
+	// As far as AL is concerned, this is 16 bit PCM.
+	int format = (channelCount > 1) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+
+	self = [super _initWithFormat:format
+						frequency:frequency
+					   bytesTotal:frameCount * channelCount * sizeof(int16_t)
+						   length:_length
+					 channelCount:channelCount
+					 createBuffer:NO];
+
+	if (self)
+	{
+		_byteCount = byteCount;
+		_frameCount = frameCount;
+
+		_bytes = malloc(byteCount);
+
+		if (!_bytes)
+		{
+			[self release];
+			return nil;
+		}
+
+		memcpy(_bytes, bytes, byteCount);
+	}
+
+	return self;
+}
+
+- (void) dealloc
+{
+	if (_bytes)
+	{
+		free(_bytes);
+		_bytes = NULL;
+	}
+
+	[super dealloc];
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"(%@, compressedBytes=%u)",
+			[super description],
+			_byteCount];
+}
+
+- (Class) _channelClass
+{
+	return [PXALADPCMSoundChannel class];
+}
+
+@end
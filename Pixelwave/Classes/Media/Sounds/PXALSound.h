@@ -57,3 +57,14 @@
 		 channelCount:(unsigned)channelCount;
 
 @end
+
+@interface PXALSound(PrivateButPublic)
+- (id) _initWithFormat:(int)format
+			 frequency:(int)frequency
+			bytesTotal:(int)bytesTotal
+				length:(unsigned)length
+		  channelCount:(unsigned)channelCount
+		  createBuffer:(BOOL)createBuffer;
+
+- (Class) _channelClass;
+@end
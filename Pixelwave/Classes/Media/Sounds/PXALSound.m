@@ -50,6 +50,21 @@
 		   bytesTotal:(int)bytesTotal
 			   length:(unsigned)_length
 		 channelCount:(unsigned)channelCount
+{
+	return [self _initWithFormat:format
+					   frequency:frequency
+					  bytesTotal:bytesTotal
+						  length:_length
+					channelCount:channelCount
+					createBuffer:YES];
+}
+
+- (id) _initWithFormat:(int)format
+			 frequency:(int)frequency
+			bytesTotal:(int)bytesTotal
+				length:(unsigned)_length
+		  channelCount:(unsigned)channelCount
+		  createBuffer:(BOOL)createBuffer
 {
 	self = [super _initWithLength:_length];
 
@@ -60,8 +75,13 @@
 		_format = format;
 		_freq = frequency;
 		_bytesTotal = bytesTotal;
-		alGenBuffers(1, &_alName);
+		_alName = 0;
 		_channelCount = channelCount;
+
+		if (createBuffer)
+		{
+			alGenBuffers(1, &_alName);
+		}
 	}
 
 	return self;
@@ -96,16 +116,21 @@
 	return (_format == AL_FORMAT_MONO8 || _format == AL_FORMAT_MONO16);
 }
 
+- (Class) _channelClass
+{
+	return [PXALSoundChannel class];
+}
+
 - (PXSoundChannel *)playWithStartTime:(unsigned)startTime
 							loopCount:(int)loops
 					   soundTransform:(PXSoundTransform *)soundTransform
 {
 	[super playWithStartTime:startTime loopCount:loops soundTransform:soundTransform];
 
-	PXALSoundChannel *channel = [[PXALSoundChannel alloc] _initWithSound:self
-															   startTime:startTime
-															   loopCount:loops
-														  soundTransform:soundTransform];
+	PXALSoundChannel *channel = [[[self _channelClass] alloc] _initWithSound:self
+															       startTime:startTime
+															       loopCount:loops
+														      soundTransform:soundTransform];
 
 	PXSoundEngineAddSound (channel);
 	[channel release];
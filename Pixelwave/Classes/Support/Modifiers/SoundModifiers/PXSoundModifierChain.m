@@ -0,0 +1,185 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXSoundModifierChain.h"
+
+#import "PXSoundConversionModifier.h"
+#import "PXAssetCache.h"
+
+PXInline PXParsedSoundData *PXSoundModifierChainAdvance(PXParsedSoundData *curSoundData,
+														PXParsedSoundData *origSoundData,
+														PXParsedSoundData *newSoundData);
+
+/**
+ * A PXSoundModifierChain runs several sound modifiers, one after the other,
+ * on the same sound.
+ *
+ * Consecutive built in modifiers (such as the ones made by
+ * #PXSoundModifiers) are fused together and run as a single pass over the
+ * samples, so no intermediate copies of the sound are made.
+ *
+ * **Example:**
+ *	NSArray *list = [NSArray arrayWithObjects:[PXSoundModifiers soundModifierToMono],
+ *	                                          [PXSoundModifiers soundModifierToFrequency:22050],
+ *	                                          [PXSoundModifiers soundModifierTo8Bit],
+ *	                                          nil];
+ *	id<PXSoundModifier> modifier = [PXSoundModifiers soundModifierWithModifiers:list];
+ *	PXSoundLoader *loader = [[PXSoundLoader alloc] initWithContentsOfFile:@"sound.wav" modifier:modifier];
+ */
+@implementation PXSoundModifierChain
+
+@synthesize modifiers;
+
+- (id) init
+{
+	return [self initWithModifiers:nil];
+}
+
+/**
+ * Creates a chain that runs the given modifiers in order.
+ *
+ * @param modifiers A list of objects conforming to the PXSoundModifier
+ * protocol.
+ */
+- (id) initWithModifiers:(NSArray *)_modifiers
+{
+	self = [super init];
+
+	if (self)
+	{
+		modifiers = (_modifiers != nil) ? [_modifiers copy] : [[NSArray alloc] init];
+	}
+
+	return self;
+}
+
+- (void) dealloc
+{
+	[modifiers release];
+	modifiers = nil;
+
+	[super dealloc];
+}
+
+- (PXParsedSoundData *)newModifiedSoundDataFromData:(PXParsedSoundData *)soundData
+{
+	if (!soundData)
+	{
+		return NULL;
+	}
+
+	PXParsedSoundData *curSoundData = soundData;
+	PXSoundConversion conversion = PXSoundConversionMake();
+	BOOL hasConversion = NO;
+
+	for (id<PXSoundModifier> modifier in modifiers)
+	{
+		if ([modifier isKindOfClass:[PXSoundConversionModifier class]])
+		{
+			[(PXSoundConversionModifier *)modifier _appendToConversion:&conversion];
+			hasConversion = YES;
+
+			continue;
+		}
+
+		// A modifier which can't be fused; run what has been gathered so far,
+		// then hand it the result.
+		if (hasConversion)
+		{
+			curSoundData = PXSoundModifierChainAdvance(curSoundData, soundData, PXSoundFormatNewConvertedSoundData(curSoundData, conversion));
+
+			conversion = PXSoundConversionMake();
+			hasConversion = NO;
+		}
+
+		curSoundData = PXSoundModifierChainAdvance(curSoundData, soundData, [modifier newModifiedSoundDataFromData:curSoundData]);
+	}
+
+	if (hasConversion)
+	{
+		curSoundData = PXSoundModifierChainAdvance(curSoundData, soundData, PXSoundFormatNewConvertedSoundData(curSoundData, conversion));
+	}
+
+	// Nothing changed
+	if (curSoundData == soundData)
+	{
+		return NULL;
+	}
+
+	return curSoundData;
+}
+
+// Equal chains of modifiers share their cached assets.
+- (NSString *)_assetCacheKey
+{
+	NSMutableString *key = [NSMutableString stringWithString:NSStringFromClass([self class])];
+
+	[key appendString:@"("];
+
+	for (id<PXSoundModifier> modifier in modifiers)
+	{
+		[key appendString:PXAssetCacheKeyForModifier(modifier)];
+		[key appendString:@","];
+	}
+
+	[key appendString:@")"];
+
+	return key;
+}
+
+@end
+
+PXInline PXParsedSoundData *PXSoundModifierChainAdvance(PXParsedSoundData *curSoundData,
+														PXParsedSoundData *origSoundData,
+														PXParsedSoundData *newSoundData)
+{
+	// The modifier made no change.
+	if (!newSoundData)
+	{
+		return curSoundData;
+	}
+
+	// Intermediate data belongs to the chain, the original never does.
+	if (curSoundData != origSoundData)
+	{
+		PXParsedSoundDataFree(curSoundData);
+	}
+
+	return newSoundData;
+}
@@ -0,0 +1,88 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXSoundModifierResample.h"
+
+#import "PXDebug.h"
+
+@implementation PXSoundModifierResample
+
+@synthesize freq;
+
+- (id) init
+{
+	PXDebugLog(@"PXSoundModifierResample must be instantiated with a frequency");
+
+	[self release];
+	return nil;
+}
+
+/**
+ * Creates a modifier that resamples a sound to the given frequency. When the
+ * source frequency is a multiple of the new one (such as 44100 to 22050) the
+ * source frames are averaged, otherwise they are linearly interpolated.
+ *
+ * @param freq The sample rate, in hertz, to convert the sound to.
+ */
+- (id) initWithFrequency:(int)_freq
+{
+	self = [super init];
+
+	if (self)
+	{
+		freq = _freq;
+	}
+
+	return self;
+}
+
+- (void) _appendToConversion:(PXSoundConversion *)conversion
+{
+	if (freq > 0)
+	{
+		conversion->freq = freq;
+	}
+}
+
+- (NSString *)_assetCacheKey
+{
+	return [NSString stringWithFormat:@"%@(%d)", NSStringFromClass([self class]), freq];
+}
+
+@end
@@ -0,0 +1,114 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXSoundModifierToADPCM.h"
+
+#include "PXSoundFormatUtils.h"
+#include "PXADPCMUtils.h"
+
+@implementation PXSoundModifierToADPCM
+
+- (PXParsedSoundData *)newModifiedSoundDataFromData:(PXParsedSoundData *)oldSoundInfo
+{
+	if (!oldSoundInfo || !(oldSoundInfo->bytes))
+	{
+		return NULL;
+	}
+
+	// Already compressed
+	if (PXSoundFormatIsCompressed(oldSoundInfo->format))
+	{
+		return NULL;
+	}
+
+	// The encoder only reads 16 bit samples.
+	PXParsedSoundData *pcmSoundInfo = oldSoundInfo;
+
+	if (PXSoundFormatGetBitsPerSample(oldSoundInfo->format) != 16)
+	{
+		PXSoundConversion conversion = PXSoundConversionMake();
+		conversion.bitsPerSample = 16;
+
+		pcmSoundInfo = PXSoundFormatNewConvertedSoundData(oldSoundInfo, conversion);
+
+		if (!pcmSoundInfo)
+		{
+			return NULL;
+		}
+	}
+
+	unsigned channelCount = PXSoundFormatGetChannelCount(pcmSoundInfo->format);
+	unsigned frameCount = pcmSoundInfo->byteCount / (channelCount * sizeof(int16_t));
+
+	PXParsedSoundData *newSoundInfo = NULL;
+
+	if (frameCount > 0)
+	{
+		newSoundInfo = PXParsedSoundDataCreatev(PXADPCMGetByteCount(frameCount, channelCount),
+												(channelCount > 1) ? PXSoundFormat_StereoIMA4 : PXSoundFormat_MonoIMA4,
+												pcmSoundInfo->freq,
+												channelCount,
+												pcmSoundInfo->milliseconds);
+
+		if (newSoundInfo && newSoundInfo->bytes)
+		{
+			newSoundInfo->frameCount = frameCount;
+			PXADPCMEncode((const int16_t *)(pcmSoundInfo->bytes), frameCount, channelCount, (uint8_t *)(newSoundInfo->bytes));
+		}
+		else
+		{
+			PXParsedSoundDataFree(newSoundInfo);
+			newSoundInfo = NULL;
+		}
+	}
+
+	if (pcmSoundInfo != oldSoundInfo)
+	{
+		PXParsedSoundDataFree(pcmSoundInfo);
+	}
+
+	return newSoundInfo;
+}
+
+- (NSString *)_assetCacheKey
+{
+	return NSStringFromClass([self class]);
+}
+
+@end
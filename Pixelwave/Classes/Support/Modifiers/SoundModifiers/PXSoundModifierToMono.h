@@ -37,9 +37,9 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
-#import "PXSoundModifier.h"
+#import "PXSoundConversionModifier.h"
 
-@interface PXSoundModifierToMono : NSObject <PXSoundModifier>
+@interface PXSoundModifierToMono : PXSoundConversionModifier
 {
 }
 
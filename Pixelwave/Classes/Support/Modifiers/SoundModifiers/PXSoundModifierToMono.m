@@ -41,103 +41,9 @@
 
 @implementation PXSoundModifierToMono
 
-- (PXParsedSoundData *)newModifiedSoundDataFromData:(PXParsedSoundData *)oldSoundInfo
+- (void) _appendToConversion:(PXSoundConversion *)conversion
 {
-	if (!oldSoundInfo)
-	{
-		return NULL;
-	}
-
-	const unsigned oldByteCount = oldSoundInfo->byteCount;
-
-	const int oldFormat = oldSoundInfo->format;
-	const int oldFreq = oldSoundInfo->freq;
-
-	const unsigned oldChannelCount = oldSoundInfo->channelCount;
-	const unsigned oldMilliseconds = oldSoundInfo->milliseconds;
-
-	// Already mono
-	if (oldFormat == PXSoundFormat_Mono8  ||
-		oldFormat == PXSoundFormat_Mono16 ||
-		oldChannelCount == 1)
-	{
-		return NULL;
-	}
-
-	PXParsedSoundData *newSoundInfo = PXParsedSoundDataCreatev(oldByteCount,
-												 oldFormat,
-												 oldFreq,
-												 oldChannelCount,
-												 oldMilliseconds);
-	memcpy(newSoundInfo->bytes, oldSoundInfo->bytes, oldByteCount);
-
-	unsigned index;
-	unsigned channelIndex;
-
-	// New val exists because if you add up a lot of 8 or 16 bit values, it
-	// will exceed a 8 or 16 bit cap.  It should never exceed 64 bits.
-	SInt64 newVal;
-	float one_channelCount = 1.0f / oldChannelCount;
-
-	unsigned newByteCount = newSoundInfo->byteCount * one_channelCount;
-	unsigned numDataSets = newByteCount * one_channelCount;
-
-	void *memData = newSoundInfo->bytes;
-
-	if (oldFormat == PXSoundFormat_Stereo16)
-	{
-		SInt16 *dataPtr;
-		SInt16 *dataInsertPtr;
-
-		for (index = 0, dataPtr = memData, dataInsertPtr = memData;
-			 index < numDataSets;
-			 ++index, ++dataInsertPtr)
-		{
-			newVal = 0;
-
-			for (channelIndex = 0; channelIndex < oldChannelCount; ++channelIndex, ++dataPtr)
-			{
-				newVal += *dataPtr;
-			}
-			newVal *= one_channelCount;
-
-			*dataInsertPtr = newVal;
-		}
-
-		newSoundInfo->format = PXSoundFormat_Mono16;
-	}
-	else
-	{
-		SInt8 *dataPtr;
-		SInt8 *dataInsertPtr;
-
-		for (index = 0, dataPtr = memData, dataInsertPtr = memData;
-			 index < numDataSets;
-			 ++index, ++dataInsertPtr)
-		{
-			newVal = 0;
-
-			for (channelIndex = 0; channelIndex < oldChannelCount; ++channelIndex, ++dataPtr)
-			{
-				newVal += *dataPtr;
-			}
-			newVal *= one_channelCount;
-
-			*dataInsertPtr = newVal;
-		}
-
-		newSoundInfo->format = PXSoundFormat_Mono8;
-	}
-
-	newSoundInfo->channelCount = 1;
-
-	if (newByteCount != newSoundInfo->byteCount)
-	{
-		newSoundInfo->byteCount = newByteCount;
-		newSoundInfo->bytes = realloc(newSoundInfo->bytes, newSoundInfo->byteCount);
-	}
-
-	return newSoundInfo;
+	conversion->channelCount = 1;
 }
 
 @end
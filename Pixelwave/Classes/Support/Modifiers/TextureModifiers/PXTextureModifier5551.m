@@ -42,6 +42,25 @@
 
 @implementation PXTextureModifier5551
 
+@synthesize dither;
+
+- (id) init
+{
+	return [self initWithDither:PXTextureDither_None];
+}
+
+- (id) initWithDither:(PXTextureDither)_dither
+{
+	self = [super init];
+
+	if (self)
+	{
+		dither = _dither;
+	}
+
+	return self;
+}
+
 - (PXParsedTextureData *)newModifiedTextureDataFromData:(PXParsedTextureData *)oldTextureInfo
 {
 	if (!oldTextureInfo)
@@ -82,20 +101,21 @@
 
 	PXTF_RGBA_5551 *writePixels = (PXTF_RGBA_5551 *)(newTextureInfo->bytes);
 
+	// Reducing from 8 bits per channel is the common case, and the only one
+	// that's dithered.
+	if (PXTextureFormatConvertTo16Bit(oldTextureInfo->bytes, oldPixelFormat, writePixels, PXTextureDataPixelFormat_RGBA5551, width, height, dither))
+	{
+		return newTextureInfo;
+	}
+
 	switch (oldPixelFormat)
 	{
-		case PXTextureDataPixelFormat_RGBA8888:
-			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_RGBA_8888, PXTF_RGBA_5551_From_RGBA_8888);
-			break;
 		case PXTextureDataPixelFormat_RGBA4444:
 			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_RGBA_4444, PXTF_RGBA_5551_From_RGBA_4444);
 			break;
 		case PXTextureDataPixelFormat_RGB565:
 			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_RGB_565, PXTF_RGBA_5551_From_RGB_565);
 			break;
-		case PXTextureDataPixelFormat_RGB888:
-			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_RGB_888, PXTF_RGBA_5551_From_RGB_888);
-			break;
 		case PXTextureDataPixelFormat_LA88:
 			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_LA_88, PXTF_RGBA_5551_From_LA_88);
 			break;
@@ -113,4 +133,9 @@
 	return newTextureInfo;
 }
 
+- (NSString *)_assetCacheKey
+{
+	return [NSString stringWithFormat:@"%@(%d)", NSStringFromClass([self class]), dither];
+}
+
 @end
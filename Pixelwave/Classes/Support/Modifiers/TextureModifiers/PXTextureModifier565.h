@@ -39,9 +39,22 @@
 
 #import "PXTextureModifier.h"
 
+#include "PXTextureDither.h"
+
 @interface PXTextureModifier565 : NSObject<PXTextureModifier>
 {
-
+@protected
+	PXTextureDither dither;
 }
 
+/**
+ * How the bits dropped by the conversion are dithered. Only applies when
+ * converting from RGBA 8888 or RGB 888.
+ *
+ * **Default:** PXTextureDither_None
+ */
+@property (nonatomic) PXTextureDither dither;
+
+- (id) initWithDither:(PXTextureDither)dither;
+
 @end
@@ -43,6 +43,25 @@
 
 @implementation PXTextureModifier565
 
+@synthesize dither;
+
+- (id) init
+{
+	return [self initWithDither:PXTextureDither_None];
+}
+
+- (id) initWithDither:(PXTextureDither)_dither
+{
+	self = [super init];
+
+	if (self)
+	{
+		dither = _dither;
+	}
+
+	return self;
+}
+
 - (PXParsedTextureData *)newModifiedTextureDataFromData:(PXParsedTextureData *)oldTextureInfo
 {
 	if (!oldTextureInfo)
@@ -83,17 +102,18 @@
 
 	PXTF_RGB_565 *writePixels = (PXTF_RGB_565 *)(newTextureInfo->bytes);
 
+	// Reducing from 8 bits per channel is the common case, and the only one
+	// that's dithered.
+	if (PXTextureFormatConvertTo16Bit(oldTextureInfo->bytes, oldPixelFormat, writePixels, PXTextureDataPixelFormat_RGB565, width, height, dither))
+	{
+		return newTextureInfo;
+	}
+
 	switch (oldPixelFormat)
 	{
-		case PXTextureDataPixelFormat_RGBA8888:
-			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_RGBA_8888, PXTF_RGB_565_From_RGBA_8888);
-			break;
 		case PXTextureDataPixelFormat_RGBA4444:
 			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_RGBA_4444, PXTF_RGB_565_From_RGBA_4444);
 			break;
-		case PXTextureDataPixelFormat_RGB888:
-			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_RGB_888, PXTF_RGB_565_From_RGB_888);
-			break;
 		case PXTextureDataPixelFormat_RGBA5551:
 			_PXTextureFormatPixelsCopyWithFunc(oldTextureInfo->bytes, writePixels, pixelCount, PXTF_RGBA_5551, PXTF_RGB_565_From_RGBA_5551);
 			break;
@@ -114,4 +134,9 @@
 	return newTextureInfo;
 }
 
+- (NSString *)_assetCacheKey
+{
+	return [NSString stringWithFormat:@"%@(%d)", NSStringFromClass([self class]), dither];
+}
+
 @end
@@ -114,4 +114,9 @@
 	return newTextureInfo;
 }
 
+- (NSString *)_assetCacheKey
+{
+	return NSStringFromClass([self class]);
+}
+
 @end
@@ -115,4 +115,9 @@
 	return newTextureInfo;
 }
 
+- (NSString *)_assetCacheKey
+{
+	return NSStringFromClass([self class]);
+}
+
 @end
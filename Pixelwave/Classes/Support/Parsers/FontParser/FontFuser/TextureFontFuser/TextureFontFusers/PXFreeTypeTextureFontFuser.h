@@ -38,10 +38,11 @@
  */
 
 #import "PXTextureFontFuser.h"
+#import "PXDynamicTextureFont.h"
 
 @class PXTextureData;
 
-@interface PXFreeTypeTextureFontFuser : PXTextureFontFuser<PXFontFuser>
+@interface PXFreeTypeTextureFontFuser : PXTextureFontFuser<PXFontFuser, PXTextureGlyphRasterizer>
 {
 @protected
 	PXTextureData *textureData;
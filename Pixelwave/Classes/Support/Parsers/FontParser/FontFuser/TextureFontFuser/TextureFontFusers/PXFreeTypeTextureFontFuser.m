@@ -45,6 +45,7 @@
 #import "PXTextureModifier.h"
 
 #import "PXTextureFontFuserUtils.h"
+#include "PXDistanceFieldUtils.h"
 
 // Freetype
 #include "ft2build.h"
@@ -56,12 +57,14 @@
 #import "PXRectanglePacker.h"
 
 #import "PXTextureGlyph.h"
+#import "PXTextureGlyphAtlas.h"
 #import "PXFont.h"
 #import "PXTextureData.h"
 #import "PXPoint.h"
 
 @interface PXFreeTypeTextureFontFuser(Private)
 - (BOOL) _parseFontWithOptions:(PXTextureFontOptions *)tfOptions parser:(PXFreeTypeFontParser *)ftParser;
+- (PXFont *)_newDynamicFont;
 @end
 
 @implementation PXFreeTypeTextureFontFuser
@@ -110,13 +113,25 @@
 
 - (PXFont *)newFont
 {
+	if (((PXTextureFontOptions *)options).dynamicGlyphs)
+	{
+		return [self _newDynamicFont];
+	}
+
 	PXTextureFontTextureInfo *textureFontInfo = (PXTextureFontTextureInfo *)(vTextureFontInfo);
 
-	return PXTextureFontUtilsNewFont(textureFontInfo,
-									 textureData,
-									 charToGlyph,
-									 charToKernPoint,
-									 PXEngineGetContentScaleFactor());
+	PXFont *font = PXTextureFontUtilsNewFont(textureFontInfo,
+											 textureData,
+											 charToGlyph,
+											 charToKernPoint,
+											 PXEngineGetContentScaleFactor());
+
+	if (font)
+	{
+		((PXTextureFont *)font)->_isDistanceField = ((PXTextureFontOptions *)options).signedDistanceField;
+	}
+
+	return font;
 }
 
 + (Class) parserType
@@ -173,16 +188,31 @@
 	textureFontInfo->baseLine = 0.0f;
 	textureFontInfo->fontSize = tfOptions.size;
 
+	// Distance fields are made from glyphs rendered several times larger than
+	// the font size, every metric read from the face is scaled back down.
+	BOOL distanceField = tfOptions.signedDistanceField;
+	unsigned fieldScale = distanceField ? PX_DISTANCE_FIELD_SCALE : 1;
+	float one_fieldScale = 1.0f / (float)fieldScale;
+
 	// Free type keeps it's information in a different format, we need to
 	// convert it to pixels, so we shift it over to inform free type the size we
 	// want.
-	unsigned ftFontSize = textureFontInfo->fontSize * 64.0f; // << 6
+	unsigned ftFontSize = textureFontInfo->fontSize * 64.0f * fieldScale; // << 6
 
 	// We set the character size, at some point we need to know how many pixels
 	// per inch we are using...
 	FT_UInt ftPixelsPerInch = _PX_FONT_PIXELS_PER_INCH * PXEngineGetContentScaleFactor();
 	FT_Set_Char_Size(face, ftFontSize, ftFontSize, ftPixelsPerInch, ftPixelsPerInch);
 
+	// Dynamic fonts rasterize their glyphs when they are first used, all we
+	// need for now is the baseline.
+	if (tfOptions.dynamicGlyphs)
+	{
+		textureFontInfo->baseLine = (face->size->metrics.ascender >> 6) * one_fieldScale;
+
+		return YES;
+	}
+
 	// We need the string in an array of characters, so lets make that array!
 	NSString *string = tfOptions.characters;
 	unsigned characterCount = [string length];
@@ -205,6 +235,9 @@
 	CGRect *curRect = rectangles;
 	for (index = 0; index < characterCount; ++index, ++curChar, ++curGlyphDef, ++curRect)
 	{
+		curGlyphDef->bitmapGlyph = NULL;
+		*curRect = CGRectZero;
+
 		// If the glyph does not exist in the font file, we should inform the
 		// user.
 		if (FT_Load_Glyph(face, FT_Get_Char_Index(face, *curChar), FT_LOAD_DEFAULT))
@@ -228,8 +261,8 @@
 		bitmap = glyphBitmap->bitmap;
 
 		// Find the origin, advance and size of the bitmap and glyph
-		curGlyphDef->origin = CGPointMake(glyphBitmap->left, glyphBitmap->top);
-		curGlyphDef->advance = CGPointMake(((face->glyph->advance.x) >> 6), ((face->glyph->advance.y) >> 6));
+		curGlyphDef->origin = CGPointMake(glyphBitmap->left * one_fieldScale, glyphBitmap->top * one_fieldScale);
+		curGlyphDef->advance = CGPointMake(((face->glyph->advance.x) >> 6) * one_fieldScale, ((face->glyph->advance.y) >> 6) * one_fieldScale);
 		glyphWidth  = bitmap.width;
 		glyphHeight = bitmap.rows;
 
@@ -237,6 +270,61 @@
 		curRect->size.height = glyphHeight;
 	}
 
+	// Turn every rendered glyph into a distance field. FreeType can't be used
+	// from several threads at once, which is why the glyphs were all rendered
+	// first; the fields themselves are independent and are made in parallel.
+	PXDistanceFieldGlyph fieldGlyphs[distanceField ? characterCount : 1];
+
+	if (distanceField)
+	{
+		PXDistanceFieldGlyph *curFieldGlyph;
+
+		for (index = 0, curGlyphDef = glyphDefs, curFieldGlyph = fieldGlyphs;
+			 index < characterCount;
+			 ++index, ++curGlyphDef, ++curFieldGlyph)
+		{
+			curFieldGlyph->bytes = NULL;
+			curFieldGlyph->width = 0;
+			curFieldGlyph->height = 0;
+			curFieldGlyph->pitch = 0;
+
+			if (!curGlyphDef->bitmapGlyph)
+				continue;
+
+			bitmap = ((FT_BitmapGlyph)(curGlyphDef->bitmapGlyph))->bitmap;
+
+			curFieldGlyph->bytes = bitmap.buffer;
+			curFieldGlyph->width = bitmap.width;
+			curFieldGlyph->height = bitmap.rows;
+			curFieldGlyph->pitch = bitmap.pitch;
+		}
+
+		PXDistanceFieldMakeGlyphs(fieldGlyphs,
+								  characterCount,
+								  PX_DISTANCE_FIELD_SCALE,
+								  PX_DISTANCE_FIELD_SPREAD,
+								  PXDistanceFieldGetDefaultThreadCount());
+
+		// The field is padded by the spread on every side, the glyph's origin
+		// moves out with it.
+		for (index = 0, curGlyphDef = glyphDefs, curFieldGlyph = fieldGlyphs, curRect = rectangles;
+			 index < characterCount;
+			 ++index, ++curGlyphDef, ++curFieldGlyph, ++curRect)
+		{
+			if (!curFieldGlyph->field)
+			{
+				curFieldGlyph->fieldWidth = 0;
+				curFieldGlyph->fieldHeight = 0;
+			}
+
+			curGlyphDef->origin.x -= PX_DISTANCE_FIELD_SPREAD;
+			curGlyphDef->origin.y += PX_DISTANCE_FIELD_SPREAD;
+
+			curRect->size.width  = curFieldGlyph->fieldWidth;
+			curRect->size.height = curFieldGlyph->fieldHeight;
+		}
+	}
+
 	CGSize texSize = [PXRectanglePacker packRectangles:rectangles count:characterCount padding:2];
 
 	textureInfo->size.width  = texSize.width;
@@ -263,7 +351,7 @@
 
 	// The value of the baseline, we shift it over by 6 to convert it to pixel
 	// coordinates.
-	int ascender = (face->size->metrics.ascender >> 6);
+	float ascender = (face->size->metrics.ascender >> 6) * one_fieldScale;
 	textureFontInfo->baseLine = ascender;
 
 	GLubyte *glyphPixels = 0;
@@ -271,6 +359,7 @@
 	int nTexWidth = textureInfo->size.width;
 	unsigned glyphPixelOriginX = 0;
 	unsigned glyphPixelOriginY = 0;
+	int glyphPitch;
 
 	// The pointer to the new glyph we are going to make.
 	PXTextureGlyph *newGlyph;
@@ -298,17 +387,31 @@
 			 index < characterCount;
 			 ++index, ++curRect, ++curChar, ++curGlyphDef)
 		{
+			if (!curGlyphDef->bitmapGlyph)
+				continue;
+
 			glyphPixelOriginX = curRect->origin.x;
 			glyphPixelOriginY = curRect->origin.y;
 
-			bitmap = ((FT_BitmapGlyph)(curGlyphDef->bitmapGlyph))->bitmap;
-			glyphPixels = bitmap.buffer;
+			if (distanceField)
+			{
+				glyphPixels = fieldGlyphs[index].field;
+				glyphWidth  = fieldGlyphs[index].fieldWidth;
+				glyphHeight = fieldGlyphs[index].fieldHeight;
+			}
+			else
+			{
+				bitmap = ((FT_BitmapGlyph)(curGlyphDef->bitmapGlyph))->bitmap;
+				glyphPixels = bitmap.buffer;
+				glyphWidth  = bitmap.width;
+				glyphHeight = bitmap.rows;
+			}
+
+			glyphPitch = glyphWidth;
+
 			texturePixelLocationToDrawGlyph = textureInfo->bytes +
 												(glyphPixelOriginX + (glyphPixelOriginY * nTexWidth));
 
-			glyphWidth  = bitmap.width;
-			glyphHeight = bitmap.rows;
-
 			// This is a tricky, yet awsome little loop.  It goes through each of
 			// the rows of the bitmap, copying the whole row at a time into the
 			// larger texture.  We find where the origin is previous to this, and
@@ -322,7 +425,7 @@
 				// Increment the texture pointer by one row.
 				texturePixelLocationToDrawGlyph += nTexWidth;
 				// Increment the glyph bitmap pointer by one row.
-				glyphPixels += glyphWidth;
+				glyphPixels += glyphPitch;
 			}
 
 			// Make a new glyph and assign it's values.
@@ -375,7 +478,8 @@
 							continue;
 						}
 
-						newKerningPoint = [[PXPoint alloc] initWithX:(kerning.x >> 6) y:(kerning.y >> 6)];
+						newKerningPoint = [[PXPoint alloc] initWithX:(kerning.x >> 6) * one_fieldScale
+																   y:(kerning.y >> 6) * one_fieldScale];
 
 						[self setKernPoint:newKerningPoint forFirstCharacter:*curChar secondCharacter:*innerKernChar];
 
@@ -385,9 +489,20 @@
 			}
 
 			FT_Done_Glyph(curGlyphDef->bitmapGlyph);
+			curGlyphDef->bitmapGlyph = NULL;
 		}
 	}
 
+	// Anything not freed above (if the texture couldn't be allocated).
+	for (index = 0, curGlyphDef = glyphDefs; index < characterCount; ++index, ++curGlyphDef)
+	{
+		if (curGlyphDef->bitmapGlyph)
+			FT_Done_Glyph(curGlyphDef->bitmapGlyph);
+
+		if (distanceField)
+			free(fieldGlyphs[index].field);
+	}
+
 	id<PXTextureModifier> modifier = tfOptions.textureModifier;
 	if (modifier)
 	{
@@ -404,4 +519,179 @@
 	return YES;
 }
 
+- (PXFont *)_newDynamicFont
+{
+	PXTextureFontTextureInfo *textureFontInfo = (PXTextureFontTextureInfo *)(vTextureFontInfo);
+	PXTextureFontOptions *tfOptions = (PXTextureFontOptions *)options;
+
+	if (!textureFontInfo)
+	{
+		return nil;
+	}
+
+	PXTextureGlyphAtlas *atlas = [[PXTextureGlyphAtlas alloc] initWithPageSize:tfOptions.glyphPageSize
+																   maxPageCount:tfOptions.maxGlyphPageCount
+															 contentScaleFactor:PXEngineGetContentScaleFactor()];
+
+	if (!atlas)
+	{
+		return nil;
+	}
+
+	// The font holds on to the parser, as the parser owns both the face we
+	// rasterize from and the data the face was read from.
+	PXDynamicTextureFont *textureFont = [[PXDynamicTextureFont alloc] initWithRasterizer:self
+																				  source:parser
+																				   atlas:atlas];
+	[atlas release];
+
+	if (!textureFont)
+	{
+		return nil;
+	}
+
+	textureFont->_baseLine = textureFontInfo->baseLine;
+	textureFont->_fontSize = textureFontInfo->fontSize;
+	textureFont->_isDistanceField = tfOptions.signedDistanceField;
+
+	// Rasterize the characters asked for up front, so that the common ones
+	// don't cost anything the first time they are displayed.
+	NSString *string = tfOptions.characters;
+	unsigned characterCount = [string length];
+	unichar characters[characterCount];
+	[string getCharacters:characters];
+
+	unsigned index;
+	unichar *curChar;
+
+	for (index = 0, curChar = characters; index < characterCount; ++index, ++curChar)
+	{
+		[textureFont glyphFromCharacter:*curChar];
+	}
+
+	return textureFont;
+}
+
+// MARK: -
+// MARK: PXTextureGlyphRasterizer
+
+- (PXTextureGlyph *)newGlyphForCharacter:(unichar)character atlas:(PXTextureGlyphAtlas *)atlas
+{
+	PXFreeTypeFontParser *ftParser = (PXFreeTypeFontParser *)parser;
+	FT_Face face = (FT_Face)(ftParser->_vFace);
+
+	if (!face)
+	{
+		return nil;
+	}
+
+	// An index of 0 is the 'missing glyph', the font does not have this
+	// character.
+	FT_UInt glyphIndex = FT_Get_Char_Index(face, character);
+	if (glyphIndex == 0)
+	{
+		return nil;
+	}
+
+	if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_RENDER))
+	{
+		[ftParser _log:[NSString stringWithFormat:@"failed to render glyph for character %C", character]];
+		return nil;
+	}
+
+	FT_GlyphSlot slot = face->glyph;
+	FT_Bitmap bitmap = slot->bitmap;
+
+	BOOL distanceField = ((PXTextureFontOptions *)options).signedDistanceField;
+	float one_fieldScale = distanceField ? (1.0f / PX_DISTANCE_FIELD_SCALE) : 1.0f;
+
+	CGPoint origin = CGPointMake(slot->bitmap_left * one_fieldScale, slot->bitmap_top * one_fieldScale);
+
+	const unsigned char *bytes = bitmap.buffer;
+	unsigned width = bitmap.width;
+	unsigned height = bitmap.rows;
+	int pitch = bitmap.pitch;
+
+	PXDistanceFieldGlyph fieldGlyph;
+
+	if (distanceField)
+	{
+		fieldGlyph.bytes = bitmap.buffer;
+		fieldGlyph.width = bitmap.width;
+		fieldGlyph.height = bitmap.rows;
+		fieldGlyph.pitch = bitmap.pitch;
+
+		PXDistanceFieldMake(&fieldGlyph, PX_DISTANCE_FIELD_SCALE, PX_DISTANCE_FIELD_SPREAD);
+
+		bytes = fieldGlyph.field;
+		width = fieldGlyph.field ? fieldGlyph.fieldWidth : 0;
+		height = fieldGlyph.field ? fieldGlyph.fieldHeight : 0;
+		pitch = width;
+
+		origin.x -= PX_DISTANCE_FIELD_SPREAD;
+		origin.y += PX_DISTANCE_FIELD_SPREAD;
+	}
+
+	CGRect textureBounds;
+	PXTextureData *textureData = [atlas addBitmap:bytes
+											width:width
+										   height:height
+											pitch:pitch
+									textureBounds:&textureBounds];
+
+	if (distanceField)
+	{
+		free(fieldGlyph.field);
+	}
+
+	if (!textureData)
+	{
+		return nil;
+	}
+
+	float ascender = (face->size->metrics.ascender >> 6) * one_fieldScale;
+
+	PXTextureGlyph *newGlyph = [PXTextureGlyph new];
+
+	newGlyph.textureData = textureData;
+
+	newGlyph->_advance		 = CGPointMake(((slot->advance.x) >> 6) * one_fieldScale, ((slot->advance.y) >> 6) * one_fieldScale);
+	newGlyph->_bounds		 = CGRectMake(origin.x,
+										  ascender - origin.y,
+										  width,
+										  height);
+	newGlyph->_textureBounds = textureBounds;
+
+	return newGlyph;
+}
+
+- (PXPoint *)newKerningPointFromFirstCharacter:(unichar)firstCharacter
+							   secondCharacter:(unichar)secondCharacter
+{
+	PXFreeTypeFontParser *ftParser = (PXFreeTypeFontParser *)parser;
+	FT_Face face = (FT_Face)(ftParser->_vFace);
+
+	if (!face || !FT_HAS_KERNING(face))
+	{
+		return nil;
+	}
+
+	FT_Vector kerning;
+	FT_Error error = FT_Get_Kerning(face,
+									FT_Get_Char_Index(face, firstCharacter),
+									FT_Get_Char_Index(face, secondCharacter),
+									FT_KERNING_DEFAULT,
+									&kerning);
+
+	if (error || (kerning.x == 0 && kerning.y == 0))
+	{
+		return nil;
+	}
+
+	float one_fieldScale = ((PXTextureFontOptions *)options).signedDistanceField ? (1.0f / PX_DISTANCE_FIELD_SCALE) : 1.0f;
+
+	return [[PXPoint alloc] initWithX:(kerning.x >> 6) * one_fieldScale
+									y:(kerning.y >> 6) * one_fieldScale];
+}
+
 @end
@@ -53,6 +53,11 @@ typedef enum
 	PXSoundFormat_Mono16 = 0x1101,
 	PXSoundFormat_Stereo8 = 0x1102,
 	PXSoundFormat_Stereo16 = 0x1103,
+
+	// Compressed in memory, decoded as the sound plays. The values match
+	// AL_EXT_IMA4, however the data is always decoded by Pixelwave.
+	PXSoundFormat_MonoIMA4 = 0x1300,
+	PXSoundFormat_StereoIMA4 = 0x1301,
 } PXSoundFormat;
 
 typedef struct
@@ -66,6 +71,9 @@ typedef struct
 
 	unsigned channelCount;
 	unsigned milliseconds;
+
+	// The number of decoded frames, only set for compressed formats.
+	unsigned frameCount;
 } PXParsedSoundData;
 
 PXInline_h PXParsedSoundData *PXParsedSoundDataCreate(unsigned byteCount);
@@ -45,6 +45,8 @@
 
 #import "PXSoundModifier.h"
 
+#include "PXProfileUtils.h"
+
 /**
  * A PXSoundParser takes the given data, and parses it into information needed
  * to play the sound.
@@ -152,6 +154,8 @@
 
 	if (self)
 	{
+		PX_PROFILE_OBJECT_ZONE(self);
+
 		// Make the sound info (it's bytes and other)
 		soundInfo = PXParsedSoundDataCreate(0);
 		modifiedSoundInfo = NULL;
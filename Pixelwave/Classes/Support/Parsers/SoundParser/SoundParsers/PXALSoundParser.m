@@ -42,8 +42,10 @@
 #import <AudioToolbox/AudioToolbox.h>
 #import "PXAL.h"
 #import "PXALSound.h"
+#import "PXALADPCMSound.h"
 
 #include "PXSoundEngine.h"
+#include "PXSoundFormatUtils.h"
 
 #import "PXDebug.h"
 
@@ -150,6 +152,18 @@ OSStatus PXALSoundLoaderFileSetSize(void *inClientData,
 	void *memData = curSoundInfo->bytes;
 	unsigned bytesTotal = curSoundInfo->byteCount;
 
+	// Compressed sounds hold on to their own data and are decoded as they
+	// play, so they never get an AL buffer of their own.
+	if (PXSoundFormatIsCompressed(format))
+	{
+		return [[PXALADPCMSound alloc] initWithBytes:memData
+										   byteCount:bytesTotal
+										  frameCount:curSoundInfo->frameCount
+										   frequency:freq
+											  length:milliseconds
+										channelCount:channelCount];
+	}
+
 	PXALSound *sound = [[PXALSound alloc] initWithFormat:format
 											   frequency:freq
 											  bytesTotal:bytesTotal
@@ -0,0 +1,319 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXBinaryAtlasParser.h"
+
+#import "PXTextureAtlas.h"
+#import "PXAtlasFrame.h"
+#import "PXClipRect.h"
+#import "PXTexturePadding.h"
+#import "PXPoint.h"
+
+#import "PXTextureLoader.h"
+#import "PXTextureData.h"
+
+#import "PXDebug.h"
+
+// Names at most this long (in UTF-8) are looked up without allocating
+#define PX_BINARY_ATLAS_NAME_BUFFER_SIZE 256
+
+@interface PXBinaryAtlasFrameSource : NSObject<PXTextureAtlasFrameSource>
+{
+@private
+	// Holds on to the bytes the atlas points into
+	NSData *data;
+	PXBinaryAtlas atlas;
+
+	NSArray *textureDatas;
+	float invScaleFactor;
+
+	// Copied by every frame that's made, so they can be reused
+	PXClipRect *clipRect;
+	PXTexturePadding *padding;
+	PXPoint *anchor;
+}
+
+- (id) initWithData:(NSData *)data
+			  atlas:(PXBinaryAtlas *)atlas
+	   textureDatas:(NSArray *)textureDatas
+ contentScaleFactor:(float)contentScaleFactor;
+
+@end
+
+@implementation PXBinaryAtlasParser
+
+- (void) dealloc
+{
+	[textureLoaders release];
+	textureLoaders = nil;
+
+	[super dealloc];
+}
+
++ (BOOL) isApplicableForData:(NSData *)data origin:(NSString *)origin
+{
+	if (!data)
+		return NO;
+
+	// The names of the images are relative to the atlas file.
+	if (!origin)
+		return NO;
+
+	return PXBinaryAtlasIsBinaryAtlas([data bytes], [data length]);
+}
++ (void) appendSupportedFileExtensions:(PXLinkedList *)extensions
+{
+	[extensions addObject:@"pxa"];
+}
+
+- (BOOL) _parseWithModifier:(id<PXTextureModifier>)modifier
+{
+	// Only checks the file, nothing is read out of it yet.
+	if (!PXBinaryAtlasInit(&atlas, [data bytes], [data length]))
+	{
+		NSString *localOrigin = [[origin pathComponents] lastObject];
+
+		PXDebugLog(@"Couldn't parse file:%@ reason:Not a valid binary atlas\n", localOrigin ? localOrigin : @"PXA");
+		return NO;
+	}
+
+	////////////////////////////////
+	// Read the texture data info //
+	////////////////////////////////
+
+	textureLoaders = [[NSMutableArray alloc] init];
+
+	NSString *directory = [origin stringByDeletingLastPathComponent];
+	NSString *imageName;
+	NSString *imagePath;
+	PXTextureLoader *loader;
+
+	unsigned index;
+	unsigned imageCount = atlas.header->imageCount;
+
+	for (index = 0; index < imageCount; ++index)
+	{
+		imageName = [NSString stringWithUTF8String:PXBinaryAtlasGetImageName(&atlas, index)];
+
+		// Like the formats it was made from, an atlas without an image name
+		// uses the image named like itself.
+		if ([imageName length] == 0)
+			imagePath = [origin stringByDeletingPathExtension];
+		else
+			imagePath = [directory stringByAppendingPathComponent:imageName];
+
+		imagePath = [PXTextureLoader resolvePathForImageFile:imagePath];
+		if (!imagePath)
+			return NO;
+
+		loader = [[PXTextureLoader alloc] initWithContentsOfFile:imagePath modifier:modifier];
+
+		if (!loader)
+			return NO;
+
+		// Require the image to be the same contentScaleFactor as the atlas.
+		[loader setContentScaleFactor:contentScaleFactor];
+
+		[textureLoaders addObject:loader];
+		[loader release];
+	}
+
+	return YES;
+}
+
+- (PXTextureAtlas *)newTextureAtlas
+{
+	if (!textureLoaders)
+		return nil;
+
+	// Convert all the loaders to TextureData objects
+	NSMutableArray *textureDatas = [[NSMutableArray alloc] init];
+	PXTextureData *textureData;
+
+	for (PXTextureLoader *textureLoader in textureLoaders)
+	{
+		textureData = [textureLoader newTextureData];
+
+		// If any of the textures couldn't be loaded, the atlas can't be
+		// created.
+		if (!textureData)
+		{
+			[textureDatas release];
+			return nil;
+		}
+
+		[textureDatas addObject:textureData];
+		[textureData release];
+	}
+
+	PXBinaryAtlasFrameSource *frameSource = [[PXBinaryAtlasFrameSource alloc] initWithData:data
+																					 atlas:&atlas
+																			  textureDatas:textureDatas
+																		contentScaleFactor:contentScaleFactor];
+	[textureDatas release];
+
+	PXTextureAtlas *textureAtlas = [[PXTextureAtlas alloc] init];
+	[textureAtlas _setFrameSource:frameSource];
+	[frameSource release];
+
+	return textureAtlas;
+}
+
+@end
+
+@implementation PXBinaryAtlasFrameSource
+
+- (id) initWithData:(NSData *)_data
+			  atlas:(PXBinaryAtlas *)_atlas
+	   textureDatas:(NSArray *)_textureDatas
+ contentScaleFactor:(float)contentScaleFactor
+{
+	self = [super init];
+
+	if (self)
+	{
+		data = [_data retain];
+		atlas = *_atlas;
+
+		textureDatas = [_textureDatas retain];
+
+		// The file is in PIXELS, frames are in POINTS.
+		invScaleFactor = 1.0f / contentScaleFactor;
+
+		clipRect = [[PXClipRect alloc] init];
+		padding = [[PXTexturePadding alloc] init];
+		anchor = [[PXPoint alloc] init];
+	}
+
+	return self;
+}
+
+- (void) dealloc
+{
+	[clipRect release];
+	clipRect = nil;
+	[padding release];
+	padding = nil;
+	[anchor release];
+	anchor = nil;
+
+	[textureDatas release];
+	textureDatas = nil;
+
+	[data release];
+	data = nil;
+
+	[super dealloc];
+}
+
+- (NSArray *)frameNames
+{
+	unsigned frameCount = atlas.header->frameCount;
+	NSMutableArray *names = [[NSMutableArray alloc] initWithCapacity:frameCount];
+
+	NSString *name;
+	const PXBinaryAtlasFrame *frame;
+	unsigned index;
+
+	for (index = 0, frame = atlas.frames; index < frameCount; ++index, ++frame)
+	{
+		name = [[NSString alloc] initWithBytes:PXBinaryAtlasGetFrameName(&atlas, frame)
+										length:frame->nameLength
+									  encoding:NSUTF8StringEncoding];
+
+		if (name)
+		{
+			[names addObject:name];
+			[name release];
+		}
+	}
+
+	return [names autorelease];
+}
+
+- (PXAtlasFrame *)newFrameWithName:(NSString *)name
+{
+	// Get at the UTF-8 bytes of the name without making a copy, if possible
+	char buffer[PX_BINARY_ATLAS_NAME_BUFFER_SIZE];
+	const char *bytes = CFStringGetCStringPtr((CFStringRef)name, kCFStringEncodingUTF8);
+
+	if (!bytes)
+	{
+		if (CFStringGetCString((CFStringRef)name, buffer, sizeof(buffer), kCFStringEncodingUTF8))
+			bytes = buffer;
+		else
+			bytes = [name UTF8String];
+	}
+
+	if (!bytes)
+		return nil;
+
+	const PXBinaryAtlasFrame *frame = PXBinaryAtlasFindFrame(&atlas, bytes, strlen(bytes));
+
+	if (!frame)
+		return nil;
+
+	[clipRect setX:frame->x * invScaleFactor
+				 y:frame->y * invScaleFactor
+			 width:frame->width * invScaleFactor
+			height:frame->height * invScaleFactor
+		  rotation:frame->rotation];
+
+	BOOL paddingEnabled = (frame->flags & PXBinaryAtlasFrameFlag_Padding) != 0;
+	if (paddingEnabled)
+	{
+		[padding setTop:frame->padding[0] * invScaleFactor
+				  right:frame->padding[1] * invScaleFactor
+				 bottom:frame->padding[2] * invScaleFactor
+				   left:frame->padding[3] * invScaleFactor];
+	}
+
+	BOOL anchorEnabled = (frame->flags & PXBinaryAtlasFrameFlag_Anchor) != 0;
+	if (anchorEnabled)
+	{
+		[anchor setX:frame->anchorX y:frame->anchorY];
+	}
+
+	return [[PXAtlasFrame alloc] initWithClipRect:clipRect
+									  textureData:[textureDatas objectAtIndex:frame->imageIndex]
+										   anchor:anchorEnabled ? anchor : nil
+										  padding:paddingEnabled ? padding : nil];
+}
+
+@end
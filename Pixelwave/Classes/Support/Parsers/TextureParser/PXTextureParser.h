@@ -41,6 +41,7 @@
 
 #import "PXParser.h"
 #import "PXParsedTextureData.h"
+#include "PXMipmapUtils.h"
 
 @class PXTextureData;
 @protocol PXTextureModifier;
@@ -56,6 +57,15 @@
 	CGSize contentSize;
 
 	float contentScaleFactor;
+
+	// Set by parsers that copy the edge pixels into the padding themselves,
+	// while decoding.
+	BOOL edgesExpanded;
+	// Set by parsers whose colors come out multiplied by their alpha.
+	BOOL alphaPremultiplied;
+
+	BOOL generatesMipmaps;
+	PXMipmapChain *mipmaps;
 }
 
 /**
@@ -77,6 +87,16 @@
  */
 @property (nonatomic) float contentScaleFactor;
 
+/**
+ * Whether a full chain of mipmaps is filtered from the image, and uploaded
+ * along with it. The filtering is done as soon as this is set (or when the
+ * modifier changes), on the calling thread, so that only the uploads are left
+ * for when a texture data is made.
+ *
+ * **Default:** [PXTextureData generatesMipmaps]
+ */
+@property (nonatomic) BOOL generatesMipmaps;
+
 //-- ScriptName: TextureParser
 //-- ScriptArg[0]: required
 //-- ScriptArg[1]: nil
@@ -94,5 +114,8 @@
 			  origin:(NSString *)origin;
 
 - (BOOL) _initializeTexture:(unsigned int)texName;
+- (BOOL) _reloadTextureData:(PXTextureData *)textureData;
 - (void) _expandEdges:(PXParsedTextureData *)data;
+- (void) _updateMipmaps;
+- (unsigned) _mipmapByteCount;
 @end
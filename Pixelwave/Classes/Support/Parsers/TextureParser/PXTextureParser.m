@@ -40,14 +40,19 @@
 #import "PXTextureParser.h"
 
 #import "PXGL.h"
+#include "PXGLCommandBuffer.h"
 
 #import "PXDebug.h"
 
 #import "PXParsedTextureData.h"
 #import "PXTextureData.h"
 #import "PXTextureModifier.h"
+#import "PXTextureMemory.h"
+
+#include "PXGLErrorUtils.h"
 
 #include "PXPrivateUtils.h"
+#include "PXProfileUtils.h"
 
 /**
  * A PXTextureParser takes the given data, and parses it into information
@@ -71,6 +76,7 @@
 
 @synthesize modifier;
 @synthesize contentScaleFactor;
+@synthesize generatesMipmaps;
 
 - (id) init
 {
@@ -153,9 +159,16 @@
 
 	if (self)
 	{
+		PX_PROFILE_OBJECT_ZONE(self);
+
 		// Make the texture info (it's bytes and other)
 		textureInfo = PXParsedTextureDataCreate(0);
 		modifiedTextureInfo = NULL;
+		edgesExpanded = NO;
+		alphaPremultiplied = NO;
+
+		generatesMipmaps = [PXTextureData generatesMipmaps];
+		mipmaps = NULL;
 
 		// Initialize the content scale factor to 1.0
 		contentScaleFactor = 1.0f;
@@ -177,6 +190,8 @@
 
 - (void) dealloc
 {
+	// Setting the modifier would filter the mipmaps again otherwise
+	generatesMipmaps = NO;
 	self.modifier = nil;
 
 	// Free the normal and modified info. If either are nil, this won't do
@@ -213,6 +228,18 @@
 		modifiedTextureInfo = [modifier newModifiedTextureDataFromData:textureInfo];
 	}
 	[_modifier release];
+
+	// The mipmaps are made from the modified data
+	[self _updateMipmaps];
+}
+
+- (void) setGeneratesMipmaps:(BOOL)_generatesMipmaps
+{
+	if (generatesMipmaps == _generatesMipmaps)
+		return;
+
+	generatesMipmaps = _generatesMipmaps;
+	[self _updateMipmaps];
 }
 
 - (BOOL) isModifiable
@@ -228,6 +255,8 @@
  */
 - (PXTextureData *)newTextureData
 {
+	PX_PROFILE_ZONE("PXTextureParser newTextureData");
+
 	// Allocate the texture data
 	PXTextureData *textureData = [[PXTextureData alloc] _init];
 
@@ -238,6 +267,8 @@
 	BOOL success;
 
 	// Grab the previously bound texture, so we can re-bind it after we are done
+	PXGLBeginDirect();
+
 	GLuint boundTex = PXGLBoundTexture();
 	PXGLBindTexture(GL_TEXTURE_2D, texName);
 	{
@@ -246,6 +277,8 @@
 	}
 	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
 
+	PXGLEndDirect();
+
 	// If we succeeded, inform the texture data to set the correct properties.
 	if (success)
 	{
@@ -255,6 +288,15 @@
 									   contentHeight:contentSize.height
 								  contentScaleFactor:contentScaleFactor
 											  format:textureInfo->pixelFormat];
+
+		unsigned mipmapByteCount = [self _mipmapByteCount];
+
+		if (mipmapByteCount > 0)
+		{
+			textureData->_hasMipmaps = YES;
+
+			PXTextureMemorySetByteCount(textureData, textureData->_memoryByteCount + mipmapByteCount);
+		}
 	}
 	else
 	{
@@ -267,6 +309,36 @@
 	return textureData;
 }
 
+/*
+ * Fills the existing GL texture of the given texture data with the parsed
+ * image again, keeping its GL name (and with it the texture parameters).
+ */
+- (BOOL) _reloadTextureData:(PXTextureData *)textureData
+{
+	if (!textureData || textureData->_glName == 0)
+		return NO;
+
+	BOOL success;
+
+	PXGLBeginDirect();
+
+	GLuint boundTex = PXGLBoundTexture();
+	PXGLBindTexture(GL_TEXTURE_2D, textureData->_glName);
+	{
+		success = [self _initializeTexture:textureData->_glName];
+	}
+	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
+
+	PXGLEndDirect();
+
+	if (success)
+	{
+		textureData->_hasMipmaps = ([self _mipmapByteCount] > 0);
+	}
+
+	return success;
+}
+
 - (BOOL) _initializeTexture:(GLuint)texName
 {
 	PXParsedTextureData *curTextureInfo = textureInfo;
@@ -277,15 +349,53 @@
 		curTextureInfo = modifiedTextureInfo;
 	}
 
-	if ([PXTextureData expandEdges])
+	if ([PXTextureData expandEdges] && !edgesExpanded)
 	{
 		[self _expandEdges:curTextureInfo];
 	}
 
-	GLsizei width = curTextureInfo->size.width;
-	GLsizei height = curTextureInfo->size.height;
-	const GLvoid *byteData = (GLvoid *)(curTextureInfo->bytes);
-	PXTextureDataPixelFormat pixelFormat = curTextureInfo->pixelFormat;
+	if (![self _texImage2D:curTextureInfo level:0])
+	{
+		return NO;
+	}
+
+	if (mipmaps)
+	{
+		unsigned index;
+
+		for (index = 0; index < mipmaps->levelCount; ++index)
+		{
+			[self _texImage2D:mipmaps->levels[index] level:index + 1];
+		}
+	}
+
+	// If there was an error, inform the user. Unless synchronous checks are
+	// on, this is only known once the frame is done.
+	GLenum err = PXGLErrorCheck("glTexImage2D", texName);
+	if (err != GL_NO_ERROR)
+	{
+		PXDebugLog(@"error [0x%X] occured while uploading texture to gl.\n", err);
+
+		return NO;
+	}
+
+	return YES;
+}
+
+/*
+ * Uploads the given data into a level of the bound texture.
+ */
+- (BOOL) _texImage2D:(PXParsedTextureData *)info level:(GLint)level
+{
+	GLsizei width = info->size.width;
+	GLsizei height = info->size.height;
+	const GLvoid *byteData = (GLvoid *)(info->bytes);
+	PXTextureDataPixelFormat pixelFormat = info->pixelFormat;
+
+	if (!PXGLErrorValidateTexImage("glTexImage2D", level, width, height, byteData))
+	{
+		return NO;
+	}
 
 	GLint align;
 
@@ -293,48 +403,99 @@
 	switch (pixelFormat)
 	{
 		case PXTextureDataPixelFormat_RGBA8888:
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, byteData);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, byteData);
 			break;
 		case PXTextureDataPixelFormat_RGBA4444:
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, byteData);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, byteData);
 			break;
 		case PXTextureDataPixelFormat_RGBA5551:
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, byteData);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, byteData);
 			break;
 		case PXTextureDataPixelFormat_RGB565:
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, byteData);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, byteData);
 			break;
 		case PXTextureDataPixelFormat_RGB888:
 			// TODO: Figure out why 1 and 2 pixel wide images do not display properly without this.
 			glGetIntegerv(GL_UNPACK_ALIGNMENT, &align);
 			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, byteData);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, byteData);
 			glPixelStorei(GL_UNPACK_ALIGNMENT, align);
 			break;
 		case PXTextureDataPixelFormat_L8:
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, byteData);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, byteData);
 			break;
 		case PXTextureDataPixelFormat_A8:
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, byteData);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, byteData);
 			break;
 		case PXTextureDataPixelFormat_LA88:
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE_ALPHA, width, height, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, byteData);
+			glTexImage2D(GL_TEXTURE_2D, level, GL_LUMINANCE_ALPHA, width, height, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, byteData);
 			break;
 		default:
 			[NSException raise:NSInternalInconsistencyException format:@""];
-			break;
+			return NO;
 	}
 
-	// If there was an error, inform the user
-	GLenum err = glGetError();
-	if (err != GL_NO_ERROR)
+	return YES;
+}
+
+/*
+ * The amount of bytes in the levels below the base one that
+ * _initializeTexture uploads. 0 if it doesn't upload a full chain of them.
+ */
+- (unsigned) _mipmapByteCount
+{
+	return PXMipmapChainGetByteCount(mipmaps);
+}
+
+/*
+ * Filters the mipmaps from the (modified) image, if they're wanted. Images
+ * that end up with 16 bits per pixel are filtered at 8 bits per channel, from
+ * the unmodified image, and converted afterwards.
+ */
+- (void) _updateMipmaps
+{
+	PXMipmapChainFree(mipmaps);
+	mipmaps = NULL;
+
+	if (!generatesMipmaps || !textureInfo)
+		return;
+
+	PXParsedTextureData *baseInfo = textureInfo;
+
+	if (modifiedTextureInfo && modifiedTextureInfo->bytes)
 	{
-		PXDebugLog(@"error [0x%X] occured while uploading texture to gl.\n", err);
+		baseInfo = modifiedTextureInfo;
+	}
 
-		return NO;
+	PXTextureDataPixelFormat pixelFormat = baseInfo->pixelFormat;
+
+	if (!PXMipmapIsFormatSupported(pixelFormat))
+	{
+		baseInfo = textureInfo;
 	}
 
-	return YES;
+	// The padding is part of what gets filtered, so it has to be filled in
+	// first.
+	if ([PXTextureData expandEdges] && !edgesExpanded)
+	{
+		[self _expandEdges:baseInfo];
+	}
+
+	mipmaps = PXMipmapChainCreate(baseInfo, alphaPremultiplied);
+
+	if (mipmaps && baseInfo->pixelFormat != pixelFormat)
+	{
+		if (!PXMipmapChainConvert(mipmaps, pixelFormat))
+		{
+			PXMipmapChainFree(mipmaps);
+			mipmaps = NULL;
+		}
+	}
+
+	if (generatesMipmaps && !mipmaps)
+	{
+		PXDebugLog(@"Couldn't make mipmaps for a texture of format [%d]\n", pixelFormat);
+	}
 }
 
 - (void) _expandEdges:(PXParsedTextureData *)_data
@@ -261,6 +261,7 @@
 			_data = malloc(_byteCount);
 
 			_context = CGBitmapContextCreate(_data, width, height, 8, 4 * width, colorSpace, kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+			alphaPremultiplied = YES;
 			CGColorSpaceRelease(colorSpace);
 			break;
 
@@ -309,6 +310,7 @@
 			_data = malloc(_byteCount);
 
 			_context = CGBitmapContextCreate(_data, width, height, 8, 4 * width, colorSpace, kCGImageAlphaPremultipliedLast | kCGBitmapByteOrder32Big);
+			alphaPremultiplied = YES;
 			CGColorSpaceRelease(colorSpace);
 			break;
 
@@ -0,0 +1,584 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXGL.h"
+
+#import "PXTextureData.h"
+#import "PXETCTextureParser.h"
+
+#import "PXExceptionUtils.h"
+#import "PXDebug.h"
+
+#include "PXETCUtils.h"
+#include "PXGLErrorUtils.h"
+#include "PXMathUtils.h"
+
+/*
+ * Loads ETC1 and ETC2 images from KTX and PKM files, such as the ones made by
+ * the pxetc tool (in Tools/pxetc).
+ *
+ * OpenGL ES 1.1 only knows about ETC1, through an extension that not every
+ * device has. When it's there, ETC1 images are uploaded as they are. ETC2
+ * images, ETC1 images with an alpha plane, and ETC1 images on devices without
+ * the extension are decoded to RGB888 or RGBA8888 first; they still load
+ * several times less data from disk.
+ */
+
+#define PX_ETC_MAX_LEVEL_COUNT 16
+
+// The largest side accepted until gl is initialized and PXGLMaxTextureSize
+// knows the real one
+#define PX_ETC_DEFAULT_MAX_SIZE 4096
+
+#define PX_ETC_PKM_HEADER_SIZE 16
+#define PX_ETC_KTX_HEADER_SIZE 64
+
+static const uint8_t pxETCKTXIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+typedef struct
+{
+	PXETCFormat format;
+
+	// The size of the encoded image, and of the part of it that was the
+	// original image
+	unsigned width;
+	unsigned height;
+	unsigned contentWidth;
+	unsigned contentHeight;
+
+	// ETC1 images can carry their alpha in a second image, below the first
+	BOOL hasAlphaPlane;
+
+	const uint8_t *levels[PX_ETC_MAX_LEVEL_COUNT];
+	unsigned levelByteCounts[PX_ETC_MAX_LEVEL_COUNT];
+	unsigned levelCount;
+} _PXETCImage;
+
+PXInline unsigned PXETCTextureParserRead16BE(const uint8_t *bytes)
+{
+	return (bytes[0] << 8) | bytes[1];
+}
+
+PXInline uint32_t PXETCTextureParserRead32(const uint8_t *bytes, BOOL swaps)
+{
+	uint32_t val;
+	memcpy(&val, bytes, sizeof(uint32_t));
+
+	return swaps ? CFSwapInt32(val) : val;
+}
+
+/*
+ * Sides above this are rejected as soon as they're read, before any byte count
+ * is worked out from them, so a corrupt header can't overflow one.
+ */
+PXInline unsigned PXETCTextureParserMaxSize()
+{
+	GLint maxSize = PXGLMaxTextureSize();
+
+	return (maxSize > 0) ? (unsigned)maxSize : PX_ETC_DEFAULT_MAX_SIZE;
+}
+
+PXInline BOOL PXETCTextureParserIsPKM(const uint8_t *bytes, unsigned byteCount)
+{
+	return byteCount >= PX_ETC_PKM_HEADER_SIZE && memcmp(bytes, "PKM ", 4) == 0;
+}
+
+PXInline BOOL PXETCTextureParserIsKTX(const uint8_t *bytes, unsigned byteCount)
+{
+	return byteCount >= PX_ETC_KTX_HEADER_SIZE && memcmp(bytes, pxETCKTXIdentifier, sizeof(pxETCKTXIdentifier)) == 0;
+}
+
+PXInline BOOL PXETCTextureParserReadPKM(const uint8_t *bytes, unsigned byteCount, _PXETCImage *image)
+{
+	switch (PXETCTextureParserRead16BE(bytes + 6))
+	{
+		case 0:
+			image->format = PXETCFormat_ETC1;
+			break;
+		case 1:
+			image->format = PXETCFormat_ETC2_RGB;
+			break;
+		// 2 is an older name for the same format
+		case 2:
+		case 3:
+			image->format = PXETCFormat_ETC2_RGBA;
+			break;
+		default:
+			PXDebugLog(@"PKM - Unsupported format [%d]\n", PXETCTextureParserRead16BE(bytes + 6));
+			return NO;
+	}
+
+	image->width  = PXETCTextureParserRead16BE(bytes + 8);
+	image->height = PXETCTextureParserRead16BE(bytes + 10);
+
+	unsigned maxSize = PXETCTextureParserMaxSize();
+
+	if (image->width > maxSize || image->height > maxSize)
+		return NO;
+
+	image->contentWidth  = PXETCTextureParserRead16BE(bytes + 12);
+	image->contentHeight = PXETCTextureParserRead16BE(bytes + 14);
+	image->hasAlphaPlane = NO;
+
+	image->levels[0] = bytes + PX_ETC_PKM_HEADER_SIZE;
+	image->levelByteCounts[0] = PXETCGetImageByteCount(image->format, image->width, image->height);
+	image->levelCount = 1;
+
+	return (PX_ETC_PKM_HEADER_SIZE + image->levelByteCounts[0] <= byteCount);
+}
+
+/*
+ * Picks the keys that pxetc writes out of the key value data.
+ */
+PXInline void PXETCTextureParserReadKTXKeyValues(const uint8_t *bytes, unsigned byteCount, BOOL swaps, _PXETCImage *image)
+{
+	unsigned offset = 0;
+	uint32_t pairByteCount;
+	const char *key;
+	const char *value;
+	size_t keyLength;
+
+	while (offset + 4 <= byteCount)
+	{
+		pairByteCount = PXETCTextureParserRead32(bytes + offset, swaps);
+		offset += 4;
+
+		if (pairByteCount > byteCount - offset)
+			break;
+
+		key = (const char *)(bytes + offset);
+		keyLength = strnlen(key, pairByteCount);
+
+		if (keyLength < pairByteCount)
+		{
+			value = key + keyLength + 1;
+
+			if (strcmp(key, "PXContentSize") == 0)
+			{
+				unsigned contentWidth, contentHeight;
+
+				if (sscanf(value, "%ux%u", &contentWidth, &contentHeight) == 2)
+				{
+					image->contentWidth = contentWidth;
+					image->contentHeight = contentHeight;
+				}
+			}
+			else if (strcmp(key, "PXAlphaPlane") == 0)
+			{
+				image->hasAlphaPlane = YES;
+			}
+		}
+
+		offset += (pairByteCount + 3) & ~3;
+	}
+}
+
+PXInline BOOL PXETCTextureParserReadKTX(const uint8_t *bytes, unsigned byteCount, _PXETCImage *image)
+{
+	uint32_t endianness = PXETCTextureParserRead32(bytes + 12, NO);
+	BOOL swaps = (endianness == 0x01020304);
+
+	if (!swaps && endianness != 0x04030201)
+		return NO;
+
+	uint32_t glInternalFormat = PXETCTextureParserRead32(bytes + 28, swaps);
+
+	switch (glInternalFormat)
+	{
+		case PX_GL_ETC1_RGB8_OES:
+			image->format = PXETCFormat_ETC1;
+			break;
+		case PX_GL_COMPRESSED_RGB8_ETC2:
+			image->format = PXETCFormat_ETC2_RGB;
+			break;
+		case PX_GL_COMPRESSED_RGBA8_ETC2_EAC:
+			image->format = PXETCFormat_ETC2_RGBA;
+			break;
+		default:
+			PXDebugLog(@"KTX - Unsupported format [0x%X]\n", glInternalFormat);
+			return NO;
+	}
+
+	image->width  = PXETCTextureParserRead32(bytes + 36, swaps);
+	image->height = PXETCTextureParserRead32(bytes + 40, swaps);
+
+	// An alpha plane doubles the height, it's checked again once that's known
+	unsigned maxSize = PXETCTextureParserMaxSize();
+
+	if (image->width > maxSize || image->height > (maxSize << 1))
+		return NO;
+
+	uint32_t depth        = PXETCTextureParserRead32(bytes + 44, swaps);
+	uint32_t elementCount = PXETCTextureParserRead32(bytes + 48, swaps);
+	uint32_t faceCount    = PXETCTextureParserRead32(bytes + 52, swaps);
+	uint32_t levelCount   = PXETCTextureParserRead32(bytes + 56, swaps);
+	uint32_t keyValueByteCount = PXETCTextureParserRead32(bytes + 60, swaps);
+
+	// Only plain 2D textures
+	if (depth > 0 || elementCount > 0 || faceCount != 1 || image->height == 0)
+		return NO;
+
+	if (keyValueByteCount > byteCount - PX_ETC_KTX_HEADER_SIZE)
+		return NO;
+
+	image->contentWidth = image->width;
+	image->contentHeight = image->height;
+	image->hasAlphaPlane = NO;
+
+	PXETCTextureParserReadKTXKeyValues(bytes + PX_ETC_KTX_HEADER_SIZE, keyValueByteCount, swaps, image);
+
+	// The alpha plane is part of the encoded image, but not of the texture
+	if (image->hasAlphaPlane)
+	{
+		if (image->format != PXETCFormat_ETC1)
+			return NO;
+
+		image->height >>= 1;
+		image->contentHeight = PXMathMin(image->contentHeight, image->height);
+	}
+
+	if (image->height > maxSize)
+		return NO;
+
+	levelCount = PXMathMax(levelCount, 1);
+	levelCount = PXMathMin(levelCount, PX_ETC_MAX_LEVEL_COUNT);
+
+	unsigned offset = PX_ETC_KTX_HEADER_SIZE + keyValueByteCount;
+	unsigned index;
+	uint32_t levelByteCount;
+
+	image->levelCount = 0;
+
+	for (index = 0; index < levelCount; ++index)
+	{
+		if (offset + 4 > byteCount)
+			break;
+
+		levelByteCount = PXETCTextureParserRead32(bytes + offset, swaps);
+		offset += 4;
+
+		if (levelByteCount > byteCount - offset)
+			break;
+
+		image->levels[index] = bytes + offset;
+		image->levelByteCounts[index] = levelByteCount;
+		++image->levelCount;
+
+		offset += (levelByteCount + 3) & ~3;
+	}
+
+	if (image->levelCount == 0)
+		return NO;
+
+	// Make sure the first level is all there before decoding it
+	unsigned expectedByteCount = PXETCGetImageByteCount(image->format, image->width, image->height);
+
+	if (image->hasAlphaPlane)
+		expectedByteCount <<= 1;
+
+	return (image->levelByteCounts[0] >= expectedByteCount);
+}
+
+@implementation PXETCTextureParser
+
+- (void) dealloc
+{
+	[imageData release];
+	imageData = nil;
+
+	[super dealloc];
+}
+
+- (BOOL) isModifiable
+{
+	// Decoded images are plain pixels, compressed ones can't be changed.
+	return (imageData == nil);
+}
+
++ (BOOL) isApplicableForData:(NSData *)data origin:(NSString *)origin
+{
+	if (!data)
+	{
+		return NO;
+	}
+
+	const uint8_t *bytes = [data bytes];
+	unsigned byteCount = [data length];
+
+	return PXETCTextureParserIsPKM(bytes, byteCount) || PXETCTextureParserIsKTX(bytes, byteCount);
+}
+
++ (void) appendSupportedFileExtensions:(PXLinkedList *)extensions
+{
+	[extensions addObject:@"ktx"];
+	[extensions addObject:@"pkm"];
+}
+
+// MARK: Protected Methods
+
+//////////////////////////////////////
+// Protected method implementations //
+//////////////////////////////////////
+
+/*
+ * Keeps the levels as they are, to upload them compressed.
+ */
+- (BOOL) _keepImage:(_PXETCImage *)image
+{
+	imageData = [[NSMutableArray alloc] initWithCapacity:image->levelCount];
+
+	unsigned index;
+
+	for (index = 0; index < image->levelCount; ++index)
+	{
+		[imageData addObject:[NSData dataWithBytes:image->levels[index] length:image->levelByteCounts[index]]];
+	}
+
+	internalFormat = PX_GL_ETC1_RGB8_OES;
+
+	textureInfo->pixelFormat = PXTextureDataPixelFormat_RGB_ETC1;
+	textureInfo->size = CGSizeMake(image->width, image->height);
+
+	return YES;
+}
+
+/*
+ * Decodes the first level into a power of two sized image.
+ */
+- (BOOL) _decodeImage:(_PXETCImage *)image
+{
+	BOOL hasAlpha = image->hasAlphaPlane || (image->format == PXETCFormat_ETC2_RGBA);
+	unsigned channelCount = hasAlpha ? 4 : 3;
+
+	unsigned texWidth  = PXMathNextPowerOfTwo(image->width);
+	unsigned texHeight = PXMathNextPowerOfTwo(image->height);
+	BOOL isPowerOfTwo = (texWidth == image->width && texHeight == image->height);
+
+	textureInfo->byteCount = texWidth * texHeight * channelCount;
+	textureInfo->bytes = malloc(textureInfo->byteCount);
+
+	if (!textureInfo->bytes)
+	{
+		textureInfo->byteCount = 0;
+		return NO;
+	}
+
+	// Decode straight into the texture when the sizes are the same
+	uint8_t *pixels = isPowerOfTwo ? textureInfo->bytes : malloc(image->width * image->height * channelCount);
+	BOOL success = (pixels != NULL);
+
+	if (success)
+	{
+		if (image->hasAlphaPlane)
+			success = PXETCDecodeImageWithAlphaPlane(image->levels[0], image->width, image->height, pixels);
+		else
+			success = PXETCDecodeImage(image->levels[0], image->format, image->width, image->height, pixels, channelCount);
+	}
+
+	if (success && !isPowerOfTwo)
+	{
+		unsigned rowByteCount = image->width * channelCount;
+		unsigned y;
+
+		for (y = 0; y < image->height; ++y)
+		{
+			memcpy(textureInfo->bytes + y * texWidth * channelCount, pixels + y * rowByteCount, rowByteCount);
+		}
+	}
+
+	if (pixels != textureInfo->bytes)
+		free(pixels);
+
+	if (!success)
+	{
+		free(textureInfo->bytes);
+		textureInfo->bytes = NULL;
+		textureInfo->byteCount = 0;
+
+		return NO;
+	}
+
+	textureInfo->pixelFormat = hasAlpha ? PXTextureDataPixelFormat_RGBA8888 : PXTextureDataPixelFormat_RGB888;
+	textureInfo->size = CGSizeMake(texWidth, texHeight);
+
+	return YES;
+}
+
+- (BOOL) _parse
+{
+	if (!data)
+	{
+		return NO;
+	}
+
+	const uint8_t *bytes = [data bytes];
+	unsigned byteCount = [data length];
+
+	_PXETCImage image;
+	memset(&image, 0, sizeof(_PXETCImage));
+
+	BOOL success = NO;
+
+	if (PXETCTextureParserIsPKM(bytes, byteCount))
+		success = PXETCTextureParserReadPKM(bytes, byteCount, &image);
+	else if (PXETCTextureParserIsKTX(bytes, byteCount))
+		success = PXETCTextureParserReadKTX(bytes, byteCount, &image);
+
+	if (!success || image.width == 0 || image.height == 0)
+	{
+		PXDebugLog(@"ETC - Couldn't read the image\n");
+		return NO;
+	}
+
+	image.contentWidth  = PXMathMin(image.contentWidth,  image.width);
+	image.contentHeight = PXMathMin(image.contentHeight, image.height);
+
+	BOOL isPowerOfTwo = (PXMathNextPowerOfTwo(image.width) == image.width &&
+						 PXMathNextPowerOfTwo(image.height) == image.height);
+
+	if (image.format == PXETCFormat_ETC1 && !image.hasAlphaPlane && isPowerOfTwo &&
+		PXGLIsExtensionSupported("GL_OES_compressed_ETC1_RGB8_texture"))
+	{
+		success = [self _keepImage:&image];
+	}
+	else
+	{
+		success = [self _decodeImage:&image];
+	}
+
+	if (!success)
+	{
+		return NO;
+	}
+
+	contentSize = CGSizeMake(image.contentWidth, image.contentHeight);
+
+	// The encoder already repeated the edges into the padding of the
+	// encoded image, but not past it.
+	edgesExpanded = (textureInfo->size.width == image.width && textureInfo->size.height == image.height);
+
+	return YES;
+}
+
+- (BOOL) _initializeTexture:(GLuint)texName
+{
+	if (!imageData)
+	{
+		return [super _initializeTexture:texName];
+	}
+
+	int width = textureInfo->size.width;
+	int height = textureInfo->size.height;
+	NSData *imgDataSection;
+	GLenum err;
+
+	int mipmapsCount = [imageData count];
+
+	int i;
+	for (i = 0; i < mipmapsCount; i++)
+	{
+		imgDataSection = [imageData objectAtIndex:i];
+
+		if (!PXGLErrorValidateTexImage("glCompressedTexImage2D", i, width, height, [imgDataSection bytes]))
+		{
+			return NO;
+		}
+
+		glCompressedTexImage2D(GL_TEXTURE_2D,
+							   i, internalFormat, width, height,
+							   0, [imgDataSection length], [imgDataSection bytes]);
+
+		err = PXGLErrorCheck("glCompressedTexImage2D", texName);
+		if (err != GL_NO_ERROR)
+		{
+			NSString *desc = [NSString stringWithFormat:@"Error uploading compressed texture level: %d. glError: 0x%04X", i, err];
+			PXThrow(PXGLException, desc);
+			desc = nil;
+
+			return NO;
+		}
+
+		width = MAX(width >> 1, 1);
+		height = MAX(height >> 1, 1);
+	}
+
+	return YES;
+}
+
+- (void) _updateMipmaps
+{
+	// Compressed images bring their own mipmaps, if any
+	if (imageData)
+		return;
+
+	[super _updateMipmaps];
+}
+
+- (unsigned) _mipmapByteCount
+{
+	if (!imageData)
+	{
+		return [super _mipmapByteCount];
+	}
+
+	// Only a full chain can be used for filtering
+	unsigned levelCount = 1;
+	unsigned size = PXMathMax(textureInfo->size.width, textureInfo->size.height);
+
+	while (size > 1)
+	{
+		size >>= 1;
+		++levelCount;
+	}
+
+	if ([imageData count] < levelCount)
+		return 0;
+
+	unsigned byteCount = 0;
+	unsigned index;
+
+	for (index = 1; index < levelCount; ++index)
+	{
+		byteCount += [[imageData objectAtIndex:index] length];
+	}
+
+	return byteCount;
+}
+
+@end
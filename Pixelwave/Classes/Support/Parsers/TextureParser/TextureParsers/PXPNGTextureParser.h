@@ -46,4 +46,7 @@
 	void *vInfoPtr;
 }
 
++ (void) setPremultipliesAlpha:(BOOL)premultipliesAlpha;
++ (BOOL) premultipliesAlpha;
+
 @end
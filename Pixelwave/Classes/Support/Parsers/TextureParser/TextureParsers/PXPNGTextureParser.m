@@ -54,22 +54,42 @@
 // 1 byte = 8 bits, 8 bits * 8 (header bytes) = 64 bits.
 typedef u_int64_t _PXPNGHeader;
 
+// Everything the progressive reader callbacks need. The pixels themselves are
+// written straight into the parsed texture info, which lives on the heap, so
+// nothing here has to survive a long jump.
 typedef struct
 {
-	void *bytes;
-	void *curByte;
+	PXParsedTextureData *textureInfo;
 
-	unsigned byteCount;
-	unsigned bytePos;
-} PXPNGByteData;
+	// Content size
+	unsigned width;
+	unsigned height;
+	// Power of two size
+	unsigned texWidth;
+	unsigned texHeight;
 
-void PXPNGTextureParserLoadPNGFromBytes(png_structp pngPtr, png_bytep bytePtr, png_size_t byteCount);
+	unsigned channels;
+	unsigned rowByteCount;
+
+	bool isInterlaced;
+	bool expandEdges;
+	bool premultiplyAlpha;
+	bool isDone;
+} _PXPNGDecodeState;
+
+BOOL pxPNGTextureParserPremultipliesAlpha = NO;
+
+void PXPNGTextureParserInfoCallback(png_structp pngPtr, png_infop infoPtr);
+void PXPNGTextureParserRowCallback(png_structp pngPtr, png_bytep newRow, png_uint_32 rowNum, int pass);
+void PXPNGTextureParserEndCallback(png_structp pngPtr, png_infop infoPtr);
+
+PXInline void PXPNGDecodeStateFinishRow(_PXPNGDecodeState *state, png_bytep row);
+PXInline void PXPNGDecodeStateFinish(_PXPNGDecodeState *state);
 
 @interface PXPNGTextureParser(Private)
 + (BOOL) isPNGFromHeader:(_PXPNGHeader)header;
 
 - (void) makePNGStruct:(png_structp *)pngPtr infoStruct:(png_infop *)infoPtr;
-- (BOOL) unpackPNGFromPNG:(png_structp *)pngPtr info:(png_infop *)infoPtr;
 @end
 
 @implementation PXPNGTextureParser
@@ -101,6 +121,27 @@ void PXPNGTextureParserLoadPNGFromBytes(png_structp pngPtr, png_bytep bytePtr, p
 	return YES;
 }
 
+/**
+ * Sets whether the color channels of PNG images with alpha are multiplied by
+ * their alpha while decoding. This is only useful with a blend function that
+ * expects premultiplied colors, such as (GL_ONE, GL_ONE_MINUS_SRC_ALPHA).
+ *
+ * **Default:** NO
+ */
++ (void) setPremultipliesAlpha:(BOOL)premultipliesAlpha
+{
+	pxPNGTextureParserPremultipliesAlpha = premultipliesAlpha;
+}
+
+/**
+ * Whether the color channels of PNG images with alpha are multiplied by their
+ * alpha while decoding.
+ */
++ (BOOL) premultipliesAlpha
+{
+	return pxPNGTextureParserPremultipliesAlpha;
+}
+
 + (BOOL) isPNGFromHeader:(_PXPNGHeader)header
 {
 	// Lets make sure that the header of the png file is correct, if it is not
@@ -136,348 +177,338 @@ void PXPNGTextureParserLoadPNGFromBytes(png_structp pngPtr, png_bytep bytePtr, p
 		//*pngPtr = NULL;
 		return;
 	}
+}
 
-	if (setjmp(png_jmpbuf(*pngPtr)))
-	{
-		png_destroy_read_struct(pngPtr, infoPtr, (png_infopp)NULL);
-		PXThrow(PXException, @"PNG - Error occured, PNG long jumped away!");
+// MARK: Protected Methods
 
-		// This is done for me...
-		//*pngPtr  = NULL;
-		//*infoPtr = NULL;
-		return;
-	}
-}
+//////////////////////////////////////
+// Protected method implementations //
+//////////////////////////////////////
 
-- (BOOL) unpackPNGFromPNG:(png_structp *)pngPtr info:(png_infop *)infoPtr
+/*
+ * The image is decoded with libpng's progressive reader. Once the header has
+ * been read the power of two buffer is allocated, and every row is decoded
+ * straight into its final place in it. The alpha premultiplication and the
+ * right edge expansion are done on each row as it arrives (or once all of the
+ * passes are in, for interlaced images), so the pixels are only walked once.
+ */
+- (BOOL) _parse
 {
-	int bit_depth;
-	int color_type;
-	int interlace_type;
-	int compression_type;
-	int filter_type;
+	// Set the image data to null for now, this way if something happens
+	// and we do not load the iamge, then we know not to free any memory for it.
 
-	png_set_sig_bytes(*pngPtr, 8);
+	int byteCount = [data length];
+	void *bytes = (void *)[data bytes];
 
-	png_read_info(*pngPtr, *infoPtr);
-	png_uint_32 png_width;
-	png_uint_32 png_height;
-	png_get_IHDR(*pngPtr, *infoPtr, &png_width, &png_height, &bit_depth,
-				 &color_type, &interlace_type, &compression_type, &filter_type);
+	if (byteCount < sizeof(_PXPNGHeader))
+	{
+		PXThrow(PXException, @"PNG File had incorrect header.");
 
-	unsigned short _width = png_width;
-	unsigned short _height = png_height;
+		return NO;
+	}
 
-	png_set_strip_16(*pngPtr);
+	_PXPNGHeader *chunks = bytes;
+	_PXPNGHeader header = *chunks;
+	if (![PXPNGTextureParser isPNGFromHeader:header])
+	{
+		PXThrow(PXException, @"PNG File had incorrect header.");
 
-//	int preColorType = color_type;
-	int preChannels = png_get_channels(*pngPtr, *infoPtr);
+		return NO;
+	}
 
-//	NSLog(@"preChannels = %d, color_type = %d, compression_type = %d, filter_type = %d, BIT DEPTH = %d\n",
-//		  preChannels,
-//		  preColorType,
-//		  compression_type,
-//		  filter_type,
-//		  bit_depth);
+	png_structp *pngPtr = (png_structp *)(&vPngPtr);
+	png_infop *infoPtr = (png_infop *)(&vInfoPtr);
+	[self makePNGStruct:pngPtr infoStruct:infoPtr];
 
-	BOOL forceOneChannel = NO;
+	if (!vPngPtr || !vInfoPtr)
+	{
+		return NO;
+	}
 
-// This is not accurate, in fact, the color_type needs to be ALPHA for only
-// alpha, which is rare if at all.
-//	if (preChannels == 1 && preColorType == PNG_COLOR_TYPE_PALETTE)
-//	{
-//		forceOneChannel = YES;
-//		png_set_rgb_to_gray(*pngPtr, 1, 0, 0);
-//		png_set_swap_alpha(*pngPtr);
-//	}
+	_PXPNGDecodeState state;
+	memset(&state, 0, sizeof(_PXPNGDecodeState));
 
-	// expand paletted colors into true RGB triplets
-	if (color_type == PNG_COLOR_TYPE_PALETTE)
+	state.textureInfo = textureInfo;
+	state.expandEdges = [PXTextureData expandEdges];
+	state.premultiplyAlpha = pxPNGTextureParserPremultipliesAlpha;
+
+	png_set_progressive_read_fn(*pngPtr,
+								&state,
+								PXPNGTextureParserInfoCallback,
+								PXPNGTextureParserRowCallback,
+								PXPNGTextureParserEndCallback);
+
+	if (setjmp(png_jmpbuf(*pngPtr)))
 	{
-		png_set_expand(*pngPtr);
+		png_destroy_read_struct(pngPtr, infoPtr, (png_infopp)NULL);
+
+		free(textureInfo->bytes);
+		textureInfo->bytes = NULL;
+		textureInfo->byteCount = 0;
+
+		PXThrow(PXException, @"PNG - Error occured, PNG long jumped away!");
+
+		return NO;
 	}
 
-	// expand grayscale images to the full 8 bits from 1, 2, or 4 bits/pixel
-	//if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
-	if (preChannels == 1 && bit_depth < 8)
+	png_process_data(*pngPtr, *infoPtr, bytes, byteCount);
+
+	// The data ran out before the header did
+	if (!textureInfo->bytes)
 	{
-		png_set_expand(*pngPtr);
+		png_destroy_read_struct(pngPtr, infoPtr, (png_infopp)NULL);
+		PXThrow(PXException, @"PNG - File ended before the image began.");
+
+		return NO;
 	}
 
-	// expand paletted or RGB images with transparency to full alpha channels
-	// so the data will be available as RGBA quartets
-	if (png_get_valid(*pngPtr, *infoPtr, PNG_INFO_tRNS))
+	// The data ran out part way through the image; keep what was decoded.
+	if (!state.isDone)
 	{
-		png_set_expand(*pngPtr);
+		PXDebugLog(@"PNG - File ended before the image did.");
+		PXPNGDecodeStateFinish(&state);
 	}
 
-	png_read_update_info(*pngPtr, *infoPtr);
+	textureInfo->size = CGSizeMake(state.texWidth, state.texHeight);
+	contentSize = CGSizeMake(state.width, state.height);
+	edgesExpanded = state.expandEdges;
+	alphaPremultiplied = state.premultiplyAlpha;
 
-	if (setjmp(png_jmpbuf(*pngPtr)))
-	{
-		PXThrow(PXException, @"PNG - Error occured, PNG long jumped away!");
-		png_destroy_read_struct(pngPtr, infoPtr, (png_infopp)NULL);
+	//Lets free the memory libpng used.
+	png_destroy_read_struct(pngPtr, infoPtr, (png_infopp)NULL);
 
+	//Lets return successful
+	return YES;
+}
+
++ (BOOL) isApplicableForData:(NSData *)data origin:(NSString *)origin
+{
+	if (!data)
+	{
 		return NO;
 	}
 
-	//Lets allocate enough memory to store the image into rows (scan lines)
-	//then grab the image data.
-	unsigned int row = 0;
-	png_bytep row_pointers[_height];
-	unsigned rowBytes = png_get_rowbytes(*pngPtr, *infoPtr);
+	int byteCount = [data length];
+	const void *bytes = (void *)[data bytes];
 
-	for (row = 0; row < _height; row++)
+	if (byteCount < sizeof(_PXPNGHeader))
 	{
-		row_pointers[row] = malloc(rowBytes);
+		return NO;
 	}
 
-	png_read_image(*pngPtr, row_pointers);
+	const _PXPNGHeader *chunks = bytes;
+	const _PXPNGHeader header = *chunks;
+
+	return [PXPNGTextureParser isPNGFromHeader:header];
+}
++ (void) appendSupportedFileExtensions:(PXLinkedList *)extensions
+{
+	[extensions addObject:@"png"];
+}
 
-	//We need to convert the image to a power of 2 by power of 2 image, so
-	//lets increase the size until it fits.  We only need to do this if the
-	//image isn't already a power of 2 in size.
+@end
 
-	const unsigned texWidth  = PXMathNextPowerOfTwo(_width);
-	const unsigned texHeight = PXMathNextPowerOfTwo(_height);
+// MARK: -
+// MARK: Progressive reader
+// MARK: -
 
-	//If the image used red, green, blue and alpha then we need to allocate
-	//4 bytes for each pixel, however if it only uses red, green and blue then
-	//we only need to allocate 3 bytes.
-	//Lets also grab the difference in width (bytes) so we can properly transfer
-	//the data later
-	// -------------------- Changed from info->color_type
+/*
+ * Called once the header has been read. Sets up the transformations and
+ * allocates the power of two buffer the rows are decoded into.
+ */
+void PXPNGTextureParserInfoCallback(png_structp pngPtr, png_infop infoPtr)
+{
+	_PXPNGDecodeState *state = (_PXPNGDecodeState *)(png_get_progressive_ptr(pngPtr));
+	PXParsedTextureData *textureInfo = state->textureInfo;
+
+	int bit_depth;
+	int color_type;
+	int interlace_type;
+	int compression_type;
+	int filter_type;
+
+	png_uint_32 png_width;
+	png_uint_32 png_height;
+	png_get_IHDR(pngPtr, infoPtr, &png_width, &png_height, &bit_depth,
+				 &color_type, &interlace_type, &compression_type, &filter_type);
+
+	png_set_strip_16(pngPtr);
+
+	int preChannels = png_get_channels(pngPtr, infoPtr);
+
+	// expand paletted colors into true RGB triplets
+	if (color_type == PNG_COLOR_TYPE_PALETTE)
+	{
+		png_set_expand(pngPtr);
+	}
 
-	const int readChannels = png_get_channels(*pngPtr, *infoPtr);
-	const int drawChannels = forceOneChannel ? 1 : readChannels;
+	// expand grayscale images to the full 8 bits from 1, 2, or 4 bits/pixel
+	if (preChannels == 1 && bit_depth < 8)
+	{
+		png_set_expand(pngPtr);
+	}
 
-	const unsigned drawWidthInBytes = drawChannels * texWidth;
-	const unsigned readWidthInBytes = readChannels * _width;
+	// expand paletted or RGB images with transparency to full alpha channels
+	// so the data will be available as RGBA quartets
+	if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS))
+	{
+		png_set_expand(pngPtr);
+	}
 
-//	NSLog (@"channel count = [said=%d, have=%d], color_type = %d\n", readChannels, drawChannels, color_type);
+	png_set_interlace_handling(pngPtr);
+	png_read_update_info(pngPtr, infoPtr);
 
-//	unsigned glFormat;
+	state->width  = png_width;
+	state->height = png_height;
+	state->texWidth  = PXMathNextPowerOfTwo(png_width);
+	state->texHeight = PXMathNextPowerOfTwo(png_height);
+	state->channels = png_get_channels(pngPtr, infoPtr);
+	state->rowByteCount = state->channels * state->texWidth;
+	state->isInterlaced = (interlace_type != PNG_INTERLACE_NONE);
 
-	switch (drawChannels)
+	switch (state->channels)
 	{
 		case 1:
 			if (color_type == PNG_COLOR_TYPE_GRAY)
-			{
-//				glFormat = GL_LUMINANCE;
 				textureInfo->pixelFormat = PXTextureDataPixelFormat_L8;
-			}
 			else
-			{
-//				glFormat = GL_ALPHA;
 				textureInfo->pixelFormat = PXTextureDataPixelFormat_A8;
-			}
 			break;
 		case 2:
-//			glFormat = GL_LUMINANCE_ALPHA;
 			textureInfo->pixelFormat = PXTextureDataPixelFormat_LA88;
 			break;
 		case 3:
-//			glFormat = GL_RGB;
 			textureInfo->pixelFormat = PXTextureDataPixelFormat_RGB888;
 			break;
 		case 4:
 		default:
-//			glFormat = GL_RGBA;
 			textureInfo->pixelFormat = PXTextureDataPixelFormat_RGBA8888;
 			break;
 	}
 
-	textureInfo->byteCount = sizeof(GLubyte) * drawWidthInBytes * texHeight;
-	textureInfo->bytes = malloc(textureInfo->byteCount);
-
-	// If we couldn't allocate enough memory then lets free what we have used
-	// and return unsuccessful
-	if (!textureInfo->bytes)
+	// Only the formats that have both color and alpha can be premultiplied
+	if (state->channels != 2 && state->channels != 4)
 	{
-		png_read_end(*pngPtr, *infoPtr);
-		png_destroy_read_struct(pngPtr, infoPtr, (png_infopp)NULL);
-
-		for (row = 0; row < _height; ++row)
-		{
-			free(row_pointers[row]);
-		}
-
-		PXThrow(PXException, @"PNG - Couldn't allocate enough memory for the picture");
-
-		return NO;
+		state->premultiplyAlpha = false;
 	}
 
-	// Loop through each of the rows and grab each pixel for the image
-	// Should we 0 out the excess width and height?
+	textureInfo->byteCount = sizeof(GLubyte) * state->rowByteCount * state->texHeight;
+	// Cleared, as rows missing from a truncated file, and the padding when the
+	// edges aren't expanded, are never written by the decoder.
+	textureInfo->bytes = calloc(textureInfo->byteCount, 1);
 
-	GLubyte *drawBytePtr = (GLubyte *)(textureInfo->bytes);
-	png_byte *readBytePtr = NULL;
-
-	int rowIndex = 0;
-
-	// This was a big change, instead of iterating through each byte ourselves
-	// and coping it, we now let memcpy copy a row at a time for us!
-	if (drawChannels == readChannels)
+	if (!textureInfo->bytes)
 	{
-		for (rowIndex = 0; rowIndex < _height; ++rowIndex)
-		{
-			// Double pointer, so can't quite increment.
-			readBytePtr = row_pointers[rowIndex];
-
-			// Copy the row into the larger texture.
-			memcpy(drawBytePtr, readBytePtr, readWidthInBytes);
-
-			// This could be done at the end of the for loop; I put it here for
-			// clarification.  The draw pointer is incremented by it's width, so
-			// that it goes down to the next row for copying.
-			drawBytePtr += drawWidthInBytes;
-		}
+		textureInfo->byteCount = 0;
+		png_error(pngPtr, "Couldn't allocate enough memory for the picture");
 	}
-	else
-	{
-		const int memCpyChannels = MIN(readChannels, drawChannels);
-		const float readDiv = readWidthInBytes / readChannels;
-		const float drawDiv = drawWidthInBytes / drawChannels;
-		const int memCpyCount = MIN(readDiv, drawDiv);
-		void *drawBytePtrBefore;
-		int colIndex;
-
-		for (rowIndex = 0; rowIndex < _height; ++rowIndex)
-		{
-			// Double pointer, so can't quite increment.
-			readBytePtr = row_pointers[rowIndex];
-			drawBytePtrBefore = drawBytePtr;
-
-			for (colIndex = 0; colIndex < memCpyCount; ++colIndex)
-			{
-				memcpy(drawBytePtr, readBytePtr, memCpyChannels);
-				readBytePtr += readChannels;
-				drawBytePtr += drawChannels;
-			}
+}
 
-			drawBytePtr = drawBytePtrBefore;
-			// This could be done at the end of the for loop; I put it here for
-			// clarification.  The draw pointer is incremented by it's width, so
-			// that it goes down to the next row for copying.
-			drawBytePtr += drawWidthInBytes;
-		}
-	}
+void PXPNGTextureParserRowCallback(png_structp pngPtr, png_bytep newRow, png_uint_32 rowNum, int pass)
+{
+	_PXPNGDecodeState *state = (_PXPNGDecodeState *)(png_get_progressive_ptr(pngPtr));
 
-	textureInfo->size = CGSizeMake(texWidth, texHeight);
-	contentSize = CGSizeMake(_width, _height);
+	// This row didn't change during this pass
+	if (!newRow || rowNum >= state->height)
+		return;
 
-	//Lets make it into an opengl texture, and store it to video memory.
+	png_bytep row = state->textureInfo->bytes + rowNum * state->rowByteCount;
 
-	//Lets free the memory libpng used.
-	png_read_end(*pngPtr, *infoPtr);
-	png_destroy_read_struct(pngPtr, infoPtr, (png_infopp)NULL);
+	// Merges the pixels of this pass into the ones that are already there,
+	// or just copies the row when the image isn't interlaced.
+	png_progressive_combine_row(pngPtr, row, newRow);
 
-	//Lets free the memory we used for the rows
-	for (row = 0; row < _height; ++row)
+	// An interlaced row isn't complete until the last pass, so those are
+	// finished once the whole image is in.
+	if (!state->isInterlaced)
 	{
-		free(row_pointers[row]);
+		PXPNGDecodeStateFinishRow(state, row);
 	}
-
-	//Lets return successful
-	return YES;
 }
 
-// MARK: Protected Methods
+void PXPNGTextureParserEndCallback(png_structp pngPtr, png_infop infoPtr)
+{
+	_PXPNGDecodeState *state = (_PXPNGDecodeState *)(png_get_progressive_ptr(pngPtr));
 
-//////////////////////////////////////
-// Protected method implementations //
-//////////////////////////////////////
+	PXPNGDecodeStateFinish(state);
+}
 
-- (BOOL) _parse
+/*
+ * Premultiplies the row, and copies its last pixel across the padding to the
+ * right of it.
+ */
+PXInline void PXPNGDecodeStateFinishRow(_PXPNGDecodeState *state, png_bytep row)
 {
-	// Set the image data to null for now, this way if something happens
-	// and we do not load the iamge, then we know not to free any memory for it.
-
-	int byteCount = [data length];
-	void *bytes = (void *)[data bytes];
+	unsigned channels = state->channels;
 
-	if (byteCount < sizeof(_PXPNGHeader))
+	if (state->premultiplyAlpha)
 	{
-		PXThrow(PXException, @"PNG File had incorrect header.");
+		png_bytep pixel = row;
+		png_bytep end = row + state->width * channels;
+		unsigned alphaIndex = channels - 1;
+		unsigned alpha;
+		unsigned index;
 
-		return NO;
-	}
+		for (; pixel < end; pixel += channels)
+		{
+			alpha = pixel[alphaIndex];
 
-	_PXPNGHeader *chunks = bytes;
-	_PXPNGHeader header = *chunks;
-	if (![PXPNGTextureParser isPNGFromHeader:header])
-	{
-		PXThrow(PXException, @"PNG File had incorrect header.");
+			if (alpha == 0xFF)
+				continue;
 
-		return NO;
+			for (index = 0; index < alphaIndex; ++index)
+			{
+				pixel[index] = (pixel[index] * alpha + 127) / 0xFF;
+			}
+		}
 	}
 
-	png_structp *pngPtr = (png_structp *)(&vPngPtr);
-	png_infop *infoPtr = (png_infop *)(&vInfoPtr);
-	[self makePNGStruct:pngPtr infoStruct:infoPtr];
-
-	if (!vPngPtr || !vInfoPtr)
+	if (state->expandEdges && state->texWidth > state->width && state->width > 0)
 	{
-		return NO;
-	}
-
-	PXPNGByteData byteData;
-
-	byteData.bytes = bytes;
-	byteData.bytePos = sizeof(_PXPNGHeader);
-	byteData.curByte = bytes + byteData.bytePos;
-	byteData.byteCount = byteCount;
+		png_bytep lastPixel = row + (state->width - 1) * channels;
+		png_bytep pixel = lastPixel + channels;
+		png_bytep end = row + state->rowByteCount;
 
-	png_set_read_fn(*pngPtr, &byteData, PXPNGTextureParserLoadPNGFromBytes);
-
-	if (!vPngPtr || !vInfoPtr)
-	{
-		return NO;
+		for (; pixel < end; pixel += channels)
+		{
+			memcpy(pixel, lastPixel, channels);
+		}
 	}
-
-	return [self unpackPNGFromPNG:pngPtr info:infoPtr];
 }
 
-+ (BOOL) isApplicableForData:(NSData *)data origin:(NSString *)origin
+/*
+ * Finishes the interlaced rows, and copies the last row down across the
+ * padding below it. Only ever called once.
+ */
+PXInline void PXPNGDecodeStateFinish(_PXPNGDecodeState *state)
 {
-	if (!data)
-	{
-		return NO;
-	}
-
-	int byteCount = [data length];
-	const void *bytes = (void *)[data bytes];
+	if (state->isDone)
+		return;
 
-	if (byteCount < sizeof(_PXPNGHeader))
-	{
-		return NO;
-	}
+	state->isDone = true;
 
-	const _PXPNGHeader *chunks = bytes;
-	const _PXPNGHeader header = *chunks;
+	png_bytep bytes = state->textureInfo->bytes;
 
-	return [PXPNGTextureParser isPNGFromHeader:header];
-}
-+ (void) appendSupportedFileExtensions:(PXLinkedList *)extensions
-{
-	[extensions addObject:@"png"];
-}
-
-@end
+	if (!bytes)
+		return;
 
-void PXPNGTextureParserLoadPNGFromBytes(png_structp pngPtr, png_bytep bytePtr, png_size_t byteCount)
-{
-	PXPNGByteData *byteData = (PXPNGByteData *)(png_get_io_ptr(pngPtr));
+	unsigned row;
 
-	if (byteData->bytePos + byteCount > byteData->byteCount)
+	if (state->isInterlaced)
 	{
-		return;
+		for (row = 0; row < state->height; ++row)
+		{
+			PXPNGDecodeStateFinishRow(state, bytes + row * state->rowByteCount);
+		}
 	}
 
-	png_voidp curPtr = byteData->curByte;
-
-	memcpy(bytePtr, curPtr, byteCount);
+	if (state->expandEdges && state->texHeight > state->height && state->height > 0)
+	{
+		png_bytep lastRow = bytes + (state->height - 1) * state->rowByteCount;
 
-	byteData->bytePos += byteCount;
-	byteData->curByte += byteCount;
+		for (row = state->height; row < state->texHeight; ++row)
+		{
+			memcpy(bytes + row * state->rowByteCount, lastRow, state->rowByteCount);
+		}
+	}
 }
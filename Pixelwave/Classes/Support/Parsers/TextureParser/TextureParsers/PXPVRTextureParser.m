@@ -44,6 +44,8 @@
 
 #import "PXExceptionUtils.h"
 
+#include "PXGLErrorUtils.h"
+
 typedef enum
 {
 	PVRTCType_2 = 24,
@@ -333,11 +335,17 @@ typedef struct _PVRTexHeader
 	for (i = 0; i < mipmapsCount; i++)
 	{
 		imgDataSection = [imageData objectAtIndex:i];
+
+		if (!PXGLErrorValidateTexImage("glCompressedTexImage2D", i, width, height, [imgDataSection bytes]))
+		{
+			return NO;
+		}
+
 		glCompressedTexImage2D(GL_TEXTURE_2D,
 							   i, internalFormat, width, height,
 							   0, [imgDataSection length], [imgDataSection bytes]);
 
-		err = glGetError();
+		err = PXGLErrorCheck("glCompressedTexImage2D", texName);
 		if (err != GL_NO_ERROR)
 		{
 			NSString *desc = [NSString stringWithFormat:@"Error uploading compressed texture level: %d. glError: 0x%04X", i, err];
@@ -0,0 +1,289 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXADPCMUtils.h"
+
+static const int8_t pxADPCMIndexTable[16] =
+{
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static const int16_t pxADPCMStepTable[89] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+	19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+	130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+	337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+	876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+	2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+	5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+	15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+typedef struct
+{
+	int32_t predictor;
+	int32_t index;
+} _PXADPCMState;
+
+// MARK: -
+// MARK: - Codec
+// MARK: -
+
+PXInline void _PXADPCMStateStep(_PXADPCMState *state, uint8_t code)
+{
+	int32_t step = pxADPCMStepTable[state->index];
+	int32_t delta = step >> 3;
+
+	if (code & 4)
+		delta += step;
+	if (code & 2)
+		delta += step >> 1;
+	if (code & 1)
+		delta += step >> 2;
+
+	state->predictor += (code & 8) ? -delta : delta;
+
+	if (state->predictor > INT16_MAX)
+		state->predictor = INT16_MAX;
+	else if (state->predictor < INT16_MIN)
+		state->predictor = INT16_MIN;
+
+	state->index += pxADPCMIndexTable[code];
+
+	if (state->index < 0)
+		state->index = 0;
+	else if (state->index > 88)
+		state->index = 88;
+}
+
+PXInline uint8_t _PXADPCMEncodeSample(_PXADPCMState *state, int32_t sample)
+{
+	int32_t step = pxADPCMStepTable[state->index];
+	int32_t diff = sample - state->predictor;
+	uint8_t code = 0;
+
+	if (diff < 0)
+	{
+		code = 8;
+		diff = -diff;
+	}
+
+	if (diff >= step)
+	{
+		code |= 4;
+		diff -= step;
+	}
+	step >>= 1;
+	if (diff >= step)
+	{
+		code |= 2;
+		diff -= step;
+	}
+	step >>= 1;
+	if (diff >= step)
+	{
+		code |= 1;
+	}
+
+	// Track the decoder exactly so that error does not accumulate.
+	_PXADPCMStateStep(state, code);
+
+	return code;
+}
+
+PXInline_c unsigned PXADPCMGetBlockCount(unsigned frameCount)
+{
+	return (frameCount + PX_ADPCM_BLOCK_FRAMES - 1) / PX_ADPCM_BLOCK_FRAMES;
+}
+
+PXInline_c unsigned PXADPCMGetByteCount(unsigned frameCount, unsigned channelCount)
+{
+	return PXADPCMGetBlockCount(frameCount) * channelCount * PX_ADPCM_BLOCK_CHANNEL_BYTES;
+}
+
+/*
+ * Encodes frameCount interleaved 16 bit frames. write must have room for
+ * PXADPCMGetByteCount(frameCount, channelCount) bytes.
+ */
+void PXADPCMEncode(const int16_t *samples, unsigned frameCount, unsigned channelCount, uint8_t *write)
+{
+	_PXADPCMState states[2] = {{0, 0}, {0, 0}};
+
+	unsigned blockCount = PXADPCMGetBlockCount(frameCount);
+	unsigned blockIndex;
+	unsigned blockFrameCount;
+	unsigned channel;
+	unsigned index;
+
+	const int16_t *read;
+	_PXADPCMState *state;
+	uint8_t code;
+
+	memset(write, 0, PXADPCMGetByteCount(frameCount, channelCount));
+
+	for (blockIndex = 0; blockIndex < blockCount; ++blockIndex, samples += PX_ADPCM_BLOCK_FRAMES * channelCount)
+	{
+		blockFrameCount = frameCount - blockIndex * PX_ADPCM_BLOCK_FRAMES;
+
+		if (blockFrameCount > PX_ADPCM_BLOCK_FRAMES)
+		{
+			blockFrameCount = PX_ADPCM_BLOCK_FRAMES;
+		}
+
+		for (channel = 0; channel < channelCount; ++channel, write += PX_ADPCM_BLOCK_CHANNEL_BYTES)
+		{
+			state = states + channel;
+			read = samples + channel;
+
+			// The first sample is stored as is
+			state->predictor = *read;
+
+			write[0] = (uint8_t)(state->predictor & 0xFF);
+			write[1] = (uint8_t)((state->predictor >> 8) & 0xFF);
+			write[2] = (uint8_t)(state->index);
+			write[3] = 0;
+
+			for (index = 1, read += channelCount; index < blockFrameCount; ++index, read += channelCount)
+			{
+				code = _PXADPCMEncodeSample(state, *read);
+
+				if (index & 1)
+					write[4 + ((index - 1) >> 1)] = code;
+				else
+					write[4 + ((index - 1) >> 1)] |= code << 4;
+			}
+		}
+	}
+}
+
+/*
+ * Decodes the first frameCount frames (at most PX_ADPCM_BLOCK_FRAMES) of a
+ * single block into interleaved 16 bit frames.
+ */
+void PXADPCMDecodeBlock(const uint8_t *block, unsigned channelCount, unsigned frameCount, int16_t *write)
+{
+	_PXADPCMState state;
+
+	unsigned channel;
+	unsigned index;
+
+	const uint8_t *codes;
+	int16_t *curWrite;
+	uint8_t code;
+
+	if (frameCount > PX_ADPCM_BLOCK_FRAMES)
+	{
+		frameCount = PX_ADPCM_BLOCK_FRAMES;
+	}
+
+	for (channel = 0; channel < channelCount; ++channel, block += PX_ADPCM_BLOCK_CHANNEL_BYTES)
+	{
+		state.predictor = (int16_t)(block[0] | (block[1] << 8));
+		state.index = block[2];
+
+		if (state.index > 88)
+		{
+			state.index = 88;
+		}
+
+		curWrite = write + channel;
+		*curWrite = state.predictor;
+		curWrite += channelCount;
+
+		codes = block + 4;
+
+		for (index = 1; index < frameCount; ++index, curWrite += channelCount)
+		{
+			code = (index & 1) ? (*codes & 0x0F) : ((*codes >> 4) & 0x0F);
+
+			if (!(index & 1))
+			{
+				++codes;
+			}
+
+			_PXADPCMStateStep(&state, code);
+			*curWrite = state.predictor;
+		}
+	}
+}
+
+/*
+ * Decodes frameCount frames starting at any frame, crossing block boundaries
+ * as needed.
+ */
+void PXADPCMDecode(const uint8_t *bytes, unsigned channelCount, unsigned firstFrame, unsigned frameCount, int16_t *write)
+{
+	int16_t scratch[PX_ADPCM_BLOCK_FRAMES << 1];
+
+	unsigned blockBytes = PX_ADPCM_BLOCK_CHANNEL_BYTES * channelCount;
+	unsigned blockIndex;
+	unsigned blockOffset;
+	unsigned count;
+
+	while (frameCount > 0)
+	{
+		blockIndex = firstFrame / PX_ADPCM_BLOCK_FRAMES;
+		blockOffset = firstFrame - blockIndex * PX_ADPCM_BLOCK_FRAMES;
+
+		count = PX_ADPCM_BLOCK_FRAMES - blockOffset;
+
+		if (count > frameCount)
+		{
+			count = frameCount;
+		}
+
+		if (blockOffset == 0)
+		{
+			// Decode straight into place
+			PXADPCMDecodeBlock(bytes + blockIndex * blockBytes, channelCount, count, write);
+		}
+		else
+		{
+			PXADPCMDecodeBlock(bytes + blockIndex * blockBytes, channelCount, blockOffset + count, scratch);
+			memcpy(write, scratch + blockOffset * channelCount, count * channelCount * sizeof(int16_t));
+		}
+
+		write += count * channelCount;
+		firstFrame += count;
+		frameCount -= count;
+	}
+}
@@ -0,0 +1,74 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_ADPCM_UTILS_H_
+#define _PX_ADPCM_UTILS_H_
+
+#include "PXHeaderUtils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * IMA ADPCM, stored in fixed size blocks so that any block can be decoded on
+ * its own. Each block holds PX_ADPCM_BLOCK_FRAMES frames; within a block every
+ * channel gets PX_ADPCM_BLOCK_CHANNEL_BYTES bytes, one channel after the
+ * other:
+ *
+ *	[int16 first sample (little endian)][uint8 step index][uint8 unused]
+ *	[(PX_ADPCM_BLOCK_FRAMES - 1) 4 bit codes, low nibble first]
+ *
+ * The last block is padded out to the full size.
+ */
+#define PX_ADPCM_BLOCK_CHANNEL_BYTES 512
+#define PX_ADPCM_BLOCK_FRAMES (((PX_ADPCM_BLOCK_CHANNEL_BYTES - 4) << 1) + 1)
+
+PXInline_h unsigned PXADPCMGetBlockCount(unsigned frameCount);
+PXInline_h unsigned PXADPCMGetByteCount(unsigned frameCount, unsigned channelCount);
+
+void PXADPCMEncode(const int16_t *samples, unsigned frameCount, unsigned channelCount, uint8_t *write);
+void PXADPCMDecodeBlock(const uint8_t *block, unsigned channelCount, unsigned frameCount, int16_t *write);
+void PXADPCMDecode(const uint8_t *bytes, unsigned channelCount, unsigned firstFrame, unsigned frameCount, int16_t *write);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
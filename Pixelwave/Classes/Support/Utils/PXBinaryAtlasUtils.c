@@ -0,0 +1,221 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXBinaryAtlasUtils.h"
+
+#include <string.h>
+
+static const char pxBinaryAtlasMagic[4] = {'P', 'X', 'A', 'T'};
+
+/*
+ * Whether count items of the given size fit in the file, starting at the
+ * (4 byte aligned) offset.
+ */
+PXInline bool PXBinaryAtlasFits(uint32_t offset, uint32_t count, size_t size, size_t length)
+{
+	if ((offset & 3) != 0 || offset > length)
+		return false;
+
+	return (uint64_t)count * size <= (uint64_t)(length - offset);
+}
+
+/*
+ * The 32 bit FNV-1a hash of the bytes of a name.
+ */
+uint32_t PXBinaryAtlasHash(const char *name, size_t length)
+{
+	const uint8_t *byte = (const uint8_t *)name;
+	uint32_t hash = 2166136261u;
+
+	for (; length > 0; --length, ++byte)
+	{
+		hash ^= *byte;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+bool PXBinaryAtlasIsBinaryAtlas(const void *bytes, size_t length)
+{
+	if (!bytes || length < sizeof(PXBinaryAtlasHeader))
+		return false;
+
+	return memcmp(bytes, pxBinaryAtlasMagic, sizeof(pxBinaryAtlasMagic)) == 0;
+}
+
+/*
+ * Checks that everything in the file stays within its bytes, so that lookups
+ * don't have to, and points the atlas at its parts. This walks the frames
+ * and buckets once, but doesn't allocate anything.
+ *
+ * @return Whether the bytes are a valid binary atlas.
+ */
+bool PXBinaryAtlasInit(PXBinaryAtlas *atlas, const void *bytes, size_t length)
+{
+	if (!atlas || !PXBinaryAtlasIsBinaryAtlas(bytes, length))
+		return false;
+
+	// The structs are read in place
+	if (((uintptr_t)bytes & 3) != 0)
+		return false;
+
+	const uint8_t *base = (const uint8_t *)bytes;
+	const PXBinaryAtlasHeader *header = (const PXBinaryAtlasHeader *)bytes;
+
+	if (header->version != PX_BINARY_ATLAS_VERSION)
+		return false;
+
+	uint32_t frameCount = header->frameCount;
+	uint32_t imageCount = header->imageCount;
+	uint32_t bucketCount = header->bucketCount;
+	uint32_t stringsLength = header->stringsLength;
+
+	if (frameCount == 0 || imageCount == 0 || imageCount > 0xFFFF)
+		return false;
+	// Leaves an empty bucket for lookups to stop at
+	if (bucketCount <= frameCount || (bucketCount & (bucketCount - 1)) != 0)
+		return false;
+
+	if (!PXBinaryAtlasFits(header->imagesOffset, imageCount, sizeof(uint32_t), length) ||
+		!PXBinaryAtlasFits(header->framesOffset, frameCount, sizeof(PXBinaryAtlasFrame), length) ||
+		!PXBinaryAtlasFits(header->bucketsOffset, bucketCount, sizeof(uint32_t), length) ||
+		header->stringsOffset > length || stringsLength > length - header->stringsOffset)
+	{
+		return false;
+	}
+
+	const uint32_t *imageNames = (const uint32_t *)(base + header->imagesOffset);
+	const PXBinaryAtlasFrame *frames = (const PXBinaryAtlasFrame *)(base + header->framesOffset);
+	const uint32_t *buckets = (const uint32_t *)(base + header->bucketsOffset);
+	const char *strings = (const char *)(base + header->stringsOffset);
+
+	if (stringsLength == 0 || strings[stringsLength - 1] != '\0')
+		return false;
+
+	uint32_t index;
+
+	for (index = 0; index < imageCount; ++index)
+	{
+		if (imageNames[index] >= stringsLength)
+			return false;
+	}
+
+	const PXBinaryAtlasFrame *frame;
+
+	for (index = 0, frame = frames; index < frameCount; ++index, ++frame)
+	{
+		if (frame->imageIndex >= imageCount)
+			return false;
+		if (frame->nameOffset >= stringsLength || frame->nameLength >= stringsLength - frame->nameOffset)
+			return false;
+		if (strings[frame->nameOffset + frame->nameLength] != '\0')
+			return false;
+	}
+
+	for (index = 0; index < bucketCount; ++index)
+	{
+		if (buckets[index] > frameCount)
+			return false;
+	}
+
+	atlas->header = header;
+	atlas->imageNames = imageNames;
+	atlas->frames = frames;
+	atlas->buckets = buckets;
+	atlas->strings = strings;
+
+	return true;
+}
+
+/*
+ * Finds the frame with the given name.
+ *
+ * @param name The UTF-8 bytes of the name, which don't have to end in 0.
+ * @param length The amount of bytes in the name.
+ *
+ * @return The frame, or NULL if the atlas doesn't have one by that name.
+ */
+const PXBinaryAtlasFrame *PXBinaryAtlasFindFrame(const PXBinaryAtlas *atlas, const char *name, size_t length)
+{
+	if (!atlas || !atlas->header || !name)
+		return NULL;
+
+	uint32_t hash = PXBinaryAtlasHash(name, length);
+	uint32_t bucketCount = atlas->header->bucketCount;
+	uint32_t mask = bucketCount - 1;
+	uint32_t index = hash & mask;
+
+	uint32_t probeCount;
+	uint32_t entry;
+	const PXBinaryAtlasFrame *frame;
+
+	// Bounded, in case a file without empty buckets got past PXBinaryAtlasInit
+	for (probeCount = 0; probeCount < bucketCount; ++probeCount, index = (index + 1) & mask)
+	{
+		entry = atlas->buckets[index];
+
+		if (entry == 0)
+			return NULL;
+
+		frame = &atlas->frames[entry - 1];
+
+		if (frame->nameHash == hash &&
+			frame->nameLength == length &&
+			memcmp(atlas->strings + frame->nameOffset, name, length) == 0)
+		{
+			return frame;
+		}
+	}
+
+	return NULL;
+}
+
+const char *PXBinaryAtlasGetFrameName(const PXBinaryAtlas *atlas, const PXBinaryAtlasFrame *frame)
+{
+	return atlas->strings + frame->nameOffset;
+}
+
+const char *PXBinaryAtlasGetImageName(const PXBinaryAtlas *atlas, unsigned index)
+{
+	if (index >= atlas->header->imageCount)
+		return NULL;
+
+	return atlas->strings + atlas->imageNames[index];
+}
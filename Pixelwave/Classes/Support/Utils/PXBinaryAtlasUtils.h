@@ -0,0 +1,144 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_BINARY_ATLAS_UTILS_H_
+#define _PX_BINARY_ATLAS_UTILS_H_
+
+#include "PXHeaderUtils.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PX_BINARY_ATLAS_VERSION 1
+
+/*
+ * A texture atlas definition that can be used straight from the bytes of the
+ * file, without parsing it. Made from TexturePacker and Zwoptex files by
+ * Tools/pxatlas, which has to be kept in sync with these structs.
+ *
+ * Everything is little endian and 4 byte aligned. Offsets are from the start
+ * of the file, and the names in the string table are UTF-8 and end in 0.
+ *
+ * The layout is:
+ *
+ *	PXBinaryAtlasHeader
+ *	uint32_t imageNames[imageCount]		(offsets into the string table)
+ *	PXBinaryAtlasFrame frames[frameCount]
+ *	uint32_t buckets[bucketCount]		(0 or frame index + 1)
+ *	char strings[stringsLength]
+ *
+ * The buckets are an open addressed hash table of the frame names, probed
+ * linearly from PXBinaryAtlasHash(name) & (bucketCount - 1). There is always
+ * at least one empty bucket.
+ */
+
+typedef struct
+{
+	char magic[4];			// "PXAT"
+	uint16_t version;
+	uint16_t reserved;
+
+	uint32_t frameCount;
+	uint32_t imageCount;
+	uint32_t bucketCount;	// Power of two
+
+	uint32_t imagesOffset;
+	uint32_t framesOffset;
+	uint32_t bucketsOffset;
+	uint32_t stringsOffset;
+	uint32_t stringsLength;
+} PXBinaryAtlasHeader; // 40 - bytes
+
+typedef enum
+{
+	PXBinaryAtlasFrameFlag_Padding = 0x0001,
+	PXBinaryAtlasFrameFlag_Anchor = 0x0002
+} PXBinaryAtlasFrameFlag;
+
+/*
+ * The values are the ones the TexturePacker and Zwoptex parsers would come
+ * up with, in pixels: the clip rect is already swapped for rotated frames,
+ * and the padding goes top, right, bottom, left. The anchor is in percent.
+ */
+typedef struct
+{
+	uint32_t nameOffset;
+	uint32_t nameHash;
+	uint16_t nameLength;	// In bytes, without the 0
+	uint16_t imageIndex;
+	uint16_t flags;			// PXBinaryAtlasFrameFlag
+	uint16_t reserved;
+
+	float x, y, width, height;
+	float rotation;
+	float padding[4];
+	float anchorX, anchorY;
+} PXBinaryAtlasFrame; // 60 - bytes
+
+/*
+ * Points into the bytes of a file checked by PXBinaryAtlasInit. The bytes
+ * must outlive it.
+ */
+typedef struct
+{
+	const PXBinaryAtlasHeader *header;
+	const uint32_t *imageNames;
+	const PXBinaryAtlasFrame *frames;
+	const uint32_t *buckets;
+	const char *strings;
+} PXBinaryAtlas;
+
+uint32_t PXBinaryAtlasHash(const char *name, size_t length);
+
+bool PXBinaryAtlasIsBinaryAtlas(const void *bytes, size_t length);
+bool PXBinaryAtlasInit(PXBinaryAtlas *atlas, const void *bytes, size_t length);
+
+const PXBinaryAtlasFrame *PXBinaryAtlasFindFrame(const PXBinaryAtlas *atlas, const char *name, size_t length);
+const char *PXBinaryAtlasGetFrameName(const PXBinaryAtlas *atlas, const PXBinaryAtlasFrame *frame);
+const char *PXBinaryAtlasGetImageName(const PXBinaryAtlas *atlas, unsigned index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -173,13 +173,14 @@ CGImageRef PXCGUtilsCreateCGImageFromTextureData(PXTextureData *textureData)
 
 	PXTextureDataPixelFormat pixelFormat = textureData.pixelFormat;
 
-	// Evidently PVR can't be converted to RGBA8888 reliably...
+	// Evidently compressed formats can't be converted to RGBA8888 reliably...
 	if (pixelFormat == PXTextureDataPixelFormat_RGB_PVRTC2 ||
 		pixelFormat == PXTextureDataPixelFormat_RGB_PVRTC4 ||
 		pixelFormat == PXTextureDataPixelFormat_RGBA_PVRTC2 ||
-		pixelFormat == PXTextureDataPixelFormat_RGBA_PVRTC4)
+		pixelFormat == PXTextureDataPixelFormat_RGBA_PVRTC4 ||
+		pixelFormat == PXTextureDataPixelFormat_RGB_ETC1)
 	{
-		PXDebugLog(@"Warning: PXTextureData in compressed PVR pixel format cannot be converted to a CGImage");
+		PXDebugLog(@"Warning: PXTextureData in a compressed pixel format cannot be converted to a CGImage");
 		return nil;
 	}
 
@@ -52,6 +52,7 @@ typedef enum
 	PXDebugSetting_CountGLCalls					= 0x00000008,
 	PXDebugSetting_LogErrors					= 0x00000010,
 	PXDebugSetting_DrawHitAreas					= 0x00000020,
+	PXDebugSetting_SynchronousGLErrors			= 0x00000040,
 	PXDebugSetting_All							= 0xFFFFFFFF
 } PXDebugSetting;
 
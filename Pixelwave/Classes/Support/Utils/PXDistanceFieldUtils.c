@@ -0,0 +1,342 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXDistanceFieldUtils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define PX_DISTANCE_FIELD_INF 1e20f
+#define PX_DISTANCE_FIELD_MAX_THREADS 8
+
+typedef struct
+{
+	PXDistanceFieldGlyph *glyphs;
+	unsigned count;
+	unsigned scale;
+	unsigned spread;
+
+	// The index of the next glyph to make, shared by every worker.
+	volatile int next;
+} _PXDistanceFieldWork;
+
+// MARK: -
+// MARK: Distance Transform
+// MARK: -
+
+/*
+ * One dimensional squared euclidean distance transform (Felzenszwalb &
+ * Huttenlocher). Reads `count` values `stride` apart from `f`, and writes the
+ * result back in place. `d`, `v` and `z` are scratch buffers of at least
+ * `count`, `count` and `count + 1` elements.
+ */
+PXInline void _PXDistanceFieldTransform1D(float *f, unsigned count, unsigned stride, float *d, int *v, float *z)
+{
+	int k = 0;
+	unsigned q;
+	float s;
+
+	v[0] = 0;
+	z[0] = -PX_DISTANCE_FIELD_INF;
+	z[1] =  PX_DISTANCE_FIELD_INF;
+
+	for (q = 1; q < count; ++q)
+	{
+		do
+		{
+			int p = v[k];
+			s = ((f[q * stride] + q * q) - (f[p * stride] + p * p)) / (float)((q - p) << 1);
+		} while (s <= z[k] && --k >= 0);
+
+		++k;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = PX_DISTANCE_FIELD_INF;
+	}
+
+	for (q = 0, k = 0; q < count; ++q)
+	{
+		while (z[k + 1] < q)
+			++k;
+
+		float dq = (float)q - v[k];
+		d[q] = dq * dq + f[v[k] * stride];
+	}
+
+	for (q = 0; q < count; ++q)
+		f[q * stride] = d[q];
+}
+
+PXInline void _PXDistanceFieldTransform2D(float *grid, unsigned width, unsigned height, float *d, int *v, float *z)
+{
+	unsigned index;
+
+	for (index = 0; index < width; ++index)
+		_PXDistanceFieldTransform1D(grid + index, height, width, d, v, z);
+	for (index = 0; index < height; ++index)
+		_PXDistanceFieldTransform1D(grid + index * width, width, 1, d, v, z);
+}
+
+// MARK: -
+// MARK: Fields
+// MARK: -
+
+PXInline_c void PXDistanceFieldGetSize(unsigned width, unsigned height,
+									   unsigned scale, unsigned spread,
+									   unsigned *retWidth, unsigned *retHeight)
+{
+	if (scale == 0)
+		scale = 1;
+
+	if (retWidth)
+		*retWidth  = ((width  + scale - 1) / scale) + (spread << 1);
+	if (retHeight)
+		*retHeight = ((height + scale - 1) / scale) + (spread << 1);
+}
+
+/*
+ * Makes the distance field for a single glyph. The coverage is thresholded
+ * at half and the distance to the nearest pixel on the other side of the edge
+ * is found for every pixel, both on the inside and the outside. Each field
+ * pixel then takes the distance at the center of the `scale` x `scale` block
+ * of coverage it covers.
+ */
+bool PXDistanceFieldMake(PXDistanceFieldGlyph *glyph, unsigned scale, unsigned spread)
+{
+	if (!glyph)
+		return false;
+
+	glyph->field = NULL;
+
+	// Nothing to draw, so nothing to make.
+	if (glyph->width == 0 || glyph->height == 0 || !glyph->bytes)
+	{
+		glyph->fieldWidth = 0;
+		glyph->fieldHeight = 0;
+
+		return true;
+	}
+
+	PXDistanceFieldGetSize(glyph->width, glyph->height, scale, spread, &(glyph->fieldWidth), &(glyph->fieldHeight));
+
+	if (scale == 0)
+		scale = 1;
+	if (spread == 0)
+		spread = 1;
+
+	unsigned fieldWidth  = glyph->fieldWidth;
+	unsigned fieldHeight = glyph->fieldHeight;
+
+	glyph->field = malloc(fieldWidth * fieldHeight);
+	if (!glyph->field)
+		return false;
+
+	unsigned gridWidth  = fieldWidth  * scale;
+	unsigned gridHeight = fieldHeight * scale;
+	unsigned gridCount  = gridWidth * gridHeight;
+	unsigned gridMax    = gridWidth > gridHeight ? gridWidth : gridHeight;
+	unsigned padding    = spread * scale;
+
+	// Distance to the nearest inside pixel, and to the nearest outside pixel.
+	float *outside = malloc(sizeof(float) * gridCount);
+	float *inside  = malloc(sizeof(float) * gridCount);
+	float *d = malloc(sizeof(float) * gridMax);
+	float *z = malloc(sizeof(float) * (gridMax + 1));
+	int *v = malloc(sizeof(int) * gridMax);
+
+	if (!outside || !inside || !d || !z || !v)
+	{
+		free(outside);
+		free(inside);
+		free(d);
+		free(z);
+		free(v);
+
+		free(glyph->field);
+		glyph->field = NULL;
+
+		return false;
+	}
+
+	unsigned x;
+	unsigned y;
+	unsigned index;
+	unsigned char coverage;
+
+	for (y = 0, index = 0; y < gridHeight; ++y)
+	{
+		for (x = 0; x < gridWidth; ++x, ++index)
+		{
+			coverage = 0;
+
+			if (x >= padding && y >= padding &&
+				x - padding < glyph->width && y - padding < glyph->height)
+			{
+				coverage = glyph->bytes[(y - padding) * glyph->pitch + (x - padding)];
+			}
+
+			if (coverage >= 128)
+			{
+				outside[index] = 0.0f;
+				inside[index] = PX_DISTANCE_FIELD_INF;
+			}
+			else
+			{
+				outside[index] = PX_DISTANCE_FIELD_INF;
+				inside[index] = 0.0f;
+			}
+		}
+	}
+
+	_PXDistanceFieldTransform2D(outside, gridWidth, gridHeight, d, v, z);
+	_PXDistanceFieldTransform2D(inside,  gridWidth, gridHeight, d, v, z);
+
+	// Distances are measured in grid pixels, the field stores them in field
+	// pixels scaled so that `spread` reaches the end of the byte range.
+	float toField = 127.0f / (float)(spread * scale);
+	unsigned half = scale >> 1;
+
+	unsigned char *write = glyph->field;
+	float distance;
+	int value;
+
+	for (y = 0; y < fieldHeight; ++y)
+	{
+		for (x = 0; x < fieldWidth; ++x, ++write)
+		{
+			index = (y * scale + half) * gridWidth + (x * scale + half);
+
+			// The edge lies half way between the two pixels.
+			if (outside[index] > 0.0f)
+				distance = sqrtf(outside[index]) - 0.5f;
+			else
+				distance = 0.5f - sqrtf(inside[index]);
+
+			value = 128 - (int)lroundf(distance * toField);
+
+			if (value < 0)
+				value = 0;
+			else if (value > 255)
+				value = 255;
+
+			*write = (unsigned char)value;
+		}
+	}
+
+	free(outside);
+	free(inside);
+	free(d);
+	free(z);
+	free(v);
+
+	return true;
+}
+
+// MARK: -
+// MARK: Threads
+// MARK: -
+
+static void *_PXDistanceFieldWorker(void *vWork)
+{
+	_PXDistanceFieldWork *work = (_PXDistanceFieldWork *)vWork;
+	int index;
+
+	while ((index = __sync_fetch_and_add(&(work->next), 1)) < (int)(work->count))
+	{
+		PXDistanceFieldMake(work->glyphs + index, work->scale, work->spread);
+	}
+
+	return NULL;
+}
+
+/*
+ * Makes the distance field of every glyph, spreading them across
+ * `threadCount` threads (the calling thread included). Glyphs whose field
+ * could not be made are left with a NULL field.
+ */
+void PXDistanceFieldMakeGlyphs(PXDistanceFieldGlyph *glyphs, unsigned count,
+							   unsigned scale, unsigned spread,
+							   unsigned threadCount)
+{
+	if (!glyphs || count == 0)
+		return;
+
+	_PXDistanceFieldWork work;
+	work.glyphs = glyphs;
+	work.count = count;
+	work.scale = scale;
+	work.spread = spread;
+	work.next = 0;
+
+	if (threadCount > count)
+		threadCount = count;
+	if (threadCount > PX_DISTANCE_FIELD_MAX_THREADS)
+		threadCount = PX_DISTANCE_FIELD_MAX_THREADS;
+
+	pthread_t threads[PX_DISTANCE_FIELD_MAX_THREADS];
+	unsigned threadIndex;
+	unsigned startedCount = 0;
+
+	// The calling thread is one of the workers.
+	for (threadIndex = 1; threadIndex < threadCount; ++threadIndex)
+	{
+		if (pthread_create(threads + startedCount, NULL, _PXDistanceFieldWorker, &work) == 0)
+			++startedCount;
+	}
+
+	_PXDistanceFieldWorker(&work);
+
+	for (threadIndex = 0; threadIndex < startedCount; ++threadIndex)
+	{
+		pthread_join(threads[threadIndex], NULL);
+	}
+}
+
+unsigned PXDistanceFieldGetDefaultThreadCount()
+{
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (count < 1)
+		return 1;
+
+	return (unsigned)count;
+}
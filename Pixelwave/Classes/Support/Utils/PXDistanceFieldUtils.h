@@ -0,0 +1,89 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_DISTANCE_FIELD_UTILS_H_
+#define _PX_DISTANCE_FIELD_UTILS_H_
+
+#include "PXHeaderUtils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Signed distance fields are made from a coverage bitmap rendered `scale`
+ * times larger than the field. Each field pixel stores the distance to the
+ * nearest edge, mapped so that 128 is on the edge, 255 is `spread` field
+ * pixels inside it and 0 is `spread` field pixels outside of it. The field is
+ * padded by `spread` pixels on every side so the outside of the edge can be
+ * stored.
+ */
+#define PX_DISTANCE_FIELD_SCALE 4
+#define PX_DISTANCE_FIELD_SPREAD 4
+
+typedef struct
+{
+	// Coverage bitmap, one byte per pixel.
+	const unsigned char *bytes;
+	unsigned width;
+	unsigned height;
+	int pitch;
+
+	// Filled in by PXDistanceFieldMake, free with free().
+	unsigned char *field;
+	unsigned fieldWidth;
+	unsigned fieldHeight;
+} PXDistanceFieldGlyph;
+
+PXInline_h void PXDistanceFieldGetSize(unsigned width, unsigned height,
+									   unsigned scale, unsigned spread,
+									   unsigned *retWidth, unsigned *retHeight);
+
+bool PXDistanceFieldMake(PXDistanceFieldGlyph *glyph, unsigned scale, unsigned spread);
+void PXDistanceFieldMakeGlyphs(PXDistanceFieldGlyph *glyphs, unsigned count,
+							   unsigned scale, unsigned spread,
+							   unsigned threadCount);
+
+unsigned PXDistanceFieldGetDefaultThreadCount();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
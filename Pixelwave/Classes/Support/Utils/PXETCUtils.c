@@ -0,0 +1,497 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXETCUtils.h"
+
+#include "PXMathUtils.h"
+
+/*
+ * Each block is a big endian 64 bit word. The top 32 bits pick the base
+ * colors and tables, the bottom 32 are two bit planes of 16 pixel indices,
+ * most significant bits first. Pixels are indexed down the columns, so pixel
+ * (x, y) is at bit x * 4 + y of each plane.
+ */
+
+const int pxETCCodewordTable[8][2] =
+{
+	{ 2,   8},
+	{ 5,  17},
+	{ 9,  29},
+	{13,  42},
+	{18,  60},
+	{24,  80},
+	{33, 106},
+	{47, 183}
+};
+
+// Used by the ETC2 T and H modes
+const int pxETCDistanceTable[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+const int pxETCAlphaModifierTable[16][8] =
+{
+	{-3, -6,  -9, -15, 2, 5, 8, 14},
+	{-3, -7, -10, -13, 2, 6, 9, 12},
+	{-2, -5,  -8, -13, 1, 4, 7, 12},
+	{-2, -4,  -6, -13, 1, 3, 5, 12},
+	{-3, -6,  -8, -12, 2, 5, 7, 11},
+	{-3, -7,  -9, -11, 2, 6, 8, 10},
+	{-4, -7,  -8, -11, 3, 6, 7, 10},
+	{-3, -5,  -8, -11, 2, 4, 7, 10},
+	{-2, -6,  -8, -10, 1, 5, 7,  9},
+	{-2, -5,  -8, -10, 1, 4, 7,  9},
+	{-2, -4,  -8, -10, 1, 3, 7,  9},
+	{-2, -5,  -7, -10, 1, 4, 6,  9},
+	{-3, -4,  -7, -10, 2, 3, 6,  9},
+	{-1, -2,  -3, -10, 0, 1, 2,  9},
+	{-4, -6,  -8,  -9, 3, 5, 7,  8},
+	{-3, -5,  -7,  -9, 2, 4, 6,  8}
+};
+
+PXInline uint8_t PXETCClamp(int val)
+{
+	return (val < 0) ? 0 : ((val > 255) ? 255 : val);
+}
+
+PXInline uint8_t PXETCExtend4(unsigned val)
+{
+	return (val << 4) | val;
+}
+
+PXInline uint8_t PXETCExtend5(unsigned val)
+{
+	return (val << 3) | (val >> 2);
+}
+
+PXInline uint8_t PXETCExtend6(unsigned val)
+{
+	return (val << 2) | (val >> 4);
+}
+
+PXInline uint8_t PXETCExtend7(unsigned val)
+{
+	return (val << 1) | (val >> 6);
+}
+
+PXInline int PXETCSigned3(unsigned val)
+{
+	return (val & 0x4) ? ((int)val - 8) : (int)val;
+}
+
+PXInline unsigned PXETCPixelIndex(uint32_t indices, unsigned x, unsigned y)
+{
+	unsigned bit = (x << 2) | y;
+
+	return (((indices >> (bit + 16)) & 0x1) << 1) | ((indices >> bit) & 0x1);
+}
+
+PXInline void PXETCSetPixel(uint8_t *pixels, unsigned pixelStride, unsigned rowStride, unsigned x, unsigned y, int r, int g, int b)
+{
+	uint8_t *pixel = pixels + y * rowStride + x * pixelStride;
+
+	pixel[0] = PXETCClamp(r);
+	pixel[1] = PXETCClamp(g);
+	pixel[2] = PXETCClamp(b);
+}
+
+/*
+ * The ETC1 modes: two sub blocks (side by side, or on top of each other when
+ * flipped), each with a base color that a table of luminance offsets is added
+ * to.
+ */
+PXInline void PXETCDecodeSubBlocks(uint32_t high, uint32_t indices, const uint8_t colors[2][3], uint8_t *pixels, unsigned pixelStride, unsigned rowStride)
+{
+	unsigned tables[2] = {(high >> 5) & 0x7, (high >> 2) & 0x7};
+	bool flip = (high & 0x1);
+
+	// Pixel index 0 and 1 add the two offsets, 2 and 3 subtract them
+	static const int signs[4] = {1, 1, -1, -1};
+	static const int columns[4] = {0, 1, 0, 1};
+
+	unsigned x, y;
+	unsigned subBlock;
+	unsigned index;
+	int offset;
+
+	for (y = 0; y < 4; ++y)
+	{
+		for (x = 0; x < 4; ++x)
+		{
+			subBlock = flip ? (y >> 1) : (x >> 1);
+			index = PXETCPixelIndex(indices, x, y);
+			offset = signs[index] * pxETCCodewordTable[tables[subBlock]][columns[index]];
+
+			PXETCSetPixel(pixels, pixelStride, rowStride, x, y,
+						  colors[subBlock][0] + offset,
+						  colors[subBlock][1] + offset,
+						  colors[subBlock][2] + offset);
+		}
+	}
+}
+
+/*
+ * The ETC2 T and H modes: four colors made from two base colors and a
+ * distance, picked straight from the pixel indices.
+ */
+PXInline void PXETCDecodePaintColors(uint32_t indices, const int paint[4][3], uint8_t *pixels, unsigned pixelStride, unsigned rowStride)
+{
+	unsigned x, y;
+	unsigned index;
+
+	for (y = 0; y < 4; ++y)
+	{
+		for (x = 0; x < 4; ++x)
+		{
+			index = PXETCPixelIndex(indices, x, y);
+
+			PXETCSetPixel(pixels, pixelStride, rowStride, x, y,
+						  paint[index][0], paint[index][1], paint[index][2]);
+		}
+	}
+}
+
+PXInline void PXETCDecodeTMode(const uint8_t *block, uint32_t indices, uint8_t *pixels, unsigned pixelStride, unsigned rowStride)
+{
+	int c0[3] = {PXETCExtend4(((block[0] & 0x18) >> 1) | (block[0] & 0x3)), PXETCExtend4(block[1] >> 4), PXETCExtend4(block[1] & 0xF)};
+	int c1[3] = {PXETCExtend4(block[2] >> 4), PXETCExtend4(block[2] & 0xF), PXETCExtend4(block[3] >> 4)};
+	int d = pxETCDistanceTable[((block[3] >> 1) & 0x6) | (block[3] & 0x1)];
+
+	int paint[4][3] =
+	{
+		{c0[0], c0[1], c0[2]},
+		{c1[0] + d, c1[1] + d, c1[2] + d},
+		{c1[0], c1[1], c1[2]},
+		{c1[0] - d, c1[1] - d, c1[2] - d}
+	};
+
+	PXETCDecodePaintColors(indices, paint, pixels, pixelStride, rowStride);
+}
+
+PXInline void PXETCDecodeHMode(const uint8_t *block, uint32_t indices, uint8_t *pixels, unsigned pixelStride, unsigned rowStride)
+{
+	unsigned r0 = (block[0] >> 3) & 0xF;
+	unsigned g0 = ((block[0] & 0x7) << 1) | ((block[1] >> 4) & 0x1);
+	unsigned b0 = (block[1] & 0x8) | ((block[1] & 0x3) << 1) | (block[2] >> 7);
+	unsigned r1 = (block[2] >> 3) & 0xF;
+	unsigned g1 = ((block[2] & 0x7) << 1) | (block[3] >> 7);
+	unsigned b1 = (block[3] >> 3) & 0xF;
+
+	// The lowest bit of the distance is whether the first color is the larger
+	unsigned distanceIndex = (block[3] & 0x4) | ((block[3] & 0x1) << 1);
+	if (((r0 << 8) | (g0 << 4) | b0) >= ((r1 << 8) | (g1 << 4) | b1))
+		distanceIndex |= 0x1;
+
+	int d = pxETCDistanceTable[distanceIndex];
+
+	int c0[3] = {PXETCExtend4(r0), PXETCExtend4(g0), PXETCExtend4(b0)};
+	int c1[3] = {PXETCExtend4(r1), PXETCExtend4(g1), PXETCExtend4(b1)};
+
+	int paint[4][3] =
+	{
+		{c0[0] + d, c0[1] + d, c0[2] + d},
+		{c0[0] - d, c0[1] - d, c0[2] - d},
+		{c1[0] + d, c1[1] + d, c1[2] + d},
+		{c1[0] - d, c1[1] - d, c1[2] - d}
+	};
+
+	PXETCDecodePaintColors(indices, paint, pixels, pixelStride, rowStride);
+}
+
+/*
+ * The ETC2 planar mode: a gradient through three colors, at the origin, the
+ * right and the bottom of the block.
+ */
+PXInline void PXETCDecodePlanarMode(const uint8_t *block, uint8_t *pixels, unsigned pixelStride, unsigned rowStride)
+{
+	int o[3] =
+	{
+		PXETCExtend6((block[0] >> 1) & 0x3F),
+		PXETCExtend7(((block[0] & 0x1) << 6) | ((block[1] >> 1) & 0x3F)),
+		PXETCExtend6(((block[1] & 0x1) << 5) | (block[2] & 0x18) | ((block[2] & 0x3) << 1) | (block[3] >> 7))
+	};
+	int h[3] =
+	{
+		PXETCExtend6((((block[3] >> 2) & 0x1F) << 1) | (block[3] & 0x1)),
+		PXETCExtend7((block[4] >> 1) & 0x7F),
+		PXETCExtend6(((block[4] & 0x1) << 5) | (block[5] >> 3))
+	};
+	int v[3] =
+	{
+		PXETCExtend6(((block[5] & 0x7) << 3) | (block[6] >> 5)),
+		PXETCExtend7(((block[6] & 0x1F) << 2) | (block[7] >> 6)),
+		PXETCExtend6(block[7] & 0x3F)
+	};
+
+	int x, y;
+
+	for (y = 0; y < 4; ++y)
+	{
+		for (x = 0; x < 4; ++x)
+		{
+			PXETCSetPixel(pixels, pixelStride, rowStride, x, y,
+						  (x * (h[0] - o[0]) + y * (v[0] - o[0]) + 4 * o[0] + 2) >> 2,
+						  (x * (h[1] - o[1]) + y * (v[1] - o[1]) + 4 * o[1] + 2) >> 2,
+						  (x * (h[2] - o[2]) + y * (v[2] - o[2]) + 4 * o[2] + 2) >> 2);
+		}
+	}
+}
+
+/**
+ * Decodes a block of color into 4x4 pixels. Only the first three channels of
+ * each pixel are written.
+ *
+ * @param isETC2 Whether the block may use the ETC2 modes. In ETC1 those bit
+ * patterns aren't valid, and are decoded as ETC1 blocks.
+ */
+void PXETCDecodeColorBlock(const uint8_t *block, uint8_t *pixels, unsigned pixelStride, unsigned rowStride, bool isETC2)
+{
+	uint32_t high = ((uint32_t)block[0] << 24) | ((uint32_t)block[1] << 16) | ((uint32_t)block[2] << 8) | block[3];
+	uint32_t indices = ((uint32_t)block[4] << 24) | ((uint32_t)block[5] << 16) | ((uint32_t)block[6] << 8) | block[7];
+
+	uint8_t colors[2][3];
+
+	if (high & 0x2)
+	{
+		// Differential mode, a 555 color and a signed 333 difference
+		int r = (high >> 27) & 0x1F;
+		int g = (high >> 19) & 0x1F;
+		int b = (high >> 11) & 0x1F;
+		int r2 = r + PXETCSigned3((high >> 24) & 0x7);
+		int g2 = g + PXETCSigned3((high >> 16) & 0x7);
+		int b2 = b + PXETCSigned3((high >> 8) & 0x7);
+
+		if (isETC2)
+		{
+			// The second color overflowing switches to one of the ETC2 modes
+			if (r2 < 0 || r2 > 31)
+			{
+				PXETCDecodeTMode(block, indices, pixels, pixelStride, rowStride);
+				return;
+			}
+			if (g2 < 0 || g2 > 31)
+			{
+				PXETCDecodeHMode(block, indices, pixels, pixelStride, rowStride);
+				return;
+			}
+			if (b2 < 0 || b2 > 31)
+			{
+				PXETCDecodePlanarMode(block, pixels, pixelStride, rowStride);
+				return;
+			}
+		}
+
+		colors[0][0] = PXETCExtend5(r);
+		colors[0][1] = PXETCExtend5(g);
+		colors[0][2] = PXETCExtend5(b);
+		colors[1][0] = PXETCExtend5(r2 & 0x1F);
+		colors[1][1] = PXETCExtend5(g2 & 0x1F);
+		colors[1][2] = PXETCExtend5(b2 & 0x1F);
+	}
+	else
+	{
+		// Individual mode, two 444 colors
+		colors[0][0] = PXETCExtend4((high >> 28) & 0xF);
+		colors[0][1] = PXETCExtend4((high >> 20) & 0xF);
+		colors[0][2] = PXETCExtend4((high >> 12) & 0xF);
+		colors[1][0] = PXETCExtend4((high >> 24) & 0xF);
+		colors[1][1] = PXETCExtend4((high >> 16) & 0xF);
+		colors[1][2] = PXETCExtend4((high >> 8) & 0xF);
+	}
+
+	PXETCDecodeSubBlocks(high, indices, colors, pixels, pixelStride, rowStride);
+}
+
+/**
+ * Decodes an EAC alpha block into the first channel of 4x4 pixels. The
+ * indices are 3 bits each, in the same column order as the color blocks.
+ */
+void PXETCDecodeAlphaBlock(const uint8_t *block, uint8_t *pixels, unsigned pixelStride, unsigned rowStride)
+{
+	int base = block[0];
+	int multiplier = block[1] >> 4;
+	const int *modifiers = pxETCAlphaModifierTable[block[1] & 0xF];
+
+	uint64_t indices = 0;
+	unsigned index;
+
+	for (index = 2; index < 8; ++index)
+	{
+		indices = (indices << 8) | block[index];
+	}
+
+	unsigned x, y;
+	unsigned bit;
+
+	for (x = 0; x < 4; ++x)
+	{
+		for (y = 0; y < 4; ++y)
+		{
+			bit = 45 - ((x << 2) | y) * 3;
+
+			pixels[y * rowStride + x * pixelStride] = PXETCClamp(base + modifiers[(indices >> bit) & 0x7] * multiplier);
+		}
+	}
+}
+
+unsigned PXETCGetBlockByteCount(PXETCFormat format)
+{
+	return (format == PXETCFormat_ETC2_RGBA) ? 16 : 8;
+}
+
+/**
+ * The amount of bytes an image takes up. Partial blocks at the right and
+ * bottom edges take up a full block.
+ */
+unsigned PXETCGetImageByteCount(PXETCFormat format, unsigned width, unsigned height)
+{
+	return ((width + 3) >> 2) * ((height + 3) >> 2) * PXETCGetBlockByteCount(format);
+}
+
+/*
+ * Copies the part of a decoded block that is inside of the image.
+ */
+PXInline void PXETCCopyBlock(const uint8_t *block, uint8_t *dst, unsigned channelCount, unsigned rowStride, unsigned blockWidth, unsigned blockHeight)
+{
+	unsigned y;
+
+	for (y = 0; y < blockHeight; ++y)
+	{
+		memcpy(dst + y * rowStride, block + y * 4 * channelCount, blockWidth * channelCount);
+	}
+}
+
+/**
+ * Decodes a whole image into RGB888 (a channel count of 3) or RGBA8888 (a
+ * channel count of 4) pixels. Images without alpha come out opaque.
+ *
+ * @return false if the format or channel count isn't valid.
+ */
+bool PXETCDecodeImage(const void *src, PXETCFormat format, unsigned width, unsigned height, void *dst, unsigned channelCount)
+{
+	if (!src || !dst || (channelCount != 3 && channelCount != 4))
+		return false;
+
+	if (format != PXETCFormat_ETC1 && format != PXETCFormat_ETC2_RGB && format != PXETCFormat_ETC2_RGBA)
+		return false;
+
+	bool isETC2 = (format != PXETCFormat_ETC1);
+	bool hasAlpha = (format == PXETCFormat_ETC2_RGBA);
+
+	const uint8_t *block = src;
+	uint8_t *pixels = dst;
+	unsigned rowStride = width * channelCount;
+
+	uint8_t decoded[4 * 4 * 4];
+	unsigned blockRowStride = 4 * channelCount;
+
+	// Opaque unless the alpha blocks say otherwise
+	if (channelCount == 4)
+		memset(decoded, 0xFF, sizeof(decoded));
+
+	unsigned x, y;
+
+	for (y = 0; y < height; y += 4)
+	{
+		for (x = 0; x < width; x += 4)
+		{
+			if (hasAlpha)
+			{
+				if (channelCount == 4)
+					PXETCDecodeAlphaBlock(block, decoded + 3, channelCount, blockRowStride);
+
+				block += 8;
+			}
+
+			PXETCDecodeColorBlock(block, decoded, channelCount, blockRowStride, isETC2);
+			block += 8;
+
+			PXETCCopyBlock(decoded, pixels + y * rowStride + x * channelCount, channelCount, rowStride,
+						   PXMathMin(4, width - x), PXMathMin(4, height - y));
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Decodes an ETC1 image that carries its alpha in a second, gray image below
+ * the colors (so there are twice as many block rows as the height needs)
+ * into RGBA8888 pixels.
+ */
+bool PXETCDecodeImageWithAlphaPlane(const void *src, unsigned width, unsigned height, void *dst)
+{
+	if (!src || !dst)
+		return false;
+
+	if (!PXETCDecodeImage(src, PXETCFormat_ETC1, width, height, dst, 4))
+		return false;
+
+	const uint8_t *block = (const uint8_t *)src + PXETCGetImageByteCount(PXETCFormat_ETC1, width, height);
+	uint8_t *pixels = dst;
+	unsigned rowStride = width << 2;
+
+	uint8_t decoded[4 * 4 * 3];
+
+	unsigned x, y;
+	unsigned blockX, blockY;
+	unsigned blockWidth, blockHeight;
+
+	for (y = 0; y < height; y += 4)
+	{
+		blockHeight = PXMathMin(4, height - y);
+
+		for (x = 0; x < width; x += 4)
+		{
+			PXETCDecodeColorBlock(block, decoded, 3, 4 * 3, false);
+			block += 8;
+
+			blockWidth = PXMathMin(4, width - x);
+
+			// The alpha is stored as gray, green has the most precision
+			for (blockY = 0; blockY < blockHeight; ++blockY)
+			{
+				for (blockX = 0; blockX < blockWidth; ++blockX)
+				{
+					pixels[(y + blockY) * rowStride + ((x + blockX) << 2) + 3] = decoded[(blockY * 4 + blockX) * 3 + 1];
+				}
+			}
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,82 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_ETC_UTILS_H_
+#define _PX_ETC_UTILS_H_
+
+#include "PXHeaderUtils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The gl names of the formats, which the iOS headers don't define
+#define PX_GL_ETC1_RGB8_OES					0x8D64
+#define PX_GL_COMPRESSED_RGB8_ETC2			0x9274
+#define PX_GL_COMPRESSED_RGBA8_ETC2_EAC		0x9278
+
+/*
+ * ETC1 and ETC2 RGB store each 4x4 block of pixels in 8 bytes. ETC2 RGBA puts
+ * an 8 byte EAC alpha block before each color block.
+ */
+typedef enum
+{
+	PXETCFormat_ETC1 = 0,
+	PXETCFormat_ETC2_RGB,
+	PXETCFormat_ETC2_RGBA
+} PXETCFormat;
+
+PXExtern const int pxETCCodewordTable[8][2];
+PXExtern const int pxETCDistanceTable[8];
+PXExtern const int pxETCAlphaModifierTable[16][8];
+
+unsigned PXETCGetBlockByteCount(PXETCFormat format);
+unsigned PXETCGetImageByteCount(PXETCFormat format, unsigned width, unsigned height);
+
+void PXETCDecodeColorBlock(const uint8_t *block, uint8_t *pixels, unsigned pixelStride, unsigned rowStride, bool isETC2);
+void PXETCDecodeAlphaBlock(const uint8_t *block, uint8_t *pixels, unsigned pixelStride, unsigned rowStride);
+
+bool PXETCDecodeImage(const void *src, PXETCFormat format, unsigned width, unsigned height, void *dst, unsigned channelCount);
+bool PXETCDecodeImageWithAlphaPlane(const void *src, unsigned width, unsigned height, void *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
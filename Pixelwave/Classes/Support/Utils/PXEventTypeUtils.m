@@ -0,0 +1,153 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXEventTypeUtils.h"
+
+#include <pthread.h>
+
+// Events can be made on the loading threads, so the table is locked. The
+// lookup doesn't allocate, and happens once per type change rather than once
+// per dispatch.
+pthread_mutex_t pxEventTypeMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// type string -> ID
+CFMutableDictionaryRef pxEventTypeIDs = NULL;
+
+// ID -> type string. Index 0 is PXEventTypeNone and is never filled in.
+NSString **pxEventTypeNames = NULL;
+unsigned int pxEventTypeCount = 1;
+unsigned int pxEventTypeCapacity = 0;
+
+/*
+ * Returns the ID of the given event type, registering it if this is the first
+ * time the type has been seen.
+ *
+ * @param type The event type.
+ *
+ * @return The ID of the type, or PXEventTypeNone if `type` is nil.
+ */
+PXEventTypeID PXEventTypeIntern(NSString *type)
+{
+	if (!type)
+		return PXEventTypeNone;
+
+	pthread_mutex_lock(&pxEventTypeMutex);
+
+	if (!pxEventTypeIDs)
+	{
+		pxEventTypeIDs = CFDictionaryCreateMutable(NULL, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+	}
+
+	const void *value = NULL;
+	PXEventTypeID typeID;
+
+	if (CFDictionaryGetValueIfPresent(pxEventTypeIDs, type, &value))
+	{
+		typeID = (PXEventTypeID)((intptr_t)value);
+	}
+	else
+	{
+		if (pxEventTypeCount >= pxEventTypeCapacity)
+		{
+			pxEventTypeCapacity = pxEventTypeCapacity ? pxEventTypeCapacity << 1 : 32;
+			pxEventTypeNames = realloc(pxEventTypeNames, sizeof(NSString *) * pxEventTypeCapacity);
+		}
+
+		typeID = pxEventTypeCount;
+		++pxEventTypeCount;
+
+		// The type may be mutable, so a copy is used as the key.
+		NSString *name = [type copy];
+		pxEventTypeNames[typeID] = name;
+
+		CFDictionarySetValue(pxEventTypeIDs, name, (const void *)((intptr_t)typeID));
+	}
+
+	pthread_mutex_unlock(&pxEventTypeMutex);
+
+	return typeID;
+}
+
+/*
+ * Returns the ID of the given event type without registering it. A type which
+ * was never registered can't have any listeners.
+ *
+ * @param type The event type.
+ *
+ * @return The ID of the type, or PXEventTypeNone if it has never been
+ * registered.
+ */
+PXEventTypeID PXEventTypeFind(NSString *type)
+{
+	if (!type)
+		return PXEventTypeNone;
+
+	const void *value = NULL;
+
+	pthread_mutex_lock(&pxEventTypeMutex);
+
+	if (pxEventTypeIDs)
+	{
+		CFDictionaryGetValueIfPresent(pxEventTypeIDs, type, &value);
+	}
+
+	pthread_mutex_unlock(&pxEventTypeMutex);
+
+	return (PXEventTypeID)((intptr_t)value);
+}
+
+/*
+ * Returns the event type that the given ID was made for, or nil if the ID was
+ * never handed out.
+ */
+NSString *PXEventTypeGetName(PXEventTypeID typeID)
+{
+	NSString *name = nil;
+
+	pthread_mutex_lock(&pxEventTypeMutex);
+
+	if (typeID != PXEventTypeNone && typeID < pxEventTypeCount)
+	{
+		name = pxEventTypeNames[typeID];
+	}
+
+	pthread_mutex_unlock(&pxEventTypeMutex);
+
+	return name;
+}
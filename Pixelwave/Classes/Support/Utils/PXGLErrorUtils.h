@@ -0,0 +1,77 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_GL_ERROR_UTILS_H_
+#define _PX_GL_ERROR_UTILS_H_
+
+#include "PXHeaderUtils.h"
+
+#include "inkGL.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// How many of the most recent operations an error is attributed to
+#define PX_GL_ERROR_TAG_COUNT 8
+
+/*
+ * glGetError makes the cpu wait for the gpu to catch up, which on tile based
+ * gpus means waiting for the whole frame. Instead of asking after every call,
+ * operations that may fail are tagged and the errors are collected once per
+ * frame by PXGLErrorFlush, which blames the last PX_GL_ERROR_TAG_COUNT tags.
+ *
+ * When PXDebugSetting_SynchronousGLErrors is on (debug builds only),
+ * PXGLErrorCheck asks gl right away instead.
+ */
+
+PXExtern void PXGLErrorTag(const char *operation, GLuint name);
+PXExtern GLenum PXGLErrorCheck(const char *operation, GLuint name);
+PXExtern unsigned PXGLErrorFlush();
+
+PXExtern bool PXGLErrorIsSynchronous();
+PXExtern unsigned PXGLErrorGetCount();
+
+PXExtern bool PXGLErrorValidateTexImage(const char *operation, GLint level, GLsizei width, GLsizei height, const GLvoid *bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXGLErrorUtils.h"
+
+#import "PXDebug.h"
+#import "PXDebugUtils.h"
+
+#include "PXGL.h"
+
+// gl keeps one flag per kind of error, so a frame can't leave more than a
+// handful of them behind.
+#define PX_GL_ERROR_MAX_FLAG_COUNT 8
+
+typedef struct
+{
+	const char *operation;
+	GLuint name;
+} _PXGLErrorTag;
+
+_PXGLErrorTag pxGLErrorTags[PX_GL_ERROR_TAG_COUNT];
+unsigned pxGLErrorTagIndex = 0;
+unsigned pxGLErrorTagCount = 0;
+
+unsigned pxGLErrorCount = 0;
+
+const char *PXGLErrorInfo(GLenum error);
+
+/*
+ * Remembers that the operation was performed, so that errors found by the
+ * next flush can be attributed to it.
+ *
+ * @param operation A string literal naming the operation, such as
+ * "glTexImage2D". Only the pointer is kept.
+ * @param name The gl name of the object the operation was performed on, or 0.
+ */
+void PXGLErrorTag(const char *operation, GLuint name)
+{
+	_PXGLErrorTag *tag = &pxGLErrorTags[pxGLErrorTagIndex];
+
+	tag->operation = operation;
+	tag->name = name;
+
+	pxGLErrorTagIndex = (pxGLErrorTagIndex + 1) % PX_GL_ERROR_TAG_COUNT;
+
+	if (pxGLErrorTagCount < PX_GL_ERROR_TAG_COUNT)
+		++pxGLErrorTagCount;
+}
+
+/*
+ * Checks the operation that was just performed for errors. Unless
+ * synchronous checks are on, this only tags the operation and returns
+ * GL_NO_ERROR; any error it caused is reported by the next PXGLErrorFlush.
+ *
+ * @return The gl error, or GL_NO_ERROR.
+ */
+GLenum PXGLErrorCheck(const char *operation, GLuint name)
+{
+	if (!PXGLErrorIsSynchronous())
+	{
+		PXGLErrorTag(operation, name);
+
+		return GL_NO_ERROR;
+	}
+
+	GLenum error = glGetError();
+
+	if (error != GL_NO_ERROR)
+	{
+		++pxGLErrorCount;
+	}
+
+	return error;
+}
+
+/*
+ * Collects the errors gl raised since the last flush, logs them along with
+ * the operations tagged in the meantime, and forgets the tags. Meant to be
+ * called once per frame, after the frame has been submitted.
+ *
+ * @return The amount of errors found.
+ */
+unsigned PXGLErrorFlush()
+{
+	unsigned count = 0;
+	GLenum error;
+
+	while (count < PX_GL_ERROR_MAX_FLAG_COUNT)
+	{
+		error = glGetError();
+
+		if (error == GL_NO_ERROR)
+			break;
+
+		PXDebugLog(@"gl error [0x%X] (%s) occured during the last frame.\n", error, PXGLErrorInfo(error));
+		++count;
+	}
+
+	if (count > 0)
+	{
+		pxGLErrorCount += count;
+
+		// Oldest first
+		unsigned index = (pxGLErrorTagIndex + PX_GL_ERROR_TAG_COUNT - pxGLErrorTagCount) % PX_GL_ERROR_TAG_COUNT;
+		unsigned tagIndex;
+		_PXGLErrorTag *tag;
+
+		for (tagIndex = 0; tagIndex < pxGLErrorTagCount; ++tagIndex)
+		{
+			tag = &pxGLErrorTags[index];
+			PXDebugLog(@"    after %s on %u\n", tag->operation, tag->name);
+
+			index = (index + 1) % PX_GL_ERROR_TAG_COUNT;
+		}
+	}
+
+	pxGLErrorTagIndex = 0;
+	pxGLErrorTagCount = 0;
+
+	return count;
+}
+
+/*
+ * Whether PXGLErrorCheck asks gl for errors right away. Only ever true in
+ * debug builds, with PXDebugSetting_SynchronousGLErrors turned on.
+ */
+bool PXGLErrorIsSynchronous()
+{
+	return PXDebugIsEnabled(PXDebugSetting_SynchronousGLErrors);
+}
+
+/*
+ * The amount of gl errors found since the engine started.
+ */
+unsigned PXGLErrorGetCount()
+{
+	return pxGLErrorCount;
+}
+
+/*
+ * Checks the arguments of a texture upload against what gl accepts before
+ * handing them over, as an upload gl rejects is only reported a frame later.
+ *
+ * @return Whether the upload can go ahead.
+ */
+bool PXGLErrorValidateTexImage(const char *operation, GLint level, GLsizei width, GLsizei height, const GLvoid *bytes)
+{
+	GLint maxSize = PXGLMaxTextureSize();
+
+	if (width <= 0 || height <= 0 || (maxSize > 0 && (width > maxSize || height > maxSize)))
+	{
+		PXDebugLog(@"%s: level %d is %dx%d, gl only accepts textures up to %dx%d.\n", operation, level, width, height, maxSize, maxSize);
+
+		return false;
+	}
+
+	if (!bytes)
+	{
+		PXDebugLog(@"%s: level %d has no data to upload.\n", operation, level);
+
+		return false;
+	}
+
+	return true;
+}
+
+const char *PXGLErrorInfo(GLenum error)
+{
+	switch (error)
+	{
+		case GL_INVALID_ENUM:
+			return "invalid enum";
+		case GL_INVALID_VALUE:
+			return "invalid value";
+		case GL_INVALID_OPERATION:
+			return "invalid operation";
+		case GL_STACK_OVERFLOW:
+			return "stack overflow";
+		case GL_STACK_UNDERFLOW:
+			return "stack underflow";
+		case GL_OUT_OF_MEMORY:
+			return "out of memory";
+		case GL_INVALID_FRAMEBUFFER_OPERATION_OES:
+			return "invalid framebuffer operation";
+		default:
+			return "unknown error";
+	}
+}
@@ -0,0 +1,348 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXMaxRectsUtils.h"
+
+#include <stdlib.h>
+#include <limits.h>
+
+PXInline bool _PXMaxRectsBinPush(PXMaxRectsBin *bin, int x, int y, int width, int height);
+PXInline bool _PXMaxRectsBinSplit(PXMaxRectsBin *bin, PXMaxRectsRect freeRect, const PXMaxRectsRect *usedRect);
+PXInline bool _PXMaxRectsRectContains(const PXMaxRectsRect *a, const PXMaxRectsRect *b);
+PXInline void _PXMaxRectsBinPrune(PXMaxRectsBin *bin);
+
+bool PXMaxRectsBinInit(PXMaxRectsBin *bin, unsigned width, unsigned height)
+{
+	if (!bin)
+		return false;
+
+	bin->width = width;
+	bin->height = height;
+	bin->usedArea = 0;
+
+	bin->freeRects = NULL;
+	bin->freeCount = 0;
+	bin->freeCapacity = 0;
+
+	if (width == 0 || height == 0)
+		return true;
+
+	return _PXMaxRectsBinPush(bin, 0, 0, width, height);
+}
+
+void PXMaxRectsBinFree(PXMaxRectsBin *bin)
+{
+	if (!bin)
+		return;
+
+	free(bin->freeRects);
+
+	bin->freeRects = NULL;
+	bin->freeCount = 0;
+	bin->freeCapacity = 0;
+}
+
+/*
+ * Finds a home for a `width` x `height` rectangle and marks it as used. When
+ * `allowRotation` is true the rectangle may be placed turned on its side, in
+ * which case `retRect` holds the turned size and `retRotated` is set to true.
+ * Returns false when the rectangle doesn't fit anywhere in the bin.
+ */
+bool PXMaxRectsBinInsert(PXMaxRectsBin *bin,
+						 unsigned width, unsigned height,
+						 bool allowRotation,
+						 PXMaxRectsRect *retRect, bool *retRotated)
+{
+	if (!bin || width == 0 || height == 0)
+		return false;
+
+	int w = width;
+	int h = height;
+
+	int bestShortSide = INT_MAX;
+	int bestLongSide = INT_MAX;
+
+	PXMaxRectsRect best;
+	bool bestRotated = false;
+
+	PXMaxRectsRect *freeRect;
+	unsigned index;
+
+	for (index = 0, freeRect = bin->freeRects; index < bin->freeCount; ++index, ++freeRect)
+	{
+		int leftoverX;
+		int leftoverY;
+		int shortSide;
+		int longSide;
+
+		if (freeRect->width >= w && freeRect->height >= h)
+		{
+			leftoverX = freeRect->width - w;
+			leftoverY = freeRect->height - h;
+			shortSide = leftoverX < leftoverY ? leftoverX : leftoverY;
+			longSide  = leftoverX < leftoverY ? leftoverY : leftoverX;
+
+			if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+			{
+				best.x = freeRect->x;
+				best.y = freeRect->y;
+				best.width = w;
+				best.height = h;
+				bestRotated = false;
+
+				bestShortSide = shortSide;
+				bestLongSide = longSide;
+			}
+		}
+
+		if (allowRotation && w != h && freeRect->width >= h && freeRect->height >= w)
+		{
+			leftoverX = freeRect->width - h;
+			leftoverY = freeRect->height - w;
+			shortSide = leftoverX < leftoverY ? leftoverX : leftoverY;
+			longSide  = leftoverX < leftoverY ? leftoverY : leftoverX;
+
+			if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+			{
+				best.x = freeRect->x;
+				best.y = freeRect->y;
+				best.width = h;
+				best.height = w;
+				bestRotated = true;
+
+				bestShortSide = shortSide;
+				bestLongSide = longSide;
+			}
+		}
+	}
+
+	if (bestShortSide == INT_MAX)
+		return false;
+
+	// Split every free rectangle the new one overlaps. The pieces get appended
+	// to the end of the list, so only the original ones are walked.
+	unsigned count = bin->freeCount;
+	unsigned kept = 0;
+
+	for (index = 0; index < count; ++index)
+	{
+		PXMaxRectsRect rect = bin->freeRects[index];
+
+		if (rect.x >= best.x + best.width  || rect.x + rect.width  <= best.x ||
+			rect.y >= best.y + best.height || rect.y + rect.height <= best.y)
+		{
+			bin->freeRects[kept++] = rect;
+			continue;
+		}
+
+		if (!_PXMaxRectsBinSplit(bin, rect, &best))
+			return false;
+	}
+
+	// Move the new pieces down over the split rectangles.
+	for (index = count; index < bin->freeCount; ++index)
+	{
+		bin->freeRects[kept++] = bin->freeRects[index];
+	}
+
+	bin->freeCount = kept;
+
+	_PXMaxRectsBinPrune(bin);
+
+	bin->usedArea += width * height;
+
+	if (retRect)
+		*retRect = best;
+	if (retRotated)
+		*retRotated = bestRotated;
+
+	return true;
+}
+
+/*
+ * Makes the bin larger without touching anything already inserted. Free
+ * rectangles that reached the old right or bottom edge are stretched to the
+ * new one, and the newly covered strips are added as free space.
+ */
+bool PXMaxRectsBinGrow(PXMaxRectsBin *bin, unsigned width, unsigned height)
+{
+	if (!bin || width < bin->width || height < bin->height)
+		return false;
+
+	int oldWidth = bin->width;
+	int oldHeight = bin->height;
+	int newWidth = width;
+	int newHeight = height;
+
+	PXMaxRectsRect *freeRect;
+	unsigned index;
+
+	for (index = 0, freeRect = bin->freeRects; index < bin->freeCount; ++index, ++freeRect)
+	{
+		if (freeRect->x + freeRect->width == oldWidth)
+			freeRect->width = newWidth - freeRect->x;
+		if (freeRect->y + freeRect->height == oldHeight)
+			freeRect->height = newHeight - freeRect->y;
+	}
+
+	bin->width = width;
+	bin->height = height;
+
+	if (newWidth > oldWidth && !_PXMaxRectsBinPush(bin, oldWidth, 0, newWidth - oldWidth, newHeight))
+		return false;
+	if (newHeight > oldHeight && !_PXMaxRectsBinPush(bin, 0, oldHeight, newWidth, newHeight - oldHeight))
+		return false;
+
+	_PXMaxRectsBinPrune(bin);
+
+	return true;
+}
+
+PXInline_c float PXMaxRectsBinGetOccupancy(PXMaxRectsBin *bin)
+{
+	unsigned area = bin->width * bin->height;
+
+	if (area == 0)
+		return 0.0f;
+
+	return bin->usedArea / (float)area;
+}
+
+// MARK: -
+// MARK: Private
+// MARK: -
+
+PXInline bool _PXMaxRectsBinPush(PXMaxRectsBin *bin, int x, int y, int width, int height)
+{
+	if (bin->freeCount == bin->freeCapacity)
+	{
+		unsigned capacity = bin->freeCapacity ? bin->freeCapacity * 2 : 16;
+		PXMaxRectsRect *freeRects = realloc(bin->freeRects, sizeof(PXMaxRectsRect) * capacity);
+
+		if (!freeRects)
+			return false;
+
+		bin->freeRects = freeRects;
+		bin->freeCapacity = capacity;
+	}
+
+	PXMaxRectsRect *rect = &(bin->freeRects[bin->freeCount++]);
+
+	rect->x = x;
+	rect->y = y;
+	rect->width = width;
+	rect->height = height;
+
+	return true;
+}
+
+/*
+ * Adds the (up to four) maximal pieces of `freeRect` that are left over once
+ * `usedRect` is taken out of it. The caller makes sure the two overlap.
+ */
+PXInline bool _PXMaxRectsBinSplit(PXMaxRectsBin *bin, PXMaxRectsRect freeRect, const PXMaxRectsRect *usedRect)
+{
+	int freeRight  = freeRect.x + freeRect.width;
+	int freeBottom = freeRect.y + freeRect.height;
+	int usedRight  = usedRect->x + usedRect->width;
+	int usedBottom = usedRect->y + usedRect->height;
+
+	// Above
+	if (usedRect->y > freeRect.y)
+	{
+		if (!_PXMaxRectsBinPush(bin, freeRect.x, freeRect.y, freeRect.width, usedRect->y - freeRect.y))
+			return false;
+	}
+	// Below
+	if (usedBottom < freeBottom)
+	{
+		if (!_PXMaxRectsBinPush(bin, freeRect.x, usedBottom, freeRect.width, freeBottom - usedBottom))
+			return false;
+	}
+	// Left
+	if (usedRect->x > freeRect.x)
+	{
+		if (!_PXMaxRectsBinPush(bin, freeRect.x, freeRect.y, usedRect->x - freeRect.x, freeRect.height))
+			return false;
+	}
+	// Right
+	if (usedRight < freeRight)
+	{
+		if (!_PXMaxRectsBinPush(bin, usedRight, freeRect.y, freeRight - usedRight, freeRect.height))
+			return false;
+	}
+
+	return true;
+}
+
+PXInline bool _PXMaxRectsRectContains(const PXMaxRectsRect *a, const PXMaxRectsRect *b)
+{
+	return b->x >= a->x && b->y >= a->y &&
+		   b->x + b->width  <= a->x + a->width &&
+		   b->y + b->height <= a->y + a->height;
+}
+
+/*
+ * Removes every free rectangle that is fully covered by another one, keeping
+ * the list down to the maximal rectangles.
+ */
+PXInline void _PXMaxRectsBinPrune(PXMaxRectsBin *bin)
+{
+	unsigned i;
+	unsigned j;
+
+	for (i = 0; i < bin->freeCount; ++i)
+	{
+		for (j = i + 1; j < bin->freeCount; ++j)
+		{
+			if (_PXMaxRectsRectContains(&(bin->freeRects[j]), &(bin->freeRects[i])))
+			{
+				bin->freeRects[i] = bin->freeRects[--bin->freeCount];
+				--i;
+				break;
+			}
+
+			if (_PXMaxRectsRectContains(&(bin->freeRects[i]), &(bin->freeRects[j])))
+			{
+				bin->freeRects[j] = bin->freeRects[--bin->freeCount];
+				--j;
+			}
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_MAX_RECTS_UTILS_H_
+#define _PX_MAX_RECTS_UTILS_H_
+
+#include "PXHeaderUtils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A MaxRects bin keeps every maximal free rectangle of the area it covers.
+ * Rectangles are inserted one at a time into the free rectangle that leaves
+ * the shortest leftover side (best short side fit), so nothing that was
+ * already placed ever has to move. The free rectangles may overlap each other.
+ */
+
+typedef struct
+{
+	int x;
+	int y;
+	int width;
+	int height;
+} PXMaxRectsRect;
+
+typedef struct
+{
+	unsigned width;
+	unsigned height;
+
+	// The area covered by inserted rectangles.
+	unsigned usedArea;
+
+	PXMaxRectsRect *freeRects;
+	unsigned freeCount;
+	unsigned freeCapacity;
+} PXMaxRectsBin;
+
+bool PXMaxRectsBinInit(PXMaxRectsBin *bin, unsigned width, unsigned height);
+void PXMaxRectsBinFree(PXMaxRectsBin *bin);
+
+bool PXMaxRectsBinInsert(PXMaxRectsBin *bin,
+						 unsigned width, unsigned height,
+						 bool allowRotation,
+						 PXMaxRectsRect *retRect, bool *retRotated);
+
+bool PXMaxRectsBinGrow(PXMaxRectsBin *bin, unsigned width, unsigned height);
+
+PXInline_h float PXMaxRectsBinGetOccupancy(PXMaxRectsBin *bin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,370 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXMipmapUtils.h"
+
+#include "PXTextureFormatUtils.h"
+
+/*
+ * Colors are stored gamma encoded, so averaging them directly makes every
+ * level darker than the one above it. Each color is decoded to linear light
+ * (12 bits, through a table) before it's averaged and encoded again after.
+ * Alpha is already linear and is averaged as is.
+ *
+ * Colors are also weighted by their alpha, so the invisible color of fully
+ * transparent pixels doesn't bleed into the visible ones next to them.
+ */
+
+#define PX_MIPMAP_LINEAR_MAX 4095
+
+static unsigned short pxMipmapToLinear[256];
+static unsigned char pxMipmapFromLinear[PX_MIPMAP_LINEAR_MAX + 1];
+static bool pxMipmapTablesInitialized = false;
+
+PXInline void PXMipmapInitTables()
+{
+	if (pxMipmapTablesInitialized)
+		return;
+
+	unsigned index;
+	float val;
+
+	// sRGB transfer function
+	for (index = 0; index < 256; ++index)
+	{
+		val = index / 255.0f;
+		val = (val <= 0.04045f) ? (val / 12.92f) : powf((val + 0.055f) / 1.055f, 2.4f);
+
+		pxMipmapToLinear[index] = (unsigned short)(val * PX_MIPMAP_LINEAR_MAX + 0.5f);
+	}
+
+	for (index = 0; index <= PX_MIPMAP_LINEAR_MAX; ++index)
+	{
+		val = index / (float)PX_MIPMAP_LINEAR_MAX;
+		val = (val <= 0.0031308f) ? (val * 12.92f) : (1.055f * powf(val, 1.0f / 2.4f) - 0.055f);
+
+		pxMipmapFromLinear[index] = (unsigned char)(val * 255.0f + 0.5f);
+	}
+
+	// Every thread computes the same values, so a race here is harmless.
+	pxMipmapTablesInitialized = true;
+}
+
+/*
+ * How the channels of a format are laid out. alphaIndex is -1 when the
+ * format has no alpha, and colorCount is the amount of channels before it.
+ */
+PXInline bool PXMipmapGetLayout(PXTextureDataPixelFormat pixelFormat, unsigned *channelCount, unsigned *colorCount, int *alphaIndex)
+{
+	switch (pixelFormat)
+	{
+		case PXTextureDataPixelFormat_RGBA8888:
+			*channelCount = 4; *colorCount = 3; *alphaIndex = 3;
+			return true;
+		case PXTextureDataPixelFormat_RGB888:
+			*channelCount = 3; *colorCount = 3; *alphaIndex = -1;
+			return true;
+		case PXTextureDataPixelFormat_LA88:
+			*channelCount = 2; *colorCount = 1; *alphaIndex = 1;
+			return true;
+		case PXTextureDataPixelFormat_L8:
+			*channelCount = 1; *colorCount = 1; *alphaIndex = -1;
+			return true;
+		case PXTextureDataPixelFormat_A8:
+			*channelCount = 1; *colorCount = 0; *alphaIndex = 0;
+			return true;
+		default:
+			break;
+	}
+
+	return false;
+}
+
+/**
+ * Whether mipmaps can be filtered from an image of the given format. Only the
+ * formats with 8 bits per channel can be; 16 bit images should be filtered
+ * before they're reduced, then converted with PXMipmapChainConvert.
+ */
+bool PXMipmapIsFormatSupported(PXTextureDataPixelFormat pixelFormat)
+{
+	unsigned channelCount;
+	unsigned colorCount;
+	int alphaIndex;
+
+	return PXMipmapGetLayout(pixelFormat, &channelCount, &colorCount, &alphaIndex);
+}
+
+/*
+ * Box filters `src` into `dst`, which is half its size in each dimension
+ * (a dimension of 1 stays 1).
+ */
+PXInline void PXMipmapFilterLevel(const unsigned char *src, unsigned srcWidth, unsigned srcHeight,
+								  unsigned char *dst, unsigned dstWidth, unsigned dstHeight,
+								  unsigned channelCount, unsigned colorCount, int alphaIndex,
+								  bool isPremultiplied)
+{
+	unsigned stepX = (srcWidth > 1) ? 2 : 1;
+	unsigned stepY = (srcHeight > 1) ? 2 : 1;
+	unsigned srcStride = srcWidth * channelCount;
+
+	const unsigned char *samples[4];
+	unsigned x, y, sample, c;
+
+	for (y = 0; y < dstHeight; ++y)
+	{
+		const unsigned char *srcRow = src + (y * stepY) * srcStride;
+
+		for (x = 0; x < dstWidth; ++x, dst += channelCount)
+		{
+			const unsigned char *srcPixel = srcRow + (x * stepX) * channelCount;
+
+			samples[0] = srcPixel;
+			samples[1] = srcPixel + (stepX - 1) * channelCount;
+			samples[2] = srcPixel + (stepY - 1) * srcStride;
+			samples[3] = samples[2] + (stepX - 1) * channelCount;
+
+			// When a dimension is 1 the same samples show up twice, which
+			// doesn't change the average.
+			unsigned alphaSum = 0;
+			unsigned alpha;
+
+			if (alphaIndex >= 0)
+			{
+				for (sample = 0; sample < 4; ++sample)
+					alphaSum += samples[sample][alphaIndex];
+			}
+
+			for (c = 0; c < colorCount; ++c)
+			{
+				unsigned long colorSum = 0;
+				unsigned long weightSum = 0;
+
+				for (sample = 0; sample < 4; ++sample)
+				{
+					unsigned val = samples[sample][c];
+					unsigned weight = (alphaIndex >= 0) ? samples[sample][alphaIndex] : 0xFF;
+
+					if (isPremultiplied && alphaIndex >= 0)
+					{
+						// Back to straight color before linearizing
+						val = weight ? (val * 0xFF + (weight >> 1)) / weight : 0;
+						val = val > 0xFF ? 0xFF : val;
+					}
+
+					colorSum += (unsigned long)pxMipmapToLinear[val] * weight;
+					weightSum += weight;
+				}
+
+				unsigned linear;
+
+				if (weightSum > 0)
+				{
+					linear = (unsigned)((colorSum + (weightSum >> 1)) / weightSum);
+				}
+				else
+				{
+					// Fully transparent, average the colors evenly
+					linear = 0;
+
+					for (sample = 0; sample < 4; ++sample)
+						linear += pxMipmapToLinear[samples[sample][c]];
+
+					linear = (linear + 2) >> 2;
+				}
+
+				unsigned val = pxMipmapFromLinear[linear];
+
+				if (isPremultiplied && alphaIndex >= 0)
+				{
+					alpha = (alphaSum + 2) >> 2;
+					val = (val * alpha + 127) / 0xFF;
+				}
+
+				dst[c] = val;
+			}
+
+			if (alphaIndex >= 0)
+			{
+				dst[alphaIndex] = (alphaSum + 2) >> 2;
+			}
+		}
+	}
+
+}
+
+/**
+ * Filters every level below the given image, down to 1x1.
+ *
+ * @param base The image, with 8 bits per channel. Its size must be a power of
+ * two.
+ * @param isPremultiplied Whether the colors of the image have already been
+ * multiplied by its alpha.
+ *
+ * @return The chain, to be freed with PXMipmapChainFree, or `NULL` if the
+ * format isn't supported or memory ran out.
+ */
+PXMipmapChain *PXMipmapChainCreate(const PXParsedTextureData *base, bool isPremultiplied)
+{
+	if (!base || !base->bytes)
+		return NULL;
+
+	unsigned channelCount;
+	unsigned colorCount;
+	int alphaIndex;
+
+	if (!PXMipmapGetLayout(base->pixelFormat, &channelCount, &colorCount, &alphaIndex))
+		return NULL;
+
+	PXMipmapInitTables();
+
+	PXMipmapChain *chain = calloc(1, sizeof(PXMipmapChain));
+
+	if (!chain)
+		return NULL;
+
+	const unsigned char *src = base->bytes;
+	unsigned srcWidth  = base->size.width;
+	unsigned srcHeight = base->size.height;
+
+	while ((srcWidth > 1 || srcHeight > 1) && chain->levelCount < PX_MIPMAP_MAX_LEVEL_COUNT)
+	{
+		unsigned dstWidth  = (srcWidth  > 1) ? (srcWidth  >> 1) : 1;
+		unsigned dstHeight = (srcHeight > 1) ? (srcHeight >> 1) : 1;
+
+		PXParsedTextureData *level = PXParsedTextureDataCreatev(dstWidth * dstHeight * channelCount,
+																 base->pixelFormat,
+																 CGSizeMake(dstWidth, dstHeight));
+
+		if (!level || !level->bytes)
+		{
+			PXParsedTextureDataFree(level);
+			PXMipmapChainFree(chain);
+
+			return NULL;
+		}
+
+		PXMipmapFilterLevel(src, srcWidth, srcHeight,
+							level->bytes, dstWidth, dstHeight,
+							channelCount, colorCount, alphaIndex,
+							isPremultiplied);
+
+		chain->levels[chain->levelCount] = level;
+		++chain->levelCount;
+
+		src = level->bytes;
+		srcWidth = dstWidth;
+		srcHeight = dstHeight;
+	}
+
+	return chain;
+}
+
+void PXMipmapChainFree(PXMipmapChain *chain)
+{
+	if (!chain)
+		return;
+
+	unsigned index;
+
+	for (index = 0; index < chain->levelCount; ++index)
+	{
+		PXParsedTextureDataFree(chain->levels[index]);
+	}
+
+	free(chain);
+}
+
+/**
+ * Converts every level of the chain, in place, from 8 bits per channel to the
+ * given 16 bit format.
+ *
+ * @return `false` if the pair of formats isn't supported, in which case the
+ * chain is left as it was.
+ */
+bool PXMipmapChainConvert(PXMipmapChain *chain, PXTextureDataPixelFormat pixelFormat)
+{
+	if (!chain)
+		return false;
+
+	unsigned index;
+
+	for (index = 0; index < chain->levelCount; ++index)
+	{
+		PXParsedTextureData *level = chain->levels[index];
+
+		if (level->pixelFormat == pixelFormat)
+			continue;
+
+		unsigned width  = level->size.width;
+		unsigned height = level->size.height;
+
+		if (!PXTextureFormatConvertTo16Bit(level->bytes, level->pixelFormat,
+										   level->bytes, pixelFormat,
+										   width, height,
+										   PXTextureDither_None))
+		{
+			// Only the first level can fail, as they all share a format
+			return false;
+		}
+
+		level->pixelFormat = pixelFormat;
+		level->byteCount = width * height * 2;
+	}
+
+	return true;
+}
+
+/**
+ * The amount of bytes the chain takes up once uploaded.
+ */
+unsigned PXMipmapChainGetByteCount(const PXMipmapChain *chain)
+{
+	if (!chain)
+		return 0;
+
+	unsigned byteCount = 0;
+	unsigned index;
+
+	for (index = 0; index < chain->levelCount; ++index)
+	{
+		byteCount += chain->levels[index]->byteCount;
+	}
+
+	return byteCount;
+}
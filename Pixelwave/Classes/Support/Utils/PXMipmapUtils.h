@@ -0,0 +1,76 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_MIPMAP_UTILS_H_
+#define _PX_MIPMAP_UTILS_H_
+
+#include "PXHeaderUtils.h"
+#include "PXParsedTextureData.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Enough for a 32768x32768 image
+#define PX_MIPMAP_MAX_LEVEL_COUNT 16
+
+/*
+ * The levels below an image, each half the size of the one above it, down to
+ * 1x1. Level 0 (the image itself) isn't part of the chain, so levels[0] is GL
+ * mipmap level 1.
+ */
+typedef struct
+{
+	PXParsedTextureData *levels[PX_MIPMAP_MAX_LEVEL_COUNT];
+	unsigned levelCount;
+} PXMipmapChain;
+
+bool PXMipmapIsFormatSupported(PXTextureDataPixelFormat pixelFormat);
+
+PXMipmapChain *PXMipmapChainCreate(const PXParsedTextureData *base, bool isPremultiplied);
+void PXMipmapChainFree(PXMipmapChain *chain);
+
+bool PXMipmapChainConvert(PXMipmapChain *chain, PXTextureDataPixelFormat pixelFormat);
+unsigned PXMipmapChainGetByteCount(const PXMipmapChain *chain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,416 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXProfileUtils.h"
+
+#ifdef PX_PROFILE_MODE
+
+#include "PXTimeUtils.h"
+
+#include <stdio.h>
+#include <pthread.h>
+#include <libkern/OSAtomic.h>
+
+// Must be a power of two. Once a thread's buffer is full, its oldest zones get
+// overwritten.
+#define PX_PROFILE_EVENTS_PER_THREAD 0x4000
+#define PX_PROFILE_THREAD_NAME_LENGTH 32
+// The most buffers of exited threads that are kept around for the trace. Past
+// that, new threads take over the buffer of the thread that exited first.
+#define PX_PROFILE_MAX_RETIRED_THREADS 8
+
+typedef struct
+{
+	// NULL for frame marks
+	const char *name;
+	uint64_t start;
+	uint64_t end;
+} _PXProfileEvent;
+
+typedef struct _PXProfileThread
+{
+	struct _PXProfileThread *next;
+
+	_PXProfileEvent *events;
+	// Every event ever written, the ring position is this masked
+	unsigned writeCount;
+	// Only contended while a trace is being written
+	OSSpinLock lock;
+
+	unsigned id;
+	char name[PX_PROFILE_THREAD_NAME_LENGTH];
+
+	// Set once the thread has exited, to the order it exited in
+	unsigned retiredOrder;
+} _PXProfileThread;
+
+bool pxProfileCapturing = false;
+
+// Zones are timed relative to this, reset by PXProfileClear
+uint64_t pxProfileBaseTicks = 0;
+
+pthread_key_t pxProfileThreadKey;
+pthread_once_t pxProfileThreadKeyOnce = PTHREAD_ONCE_INIT;
+
+// Buffers are kept after their thread exits, so that what it captured can
+// still be written out, and are reused by later threads once more than
+// PX_PROFILE_MAX_RETIRED_THREADS have piled up. Nodes are never taken out of
+// the list.
+_PXProfileThread *pxProfileThreads = NULL;
+OSSpinLock pxProfileThreadsLock = OS_SPINLOCK_INIT;
+unsigned pxProfileThreadCount = 0;
+unsigned pxProfileRetiredThreadCount = 0;
+unsigned pxProfileRetireCount = 0;
+
+// MARK: Threads
+
+void _PXProfileRetireThread(void *value)
+{
+	_PXProfileThread *thread = value;
+
+	OSSpinLockLock(&pxProfileThreadsLock);
+	thread->retiredOrder = ++pxProfileRetireCount;
+	++pxProfileRetiredThreadCount;
+	OSSpinLockUnlock(&pxProfileThreadsLock);
+}
+
+void _PXProfileMakeThreadKey()
+{
+	pthread_key_create(&pxProfileThreadKey, _PXProfileRetireThread);
+}
+
+/*
+ * Hands out the buffer of an exited thread which is no longer worth keeping:
+ * one that never captured anything, or the one that exited first when too
+ * many are kept. Must be called with pxProfileThreadsLock held.
+ */
+PXInline _PXProfileThread *_PXProfileReuseRetiredThread()
+{
+	_PXProfileThread *thread;
+	_PXProfileThread *oldest = NULL;
+
+	if (pxProfileRetiredThreadCount == 0)
+		return NULL;
+
+	for (thread = pxProfileThreads; thread; thread = thread->next)
+	{
+		if (thread->retiredOrder == 0)
+			continue;
+
+		if (thread->writeCount == 0)
+		{
+			oldest = thread;
+			break;
+		}
+
+		if (!oldest || thread->retiredOrder < oldest->retiredOrder)
+			oldest = thread;
+	}
+
+	if (oldest->writeCount != 0 && pxProfileRetiredThreadCount < PX_PROFILE_MAX_RETIRED_THREADS)
+		return NULL;
+
+	OSSpinLockLock(&oldest->lock);
+	oldest->writeCount = 0;
+	OSSpinLockUnlock(&oldest->lock);
+
+	oldest->retiredOrder = 0;
+	--pxProfileRetiredThreadCount;
+
+	return oldest;
+}
+
+PXInline _PXProfileThread *_PXProfileGetThread()
+{
+	pthread_once(&pxProfileThreadKeyOnce, _PXProfileMakeThreadKey);
+
+	_PXProfileThread *thread = pthread_getspecific(pxProfileThreadKey);
+
+	if (thread)
+		return thread;
+
+	OSSpinLockLock(&pxProfileThreadsLock);
+	thread = _PXProfileReuseRetiredThread();
+	if (thread)
+		thread->id = ++pxProfileThreadCount;
+	OSSpinLockUnlock(&pxProfileThreadsLock);
+
+	if (!thread)
+	{
+		thread = calloc(1, sizeof(_PXProfileThread));
+		if (!thread)
+			return NULL;
+
+		thread->events = malloc(sizeof(_PXProfileEvent) * PX_PROFILE_EVENTS_PER_THREAD);
+		if (!thread->events)
+		{
+			free(thread);
+			return NULL;
+		}
+
+		thread->lock = OS_SPINLOCK_INIT;
+
+		OSSpinLockLock(&pxProfileThreadsLock);
+		thread->id = ++pxProfileThreadCount;
+		thread->next = pxProfileThreads;
+		pxProfileThreads = thread;
+		OSSpinLockUnlock(&pxProfileThreadsLock);
+	}
+
+	if (pthread_main_np())
+		strlcpy(thread->name, "Main", PX_PROFILE_THREAD_NAME_LENGTH);
+	else
+		snprintf(thread->name, PX_PROFILE_THREAD_NAME_LENGTH, "Thread %u", thread->id);
+
+	pthread_setspecific(pxProfileThreadKey, thread);
+
+	return thread;
+}
+
+PXInline void _PXProfileWriteEvent(const char *name, uint64_t start, uint64_t end)
+{
+	_PXProfileThread *thread = _PXProfileGetThread();
+
+	if (!thread)
+		return;
+
+	OSSpinLockLock(&thread->lock);
+	{
+		_PXProfileEvent *event = thread->events + (thread->writeCount & (PX_PROFILE_EVENTS_PER_THREAD - 1));
+
+		event->name = name;
+		event->start = start;
+		event->end = end;
+
+		++(thread->writeCount);
+	}
+	OSSpinLockUnlock(&thread->lock);
+}
+
+/*
+ * Names the calling thread in the written trace.
+ */
+void PXProfileSetThreadName(const char *name)
+{
+	_PXProfileThread *thread = _PXProfileGetThread();
+
+	if (!thread || !name)
+		return;
+
+	strlcpy(thread->name, name, PX_PROFILE_THREAD_NAME_LENGTH);
+}
+
+// MARK: Capturing
+
+void PXProfileSetCapturing(bool capturing)
+{
+	if (capturing && pxProfileBaseTicks == 0)
+		pxProfileBaseTicks = PXTimeGetTicks();
+
+	pxProfileCapturing = capturing;
+}
+
+bool PXProfileIsCapturing()
+{
+	return pxProfileCapturing;
+}
+
+/*
+ * Throws away everything captured so far.
+ */
+void PXProfileClear()
+{
+	_PXProfileThread *thread;
+
+	OSSpinLockLock(&pxProfileThreadsLock);
+	for (thread = pxProfileThreads; thread; thread = thread->next)
+	{
+		OSSpinLockLock(&thread->lock);
+		thread->writeCount = 0;
+		OSSpinLockUnlock(&thread->lock);
+	}
+	OSSpinLockUnlock(&pxProfileThreadsLock);
+
+	pxProfileBaseTicks = pxProfileCapturing ? PXTimeGetTicks() : 0;
+}
+
+uint64_t _PXProfileGetTicks()
+{
+	return PXTimeGetTicks();
+}
+
+void _PXProfileZoneEnd(PXProfileZone *zone)
+{
+	// Capturing was off when the zone began
+	if (zone->start == 0)
+		return;
+
+	_PXProfileWriteEvent(zone->name, zone->start, PXTimeGetTicks());
+}
+
+/*
+ * Marks the start of a frame, shown as an instant event in the trace.
+ */
+void PXProfileMarkFrame()
+{
+	if (!pxProfileCapturing)
+		return;
+
+	uint64_t now = PXTimeGetTicks();
+	_PXProfileWriteEvent(NULL, now, now);
+}
+
+// MARK: Writing
+
+PXInline double _PXProfileTicksToMicroseconds(uint64_t ticks)
+{
+	if (ticks < pxProfileBaseTicks)
+		return 0.0;
+
+	return PXTimeTicksToSeconds(ticks - pxProfileBaseTicks) * 1.0e6;
+}
+
+// Zone names come from literals and class names, but quotes and backslashes
+// would still break the file.
+PXInline void _PXProfileWriteString(FILE *file, const char *string)
+{
+	fputc('"', file);
+
+	for (; *string; ++string)
+	{
+		if (*string == '"' || *string == '\\')
+			fputc('\\', file);
+
+		if ((unsigned char)(*string) >= 0x20)
+			fputc(*string, file);
+	}
+
+	fputc('"', file);
+}
+
+/*
+ * Writes every zone captured so far to the given path, in the Chrome trace
+ * event format. Returns false if the file couldn't be written.
+ */
+bool PXProfileWriteTrace(const char *path)
+{
+	if (!path)
+		return false;
+
+	FILE *file = fopen(path, "w");
+	if (!file)
+		return false;
+
+	// Each thread's events are copied out first, so that it isn't held up
+	// while the file is being written.
+	_PXProfileEvent *events = malloc(sizeof(_PXProfileEvent) * PX_PROFILE_EVENTS_PER_THREAD);
+	if (!events)
+	{
+		fclose(file);
+		return false;
+	}
+
+	bool first = true;
+	_PXProfileThread *thread;
+	_PXProfileEvent *event;
+	unsigned index;
+	unsigned count;
+	unsigned writeCount;
+
+	fputs("{\"traceEvents\":[\n", file);
+
+	OSSpinLockLock(&pxProfileThreadsLock);
+	_PXProfileThread *threads = pxProfileThreads;
+	OSSpinLockUnlock(&pxProfileThreadsLock);
+
+	// Threads are only ever added to the front of the list, so walking it from
+	// the head taken above is safe without holding the lock.
+	for (thread = threads; thread; thread = thread->next)
+	{
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", thread->id);
+		_PXProfileWriteString(file, thread->name);
+		fputs("}}", file);
+		first = false;
+
+		OSSpinLockLock(&thread->lock);
+		{
+			writeCount = thread->writeCount;
+			count = 0;
+
+			index = (writeCount > PX_PROFILE_EVENTS_PER_THREAD) ? (writeCount - PX_PROFILE_EVENTS_PER_THREAD) : 0;
+
+			// Oldest first
+			for (; index < writeCount; ++index, ++count)
+				events[count] = thread->events[index & (PX_PROFILE_EVENTS_PER_THREAD - 1)];
+		}
+		OSSpinLockUnlock(&thread->lock);
+
+		for (index = 0, event = events; index < count; ++index, ++event)
+		{
+			if (event->name)
+			{
+				fputs(",\n{\"name\":", file);
+				_PXProfileWriteString(file, event->name);
+				fprintf(file, ",\"cat\":\"px\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+				        _PXProfileTicksToMicroseconds(event->start),
+				        PXTimeTicksToSeconds(event->end - event->start) * 1.0e6,
+				        thread->id);
+			}
+			else
+			{
+				fprintf(file, ",\n{\"name\":\"Frame\",\"cat\":\"px\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+				        _PXProfileTicksToMicroseconds(event->start),
+				        thread->id);
+			}
+		}
+	}
+
+	free(events);
+
+	fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+
+	bool success = (ferror(file) == 0);
+
+	if (fclose(file) != 0)
+		success = false;
+
+	return success;
+}
+
+#endif
@@ -0,0 +1,134 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_PROFILE_UTILS_H_
+#define _PX_PROFILE_UTILS_H_
+
+#include "PXHeaderUtils.h"
+#include "PXSettings.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A scoped zone profiler. PX_PROFILE_ZONE marks the rest of the enclosing block
+ * as a zone; when the block exits, the zone is stored in a ring buffer owned by
+ * the calling thread. Zones nest, so the engine's zones show up as a call tree
+ * per frame. Nothing is stored unless capturing has been turned on with
+ * PXProfileSetCapturing.
+ *
+ * PXProfileWriteTrace writes everything captured so far as a Chrome trace
+ * (JSON), which can be opened with chrome://tracing or Perfetto.
+ *
+ * Unless PX_PROFILE_MODE is defined in PXSettings.h, every macro compiles to
+ * nothing and the functions do nothing.
+ */
+
+#ifdef PX_PROFILE_MODE
+
+typedef struct
+{
+	const char *name;
+	uint64_t start;
+} PXProfileZone;
+
+PXExtern bool pxProfileCapturing;
+
+PXExtern void PXProfileSetCapturing(bool capturing);
+PXExtern bool PXProfileIsCapturing();
+PXExtern void PXProfileClear();
+PXExtern bool PXProfileWriteTrace(const char *path);
+
+PXExtern void PXProfileSetThreadName(const char *name);
+PXExtern void PXProfileMarkFrame();
+
+PXExtern uint64_t _PXProfileGetTicks();
+PXExtern void _PXProfileZoneEnd(PXProfileZone *zone);
+
+PXInline PXProfileZone _PXProfileZoneBegin(const char *name)
+{
+	PXProfileZone zone;
+
+	zone.name = name;
+	zone.start = pxProfileCapturing ? _PXProfileGetTicks() : 0;
+
+	return zone;
+}
+
+// The name must outlive the capture; string literals and class names do.
+#define PX_PROFILE_ZONE(_name_) \
+	PXProfileZone PX_UNIQUE_VAR(_pxProfileZone) __attribute__((cleanup(_PXProfileZoneEnd))) = _PXProfileZoneBegin(_name_)
+
+#ifdef __OBJC__
+#include <objc/runtime.h>
+
+// A zone named after the class of the given object.
+#define PX_PROFILE_OBJECT_ZONE(_object_) PX_PROFILE_ZONE(object_getClassName(_object_))
+#endif
+
+#define PX_PROFILE_FRAME() PXProfileMarkFrame()
+#define PX_PROFILE_THREAD_NAME(_name_) PXProfileSetThreadName(_name_)
+
+#else
+
+#define PX_PROFILE_ZONE(_name_)
+#define PX_PROFILE_OBJECT_ZONE(_object_)
+#define PX_PROFILE_FRAME()
+#define PX_PROFILE_THREAD_NAME(_name_)
+
+PXInline void PXProfileSetCapturing(bool capturing)
+{
+	PX_NOT_USED(capturing);
+}
+PXInline bool PXProfileIsCapturing() { return false; }
+PXInline void PXProfileClear() {}
+PXInline bool PXProfileWriteTrace(const char *path)
+{
+	PX_NOT_USED(path);
+	return false;
+}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
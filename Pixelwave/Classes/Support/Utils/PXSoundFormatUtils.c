@@ -0,0 +1,644 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXSoundFormatUtils.h"
+
+#if defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PX_SOUND_FORMAT_NEON
+#endif
+
+// Q12 fixed point, used for the normalization gain.
+#define PX_SOUND_FORMAT_GAIN_ONE 4096
+#define PX_SOUND_FORMAT_GAIN_MAX 32767
+
+typedef enum
+{
+	_PXSoundFormatRate_Same = 0,
+	_PXSoundFormatRate_Decimate,
+	_PXSoundFormatRate_Interpolate
+} _PXSoundFormatRateMode;
+
+typedef struct
+{
+	const void *bytes;
+
+	unsigned frameCount;
+	unsigned channelCount;
+	unsigned bitsPerSample;
+} _PXSoundFormatSource;
+
+typedef struct
+{
+	_PXSoundFormatRateMode mode;
+
+	// Source frames averaged into each output frame (decimate)
+	unsigned decimation;
+	// Source frames advanced per output frame in 16.16 fixed point (interpolate)
+	uint64_t step;
+} _PXSoundFormatRate;
+
+// MARK: -
+// MARK: - Format
+// MARK: -
+
+PXInline_c PXSoundConversion PXSoundConversionMake()
+{
+	PXSoundConversion conversion;
+
+	conversion.channelCount = 0;
+	conversion.bitsPerSample = 0;
+	conversion.freq = 0;
+
+	conversion.normalize = false;
+	conversion.normalizePeak = 1.0f;
+
+	return conversion;
+}
+
+PXInline_c bool PXSoundConversionIsIdentity(PXSoundConversion conversion, PXParsedSoundData *soundData)
+{
+	if (!soundData)
+	{
+		return true;
+	}
+
+	if (conversion.normalize)
+	{
+		return false;
+	}
+
+	if (conversion.channelCount != 0 &&
+		conversion.channelCount != PXSoundFormatGetChannelCount(soundData->format))
+	{
+		return false;
+	}
+
+	if (conversion.bitsPerSample != 0 &&
+		conversion.bitsPerSample != PXSoundFormatGetBitsPerSample(soundData->format))
+	{
+		return false;
+	}
+
+	if (conversion.freq > 0 && conversion.freq != soundData->freq)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+PXInline_c PXSoundFormat PXSoundFormatMake(unsigned channelCount, unsigned bitsPerSample)
+{
+	if (channelCount > 1)
+	{
+		return (bitsPerSample == 8) ? PXSoundFormat_Stereo8 : PXSoundFormat_Stereo16;
+	}
+
+	return (bitsPerSample == 8) ? PXSoundFormat_Mono8 : PXSoundFormat_Mono16;
+}
+
+PXInline_c unsigned PXSoundFormatGetChannelCount(PXSoundFormat format)
+{
+	if (format == PXSoundFormat_Stereo8 ||
+		format == PXSoundFormat_Stereo16 ||
+		format == PXSoundFormat_StereoIMA4)
+	{
+		return 2;
+	}
+
+	return 1;
+}
+
+PXInline_c unsigned PXSoundFormatGetBitsPerSample(PXSoundFormat format)
+{
+	if (format == PXSoundFormat_Mono8 || format == PXSoundFormat_Stereo8)
+	{
+		return 8;
+	}
+
+	return 16;
+}
+
+PXInline_c bool PXSoundFormatIsCompressed(PXSoundFormat format)
+{
+	return (format == PXSoundFormat_MonoIMA4 || format == PXSoundFormat_StereoIMA4);
+}
+
+// MARK: -
+// MARK: - Read
+// MARK: -
+
+// 8 bit PCM is unsigned (centered on 128), 16 bit PCM is signed. Everything
+// is processed as signed 16 bit.
+PXInline void _PXSoundFormatReadFrame(const _PXSoundFormatSource *source,
+									  unsigned frame,
+									  unsigned dstChannelCount,
+									  int32_t *out)
+{
+	int32_t left;
+	int32_t right;
+
+	if (source->bitsPerSample == 8)
+	{
+		const uint8_t *ptr = ((const uint8_t *)(source->bytes)) + frame * source->channelCount;
+
+		left = ((int32_t)(ptr[0]) - 128) * 256;
+		right = (source->channelCount > 1) ? (((int32_t)(ptr[1]) - 128) * 256) : left;
+	}
+	else
+	{
+		const int16_t *ptr = ((const int16_t *)(source->bytes)) + frame * source->channelCount;
+
+		left = ptr[0];
+		right = (source->channelCount > 1) ? ptr[1] : left;
+	}
+
+	if (dstChannelCount == 1)
+	{
+		out[0] = (left + right) >> 1;
+	}
+	else
+	{
+		out[0] = left;
+		out[1] = right;
+	}
+}
+
+#ifdef PX_SOUND_FORMAT_NEON
+PXInline void _PXSoundFormatDownmixS16NEON(const int16_t *read, int16_t *write, unsigned frameCount)
+{
+	unsigned index = 0;
+
+	for (; index + 8 <= frameCount; index += 8, read += 16, write += 8)
+	{
+		int16x8x2_t frames = vld2q_s16(read);
+		vst1q_s16(write, vhaddq_s16(frames.val[0], frames.val[1]));
+	}
+
+	for (; index < frameCount; ++index, read += 2, ++write)
+	{
+		*write = ((int32_t)(read[0]) + (int32_t)(read[1])) >> 1;
+	}
+}
+#endif
+
+// Fills frameCount frames, starting at output frame firstFrame, with dst
+// channel count samples each. Channel conversion and resampling both happen
+// here so that the source is only ever read once.
+static void _PXSoundFormatFillChunk(const _PXSoundFormatSource *source,
+									const _PXSoundFormatRate *rate,
+									unsigned dstChannelCount,
+									unsigned firstFrame,
+									unsigned frameCount,
+									int16_t *write)
+{
+	int32_t frame[2];
+	int32_t nextFrame[2];
+	int32_t sum[2];
+
+	unsigned index;
+	unsigned channel;
+
+	switch (rate->mode)
+	{
+		case _PXSoundFormatRate_Same:
+		{
+#ifdef PX_SOUND_FORMAT_NEON
+			if (source->bitsPerSample == 16 && source->channelCount == 2 && dstChannelCount == 1)
+			{
+				_PXSoundFormatDownmixS16NEON(((const int16_t *)(source->bytes)) + (firstFrame << 1), write, frameCount);
+				break;
+			}
+#endif
+			if (source->bitsPerSample == 16 && source->channelCount == dstChannelCount)
+			{
+				memcpy(write,
+					   ((const int16_t *)(source->bytes)) + firstFrame * dstChannelCount,
+					   frameCount * dstChannelCount * sizeof(int16_t));
+				break;
+			}
+
+			for (index = 0; index < frameCount; ++index)
+			{
+				_PXSoundFormatReadFrame(source, firstFrame + index, dstChannelCount, frame);
+
+				for (channel = 0; channel < dstChannelCount; ++channel, ++write)
+				{
+					*write = frame[channel];
+				}
+			}
+		}
+			break;
+		case _PXSoundFormatRate_Decimate:
+		{
+			// A box filter, this avoids most of the aliasing that point
+			// sampling would introduce for the common 2:1 and 4:1 cases.
+			unsigned decimation = rate->decimation;
+			unsigned sourceFrame = firstFrame * decimation;
+			unsigned subIndex;
+
+			for (index = 0; index < frameCount; ++index)
+			{
+				sum[0] = 0;
+				sum[1] = 0;
+
+				for (subIndex = 0; subIndex < decimation; ++subIndex, ++sourceFrame)
+				{
+					_PXSoundFormatReadFrame(source, sourceFrame, dstChannelCount, frame);
+
+					for (channel = 0; channel < dstChannelCount; ++channel)
+					{
+						sum[channel] += frame[channel];
+					}
+				}
+
+				for (channel = 0; channel < dstChannelCount; ++channel, ++write)
+				{
+					*write = sum[channel] / (int32_t)decimation;
+				}
+			}
+		}
+			break;
+		case _PXSoundFormatRate_Interpolate:
+		{
+			unsigned lastFrame = source->frameCount - 1;
+			uint64_t position = (uint64_t)firstFrame * rate->step;
+
+			unsigned sourceFrame;
+			int64_t fraction;
+
+			for (index = 0; index < frameCount; ++index, position += rate->step)
+			{
+				sourceFrame = position >> 16;
+				fraction = position & 0xFFFF;
+
+				if (sourceFrame > lastFrame)
+				{
+					sourceFrame = lastFrame;
+				}
+
+				_PXSoundFormatReadFrame(source, sourceFrame, dstChannelCount, frame);
+				_PXSoundFormatReadFrame(source, (sourceFrame < lastFrame) ? sourceFrame + 1 : lastFrame, dstChannelCount, nextFrame);
+
+				for (channel = 0; channel < dstChannelCount; ++channel, ++write)
+				{
+					*write = frame[channel] + (int32_t)(((int64_t)(nextFrame[channel] - frame[channel]) * fraction) >> 16);
+				}
+			}
+		}
+			break;
+	}
+}
+
+// Returns the largest absolute sample value in the source once converted to
+// the dst channel count, in 16 bit scale.
+static int32_t _PXSoundFormatFindPeak(const _PXSoundFormatSource *source, unsigned dstChannelCount)
+{
+	unsigned count = source->frameCount * source->channelCount;
+	unsigned index = 0;
+
+	int32_t peak = 0;
+	int32_t val;
+
+	if (dstChannelCount < source->channelCount)
+	{
+		int32_t frame[2];
+
+		for (; index < source->frameCount; ++index)
+		{
+			_PXSoundFormatReadFrame(source, index, dstChannelCount, frame);
+			val = abs(frame[0]);
+
+			if (val > peak)
+			{
+				peak = val;
+			}
+		}
+
+		return peak;
+	}
+
+	if (source->bitsPerSample == 8)
+	{
+		const uint8_t *read = source->bytes;
+
+		for (; index < count; ++index, ++read)
+		{
+			val = abs((int32_t)(*read) - 128) << 8;
+
+			if (val > peak)
+			{
+				peak = val;
+			}
+		}
+
+		return peak;
+	}
+
+	const int16_t *read = source->bytes;
+
+#ifdef PX_SOUND_FORMAT_NEON
+	int16x8_t peaks = vdupq_n_s16(0);
+
+	for (; index + 8 <= count; index += 8, read += 8)
+	{
+		peaks = vmaxq_s16(peaks, vqabsq_s16(vld1q_s16(read)));
+	}
+
+	int16x4_t half = vpmax_s16(vget_low_s16(peaks), vget_high_s16(peaks));
+	half = vpmax_s16(half, half);
+	half = vpmax_s16(half, half);
+	peak = vget_lane_s16(half, 0);
+#endif
+
+	for (; index < count; ++index, ++read)
+	{
+		val = abs((int32_t)(*read));
+
+		if (val > peak)
+		{
+			peak = val;
+		}
+	}
+
+	return peak;
+}
+
+// MARK: -
+// MARK: - Write
+// MARK: -
+
+static void _PXSoundFormatApplyGain(int16_t *samples, unsigned count, int32_t gain)
+{
+	unsigned index = 0;
+	int32_t val;
+
+#ifdef PX_SOUND_FORMAT_NEON
+	int16_t gain16 = gain;
+
+	for (; index + 8 <= count; index += 8, samples += 8)
+	{
+		int16x8_t vals = vld1q_s16(samples);
+
+		int16x4_t low  = vqshrn_n_s32(vmull_n_s16(vget_low_s16(vals), gain16), 12);
+		int16x4_t high = vqshrn_n_s32(vmull_n_s16(vget_high_s16(vals), gain16), 12);
+
+		vst1q_s16(samples, vcombine_s16(low, high));
+	}
+#endif
+
+	for (; index < count; ++index, ++samples)
+	{
+		val = ((int32_t)(*samples) * gain) >> 12;
+
+		if (val > INT16_MAX)
+		{
+			val = INT16_MAX;
+		}
+		else if (val < INT16_MIN)
+		{
+			val = INT16_MIN;
+		}
+
+		*samples = val;
+	}
+}
+
+static void _PXSoundFormatWriteChunk(const int16_t *samples, unsigned count, unsigned bitsPerSample, void *write)
+{
+	if (bitsPerSample == 16)
+	{
+		memcpy(write, samples, count * sizeof(int16_t));
+		return;
+	}
+
+	uint8_t *ptr = write;
+	unsigned index = 0;
+
+#ifdef PX_SOUND_FORMAT_NEON
+	uint8x8_t bias = vdup_n_u8(0x80);
+
+	for (; index + 8 <= count; index += 8, samples += 8, ptr += 8)
+	{
+		int8x8_t vals = vshrn_n_s16(vld1q_s16(samples), 8);
+		vst1_u8(ptr, veor_u8(vreinterpret_u8_s8(vals), bias));
+	}
+#endif
+
+	for (; index < count; ++index, ++samples, ++ptr)
+	{
+		*ptr = (uint8_t)(((*samples) >> 8) + 128);
+	}
+}
+
+// MARK: -
+// MARK: - Convert
+// MARK: -
+
+/*
+ * Converts the given sound data in a single streaming pass. The source is read
+ * once, a chunk at a time, into a small stack buffer where the channel, rate,
+ * gain and bit depth changes are all applied before the chunk is written to
+ * its final location. Only the output buffer is allocated.
+ *
+ * Returns NULL if the conversion would not change the sound, if the sound is
+ * compressed, or on failure.
+ */
+PXParsedSoundData *PXSoundFormatNewConvertedSoundData(PXParsedSoundData *soundData, PXSoundConversion conversion)
+{
+	if (!soundData || !(soundData->bytes) || soundData->byteCount == 0 || soundData->freq <= 0)
+	{
+		return NULL;
+	}
+
+	// Compressed data has to stay as is, it is only decoded during playback.
+	if (PXSoundFormatIsCompressed(soundData->format))
+	{
+		return NULL;
+	}
+
+	if (PXSoundConversionIsIdentity(conversion, soundData))
+	{
+		return NULL;
+	}
+
+	_PXSoundFormatSource source;
+
+	source.bytes = soundData->bytes;
+	source.channelCount = PXSoundFormatGetChannelCount(soundData->format);
+	source.bitsPerSample = PXSoundFormatGetBitsPerSample(soundData->format);
+	source.frameCount = soundData->byteCount / (source.channelCount * (source.bitsPerSample >> 3));
+
+	if (source.frameCount == 0)
+	{
+		return NULL;
+	}
+
+	unsigned dstChannelCount = source.channelCount;
+	unsigned dstBitsPerSample = source.bitsPerSample;
+	int srcFreq = soundData->freq;
+	int dstFreq = srcFreq;
+
+	if (conversion.channelCount != 0)
+	{
+		dstChannelCount = (conversion.channelCount > 1) ? 2 : 1;
+	}
+	if (conversion.bitsPerSample != 0)
+	{
+		dstBitsPerSample = (conversion.bitsPerSample == 8) ? 8 : 16;
+	}
+	if (conversion.freq > 0)
+	{
+		dstFreq = conversion.freq;
+	}
+
+	// Rate
+	_PXSoundFormatRate rate;
+	unsigned dstFrameCount;
+
+	rate.mode = _PXSoundFormatRate_Same;
+	rate.decimation = 1;
+	rate.step = 1 << 16;
+
+	if (dstFreq == srcFreq)
+	{
+		dstFrameCount = source.frameCount;
+	}
+	else if (dstFreq < srcFreq && (srcFreq % dstFreq) == 0 && source.frameCount >= (unsigned)(srcFreq / dstFreq))
+	{
+		rate.mode = _PXSoundFormatRate_Decimate;
+		rate.decimation = srcFreq / dstFreq;
+
+		dstFrameCount = source.frameCount / rate.decimation;
+	}
+	else
+	{
+		rate.mode = _PXSoundFormatRate_Interpolate;
+		rate.step = (((uint64_t)srcFreq) << 16) / dstFreq;
+
+		dstFrameCount = ((uint64_t)(source.frameCount) * dstFreq) / srcFreq;
+	}
+
+	if (dstFrameCount == 0)
+	{
+		return NULL;
+	}
+
+	// Gain. Linear interpolation and box filtering can never produce a sample
+	// louder than the loudest source frame, so the peak can be found before
+	// any resampling takes place.
+	int32_t gain = PX_SOUND_FORMAT_GAIN_ONE;
+
+	if (conversion.normalize)
+	{
+		int32_t peak = _PXSoundFormatFindPeak(&source, dstChannelCount);
+
+		if (peak > 0)
+		{
+			float targetPeak = conversion.normalizePeak;
+
+			if (targetPeak < 0.0f)
+			{
+				targetPeak = 0.0f;
+			}
+			else if (targetPeak > 1.0f)
+			{
+				targetPeak = 1.0f;
+			}
+
+			int64_t newGain = (((int64_t)(targetPeak * INT16_MAX)) << 12) / peak;
+			gain = (newGain > PX_SOUND_FORMAT_GAIN_MAX) ? PX_SOUND_FORMAT_GAIN_MAX : (int32_t)newGain;
+		}
+	}
+
+	bool applyGain = (gain != PX_SOUND_FORMAT_GAIN_ONE);
+
+	// Output
+	unsigned dstBytesPerFrame = dstChannelCount * (dstBitsPerSample >> 3);
+
+	PXParsedSoundData *newSoundData = PXParsedSoundDataCreatev(dstFrameCount * dstBytesPerFrame,
+															   PXSoundFormatMake(dstChannelCount, dstBitsPerSample),
+															   dstFreq,
+															   dstChannelCount,
+															   ((uint64_t)dstFrameCount * 1000) / dstFreq);
+
+	if (!newSoundData || !(newSoundData->bytes))
+	{
+		PXParsedSoundDataFree(newSoundData);
+		return NULL;
+	}
+
+	int16_t scratch[PX_SOUND_FORMAT_CHUNK_FRAMES << 1];
+
+	// When nothing needs to happen after the fill, the chunk is filled
+	// straight into the output.
+	bool fillsOutput = (dstBitsPerSample == 16 && !applyGain);
+
+	uint8_t *write = (uint8_t *)(newSoundData->bytes);
+	unsigned firstFrame;
+	unsigned chunkFrameCount;
+
+	for (firstFrame = 0; firstFrame < dstFrameCount; firstFrame += chunkFrameCount, write += chunkFrameCount * dstBytesPerFrame)
+	{
+		chunkFrameCount = dstFrameCount - firstFrame;
+
+		if (chunkFrameCount > PX_SOUND_FORMAT_CHUNK_FRAMES)
+		{
+			chunkFrameCount = PX_SOUND_FORMAT_CHUNK_FRAMES;
+		}
+
+		if (fillsOutput)
+		{
+			_PXSoundFormatFillChunk(&source, &rate, dstChannelCount, firstFrame, chunkFrameCount, (int16_t *)write);
+			continue;
+		}
+
+		_PXSoundFormatFillChunk(&source, &rate, dstChannelCount, firstFrame, chunkFrameCount, scratch);
+
+		if (applyGain)
+		{
+			_PXSoundFormatApplyGain(scratch, chunkFrameCount * dstChannelCount, gain);
+		}
+
+		_PXSoundFormatWriteChunk(scratch, chunkFrameCount * dstChannelCount, dstBitsPerSample, write);
+	}
+
+	return newSoundData;
+}
@@ -0,0 +1,84 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef _PX_SOUND_FORMAT_UTILS_H_
+#define _PX_SOUND_FORMAT_UTILS_H_
+
+#include "PXHeaderUtils.h"
+#include "PXParsedSoundData.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The number of frames converted per pass through the scratch buffer. Sized
+// so that a stereo chunk fits comfortably on the stack.
+#define PX_SOUND_FORMAT_CHUNK_FRAMES 512
+
+/*
+ * Describes every change to be made to a sound's samples in one pass. A value
+ * of 0 for channelCount, bitsPerSample or freq means 'keep the source value'.
+ * Sound modifiers fill one of these in so that a chain of them can be fused
+ * into a single conversion.
+ */
+typedef struct
+{
+	unsigned channelCount;
+	unsigned bitsPerSample;
+	int freq;
+
+	bool normalize;
+	float normalizePeak;
+} PXSoundConversion;
+
+PXInline_h PXSoundConversion PXSoundConversionMake();
+PXInline_h bool PXSoundConversionIsIdentity(PXSoundConversion conversion, PXParsedSoundData *soundData);
+
+PXInline_h PXSoundFormat PXSoundFormatMake(unsigned channelCount, unsigned bitsPerSample);
+PXInline_h unsigned PXSoundFormatGetChannelCount(PXSoundFormat format);
+PXInline_h unsigned PXSoundFormatGetBitsPerSample(PXSoundFormat format);
+PXInline_h bool PXSoundFormatIsCompressed(PXSoundFormat format);
+
+PXParsedSoundData *PXSoundFormatNewConvertedSoundData(PXParsedSoundData *soundData, PXSoundConversion conversion);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
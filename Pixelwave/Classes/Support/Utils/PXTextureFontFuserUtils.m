@@ -42,6 +42,7 @@
 #import <Foundation/Foundation.h>
 
 #import "PXGL.h"
+#include "PXGLCommandBuffer.h"
 
 #import "PXTextureFont.h"
 #import "PXTextureData.h"
@@ -130,6 +131,8 @@ PXFont *PXTextureFontUtilsNewFont(PXTextureFontTextureInfo *info,
 	const GLvoid *byteData = (GLvoid *)(textureInfo->bytes);
 	PXTextureDataPixelFormat pixelFormat = textureInfo->pixelFormat;
 
+	PXGLBeginDirect();
+
 	GLuint boundTex = PXGLBoundTexture();
 	PXGLBindTexture(GL_TEXTURE_2D, texName);
 	{
@@ -176,6 +179,8 @@ PXFont *PXTextureFontUtilsNewFont(PXTextureFontTextureInfo *info,
 	}
 	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
 
+	PXGLEndDirect();
+
 	[textureData _setInternalPropertiesWithWidth:textureInfo->size.width
 										  height:textureInfo->size.height
 							   usingContentWidth:textureInfo->size.width
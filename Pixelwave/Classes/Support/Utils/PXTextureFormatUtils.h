@@ -42,6 +42,9 @@
 
 #include "PXHeaderUtils.h"
 
+#include "PXTextureDataPixelFormat.h"
+#include "PXTextureDither.h"
+
 #define _PXTextureFormatPixelsCopyWithFunc(_read_, _write_, _count_, _TYPE_, _FUNC_) \
 { \
 	_TYPE_ *_curReadPixel_; \
@@ -201,6 +204,18 @@ PXInline_h PXTF_L_8 PXTF_L_8_From_RGB_565(PXTF_RGB_565 val);
 PXInline_h PXTF_L_8 PXTF_L_8_From_LA_88(PXTF_LA_88 val);
 PXInline_h PXTF_L_8 PXTF_L_8_From_A_8(PXTF_A_8 val);
 
+// MARK: -
+// MARK: - Blocks
+// MARK: -
+
+bool PXTextureFormatConvertTo16Bit(const void *src,
+								   PXTextureDataPixelFormat srcFormat,
+								   void *dst,
+								   PXTextureDataPixelFormat dstFormat,
+								   unsigned width,
+								   unsigned height,
+								   PXTextureDither dither);
+
 #ifdef __cplusplus
 }
 #endif
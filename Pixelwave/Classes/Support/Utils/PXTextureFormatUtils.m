@@ -39,6 +39,14 @@
 
 #import "PXTextureFormatUtils.h"
 
+#if defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PXTF_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define PXTF_SSE2
+#endif
+
 #define PXTF_ONE_6BIT 0.01587301f
 #define PXTF_ONE_5BIT 0.03225806f
 #define PXTF_ONE_4BIT 0.06666667f
@@ -552,3 +560,494 @@ PXInline_c PXTF_L_8 PXTF_L_8_From_A_8(PXTF_A_8 val)
 {
 	return val;
 }
+
+// MARK: -
+// MARK: - Blocks
+// MARK: -
+
+// Where each channel of a 16 bit format lives, in red, green, blue, alpha
+// order. A channel with 0 bits isn't stored.
+typedef struct
+{
+	UInt8 bits[4];
+	UInt8 shifts[4];
+} _PXTFPackLayout;
+
+static const _PXTFPackLayout pxTFPackLayout4444 = {{4, 4, 4, 4}, {12, 8, 4, 0}};
+static const _PXTFPackLayout pxTFPackLayout5551 = {{5, 5, 5, 1}, {11, 6, 1, 0}};
+static const _PXTFPackLayout pxTFPackLayout565  = {{5, 6, 5, 0}, {11, 5, 0, 0}};
+
+static const UInt8 pxTFBayer4x4[4][4] =
+{
+	{ 0,  8,  2, 10},
+	{12,  4, 14,  6},
+	{ 3, 11,  1,  9},
+	{15,  7, 13,  5}
+};
+
+// Whether the ordered pattern is applied to a channel of the given amount of
+// bits. Channels of 1 bit (such as the alpha of 5551) are only thresholded, as
+// a dithered edge looks worse than a hard one.
+#define PXTF_IS_DITHERED(_bits_) ((_bits_) >= 2 && (_bits_) < 8)
+
+// The ordered pattern for a pixel, in 8 bit units. Added to a channel that was
+// first scaled by (1 - 1/2^bits), so truncating it picks each of the two
+// nearest levels in proportion to how close the channel is to them.
+PXInline UInt8 _PXTFOrderedOffset(UInt8 bits, unsigned x, unsigned y)
+{
+	if (!PXTF_IS_DITHERED(bits))
+		return 0;
+
+	return (((pxTFBayer4x4[y & 3][x & 3] << 1) + 1) << (8 - bits)) >> 5;
+}
+
+// The loops over channels are written out by hand, so the layout (which is
+// always a constant) folds away even when the compiler doesn't unroll.
+#define PXTF_FOR_EACH_CHANNEL(_statement_) \
+{ \
+	unsigned c; \
+	c = 0; _statement_; \
+	c = 1; _statement_; \
+	c = 2; _statement_; \
+	c = 3; _statement_; \
+}
+
+PXInline PXAlwaysInline UInt16 _PXTFPack(const _PXTFPackLayout *layout, const UInt8 *channels)
+{
+	UInt16 val = 0;
+
+	PXTF_FOR_EACH_CHANNEL(
+		if (layout->bits[c] != 0)
+			val |= (channels[c] >> (8 - layout->bits[c])) << layout->shifts[c]
+	);
+
+	return val;
+}
+
+PXInline PXAlwaysInline UInt16 _PXTFConvertPixel(const UInt8 *src,
+												  unsigned srcBpp,
+												  const _PXTFPackLayout *layout,
+												  unsigned x,
+												  unsigned y,
+												  bool ordered)
+{
+	UInt8 channels[4];
+
+	channels[0] = src[0];
+	channels[1] = src[1];
+	channels[2] = src[2];
+	channels[3] = (srcBpp == 4) ? src[3] : 0xFF;
+
+	if (ordered)
+	{
+		PXTF_FOR_EACH_CHANNEL(
+			if (PXTF_IS_DITHERED(layout->bits[c]))
+				channels[c] = channels[c] - (channels[c] >> layout->bits[c]) + _PXTFOrderedOffset(layout->bits[c], x, y)
+		);
+	}
+
+	return _PXTFPack(layout, channels);
+}
+
+#if defined(PXTF_NEON)
+
+// Packs 16 pixels, given one vector per channel, into 16 bit values.
+PXInline PXAlwaysInline void _PXTFPackVectors(const _PXTFPackLayout *layout, uint8x16_t *channels, UInt16 *dst)
+{
+	uint16x8_t lo = vdupq_n_u16(0);
+	uint16x8_t hi = vdupq_n_u16(0);
+
+	PXTF_FOR_EACH_CHANNEL(
+		if (layout->bits[c] != 0)
+		{
+			int16x8_t right = vdupq_n_s16(-(8 - layout->bits[c]));
+			int16x8_t left = vdupq_n_s16(layout->shifts[c]);
+
+			lo = vorrq_u16(lo, vshlq_u16(vshlq_u16(vmovl_u8(vget_low_u8(channels[c])), right), left));
+			hi = vorrq_u16(hi, vshlq_u16(vshlq_u16(vmovl_u8(vget_high_u8(channels[c])), right), left));
+		}
+	);
+
+	vst1q_u16(dst, lo);
+	vst1q_u16(dst + 8, hi);
+}
+
+#elif defined(PXTF_SSE2)
+
+// Packs 4 RGBA 8888 pixels into 16 bit values, one per 32 bit lane.
+PXInline PXAlwaysInline __m128i _PXTFPackLanes(const _PXTFPackLayout *layout, __m128i pixels)
+{
+	__m128i val = _mm_setzero_si128();
+
+	PXTF_FOR_EACH_CHANNEL(
+		if (layout->bits[c] != 0)
+		{
+			__m128i channel = _mm_srl_epi32(pixels, _mm_cvtsi32_si128(c * 8 + 8 - layout->bits[c]));
+			channel = _mm_and_si128(channel, _mm_set1_epi32((1 << layout->bits[c]) - 1));
+
+			val = _mm_or_si128(val, _mm_sll_epi32(channel, _mm_cvtsi32_si128(layout->shifts[c])));
+		}
+	);
+
+	// Sign extend so the saturating pack keeps every bit
+	return _mm_srai_epi32(_mm_slli_epi32(val, 16), 16);
+}
+
+// Applies the ordered pattern to 4 RGBA 8888 pixels, working in 16 bit lanes.
+// The multipliers turn the high half of a product into (channel >> bits).
+PXInline PXAlwaysInline __m128i _PXTFOrderLanes(__m128i pixels, __m128i multipliers, __m128i offsetsLo, __m128i offsetsHi)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+	__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+	lo = _mm_add_epi16(_mm_sub_epi16(lo, _mm_mulhi_epu16(lo, multipliers)), offsetsLo);
+	hi = _mm_add_epi16(_mm_sub_epi16(hi, _mm_mulhi_epu16(hi, multipliers)), offsetsHi);
+
+	return _mm_packus_epi16(lo, hi);
+}
+
+#endif
+
+/*
+ * Converts as much of a row as possible with vector instructions, and returns
+ * the amount of pixels converted. Every load of an iteration happens before
+ * its store, which keeps in place conversion safe.
+ */
+PXInline PXAlwaysInline unsigned _PXTFConvertRowVector(const UInt8 *src,
+														unsigned srcBpp,
+														UInt16 *dst,
+														const _PXTFPackLayout *layout,
+														unsigned width,
+														unsigned y,
+														bool ordered)
+{
+	unsigned x = 0;
+
+#if defined(PXTF_NEON)
+	uint8x16_t channels[4];
+	uint8x16_t offsets[4];
+	int8x16_t shifts[4];
+	UInt8 lanes[16];
+	unsigned index;
+	unsigned c;
+
+	if (ordered)
+	{
+		for (c = 0; c < 4; ++c)
+		{
+			for (index = 0; index < 16; ++index)
+				lanes[index] = _PXTFOrderedOffset(layout->bits[c], index, y);
+
+			offsets[c] = vld1q_u8(lanes);
+			shifts[c] = vdupq_n_s8(-layout->bits[c]);
+		}
+	}
+
+	channels[3] = vdupq_n_u8(0xFF);
+
+	for (; x + 16 <= width; x += 16, src += 16 * srcBpp, dst += 16)
+	{
+		if (srcBpp == 4)
+		{
+			uint8x16x4_t pixels = vld4q_u8(src);
+
+			for (c = 0; c < 4; ++c)
+				channels[c] = pixels.val[c];
+		}
+		else
+		{
+			uint8x16x3_t pixels = vld3q_u8(src);
+
+			for (c = 0; c < 3; ++c)
+				channels[c] = pixels.val[c];
+		}
+
+		if (ordered)
+		{
+			PXTF_FOR_EACH_CHANNEL(
+				if (PXTF_IS_DITHERED(layout->bits[c]))
+					channels[c] = vaddq_u8(vsubq_u8(channels[c], vshlq_u8(channels[c], shifts[c])), offsets[c])
+			);
+		}
+
+		_PXTFPackVectors(layout, channels, dst);
+	}
+#elif defined(PXTF_SSE2)
+	// SSE2 has no way of splitting up 3 byte pixels, so RGB 888 is left to the
+	// scalar path.
+	if (srcBpp != 4)
+		return 0;
+
+	__m128i multipliers = _mm_setzero_si128();
+	__m128i offsetsLo = _mm_setzero_si128();
+	__m128i offsetsHi = _mm_setzero_si128();
+
+	if (ordered)
+	{
+		UInt16 lanes[3][8];
+		unsigned index;
+
+		for (index = 0; index < 8; ++index)
+		{
+			UInt8 bits = layout->bits[index & 3];
+
+			lanes[0][index] = PXTF_IS_DITHERED(bits) ? (1 << (16 - bits)) : 0;
+			lanes[1][index] = _PXTFOrderedOffset(bits, index >> 2, y);
+			lanes[2][index] = _PXTFOrderedOffset(bits, (index >> 2) + 2, y);
+		}
+
+		multipliers = _mm_loadu_si128((const __m128i *)lanes[0]);
+		offsetsLo = _mm_loadu_si128((const __m128i *)lanes[1]);
+		offsetsHi = _mm_loadu_si128((const __m128i *)lanes[2]);
+	}
+
+	for (; x + 8 <= width; x += 8, src += 32, dst += 8)
+	{
+		__m128i lo = _mm_loadu_si128((const __m128i *)src);
+		__m128i hi = _mm_loadu_si128((const __m128i *)(src + 16));
+
+		if (ordered)
+		{
+			lo = _PXTFOrderLanes(lo, multipliers, offsetsLo, offsetsHi);
+			hi = _PXTFOrderLanes(hi, multipliers, offsetsLo, offsetsHi);
+		}
+
+		_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(_PXTFPackLanes(layout, lo), _PXTFPackLanes(layout, hi)));
+	}
+#else
+	PX_NOT_USED(src);
+	PX_NOT_USED(srcBpp);
+	PX_NOT_USED(dst);
+	PX_NOT_USED(layout);
+	PX_NOT_USED(width);
+	PX_NOT_USED(y);
+	PX_NOT_USED(ordered);
+#endif
+
+	return x;
+}
+
+PXInline PXAlwaysInline void _PXTFConvertRows(const UInt8 *src,
+											   unsigned srcBpp,
+											   UInt16 *dst,
+											   const _PXTFPackLayout *layout,
+											   unsigned width,
+											   unsigned height,
+											   bool ordered)
+{
+	unsigned x;
+	unsigned y;
+
+	for (y = 0; y < height; ++y)
+	{
+		x = _PXTFConvertRowVector(src, srcBpp, dst, layout, width, y, ordered);
+
+		src += x * srcBpp;
+		dst += x;
+
+		for (; x < width; ++x, src += srcBpp, ++dst)
+		{
+			*dst = _PXTFConvertPixel(src, srcBpp, layout, x, y, ordered);
+		}
+	}
+}
+
+// Gives the compiler a copy of the row loop for each combination, with the
+// layout and pixel size known up front.
+PXInline PXAlwaysInline void _PXTFConvertRowsWithLayout(const UInt8 *src,
+														 unsigned srcBpp,
+														 UInt16 *dst,
+														 const _PXTFPackLayout *layout,
+														 unsigned width,
+														 unsigned height,
+														 bool ordered)
+{
+	if (srcBpp == 4)
+	{
+		if (ordered)
+			_PXTFConvertRows(src, 4, dst, layout, width, height, true);
+		else
+			_PXTFConvertRows(src, 4, dst, layout, width, height, false);
+	}
+	else
+	{
+		if (ordered)
+			_PXTFConvertRows(src, 3, dst, layout, width, height, true);
+		else
+			_PXTFConvertRows(src, 3, dst, layout, width, height, false);
+	}
+}
+
+/*
+ * Floyd-Steinberg. The errors are kept in sixteenths, for the row being
+ * converted and the one below it. Returns false if the error rows couldn't be
+ * allocated.
+ */
+PXInline bool _PXTFConvertErrorDiffusion(const UInt8 *src,
+										 unsigned srcBpp,
+										 UInt16 *dst,
+										 const _PXTFPackLayout *layout,
+										 unsigned width,
+										 unsigned height)
+{
+	// One pixel of padding on each side, so the neighbors never need a check
+	unsigned rowLength = (width + 2) * 4;
+	int *errors = calloc(rowLength * 2, sizeof(int));
+
+	if (!errors)
+		return false;
+
+	int *curErrors = errors;
+	int *nextErrors = errors + rowLength;
+	int *swapErrors;
+
+	UInt8 channels[4];
+	unsigned x;
+	unsigned y;
+	unsigned c;
+
+	for (y = 0; y < height; ++y)
+	{
+		for (x = 0; x < width; ++x, src += srcBpp, ++dst)
+		{
+			channels[3] = 0xFF;
+
+			for (c = 0; c < srcBpp; ++c)
+				channels[c] = src[c];
+
+			for (c = 0; c < 4; ++c)
+			{
+				UInt8 bits = layout->bits[c];
+
+				if (!PXTF_IS_DITHERED(bits))
+					continue;
+
+				int *error = curErrors + (x + 1) * 4 + c;
+				int max = (1 << bits) - 1;
+
+				int val = channels[c] + ((*error + 8) >> 4);
+				val = val < 0 ? 0 : (val > 0xFF ? 0xFF : val);
+
+				// Round to the nearest level, then store it in the top bits the
+				// way the pack expects.
+				int level = (val * max + 127) / 0xFF;
+				int diff = val - (level * 0xFF) / max;
+
+				channels[c] = level << (8 - bits);
+
+				error[4] += diff * 7;
+				nextErrors[x * 4 + c] += diff * 3;
+				nextErrors[(x + 1) * 4 + c] += diff * 5;
+				nextErrors[(x + 2) * 4 + c] += diff;
+			}
+
+			*dst = _PXTFPack(layout, channels);
+		}
+
+		swapErrors = curErrors;
+		curErrors = nextErrors;
+		nextErrors = swapErrors;
+		memset(nextErrors, 0, rowLength * sizeof(int));
+	}
+
+	free(errors);
+	return true;
+}
+
+/**
+ * Converts a block of 8 bits per channel pixels (RGBA 8888 or RGB 888) into a
+ * 16 bit format (RGBA 4444, RGBA 5551 or RGB 565), optionally dithering the
+ * result. Without dithering the output matches the per pixel `PXTF_*_From_*`
+ * functions exactly.
+ *
+ * Rows are converted 16 pixels at a time with NEON, or 8 at a time with SSE2
+ * (RGBA 8888 only) where available. Since the output is never larger than the
+ * input, `dst` may be the same buffer as `src`.
+ *
+ * Only these six pairs are handled here. Every other one is deliberately left
+ * to the per pixel functions, which the texture modifiers fall back to:
+ *
+ * - From RGBA 4444, RGBA 5551 or RGB 565 to another 16 bit format. These
+ *   already have 4 to 6 bits per channel, so there's little banding left to
+ *   dither away, and images are rarely stored this way.
+ * - From LA 88, L 8 or A 8. Each pixel spreads one or two channels over the
+ *   output, which doesn't fit the packing done here.
+ * - From or to a compressed format (PVRTC, ETC1), which can't be converted
+ *   pixel by pixel at all.
+ *
+ * Tools/pxbench has a benchmark of the RGBA 8888 to RGBA 4444 conversion of a
+ * 2048x2048 image.
+ *
+ * @return `false` if the pair of formats isn't supported, in which case
+ * nothing is written.
+ */
+bool PXTextureFormatConvertTo16Bit(const void *src,
+								   PXTextureDataPixelFormat srcFormat,
+								   void *dst,
+								   PXTextureDataPixelFormat dstFormat,
+								   unsigned width,
+								   unsigned height,
+								   PXTextureDither dither)
+{
+	unsigned srcBpp;
+
+	switch (srcFormat)
+	{
+		case PXTextureDataPixelFormat_RGBA8888:
+			srcBpp = 4;
+			break;
+		case PXTextureDataPixelFormat_RGB888:
+			srcBpp = 3;
+			break;
+		default:
+			return false;
+	}
+
+	const _PXTFPackLayout *layout;
+
+	switch (dstFormat)
+	{
+		case PXTextureDataPixelFormat_RGBA4444:
+			layout = &pxTFPackLayout4444;
+			break;
+		case PXTextureDataPixelFormat_RGBA5551:
+			layout = &pxTFPackLayout5551;
+			break;
+		case PXTextureDataPixelFormat_RGB565:
+			layout = &pxTFPackLayout565;
+			break;
+		default:
+			return false;
+	}
+
+	const UInt8 *readPixels = (const UInt8 *)src;
+	UInt16 *writePixels = (UInt16 *)dst;
+
+	if (dither == PXTextureDither_ErrorDiffusion)
+	{
+		if (_PXTFConvertErrorDiffusion(readPixels, srcBpp, writePixels, layout, width, height))
+			return true;
+
+		// Not enough memory for the error rows, use the pattern instead
+		dither = PXTextureDither_Ordered;
+	}
+
+	bool ordered = (dither == PXTextureDither_Ordered);
+
+	// Spelled out so every copy of the loop sees a constant layout
+	switch (dstFormat)
+	{
+		case PXTextureDataPixelFormat_RGBA4444:
+			_PXTFConvertRowsWithLayout(readPixels, srcBpp, writePixels, &pxTFPackLayout4444, width, height, ordered);
+			break;
+		case PXTextureDataPixelFormat_RGBA5551:
+			_PXTFConvertRowsWithLayout(readPixels, srcBpp, writePixels, &pxTFPackLayout5551, width, height, ordered);
+			break;
+		default:
+			_PXTFConvertRowsWithLayout(readPixels, srcBpp, writePixels, &pxTFPackLayout565, width, height, ordered);
+			break;
+	}
+
+	return true;
+}
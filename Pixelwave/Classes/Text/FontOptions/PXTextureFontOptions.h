@@ -47,6 +47,11 @@
 	float size;
 
 	id<PXTextureModifier> textureModifier;
+
+	BOOL dynamicGlyphs;
+	BOOL signedDistanceField;
+	unsigned glyphPageSize;
+	unsigned maxGlyphPageCount;
 }
 
 /**
@@ -65,6 +70,47 @@
  */
 @property (nonatomic) float size;
 
+/**
+ * If `YES`, glyphs are rasterized the first time they are
+ * displayed instead of when the font is registered. The characters described
+ * by these options are rasterized up front, any other character the font file
+ * contains is added when needed. Only fonts parsed from a font file (such as
+ * a .ttf) support this, and the #textureModifier is not applied to them.
+ *
+ * **Default:** `NO`
+ */
+@property (nonatomic) BOOL dynamicGlyphs;
+
+/**
+ * If `YES`, each glyph is stored as a signed distance field
+ * instead of a coverage bitmap. Distance field fonts stay sharp at any
+ * #PXTextField fontSize, so a single font can be used for every size of text.
+ * They are drawn with alpha testing, so their edges are not anti-aliased and
+ * text drawn with an alpha below 1.0 becomes thinner.
+ *
+ * A size of 24 to 48 works well for distance field fonts; smaller sizes lose
+ * the detail of thin strokes.
+ *
+ * **Default:** `NO`
+ */
+@property (nonatomic) BOOL signedDistanceField;
+
+/**
+ * The width and height, in pixels, of each texture that dynamic glyphs get
+ * packed into. Rounded up to a power of two.
+ *
+ * **Default:** 512
+ */
+@property (nonatomic) unsigned glyphPageSize;
+
+/**
+ * The largest number of textures dynamic glyphs may use. Once every texture
+ * is full, the least recently used one is emptied and reused.
+ *
+ * **Default:** 4
+ */
+@property (nonatomic) unsigned maxGlyphPageCount;
+
 //-- ScriptName: TextureFontOptions
 //-- ScriptArg[0]: required
 //-- ScriptArg[1]: PXFontCharacterSet_None
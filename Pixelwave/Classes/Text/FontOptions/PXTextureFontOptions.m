@@ -57,6 +57,10 @@
 
 @synthesize size;
 @synthesize textureModifier;
+@synthesize dynamicGlyphs;
+@synthesize signedDistanceField;
+@synthesize glyphPageSize;
+@synthesize maxGlyphPageCount;
 
 - (id) init
 {
@@ -86,6 +90,11 @@
 		size = _size;
 
 		textureModifier = nil;
+
+		dynamicGlyphs = NO;
+		signedDistanceField = NO;
+		glyphPageSize = 512;
+		maxGlyphPageCount = 4;
 	}
 
 	return self;
@@ -102,6 +111,11 @@
 {
 	size = [PXTextureFontOptions defaultSize];
 
+	dynamicGlyphs = NO;
+	signedDistanceField = NO;
+	glyphPageSize = 512;
+	maxGlyphPageCount = 4;
+
 	[super reset];
 }
 
@@ -115,15 +129,21 @@
 	options->size = size;
 	options.characters = characters;
 	options.textureModifier = textureModifier;
+	options->dynamicGlyphs = dynamicGlyphs;
+	options->signedDistanceField = signedDistanceField;
+	options->glyphPageSize = glyphPageSize;
+	options->maxGlyphPageCount = maxGlyphPageCount;
 
 	return options;
 }
 
 - (NSString *)description
 {
-	return [NSString stringWithFormat:@"(size=%f, character=%@)",
+	return [NSString stringWithFormat:@"(size=%f, character=%@, dynamicGlyphs=%@, signedDistanceField=%@)",
 			size,
-			characters];
+			characters,
+			dynamicGlyphs ? @"YES" : @"NO",
+			signedDistanceField ? @"YES" : @"NO"];
 }
 
 /**
@@ -0,0 +1,204 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXDynamicTextureFont.h"
+
+#import "PXDebug.h"
+#import "PXPoint.h"
+
+#import "PXTextureGlyphAtlas.h"
+#import "PXTextureGlyph.h"
+#import "PXTextureData.h"
+
+/**
+ * A PXDynamicTextureFont is a texture font that rasterizes its glyphs the
+ * first time they are asked for, rather than all at once when the font is
+ * registered. This lets a font cover a large character set, such as CJK,
+ * while only paying for the glyphs that actually get displayed.
+ *
+ * Glyphs are packed into a #PXTextureGlyphAtlas. When the atlas runs out of
+ * room its least recently used page is reused; the glyphs that lived on it
+ * are dropped and rasterized again if they are needed later.
+ *
+ * Dynamic fonts are made by setting the `dynamicGlyphs` property of
+ * a PXTextureFontOptions to `YES`.
+ *
+ * @see PXTextureFontOptions
+ */
+@implementation PXDynamicTextureFont
+
+@synthesize atlas;
+
+- (id) init
+{
+	PXDebugLog(@"PXDynamicTextureFont must be initialized with a rasterizer and an atlas");
+	[self release];
+	return nil;
+}
+
+- (id) initWithRasterizer:(id<PXTextureGlyphRasterizer>)_rasterizer
+				   source:(id)_source
+					atlas:(PXTextureGlyphAtlas *)_atlas
+{
+	self = [super init];
+
+	if (self)
+	{
+		if (!_rasterizer || !_atlas)
+		{
+			[self release];
+			return nil;
+		}
+
+		// The source is released after the rasterizer, in case the rasterizer
+		// only holds a weak reference to it.
+		source = [_source retain];
+		rasterizer = [_rasterizer retain];
+
+		atlas = [_atlas retain];
+		atlas->_font = self;
+
+		missingCharacters = [[NSMutableIndexSet alloc] init];
+	}
+
+	return self;
+}
+
+- (void) dealloc
+{
+	atlas->_font = nil;
+	[atlas release];
+	atlas = nil;
+
+	[missingCharacters release];
+	missingCharacters = nil;
+
+	[rasterizer release];
+	rasterizer = nil;
+
+	[source release];
+	source = nil;
+
+	[super dealloc];
+}
+
+- (NSArray *)textureDatas
+{
+	return atlas.textureDatas;
+}
+
+- (PXTextureGlyph *)glyphFromCharacter:(unichar)character
+{
+	PXTextureGlyph *glyph = [super glyphFromCharacter:character];
+
+	if (!glyph)
+	{
+		// The font does not have this character, no need to ask again.
+		if ([missingCharacters containsIndex:character])
+			return nil;
+
+		glyph = [rasterizer newGlyphForCharacter:character atlas:atlas];
+
+		if (!glyph)
+		{
+			[missingCharacters addIndex:character];
+			return nil;
+		}
+
+		[self setGlyph:glyph forCharacter:character];
+		[glyph release];
+	}
+
+	[atlas touchTextureData:glyph.textureData];
+
+	return glyph;
+}
+
+- (PXPoint *)kerningPointFromFirstCharacter:(unichar)firstCharacter
+							secondCharacter:(unichar)secondCharacter
+{
+	PXPoint *point = [super kerningPointFromFirstCharacter:firstCharacter
+										   secondCharacter:secondCharacter];
+
+	if (point)
+		return point;
+
+	point = [rasterizer newKerningPointFromFirstCharacter:firstCharacter
+										  secondCharacter:secondCharacter];
+
+	// Pairs without kerning are remembered as a zero point, so the rasterizer
+	// is only asked once per pair.
+	if (!point)
+		point = [[PXPoint alloc] initWithX:0.0f y:0.0f];
+
+	[self setKerningPoint:point forFirstCharacter:firstCharacter secondCharacter:secondCharacter];
+	[point release];
+
+	return point;
+}
+
+@end
+
+@implementation PXDynamicTextureFont(PrivateButPublic)
+
+- (void) _removeGlyphsWithTextureData:(PXTextureData *)textureData
+{
+	NSMutableArray *keys = [[NSMutableArray alloc] init];
+
+	NSEnumerator *enumerator = [characterToGlyph keyEnumerator];
+	NSString *key;
+	PXTextureGlyph *glyph;
+
+	while ((key = [enumerator nextObject]))
+	{
+		glyph = [characterToGlyph objectForKey:key];
+
+		if (glyph.textureData == textureData)
+			[keys addObject:key];
+	}
+
+	[self _removeGlyphsForStrings:keys];
+	[keys release];
+
+	// Any renderer that laid out text with the removed glyphs needs to do it
+	// again.
+	++_glyphGeneration;
+}
+
+@end
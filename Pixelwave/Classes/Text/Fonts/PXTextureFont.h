@@ -38,6 +38,7 @@
  */
 
 #import "PXFont.h"
+#include <CoreFoundation/CoreFoundation.h>
 
 @class PXTextureGlyph;
 @class PXPoint;
@@ -48,9 +49,21 @@
 	float _baseLine;
 	float _fontSize;
 
+	// Changes whenever glyphs are removed from the font, telling renderers
+	// that their layout is stale.
+	unsigned _glyphGeneration;
+
+	// The glyphs are signed distance fields rather than coverage.
+	BOOL _isDistanceField;
+
 @protected
 	NSMutableDictionary *characterToGlyph;
 	NSMutableDictionary *charactersToKern;
+
+	// The same glyphs and kerning points keyed directly by character, so that
+	// looking them up doesn't need to make a string.
+	CFMutableDictionaryRef glyphsByCharacter;
+	CFMutableDictionaryRef kernsByCharacters;
 }
 
 /**
@@ -74,3 +87,7 @@ secondCharacter:(unichar)secondCharacter;
 	   forFirstCharacter:(unichar)firstCharacter
 		 secondCharacter:(unichar)secondCharacter;
 @end
+
+@interface PXTextureFont(Protected)
+- (void) _removeGlyphsForStrings:(NSArray *)strings;
+@end
@@ -45,6 +45,19 @@
 #import "PXTextureGlyph.h"
 #import "PXTextureData.h"
 
+#include "PXPrivateUtils.h"
+
+// Keys for the character dictionaries. They are offset by one so that no key
+// is ever NULL.
+PXInline const void *PXTextureFontGlyphKey(unichar character)
+{
+	return (const void *)((uintptr_t)character + 1);
+}
+PXInline const void *PXTextureFontKernKey(unichar firstCharacter, unichar secondCharacter)
+{
+	return (const void *)((((uintptr_t)firstCharacter << 16) | secondCharacter) + 1);
+}
+
 /**
  * A PXTextureFont object represents a texture containing a parsed font.  The
  * texture is packed to try and use the least space possible.
@@ -77,10 +90,15 @@
 		// Default font information.
 		_baseLine =  0.0f;
 		_fontSize = 12.0f;
+		_glyphGeneration = 0;
+		_isDistanceField = NO;
 
 		// A dictionary to store our glyphs 
 		characterToGlyph = [[NSMutableDictionary alloc] init];
 		charactersToKern = [[NSMutableDictionary alloc] init];
+
+		glyphsByCharacter = CFDictionaryCreateMutable(NULL, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+		kernsByCharacters = CFDictionaryCreateMutable(NULL, 0, NULL, &kCFTypeDictionaryValueCallBacks);
 	}
 
 	return self;
@@ -96,6 +114,14 @@
 	[charactersToKern release];
 	charactersToKern = nil;
 
+	if (glyphsByCharacter)
+		CFRelease(glyphsByCharacter);
+	glyphsByCharacter = NULL;
+
+	if (kernsByCharacters)
+		CFRelease(kernsByCharacters);
+	kernsByCharacters = NULL;
+
 	[super dealloc];
 }
 
@@ -136,36 +162,29 @@
 
 - (PXTextureGlyph *)glyphFromCharacter:(unichar)character
 {
-	NSString *key = [[NSString alloc] initWithCharacters:&character length:1];
-
-	PXTextureGlyph *glyph = [characterToGlyph objectForKey:key];
-
-	[key release];
-
-	return glyph;
+	return (PXTextureGlyph *)CFDictionaryGetValue(glyphsByCharacter, PXTextureFontGlyphKey(character));
 }
 - (PXPoint *)kerningPointFromFirstCharacter:(unichar)firstCharacter
 						  secondCharacter:(unichar)secondCharacter
 {
-	unichar characters[] = {firstCharacter, secondCharacter};
-	NSString *key = [[NSString alloc] initWithCharacters:characters length:2];
-
-	PXPoint *point = [charactersToKern objectForKey:key];
-
-	[key release];
-
-	return point;
+	return (PXPoint *)CFDictionaryGetValue(kernsByCharacters, PXTextureFontKernKey(firstCharacter, secondCharacter));
 }
 
 - (void) setGlyph:(PXTextureGlyph *)glyph forString:(NSString *)string
 {
 	[characterToGlyph setObject:glyph forKey:string];
+
+	if ([string length] == 1)
+	{
+		CFDictionarySetValue(glyphsByCharacter, PXTextureFontGlyphKey([string characterAtIndex:0]), glyph);
+	}
 }
 - (void) setGlyph:(PXTextureGlyph *)glyph forCharacter:(unichar)character
 {
 	NSString *key = [[NSString alloc] initWithCharacters:&character length:1];
 
 	[characterToGlyph setObject:glyph forKey:key];
+	CFDictionarySetValue(glyphsByCharacter, PXTextureFontGlyphKey(character), glyph);
 
 	[key release];
 }
@@ -173,6 +192,13 @@
 - (void) setKerningPoint:(PXPoint *)kerningPoint forString:(NSString *)string
 {
 	[charactersToKern setObject:kerningPoint forKey:string];
+
+	if ([string length] == 2)
+	{
+		CFDictionarySetValue(kernsByCharacters,
+							 PXTextureFontKernKey([string characterAtIndex:0], [string characterAtIndex:1]),
+							 kerningPoint);
+	}
 }
 - (void) setKerningPoint:(PXPoint *)kerningPoint
 	   forFirstCharacter:(unichar)firstCharacter
@@ -182,8 +208,26 @@
 	NSString *key = [[NSString alloc] initWithCharacters:characters length:2];
 
 	[charactersToKern setObject:kerningPoint forKey:key];
+	CFDictionarySetValue(kernsByCharacters, PXTextureFontKernKey(firstCharacter, secondCharacter), kerningPoint);
 
 	[key release];
 }
 
 @end
+
+@implementation PXTextureFont(Protected)
+
+- (void) _removeGlyphsForStrings:(NSArray *)strings
+{
+	for (NSString *string in strings)
+	{
+		if ([string length] == 1)
+		{
+			CFDictionaryRemoveValue(glyphsByCharacter, PXTextureFontGlyphKey([string characterAtIndex:0]));
+		}
+	}
+
+	[characterToGlyph removeObjectsForKeys:strings];
+}
+
+@end
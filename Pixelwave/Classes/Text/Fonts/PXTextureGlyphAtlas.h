@@ -0,0 +1,93 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <CoreGraphics/CGGeometry.h>
+
+@class PXTextureData;
+@class PXDynamicTextureFont;
+
+@interface PXTextureGlyphAtlas : NSObject
+{
+@public
+	// Not retained, the font owns the atlas.
+	PXDynamicTextureFont *_font;
+
+@protected
+	unsigned pageSize;
+	unsigned maxPageCount;
+	float contentScaleFactor;
+
+	NSMutableArray *pages;
+	void *vPageInfos;
+
+	unsigned useClock;
+}
+
+/**
+ * Every page of the atlas. Each page is a square A8 texture data of
+ * #pageSize pixels.
+ */
+@property (nonatomic, readonly) NSArray *textureDatas;
+
+/**
+ * The width and height, in pixels, of every page.
+ */
+@property (nonatomic, readonly) unsigned pageSize;
+
+/**
+ * The maximum number of pages that may exist at once. When every page is full
+ * the least recently used page is evicted and reused.
+ */
+@property (nonatomic, readonly) unsigned maxPageCount;
+
+- (id) initWithPageSize:(unsigned)pageSize
+		   maxPageCount:(unsigned)maxPageCount
+	 contentScaleFactor:(float)contentScaleFactor;
+
+- (PXTextureData *)addBitmap:(const unsigned char *)bytes
+					   width:(unsigned)width
+					  height:(unsigned)height
+					   pitch:(int)pitch
+			   textureBounds:(CGRect *)textureBounds;
+
+- (PXTextureData *)emptyTextureData;
+
+- (void) touchTextureData:(PXTextureData *)textureData;
+
+@end
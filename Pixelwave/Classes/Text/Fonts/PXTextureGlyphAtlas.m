@@ -0,0 +1,480 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXTextureGlyphAtlas.h"
+
+#import "PXGL.h"
+#include "PXGLCommandBuffer.h"
+#import "PXDebug.h"
+#import "PXTextureData.h"
+
+#import "PXDynamicTextureFont.h"
+
+#include "PXGLErrorUtils.h"
+#include "PXMathUtils.h"
+#include "PXPrivateUtils.h"
+#include <limits.h>
+
+// Empty pixels left around every glyph so that smoothing never samples a
+// neighbour.
+#define PX_TEXTURE_GLYPH_ATLAS_PADDING 1
+
+typedef struct
+{
+	unsigned short x;
+	unsigned short y;
+	unsigned short height;
+} _PXTextureGlyphAtlasShelf;
+
+typedef struct
+{
+	_PXTextureGlyphAtlasShelf *shelves;
+	unsigned shelfCount;
+	unsigned shelfCapacity;
+
+	// Where the next shelf will be opened.
+	unsigned nextY;
+
+	// The value of the use clock the last time a glyph on this page was used.
+	unsigned lastUse;
+} _PXTextureGlyphAtlasPage;
+
+PXInline void _PXTextureGlyphAtlasPageReset(_PXTextureGlyphAtlasPage *page)
+{
+	page->shelfCount = 0;
+	page->nextY = 0;
+	page->lastUse = 0;
+}
+
+PXInline BOOL _PXTextureGlyphAtlasPageInsert(_PXTextureGlyphAtlasPage *page,
+											 unsigned pageSize,
+											 unsigned width,
+											 unsigned height,
+											 unsigned *retX,
+											 unsigned *retY)
+{
+	_PXTextureGlyphAtlasShelf *shelf;
+	_PXTextureGlyphAtlasShelf *bestShelf = NULL;
+	unsigned index;
+	unsigned waste;
+	unsigned bestWaste = UINT_MAX;
+
+	// Find the shelf that wastes the least amount of height.
+	for (index = 0, shelf = page->shelves; index < page->shelfCount; ++index, ++shelf)
+	{
+		if (shelf->height < height || shelf->x + width > pageSize)
+			continue;
+
+		waste = shelf->height - height;
+
+		if (waste < bestWaste)
+		{
+			bestShelf = shelf;
+			bestWaste = waste;
+
+			if (waste == 0)
+				break;
+		}
+	}
+
+	BOOL canOpenShelf = (page->nextY + height <= pageSize);
+
+	// Only settle for a shelf that wastes more than half of the glyph's height
+	// if a new one can't be opened.
+	if (bestShelf && (bestWaste <= (height >> 1) || !canOpenShelf))
+	{
+		*retX = bestShelf->x;
+		*retY = bestShelf->y;
+
+		bestShelf->x += width;
+
+		return YES;
+	}
+
+	if (!canOpenShelf)
+		return NO;
+
+	if (page->shelfCount == page->shelfCapacity)
+	{
+		unsigned newCapacity = page->shelfCapacity ? (page->shelfCapacity << 1) : 8;
+		_PXTextureGlyphAtlasShelf *newShelves = realloc(page->shelves, sizeof(_PXTextureGlyphAtlasShelf) * newCapacity);
+
+		if (!newShelves)
+			return NO;
+
+		page->shelves = newShelves;
+		page->shelfCapacity = newCapacity;
+	}
+
+	shelf = page->shelves + page->shelfCount;
+	++(page->shelfCount);
+
+	shelf->x = width;
+	shelf->y = page->nextY;
+	shelf->height = height;
+
+	page->nextY += height;
+
+	*retX = 0;
+	*retY = shelf->y;
+
+	return YES;
+}
+
+@interface PXTextureGlyphAtlas(Private)
+- (PXTextureData *)_newPage;
+- (unsigned) _leastRecentlyUsedPageIndex;
+@end
+
+/**
+ * A PXTextureGlyphAtlas packs glyph bitmaps into a set of A8 pages as they
+ * are needed. Glyphs are placed on horizontal shelves, and once every page
+ * is full the least recently used page is emptied, along with every glyph of
+ * the owning font that lived on it, and reused.
+ *
+ * Bitmaps are uploaded with `glTexSubImage2D`, so only the
+ * area taken by the new glyph is sent to the GPU.
+ *
+ * @see PXDynamicTextureFont
+ */
+@implementation PXTextureGlyphAtlas
+
+@synthesize pageSize;
+@synthesize maxPageCount;
+
+- (id) init
+{
+	PXDebugLog(@"PXTextureGlyphAtlas must be initialized with a page size");
+	[self release];
+	return nil;
+}
+
+- (id) initWithPageSize:(unsigned)_pageSize
+		   maxPageCount:(unsigned)_maxPageCount
+	 contentScaleFactor:(float)_contentScaleFactor
+{
+	self = [super init];
+
+	if (self)
+	{
+		_font = nil;
+
+		pageSize = PXMathNextPowerOfTwo(_pageSize);
+		maxPageCount = MAX(_maxPageCount, 1);
+		contentScaleFactor = _contentScaleFactor;
+
+		pages = [[NSMutableArray alloc] initWithCapacity:maxPageCount];
+		vPageInfos = calloc(maxPageCount, sizeof(_PXTextureGlyphAtlasPage));
+
+		useClock = 0;
+
+		if (!vPageInfos)
+		{
+			[self release];
+			return nil;
+		}
+	}
+
+	return self;
+}
+
+- (void) dealloc
+{
+	_PXTextureGlyphAtlasPage *pageInfos = (_PXTextureGlyphAtlasPage *)(vPageInfos);
+
+	if (pageInfos)
+	{
+		unsigned index;
+		for (index = 0; index < maxPageCount; ++index)
+		{
+			if (pageInfos[index].shelves)
+				free(pageInfos[index].shelves);
+		}
+
+		free(pageInfos);
+		vPageInfos = NULL;
+	}
+
+	[pages release];
+	pages = nil;
+
+	_font = nil;
+
+	[super dealloc];
+}
+
+- (NSArray *)textureDatas
+{
+	return [NSArray arrayWithArray:pages];
+}
+
+// MARK: -
+// MARK: Packing
+
+- (PXTextureData *)addBitmap:(const unsigned char *)bytes
+					   width:(unsigned)width
+					  height:(unsigned)height
+					   pitch:(int)pitch
+			   textureBounds:(CGRect *)textureBounds
+{
+	if (width == 0 || height == 0 || !bytes)
+	{
+		if (textureBounds)
+			*textureBounds = CGRectZero;
+
+		return [self emptyTextureData];
+	}
+
+	unsigned slotWidth  = width  + (PX_TEXTURE_GLYPH_ATLAS_PADDING << 1);
+	unsigned slotHeight = height + (PX_TEXTURE_GLYPH_ATLAS_PADDING << 1);
+
+	if (slotWidth > pageSize || slotHeight > pageSize)
+	{
+		PXDebugLog(@"PXTextureGlyphAtlas: a glyph of %ux%u does not fit on a page of %u", width, height, pageSize);
+		return nil;
+	}
+
+	_PXTextureGlyphAtlasPage *pageInfos = (_PXTextureGlyphAtlasPage *)(vPageInfos);
+	_PXTextureGlyphAtlasPage *pageInfo = NULL;
+
+	unsigned pageCount = [pages count];
+	unsigned pageIndex;
+	unsigned x = 0;
+	unsigned y = 0;
+
+	BOOL found = NO;
+
+	for (pageIndex = 0; pageIndex < pageCount; ++pageIndex)
+	{
+		if (_PXTextureGlyphAtlasPageInsert(pageInfos + pageIndex, pageSize, slotWidth, slotHeight, &x, &y))
+		{
+			found = YES;
+			break;
+		}
+	}
+
+	if (!found)
+	{
+		if (pageCount < maxPageCount)
+		{
+			PXTextureData *page = [self _newPage];
+
+			if (!page)
+				return nil;
+
+			[pages addObject:page];
+			[page release];
+
+			pageIndex = pageCount;
+		}
+		else
+		{
+			// Every page is full, empty the one that was used the longest time
+			// ago. The font drops every glyph that lived on it, they will be
+			// rasterized again the next time they are asked for.
+			pageIndex = [self _leastRecentlyUsedPageIndex];
+
+			[_font _removeGlyphsWithTextureData:[pages objectAtIndex:pageIndex]];
+			_PXTextureGlyphAtlasPageReset(pageInfos + pageIndex);
+		}
+
+		if (!_PXTextureGlyphAtlasPageInsert(pageInfos + pageIndex, pageSize, slotWidth, slotHeight, &x, &y))
+			return nil;
+	}
+
+	pageInfo = pageInfos + pageIndex;
+	pageInfo->lastUse = ++useClock;
+
+	PXTextureData *textureData = [pages objectAtIndex:pageIndex];
+
+	// Copy the bitmap into a zeroed slot, so the padding around it clears
+	// whatever a previously evicted glyph left behind.
+	unsigned char *slotBytes = calloc(slotWidth * slotHeight, sizeof(unsigned char));
+
+	if (!slotBytes)
+		return nil;
+
+	unsigned char *dstRow = slotBytes + PX_TEXTURE_GLYPH_ATLAS_PADDING + (PX_TEXTURE_GLYPH_ATLAS_PADDING * slotWidth);
+	const unsigned char *srcRow = bytes;
+	unsigned row;
+
+	for (row = 0; row < height; ++row, dstRow += slotWidth, srcRow += pitch)
+	{
+		memcpy(dstRow, srcRow, width);
+	}
+
+	PXGLBeginDirect();
+
+	GLuint boundTex = PXGLBoundTexture();
+	PXGLBindTexture(GL_TEXTURE_2D, textureData->_glName);
+	{
+		GLint align;
+		glGetIntegerv(GL_UNPACK_ALIGNMENT, &align);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, slotWidth, slotHeight, GL_ALPHA, GL_UNSIGNED_BYTE, slotBytes);
+		PXGLErrorTag("glTexSubImage2D", textureData->_glName);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, align);
+	}
+	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
+
+	PXGLEndDirect();
+
+	free(slotBytes);
+
+	if (textureBounds)
+	{
+		float one_pageSize = 1.0f / (float)pageSize;
+
+		*textureBounds = CGRectMake((float)(x + PX_TEXTURE_GLYPH_ATLAS_PADDING) * one_pageSize,
+									(float)(y + PX_TEXTURE_GLYPH_ATLAS_PADDING) * one_pageSize,
+									(float)(width)  * one_pageSize,
+									(float)(height) * one_pageSize);
+	}
+
+	return textureData;
+}
+
+/**
+ * The page used by glyphs that have nothing to draw, such as a space. The
+ * renderer skips any character without a texture data, so these glyphs still
+ * need one.
+ */
+- (PXTextureData *)emptyTextureData
+{
+	if ([pages count] == 0)
+	{
+		PXTextureData *page = [self _newPage];
+
+		if (!page)
+			return nil;
+
+		[pages addObject:page];
+		[page release];
+	}
+
+	return [pages objectAtIndex:0];
+}
+
+/**
+ * Marks the page holding the given texture data as used, so that it is the
+ * last one to be evicted.
+ */
+- (void) touchTextureData:(PXTextureData *)textureData
+{
+	_PXTextureGlyphAtlasPage *pageInfos = (_PXTextureGlyphAtlasPage *)(vPageInfos);
+
+	unsigned pageCount = [pages count];
+	unsigned pageIndex;
+
+	for (pageIndex = 0; pageIndex < pageCount; ++pageIndex)
+	{
+		if ([pages objectAtIndex:pageIndex] == textureData)
+		{
+			pageInfos[pageIndex].lastUse = ++useClock;
+			return;
+		}
+	}
+}
+
+// MARK: -
+// MARK: Private
+
+- (PXTextureData *)_newPage
+{
+	PXTextureData *textureData = [[PXTextureData alloc] _init];
+
+	if (!textureData)
+		return nil;
+
+	// GL does not define the contents of a texture made without data, so
+	// the page is cleared up front.
+	unsigned char *bytes = calloc(pageSize * pageSize, sizeof(unsigned char));
+
+	if (!bytes)
+	{
+		[textureData release];
+		return nil;
+	}
+
+	PXGLBeginDirect();
+
+	GLuint boundTex = PXGLBoundTexture();
+	PXGLBindTexture(GL_TEXTURE_2D, textureData->_glName);
+	{
+		textureData->_smoothingType = GL_NEAREST;
+		PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, textureData->_smoothingType);
+		PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, textureData->_smoothingType);
+
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, pageSize, pageSize, 0, GL_ALPHA, GL_UNSIGNED_BYTE, bytes);
+		PXGLErrorTag("glTexImage2D", textureData->_glName);
+	}
+	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
+
+	PXGLEndDirect();
+
+	free(bytes);
+
+	[textureData _setInternalPropertiesWithWidth:pageSize
+										  height:pageSize
+							   usingContentWidth:pageSize
+								   contentHeight:pageSize
+							  contentScaleFactor:contentScaleFactor
+										  format:PXTextureDataPixelFormat_A8];
+
+	return textureData;
+}
+
+- (unsigned) _leastRecentlyUsedPageIndex
+{
+	_PXTextureGlyphAtlasPage *pageInfos = (_PXTextureGlyphAtlasPage *)(vPageInfos);
+
+	unsigned pageCount = [pages count];
+	unsigned pageIndex;
+	unsigned oldestIndex = 0;
+
+	for (pageIndex = 1; pageIndex < pageCount; ++pageIndex)
+	{
+		if (pageInfos[pageIndex].lastUse < pageInfos[oldestIndex].lastUse)
+			oldestIndex = pageIndex;
+	}
+
+	return oldestIndex;
+}
+
+@end
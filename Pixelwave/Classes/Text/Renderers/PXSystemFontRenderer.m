@@ -49,6 +49,7 @@
 #import "PXDebug.h"
 
 #import "PXTextureData.h"
+#import "PXTextureMemory.h"
 #import "PXTextureGlyphBatch.h"
 
 @implementation PXSystemFontRenderer
@@ -209,6 +210,8 @@
 	}
 	PXGLBindTexture(GL_TEXTURE_2D, boundTex);
 
+	PXTextureMemorySetByteCount(textureData, PXTextureMemoryGetByteCount(texWidth, texHeight, PXTextureDataPixelFormat_A8));
+
 	CGContextRelease(context);
 	free(data);
 
@@ -270,6 +273,7 @@
 //	PXGLDisableClientState(GL_POINT_SIZE_ARRAY_OES);
 //	PXGLDisableClientState(GL_COLOR_ARRAY);
 
+	PXTextureMemoryUse(textureData);
 	PXGLBindTexture(GL_TEXTURE_2D, textureData->_glName);
 
 	if (smoothingType != textureData->_smoothingType)
@@ -44,8 +44,32 @@
 @interface PXTextureFontRenderer : PXFontRenderer
 {
 @protected
-	NSMutableDictionary *glNameToTextureGlyphBatch;
 	PXTextureFont *font;
+	unsigned glyphGeneration;
+
+	// One batch per texture, looked up by the texture's gl name.
+	void *vBatches;
+	unsigned batchCount;
+	unsigned batchCapacity;
+	unsigned lastBatchIndex;
+
+	// Where every character of the last laid out text was placed.
+	void *vGlyphs;
+	unsigned glyphCount;
+	unsigned glyphCapacity;
+
+	unichar *characters;
+	unsigned characterCapacity;
+
+	// What the layout was made with; if any of these change, all of it has to
+	// be redone.
+	float layoutMultVal;
+	float layoutLetterSpacing;
+	BOOL layoutKerning;
+
+	// The alignment offset already added to the vertices.
+	float appliedShiftX;
+	float appliedShiftY;
 
 	unsigned int smoothingType;
 
@@ -46,11 +46,46 @@
 #import "PXTextField.h"
 #import "PXTextureGlyph.h"
 #import "PXTextureData.h"
+#import "PXTextureMemory.h"
 
 #import "PXPoint.h"
 
 #import "PXTextureGlyphBatch.h"
 
+#include "PXPrivateUtils.h"
+
+// Every glyph takes the same number of vertices in its batch: the 4 corners
+// of its quad, plus a copy of the first and last corner which join it to the
+// neighbouring quads with degenerate triangles. Because of this a glyph can
+// be rewritten in place without touching any other glyph.
+#define PX_TEXTURE_FONT_RENDERER_VERTICES_PER_GLYPH 6
+
+#define PX_TEXTURE_FONT_RENDERER_NO_BATCH 0xFFFF
+
+typedef struct
+{
+	GLuint glName;
+	PXTextureGlyphBatch *batch;
+} _PXTextureFontRendererBatch;
+
+typedef struct
+{
+	unichar character;
+	unsigned short batchIndex;
+	unsigned slot;
+
+	// The state of the layout after this character, so that it can be
+	// continued from any point.
+	unichar lastCharacter;
+	float x;
+	float right;
+	float bottom;
+} _PXTextureFontRendererGlyph;
+
+@interface PXTextureFontRenderer(Private)
+- (unsigned) _batchIndexForTextureData:(PXTextureData *)textureData;
+@end
+
 @implementation PXTextureFontRenderer
 
 - (id) init
@@ -71,9 +106,28 @@
 	{
 		// Set our font.
 		font = _font;
+		glyphGeneration = 0;
+
+		vBatches = NULL;
+		batchCount = 0;
+		batchCapacity = 0;
+		lastBatchIndex = 0;
+
+		vGlyphs = NULL;
+		glyphCount = 0;
+		glyphCapacity = 0;
+
+		characters = NULL;
+		characterCapacity = 0;
+
+		layoutMultVal = 0.0f;
+		layoutLetterSpacing = 0.0f;
+		layoutKerning = NO;
+
+		appliedShiftX = 0.0f;
+		appliedShiftY = 0.0f;
 
 		enableColors = NO;
-		glNameToTextureGlyphBatch = [[NSMutableDictionary alloc] init];
 	}
 
 	return self;
@@ -81,8 +135,25 @@
 
 - (void) dealloc
 {
-	[glNameToTextureGlyphBatch release];
-	glNameToTextureGlyphBatch = nil;
+	_PXTextureFontRendererBatch *batches = (_PXTextureFontRendererBatch *)(vBatches);
+	unsigned index;
+
+	for (index = 0; index < batchCount; ++index)
+	{
+		[batches[index].batch release];
+	}
+
+	if (vBatches)
+		free(vBatches);
+	vBatches = NULL;
+
+	if (vGlyphs)
+		free(vGlyphs);
+	vGlyphs = NULL;
+
+	if (characters)
+		free(characters);
+	characters = NULL;
 
 	[super dealloc];
 }
@@ -94,28 +165,31 @@
 	if (!_textField)
 		return;
 
-	// Free up past memory used
-	[glNameToTextureGlyphBatch removeAllObjects];
-
-	// If we do not have any characters in our string, then we have nothing to
-	// do.
 	unsigned characterCount = [_textField->_text length];
-	if (characterCount == 0)
-		return;
 
-	unichar characters[characterCount];
-	[_textField->_text getCharacters:characters];
+	if (characterCount > characterCapacity)
+	{
+		unsigned newCapacity = PXMathNextPowerOfTwo(characterCount);
+		unichar *newCharacters = realloc(characters, sizeof(unichar) * newCapacity);
+		_PXTextureFontRendererGlyph *newGlyphs = realloc(vGlyphs, sizeof(_PXTextureFontRendererGlyph) * newCapacity);
 
-	unichar lastCharacter = 0;
-	unichar *character = NULL;
+		if (newCharacters)
+			characters = newCharacters;
+		if (newGlyphs)
+			vGlyphs = newGlyphs;
 
-	PXTextureGlyph *glyph = nil;
-	PXPoint *kern = nil;
+		if (!newCharacters || !newGlyphs)
+			return;
 
-	unsigned index;
-	NSString *glStrName = nil;
-	PXTextureGlyphBatch *textureGlyphBatch;
-	PXTextureData *textureData;
+		characterCapacity = newCapacity;
+		glyphCapacity = newCapacity;
+	}
+
+	if (characterCount > 0)
+		[_textField->_text getCharacters:characters];
+
+	_PXTextureFontRendererGlyph *glyphs = (_PXTextureFontRendererGlyph *)(vGlyphs);
+	_PXTextureFontRendererBatch *batches;
 
 	// The multiplication amount is our size over the font size.  So if we
 	// wanted it bigger, we will see it bigger, just as if we want it smaller,
@@ -124,185 +198,196 @@
 	float pixMult = 1.0f / PXEngineGetContentScaleFactor();
 	multVal *= pixMult;
 
-	{
-	NSMutableString *realString = [[NSMutableString alloc] init];
-
-	for (index = 0, character = characters; index < characterCount; ++index, ++character)
-	{
-		glyph = [font glyphFromCharacter:*character];
-
-		// If no glyph exists for the character, then continue.
-		if (!glyph)
-			continue;
-
-		textureData = glyph.textureData;
-		if (!textureData)
-			continue;
+	float letterSpacing = _textField->_letterSpacing;
+	BOOL allowedToKern = _textField->_kerning;
 
-		glStrName = [NSString stringWithFormat:@"%u", textureData->_glName];
+	// Everything up to the first character that changed can be kept as it is,
+	// as long as nothing else that the layout depends on changed. A label
+	// going from "Score: 99" to "Score: 100" only lays out the last 3
+	// characters.
+	unsigned start = 0;
 
-		textureGlyphBatch = [glNameToTextureGlyphBatch objectForKey:glStrName];
+	if (glyphGeneration == font->_glyphGeneration &&
+		layoutMultVal == multVal &&
+		layoutLetterSpacing == letterSpacing &&
+		layoutKerning == allowedToKern)
+	{
+		unsigned keepCount = MIN(characterCount, glyphCount);
 
-		if (!textureGlyphBatch)
+		while (start < keepCount && glyphs[start].character == characters[start])
 		{
-			textureGlyphBatch = [[PXTextureGlyphBatch alloc] init];
-			textureGlyphBatch->_textureData = textureData;
-			[glNameToTextureGlyphBatch setObject:textureGlyphBatch forKey:glStrName];
-			[textureGlyphBatch release];
+			++start;
 		}
+	}
 
-		++(textureGlyphBatch->_charactersInSet);
+	glyphGeneration = font->_glyphGeneration;
+	layoutMultVal = multVal;
+	layoutLetterSpacing = letterSpacing;
+	layoutKerning = allowedToKern;
 
-		[realString appendString:[NSString stringWithCharacters:character length:1]];
-	}
+	unsigned index;
+	_PXTextureFontRendererGlyph *rendererGlyph;
 
-	characterCount = [realString length];
-	if (characterCount == 0)
+	// Rewind every batch to only the glyphs being kept.
+	batches = (_PXTextureFontRendererBatch *)(vBatches);
+	for (index = 0; index < batchCount; ++index)
 	{
-		[realString release];
-		return;
+		batches[index].batch->_charactersInSet = 0;
 	}
-	[realString getCharacters:characters];
 
-	[realString release];
+	for (index = 0, rendererGlyph = glyphs; index < start; ++index, ++rendererGlyph)
+	{
+		if (rendererGlyph->batchIndex != PX_TEXTURE_FONT_RENDERER_NO_BATCH)
+			batches[rendererGlyph->batchIndex].batch->_charactersInSet = rendererGlyph->slot + 1;
 	}
 
-	// We allocate 6 vertices for each character, minus 2 because the first
-	// character does not need a previous vertex, just as the last character
-	// does not need a next.  If there is only one character, then it needs
-	// neither, thus this is always the correct amount.
-	NSEnumerator *enumerator = nil;
-    id obj = nil;
+	// Continue the layout from where the kept characters left it.
+	unichar lastCharacter = 0;
+	float x = 0.0f;
+	float right = 0.0f;
+	float bottom = 0.0f;
 
-	enumerator = [glNameToTextureGlyphBatch objectEnumerator];
-	unsigned charactersInSet = 0;
-    while (obj = [enumerator nextObject])
+	if (start > 0)
 	{
-		textureGlyphBatch = (PXTextureGlyphBatch *)obj;
+		rendererGlyph = glyphs + (start - 1);
 
-		charactersInSet = textureGlyphBatch->_charactersInSet;
-		// This will also set the vertices
-		textureGlyphBatch.vertexCount = (charactersInSet * 6) - 2;
+		lastCharacter = rendererGlyph->lastCharacter;
+		x = rendererGlyph->x;
+		right = rendererGlyph->right;
+		bottom = rendererGlyph->bottom;
 	}
 
-	float x = 0.0f;
-	float y = 0.0f;
+	PXTextureGlyph *glyph;
+	PXPoint *kern;
+	PXTextureData *textureData;
+	PXTextureGlyphBatch *textureGlyphBatch;
+	PXGLColoredTextureVertex *vertex;
+
+	unsigned batchIndex;
+	unsigned slot;
+	unsigned neededVertexCount;
+	unichar character;
 
 	PXMathRange rangeX;
 	PXMathRange rangeY;
 	PXMathRange rangeS;
 	PXMathRange rangeT;
 
-	float xBorder = 1.0f;
-	float yBorder = 2.0f;
+	for (index = start, rendererGlyph = glyphs + start; index < characterCount; ++index, ++rendererGlyph)
+	{
+		character = characters[index];
 
-	NSString *curGLStrName = nil;
+		rendererGlyph->character = character;
+		rendererGlyph->batchIndex = PX_TEXTURE_FONT_RENDERER_NO_BATCH;
+		rendererGlyph->slot = 0;
 
-	float letterSpacing = _textField->_letterSpacing;
-	float maxHeight = 0;
+		glyph = [font glyphFromCharacter:character];
+		textureData = glyph.textureData;
 
-	BOOL isFirst = NO;
-	BOOL isLast = NO;
-	BOOL allowedToKern = _textField->_kerning;
+		// If no glyph exists for the character, then it takes no space.
+		if (glyph && textureData)
+		{
+			if (allowedToKern)
+			{
+				kern = [font kerningPointFromFirstCharacter:lastCharacter secondCharacter:character];
 
-	lastCharacter = 0;
-	textureGlyphBatch = nil;
+				if (kern)
+				{
+					x += (kern.x * multVal);
+				}
+			}
 
-	// For each character we need to make a texture box for it.
-	for (index = 0, character = characters; index < characterCount; ++index, ++character)
-	{
-		glyph = [font glyphFromCharacter:*character];
+			if ((int)(glyph->_bounds.size.width)  != 0 &&
+				(int)(glyph->_bounds.size.height) != 0)
+			{
+				batchIndex = [self _batchIndexForTextureData:textureData];
 
-		if (allowedToKern)
-		{
-			kern = [font kerningPointFromFirstCharacter:lastCharacter secondCharacter:*character];
+				if (batchIndex != PX_TEXTURE_FONT_RENDERER_NO_BATCH)
+				{
+					// Looking up the batch may have grown the list.
+					batches = (_PXTextureFontRendererBatch *)(vBatches);
+					textureGlyphBatch = batches[batchIndex].batch;
 
-			if (kern)
-			{
-				x += (kern.x * multVal);
-			}
-		}
+					slot = textureGlyphBatch->_charactersInSet;
+					neededVertexCount = (slot + 1) * PX_TEXTURE_FONT_RENDERER_VERTICES_PER_GLYPH;
 
-		if ((int)(glyph->_bounds.size.width)  != 0 &&
-			(int)(glyph->_bounds.size.height) != 0)
-		{
-			textureData = glyph.textureData;
-			if (!textureData)
-				continue;
+					if (neededVertexCount > textureGlyphBatch->_vertexCount)
+					{
+						textureGlyphBatch.vertexCount = PXMathNextPowerOfTwo(slot + 1) * PX_TEXTURE_FONT_RENDERER_VERTICES_PER_GLYPH;
+					}
 
-			glStrName = [NSString stringWithFormat:@"%u", textureData->_glName];
+					rangeX.min = x + (glyph->_bounds.origin.x * multVal);
+					rangeY.min = (glyph->_bounds.origin.y * multVal);
 
-			if (![glStrName isEqualToString:curGLStrName])
-			{
-				textureGlyphBatch = [glNameToTextureGlyphBatch objectForKey:glStrName];
-				curGLStrName = glStrName;
+					rangeX.max = rangeX.min + (glyph->_bounds.size.width  * multVal);
+					rangeY.max = rangeY.min + (glyph->_bounds.size.height * multVal);
+
+					rangeS.min = glyph->_textureBounds.origin.x;
+					rangeT.min = glyph->_textureBounds.origin.y;
+
+					rangeS.max = rangeS.min + glyph->_textureBounds.size.width;
+					rangeT.max = rangeT.min + glyph->_textureBounds.size.height;
+
+					right = rangeX.max;
+					if (bottom < rangeY.max)
+						bottom = rangeY.max;
+
+					// The vertices are stored already aligned.
+					rangeX.min += appliedShiftX;
+					rangeX.max += appliedShiftX;
+					rangeY.min += appliedShiftY;
+					rangeY.max += appliedShiftY;
+
+					vertex = textureGlyphBatch->_vertices + (slot * PX_TEXTURE_FONT_RENDERER_VERTICES_PER_GLYPH);
+					PXTextureGlyphBatchConcatBox(&vertex, rangeX, rangeY, rangeS, rangeT, NO, NO);
+
+					++(textureGlyphBatch->_charactersInSet);
+
+					rendererGlyph->batchIndex = batchIndex;
+					rendererGlyph->slot = slot;
+				}
 			}
 
-			if (!textureGlyphBatch)
-				continue;
-
-//			if (index == 0)
-//			{
-//				// OLD WAY
-//				//rangeX.min = xBorder;
-//
-//				// FIXING
-//				float firstOffset = glyph->_bounds.origin.x * multVal;
-//
-//				if (firstOffset < 0.0f)
-//				{
-//					firstOffset = 0.0f;
-//					x += firstOffset;
-//				}
-//
-//				rangeX.min = xBorder + firstOffset;
-//			}
-//			else
-				rangeX.min = x + (glyph->_bounds.origin.x * multVal);
-
-			rangeY.min = y + (glyph->_bounds.origin.y * multVal);
-
-			rangeX.max = rangeX.min + (glyph->_bounds.size.width  * multVal);
-			rangeY.max = rangeY.min + (glyph->_bounds.size.height * multVal);
-
-			rangeS.min = glyph->_textureBounds.origin.x;
-			rangeT.min = glyph->_textureBounds.origin.y;
-
-			rangeS.max = rangeS.min + glyph->_textureBounds.size.width;
-			rangeT.max = rangeT.min + glyph->_textureBounds.size.height;
-
-			if (maxHeight < rangeY.max)
-				maxHeight = rangeY.max;
-
-			isFirst = (textureGlyphBatch->_usedCharactersInSet == 0);
-			isLast = (textureGlyphBatch->_usedCharactersInSet == textureGlyphBatch->_charactersInSet - 1);
-
-			textureGlyphBatch->_usedVertexCount += PXTextureGlyphBatchConcatBox(&(textureGlyphBatch->_currentVertex),
-																					rangeX,
-																					rangeY,
-																					rangeS,
-																					rangeT,
-																					isFirst,
-																					isLast);
-			++(textureGlyphBatch->_usedCharactersInSet);
-		}
+			// Move the x position.
+			x += (glyph->_advance.x * multVal) + letterSpacing;
 
-		// Move the x position.
-		x += (glyph->_advance.x * multVal) + letterSpacing;
+			lastCharacter = character;
+		}
 
-		lastCharacter = *character;
+		rendererGlyph->lastCharacter = lastCharacter;
+		rendererGlyph->x = x;
+		rendererGlyph->right = right;
+		rendererGlyph->bottom = bottom;
 	}
 
-	enumerator = [glNameToTextureGlyphBatch objectEnumerator];
-	while (obj = [enumerator nextObject])
+	glyphCount = characterCount;
+
+	// The first glyph doesn't need its leading copy, nor the last glyph its
+	// trailing one.
+	batches = (_PXTextureFontRendererBatch *)(vBatches);
+	for (index = 0; index < batchCount; ++index)
 	{
-		textureGlyphBatch = (PXTextureGlyphBatch *)obj;
+		textureGlyphBatch = batches[index].batch;
 
-		textureGlyphBatch.vertexCount = textureGlyphBatch->_usedVertexCount;
+		if (textureGlyphBatch->_charactersInSet == 0)
+			textureGlyphBatch->_usedVertexCount = 0;
+		else
+			textureGlyphBatch->_usedVertexCount = (textureGlyphBatch->_charactersInSet * PX_TEXTURE_FONT_RENDERER_VERTICES_PER_GLYPH) - 2;
 	}
 
-	_bounds.size.width  = roundf(rangeX.max + xBorder);
-	_bounds.size.height = roundf(maxHeight + yBorder);
+	float xBorder = 1.0f;
+	float yBorder = 2.0f;
+
+	if (right == 0.0f && bottom == 0.0f)
+	{
+		_bounds.size.width  = 0.0f;
+		_bounds.size.height = 0.0f;
+	}
+	else
+	{
+		_bounds.size.width  = roundf(right + xBorder);
+		_bounds.size.height = roundf(bottom + yBorder);
+	}
 
 	[super _validate];
 }
@@ -320,29 +405,40 @@
 {
 	[super _updateAlignment];
 
-	// We need to update the vertices to correspond with the new bounds.
-	unsigned index;
-	PXGLColoredTextureVertex *vertex;
+	// Move the vertices by however much the alignment changed since they were
+	// last moved.
+	float deltaX = _bounds.origin.x - appliedShiftX;
+	float deltaY = _bounds.origin.y - appliedShiftY;
 
-	NSEnumerator *enumerator = [glNameToTextureGlyphBatch objectEnumerator];
-    id obj;
+	appliedShiftX = _bounds.origin.x;
+	appliedShiftY = _bounds.origin.y;
+
+	if (deltaX == 0.0f && deltaY == 0.0f)
+		return;
+
+	_PXTextureFontRendererBatch *batches = (_PXTextureFontRendererBatch *)(vBatches);
 	PXTextureGlyphBatch *textureGlyphBatch;
+	PXGLColoredTextureVertex *vertex;
 
-    while (obj = [enumerator nextObject])
+	unsigned index;
+	unsigned vertexIndex;
+	unsigned vertexCount;
+
+	for (index = 0; index < batchCount; ++index)
 	{
-		textureGlyphBatch = (PXTextureGlyphBatch *)obj;
+		textureGlyphBatch = batches[index].batch;
 
-		if (!textureGlyphBatch)
-			continue;
-		if (!textureGlyphBatch->_vertices || textureGlyphBatch->_vertexCount == 0)
+		if (!textureGlyphBatch->_vertices)
 			continue;
 
-		for (index = 0, vertex = textureGlyphBatch->_vertices;
-			 index < textureGlyphBatch->_vertexCount;
-			 ++index, ++vertex)
+		vertexCount = textureGlyphBatch->_charactersInSet * PX_TEXTURE_FONT_RENDERER_VERTICES_PER_GLYPH;
+
+		for (vertexIndex = 0, vertex = textureGlyphBatch->_vertices;
+			 vertexIndex < vertexCount;
+			 ++vertexIndex, ++vertex)
 		{
-			vertex->x += shiftX;
-			vertex->y += shiftY;
+			vertex->x += deltaX;
+			vertex->y += deltaY;
 		}
 	}
 }
@@ -354,6 +450,13 @@
 		return;
 	}
 
+	// The font removed glyphs since we were laid out, so the texture
+	// coordinates we hold may point at another glyph.
+	if (glyphGeneration != font->_glyphGeneration)
+	{
+		[self _validate];
+	}
+
 	// Enable the texture, and draw the vertices with the correct color.
 //	PXGLShadeModel(GL_SMOOTH);
 	PXGLEnable(GL_TEXTURE_2D);
@@ -369,21 +472,30 @@
 		PXGLDisableClientState(GL_COLOR_ARRAY);
 	}
 
-	NSEnumerator *enumerator = [glNameToTextureGlyphBatch objectEnumerator];
-    id obj;
+	_PXTextureFontRendererBatch *batches = (_PXTextureFontRendererBatch *)(vBatches);
 	PXTextureGlyphBatch *textureGlyphBatch;
-
 	PXTextureData *textureData = nil;
+	PXGLColoredTextureVertex *vertices;
 
-    while (obj = [enumerator nextObject])
+	unsigned index;
+
+	// Distance fields are drawn by keeping only what is inside the edge, which
+	// lies at half alpha. They must be sampled linearly for the edge to be
+	// found in between texels.
+	GLuint batchSmoothingType = smoothingType;
+
+	if (font->_isDistanceField)
 	{
-		textureGlyphBatch = (PXTextureGlyphBatch *)obj;
+		PXGLEnable(GL_ALPHA_TEST);
+		batchSmoothingType = GL_LINEAR;
+	}
 
-		if (!textureGlyphBatch)
-			continue;
+	for (index = 0; index < batchCount; ++index)
+	{
+		textureGlyphBatch = batches[index].batch;
 
 		if (textureGlyphBatch->_vertices == NULL ||
-			textureGlyphBatch->_vertexCount == 0 ||
+			textureGlyphBatch->_usedVertexCount == 0 ||
 			textureGlyphBatch->_textureData == nil)
 		{
 			continue;
@@ -391,26 +503,87 @@
 
 		textureData = textureGlyphBatch->_textureData;
 
+		PXTextureMemoryUse(textureData);
 		PXGLBindTexture(GL_TEXTURE_2D, textureData->_glName);
 
 		// Smoothing?
-		if (smoothingType != textureData->_smoothingType)
+		if (batchSmoothingType != textureData->_smoothingType)
 		{
-			PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, smoothingType);
-			PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, smoothingType);
-			textureData->_smoothingType = smoothingType;
+			PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, batchSmoothingType);
+			PXGLTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, batchSmoothingType);
+			textureData->_smoothingType = batchSmoothingType;
 		}
 
-		PXGLVertexPointer(2, GL_FLOAT, sizeof(PXGLColoredTextureVertex), &(textureGlyphBatch->_vertices->x));
-		PXGLTexCoordPointer(2, GL_FLOAT, sizeof(PXGLColoredTextureVertex), &(textureGlyphBatch->_vertices->s));
+		// Skip the leading copy of the first glyph.
+		vertices = textureGlyphBatch->_vertices + 1;
+
+		PXGLVertexPointer(2, GL_FLOAT, sizeof(PXGLColoredTextureVertex), &(vertices->x));
+		PXGLTexCoordPointer(2, GL_FLOAT, sizeof(PXGLColoredTextureVertex), &(vertices->s));
 
 		if (enableColors)
 		{
-			PXGLColorPointer(2, GL_UNSIGNED_BYTE, sizeof(PXGLColoredTextureVertex), &(textureGlyphBatch->_vertices->r));
+			PXGLColorPointer(2, GL_UNSIGNED_BYTE, sizeof(PXGLColoredTextureVertex), &(vertices->r));
 		}
 
-		PXGLDrawArrays(GL_TRIANGLE_STRIP, 0, textureGlyphBatch->_vertexCount);
+		PXGLDrawArrays(GL_TRIANGLE_STRIP, 0, textureGlyphBatch->_usedVertexCount);
 	}
 }
 
 @end
+
+@implementation PXTextureFontRenderer(Private)
+
+- (unsigned) _batchIndexForTextureData:(PXTextureData *)textureData
+{
+	GLuint glName = textureData->_glName;
+	_PXTextureFontRendererBatch *batches = (_PXTextureFontRendererBatch *)(vBatches);
+
+	// Text is usually all on one texture, so the last one used is checked
+	// first.
+	if (lastBatchIndex < batchCount && batches[lastBatchIndex].glName == glName)
+	{
+		batches[lastBatchIndex].batch->_textureData = textureData;
+		return lastBatchIndex;
+	}
+
+	unsigned index;
+	for (index = 0; index < batchCount; ++index)
+	{
+		if (batches[index].glName == glName)
+		{
+			batches[index].batch->_textureData = textureData;
+			lastBatchIndex = index;
+
+			return index;
+		}
+	}
+
+	if (batchCount >= PX_TEXTURE_FONT_RENDERER_NO_BATCH)
+		return PX_TEXTURE_FONT_RENDERER_NO_BATCH;
+
+	if (batchCount == batchCapacity)
+	{
+		unsigned newCapacity = batchCapacity ? (batchCapacity << 1) : 2;
+		_PXTextureFontRendererBatch *newBatches = realloc(vBatches, sizeof(_PXTextureFontRendererBatch) * newCapacity);
+
+		if (!newBatches)
+			return PX_TEXTURE_FONT_RENDERER_NO_BATCH;
+
+		vBatches = newBatches;
+		batchCapacity = newCapacity;
+		batches = newBatches;
+	}
+
+	PXTextureGlyphBatch *textureGlyphBatch = [[PXTextureGlyphBatch alloc] init];
+	textureGlyphBatch->_textureData = textureData;
+
+	batches[batchCount].glName = glName;
+	batches[batchCount].batch = textureGlyphBatch;
+
+	lastBatchIndex = batchCount;
+	++batchCount;
+
+	return lastBatchIndex;
+}
+
+@end
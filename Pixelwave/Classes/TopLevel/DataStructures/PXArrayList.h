@@ -0,0 +1,188 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXPooledObject.h"
+
+#include "PXSettings.h"
+#include "PXHeaderUtils.h"
+
+/*@
+ * Used to efficiently traverse the items in an array list.
+ *
+ *	PXArrayList *list = ...
+ *	
+ *	// It's essential that this variable be declared before the loop
+ *	NSObject *item = nil;
+ *
+ *	PXArrayListForEach(list, item)
+ *	{
+ *		NSLog("Item = %@", item);
+ *	}
+ *
+ * The list may be changed inside of the loop. Each step looks the item up
+ * again, so the loop never reads past the end, but removing an item before
+ * the current one makes the loop skip an item.
+ */
+#define PXArrayListForEach(_list_,_obj_) \
+		for (	unsigned PX_UNIQUE_VAR(_i_) = 0; \
+				((_list_) && PX_UNIQUE_VAR(_i_) < (_list_)->_count) ? (((_obj_) = (_list_)->_items[PX_UNIQUE_VAR(_i_)]), YES) : NO; \
+				++PX_UNIQUE_VAR(_i_))
+
+/*@
+ * Used to efficiently traverse the items in an array list from the end to the
+ * start.
+ *
+ *	PXArrayList *list = ...
+ *	
+ *	// It's essential that this variable be declared before the loop
+ *	NSObject *item = nil;
+ *
+ *	PXArrayListForEachReverse(list, item)
+ *	{
+ *		NSLog("Item = %@", item);
+ *	}
+ *
+ * Removing the current item inside of the loop is safe, and doesn't cause any
+ * other item to be skipped.
+ */
+#define PXArrayListForEachReverse(_list_,_obj_) \
+		for (	int PX_UNIQUE_VAR(_i_) = (_list_) ? (int)((_list_)->_count) - 1 : -1; \
+				((_list_) && (PX_UNIQUE_VAR(_i_) = MIN(PX_UNIQUE_VAR(_i_), (int)((_list_)->_count) - 1)) >= 0) ? (((_obj_) = (_list_)->_items[PX_UNIQUE_VAR(_i_)]), YES) : NO; \
+				--PX_UNIQUE_VAR(_i_))
+
+@interface PXArrayList : NSObject<NSFastEnumeration, NSCopying, NSCoding, PXPooledObject>
+{
+@public
+	id *_items;
+
+	unsigned _count;
+	unsigned _capacity;
+
+	BOOL _keepStrongReference;
+}
+
+/**
+ * The number of items in the list.
+ */
+@property (nonatomic, readonly) unsigned count;
+/**
+ * The first object in the list.
+ *
+ * _**Complexity:** O(1)_
+ */
+@property (nonatomic, readonly) id firstObject;
+/**
+ * The last object in the list.
+ *
+ * _**Complexity:** O(1)_
+ */
+@property (nonatomic, readonly) id lastObject;
+/**
+ * `YES` if the list does not retain its elements; otherwise
+ * `NO`.  Default value is `NO`, as it is advised to keep
+ * a retain on the added elements.
+ * 
+ * @see [PXArrayList initWithWeakReferences:]
+ */
+@property (nonatomic, readonly) BOOL weakReferences;
+
+//-- ScriptName: ArrayList
+//-- ScriptArg[0]: NO
+- (id) initWithWeakReferences:(BOOL)weakReferences;
+//-- ScriptIgnore
+- (id) initWithWeakReferences:(BOOL)weakReferences capacity:(unsigned)capacity;
+
+// Adding, +1 retain
+//-- ScriptName: push
+- (void) addObject:(id)object;
+//-- ScriptName: pushAt
+- (void) insertObject:(id)object atIndex:(int)index;
+//-- ScriptName: pushAllFrom
+- (void) addObjectsFromList:(id<NSFastEnumeration>)otherList;
+//-- ScriptName: setIndex
+- (void) setIndex:(int)index ofObject:(id)object;
+
+// Removing, -1 retain
+//-- ScriptName: pop
+- (void) removeObject:(id)object;
+//-- ScriptName: popAt
+- (void) removeObjectAtIndex:(int)index;
+//-- ScriptName: popLast
+- (void) removeLastObject;
+//-- ScriptName: popFirst
+- (void) removeFirstObject;
+//-- ScriptName: popAll
+- (void) removeAllObjects;
+//-- ScriptName: popAllFrom
+- (void) removeObjectsInList:(id<NSFastEnumeration>)otherList;
+
+// Swapping
+//-- ScriptName: swap
+- (void) swapObject:(id)object1 withObject:(id)object2;
+//-- ScriptName: swapAt
+- (void) swapObjectAtIndex:(int)index1 withObjectAtIndex:(int)index2;
+
+// Querying
+//-- ScriptName: objectAt
+- (id) objectAtIndex:(int)index;
+//-- ScriptName: contains
+- (BOOL) containsObject:(id)object;
+//-- ScriptName: indexOf
+- (int) indexOfObject:(id)object;
+
+///////////////
+// Exporting //
+///////////////
+
+//-- ScriptIgnore
+- (id *)cArray;
+//-- ScriptName: clone
+- (id) copy;
+
+/////////////
+// Statics //
+/////////////
+
+//-- ScriptIgnore
++ (PXArrayList *)arrayList;
+//-- ScriptName: make
+//-- ScriptArg[0]: NO
++ (PXArrayList *)arrayListWithWeakReferences:(BOOL)weakReferences;
+
+@end
@@ -0,0 +1,853 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXArrayList.h"
+#import "PXSettings.h"
+
+#import "PXExceptionUtils.h"
+
+#import "PXDebugUtils.h"
+
+#include "PXPrivateUtils.h"
+#import "PXDebug.h"
+
+// The smallest amount of room made when the list first grows
+#define PX_ARRAY_LIST_MIN_CAPACITY 4
+
+@interface PXArrayList(Private)
+- (void) growToCapacity:(unsigned)capacity;
+- (void) removeItemAtIndex:(unsigned)index;
+@end
+
+/**
+ * A collection data structure which can hold any number of `NSObject`
+ * instances, kept next to each other in a single block of memory. Like all
+ * collection classes, the PXArrayList class increases an object's retain count
+ * when it is added, and decreases the object's retain count when it is
+ * removed. This behavior can be disabled, however it is not recommended.
+ *
+ * The PXArrayList class has the same interface as PXLinkedList, and can be
+ * used in its place. Which one to pick depends on how the list is used:
+ *
+ * - Looping through a PXArrayList is faster, since the items sit next to each
+ * other in memory instead of being spread out over separate nodes.
+ * - Getting an object at an index is O(1) rather than O(n).
+ * - Adding and removing at the end of the list are O(1) for both, but adding
+ * and removing anywhere else move every item after it, which is O(n) for a
+ * PXArrayList and O(1) for a PXLinkedList once the node is found.
+ *
+ * Lists which are looped over every frame and rarely changed in the middle,
+ * such as the children of a display object container, should use a
+ * PXArrayList.
+ *
+ * <br/>
+ * *Iterating through an array list*
+ *
+ * Just like the linked list, the array list can be looped through with fast
+ * enumeration:
+ *
+ *	PXArrayList *list = ...
+ *	
+ *	for (NSObject *item in list)
+ *	{
+ *		NSLog("Item = %@", item);
+ *	}
+ *
+ * Or, when it must be as fast as possible, with the `PXArrayListForEach` and
+ * `PXArrayListForEachReverse` macros:
+ *
+ *	PXArrayList *list = ...
+ *	
+ *	// It's essential that this variable be declared before the loop
+ *	NSObject *item = nil;
+ *
+ *	PXArrayListForEach(list, item)
+ *	{
+ *		NSLog("Item = %@", item);
+ *	}
+ *
+ * Both ways allow the list to be changed while it is being looped through.
+ * Fast enumeration walks a snapshot taken when the loop starts, so it visits
+ * exactly the items the list held at that point. The macros continue from
+ * the same position, so items inserted or removed before that position shift
+ * which item comes next. Loop in reverse when removing items as you go.
+ */
+@implementation PXArrayList
+
+@synthesize count = _count;
+
+- (id) init
+{
+	return [self initWithWeakReferences:NO capacity:0];
+}
+
+/**
+ * Creates a new array list which only retains added objects if
+ * #weakReferences is set to NO.
+ *
+ * @param weakReferences `YES` if the list should not retain added elements;
+ * `NO` if it should. Setting this to `YES` is only
+ * useful in very rare circumstances and should be used with caution. The
+ * default value is `NO`.
+ *
+ * **Example:**
+ *	PXArrayList *list = [[PXArrayList alloc] initWithWeakReferences:NO];
+ *	// list keeps a retain on added objects.
+ */
+- (id) initWithWeakReferences:(BOOL)weakReferences
+{
+	return [self initWithWeakReferences:weakReferences capacity:0];
+}
+
+/**
+ * Creates a new array list with room for `capacity` objects, which only
+ * retains added objects if #weakReferences is set to NO.
+ *
+ * @param weakReferences `YES` if the list should not retain added elements;
+ * `NO` if it should.
+ * @param capacity How many objects the list can hold before it has to grow.
+ */
+- (id) initWithWeakReferences:(BOOL)weakReferences capacity:(unsigned)capacity
+{
+	self = [super init];
+
+	if (self)
+	{
+		_items = NULL;
+		_count = 0;
+		_capacity = 0;
+
+		_keepStrongReference = !weakReferences;
+
+		if (capacity > 0)
+		{
+			[self growToCapacity:capacity];
+		}
+	}
+
+	return self;
+}
+
+- (void) dealloc
+{
+	[self removeAllObjects];
+
+	if (_items)
+	{
+		free(_items);
+		_items = NULL;
+	}
+
+	[super dealloc];
+}
+
+//////////////
+// NSCoding //
+//////////////
+
+- (id) initWithCoder:(NSCoder *)aDecoder
+{
+	self = [self initWithWeakReferences:![aDecoder decodeBoolForKey:@"keepStrongReference"]];
+
+	if (self)
+	{
+		id object = nil;
+		NSString *str = nil;
+		unsigned i = 0;
+
+		do
+		{
+			if (object)
+			{
+				[self addObject:object];
+			}
+
+			str = [[NSString alloc] initWithFormat:@"PX.object.%u", i];
+			object = [aDecoder decodeObjectForKey:str];
+			[str release];
+			++i;
+		}
+		while (object != nil);
+	}
+
+	return self;
+}
+
+- (void) encodeWithCoder:(NSCoder *)aCoder
+{
+	[aCoder encodeBool:_keepStrongReference forKey:@"keepStrongReference"];
+
+	NSString *str = nil;
+	unsigned index;
+
+	for (index = 0; index < _count; ++index)
+	{
+		str = [[NSString alloc] initWithFormat:@"PX.object.%u", index];
+		[aCoder encodeObject:_items[index] forKey:str];
+		[str release];
+	}
+}
+
+- (void) reset
+{
+	[self removeAllObjects];
+
+	_keepStrongReference = YES;
+}
+
+- (NSString *)description
+{
+	NSMutableString *str = [[NSMutableString alloc] initWithString:@""];
+
+	[str appendString:@"(PXArrayList: [ "];
+
+	unsigned index;
+	for (index = 0; index < _count; ++index)
+	{
+		if (index != 0)
+			[str appendString:@", "];
+
+		[str appendString:[_items[index] description]];
+	}
+
+	[str appendString:@" ]"];
+
+	return [str autorelease];
+}
+
+// MARK: Querying
+
+/**
+ * Returns the object at the specified position in the list.  If the
+ * index is out of bounds, a PXArgumentException is thrown.
+ *
+ * _**Complexity:** O(1)_
+ *
+ * @param index The index from which to look up the return object. Must be a value
+ * between `0` and #count `- 1`
+ *
+ * @return The object at the specified index.
+ */
+- (id) objectAtIndex:(int)index
+{
+	if (index < 0 || index >= _count)
+	{
+		PXThrowIndexOutOfBounds;
+		return nil;
+	}
+
+	return _items[index];
+}
+
+/**
+ * Determines if an object is contained in the list.
+ *
+ * _**Complexity:** O(n)_
+ *
+ * @param object The object for which to check existence in the list.
+ *
+ * @return `YES` If the object exists in the list; otherwise
+ * `NO`.
+ */
+- (BOOL) containsObject:(id)object
+{
+	if (!object)
+	{
+		PXThrowNilParam(object);
+		return NO;
+	}
+
+	return [self indexOfObject:object] >= 0;
+}
+
+/**
+ * Finds the position in the list of the specified object.
+ *
+ * _**Complexity:** O(n)_
+ *
+ * @param object The object for which to check existence in the list.
+ *
+ * @return If the object is contained in the list, its index; otherwise
+ * `-1`.
+ */
+- (int) indexOfObject:(id)object
+{
+	if (!object)
+	{
+		PXThrowNilParam(object);
+		return -1;
+	}
+
+	id *item = _items;
+	id *end = _items + _count;
+
+	for (; item < end; ++item)
+	{
+		if (*item == object)
+			return item - _items;
+	}
+
+	return -1;
+}
+
+- (id) firstObject
+{
+	if (_count == 0)
+		return nil;
+
+	return _items[0];
+}
+
+- (id) lastObject
+{
+	if (_count == 0)
+		return nil;
+
+	return _items[_count - 1];
+}
+
+- (BOOL) weakReferences
+{
+	return !_keepStrongReference;
+}
+
+// MARK: Adding
+
+/**
+ * Adds the specified object to the end of list.  If
+ * #weakReferences is set to `NO` (default), the
+ * object's retain count is incremented; otherwise the object's retain count
+ * stays the same.
+ *
+ * _**Complexity:** O(1) on average_
+ *
+ * @param object The object to add to the end of the list.
+ */
+- (void) addObject:(id)object
+{
+	if (!object)
+	{
+		PXThrowNilParam(object);
+		return;
+	}
+
+	if (object == self)
+	{
+		PXThrow(PXArgumentException, @"A list cannot add itself to itself... silly.");
+		return;
+	}
+
+	if (_count == _capacity)
+	{
+		[self growToCapacity:_capacity + 1];
+	}
+
+	if (_keepStrongReference)
+	{
+		[object retain];
+	}
+
+	_items[_count] = object;
+	++_count;
+}
+
+/**
+ * Adds the specified object to the list at the specified index.
+ * If #weakReferences is set to `NO` (default), the
+ * object's retain count is incremented; otherwise the object's retain count
+ * stays the same.
+ *
+ * If an object already exists at the specified index, all of the objects whose
+ * indices are greater then the specified, are shifted up by one position.
+ *
+ * _**Complexity:** O(n)_
+ *
+ * @param object The object to add. Must be a descendant of the `NSObject`
+ * class.
+ * @param index The index to add the object to. Must be a value between 0 and
+ * count.
+ */
+- (void) insertObject:(id)object atIndex:(int)index
+{
+	if (!object)
+	{
+		PXThrowNilParam(object);
+		return;
+	}
+
+	if (index < 0 || index > _count)
+	{
+		PXThrowIndexOutOfBounds;
+		return;
+	}
+
+	if (object == self)
+	{
+		PXThrow(PXArgumentException, @"A list cannot add itself to itself... silly.");
+		return;
+	}
+
+	if (_count == _capacity)
+	{
+		[self growToCapacity:_capacity + 1];
+	}
+
+	if (_keepStrongReference)
+	{
+		[object retain];
+	}
+
+	id *item = _items + index;
+	memmove(item + 1, item, sizeof(id) * (_count - index));
+
+	*item = object;
+	++_count;
+}
+
+/**
+ * Adds all of the objects from the provided list to this list.
+ * If #weakReferences is set to `NO` (default), the
+ * objects' retain counts are incremented; otherwise the object's retain count
+ * stays the same.
+ *
+ * _**Complexity:** O(n)_
+ *
+ * @param otherList Any list which supports fast enumeration, such as a
+ * PXArrayList, PXLinkedList or NSArray.
+ */
+- (void) addObjectsFromList:(id<NSFastEnumeration>)otherList
+{
+	if (otherList == self)
+		return;
+
+	id obj;
+
+	for (obj in otherList)
+	{
+		[self addObject:obj];
+	}
+}
+
+/**
+ * Sets the index of the object in the list, to the index provided. This shifts
+ * the objects in between over by one position. If the object isn't contained
+ * in the list the call is simply ignored.
+ *
+ * _**Complexity:** O(n)_
+ *
+ * @param index The new index of the object.
+ * @param object The object to move.
+ */
+- (void) setIndex:(int)index ofObject:(id)object
+{
+	if (!object)
+		return;
+
+	int oldIndex = [self indexOfObject:object];
+
+	if (oldIndex < 0)
+		return;
+
+	if (index < 0 || index >= _count)
+	{
+		PXThrowIndexOutOfBounds;
+		return;
+	}
+
+	if (index == oldIndex)
+		return;
+
+	// Slide everything in between over by one, rather than removing and
+	// inserting the object.
+	if (index < oldIndex)
+	{
+		memmove(_items + index + 1, _items + index, sizeof(id) * (oldIndex - index));
+	}
+	else
+	{
+		memmove(_items + oldIndex, _items + oldIndex + 1, sizeof(id) * (index - oldIndex));
+	}
+
+	_items[index] = object;
+}
+
+// MARK: Removing
+
+/**
+ * Removes the specified object from the list.
+ * If the object isn't contained in the list the call is simply ignored,
+ * otherwise all of the objects after the index of the specified object are
+ * shifted down by one to fill the gap.
+ *
+ * If #weakReferences is set to `NO` (default), the
+ * object's retain count is decremented; otherwise the object's retain count
+ * stays the same.
+ *
+ * _**Complexity:** O(n)_
+ *
+ * @param object The object to remove from the list.
+ */
+- (void) removeObject:(id)object
+{
+	if (!object)
+	{
+		PXThrowNilParam(object);
+		return;
+	}
+
+	int index = [self indexOfObject:object];
+
+	if (index < 0)
+		return;
+
+	[self removeItemAtIndex:index];
+}
+
+/**
+ * Removes the object at the specified index from the list. All of the objects
+ * following the object at `index` are shifted down by one.
+ *
+ * If #weakReferences is set to `NO` (default), the
+ * object's retain count is decremented; otherwise the object's retain count
+ * stays the same.
+ * 
+ * _**Complexity:** O(n)_
+ * 
+ * @param index The index from which to remove the object. `index` must be
+ * be a value between 0 and #count - 1
+ */
+- (void) removeObjectAtIndex:(int)index
+{
+	if (index < 0 || index >= _count)
+	{
+		PXThrowIndexOutOfBounds;
+		return;
+	}
+
+	[self removeItemAtIndex:index];
+}
+
+/**
+ * Removes the last object in the list (object at index
+ * #count `- 1`).  If the list is empty the call is ignored.
+ *
+ * _**Complexity:** O(1)_
+ */
+- (void) removeLastObject
+{
+	if (_count > 0)
+	{
+		[self removeItemAtIndex:_count - 1];
+	}
+}
+
+/**
+ * Removes the first object in the list (object at index `0`).  If
+ * the list is empty the call is ignored.
+ *
+ * _**Complexity:** O(n)_
+ */
+- (void) removeFirstObject
+{
+	if (_count > 0)
+	{
+		[self removeItemAtIndex:0];
+	}
+}
+
+/**
+ * Removes all of the objects in the list. The memory used to hold them is kept
+ * for when the list is filled up again.
+ * 
+ * If #weakReferences is set to `NO` (default), the
+ * objects' retain counts are decremented; otherwise the object's retain count
+ * stays the same.
+ *
+ * _**Complexity:** O(n)_
+ */
+- (void) removeAllObjects
+{
+	// Remove from the end, so that a release which changes the list doesn't
+	// leave holes behind.
+	while (_count > 0)
+	{
+		[self removeItemAtIndex:_count - 1];
+	}
+}
+
+/**
+ * Removes all of the objects in the list that are also in the provided list.
+ * 
+ * If #weakReferences is set to `NO` (default), the
+ * objects' retain counts are decremented; otherwise the object's retain count
+ * stays the same.
+ *
+ * _**Complexity:** O(n * m)_
+ *
+ * @param otherList Any list which supports fast enumeration, such as a
+ * PXArrayList, PXLinkedList or NSArray.
+ */
+- (void) removeObjectsInList:(id<NSFastEnumeration>)otherList
+{
+	if (otherList == self)
+	{
+		[self removeAllObjects];
+		return;
+	}
+
+	id object;
+
+	for (object in otherList)
+	{
+		[self removeObject:object];
+	}
+}
+
+// MARK: Swapping
+
+/**
+ * Swaps the location of two objects in the list.  If either of the parameters
+ * aren't contained in the list, a PXArgumentException is thrown.
+ * 
+ * @param object1 The object to swap with `object2`
+ * @param object2 The object to swap with `object1`
+ */
+- (void) swapObject:(id)object1 withObject:(id)object2
+{
+	if (object1 == object2)
+		return;
+
+	int index1 = [self indexOfObject:object1];
+	int index2 = [self indexOfObject:object2];
+
+	if (index1 < 0 || index2 < 0)
+	{
+		PXThrow(PXArgumentException, @"Parameter object must be contained in list");
+		return;
+	}
+
+	_items[index1] = object2;
+	_items[index2] = object1;
+}
+
+/**
+ * Swaps the location of two objects specified their indices in the list.  If
+ * either of the indices are out of bounds, a PXArgumentException is thrown.
+ * 
+ * @param index1 The index of the object to swap with the object at `index2`.
+ * Must be a value between `0` and #count `- 1`.
+ * @param index2 The index of the object to swap with the object at `index1`.
+ * Must be a value between `0` and #count `- 1`.
+ */
+- (void) swapObjectAtIndex:(int)index1 withObjectAtIndex:(int)index2
+{
+	if (index1 == index2)
+		return;
+
+	if (index1 < 0 || index1 >= _count || index2 < 0 || index2 >= _count)
+	{
+		PXThrow(PXArgumentException, @"Parameter object must be contained in list");
+		return;
+	}
+
+	id object1 = _items[index1];
+	_items[index1] = _items[index2];
+	_items[index2] = object1;
+}
+
+// MARK: Private
+
+- (void) growToCapacity:(unsigned)capacity
+{
+	if (capacity <= _capacity)
+		return;
+
+	unsigned newCapacity = _capacity < PX_ARRAY_LIST_MIN_CAPACITY ? PX_ARRAY_LIST_MIN_CAPACITY : _capacity;
+
+	while (newCapacity < capacity)
+	{
+		newCapacity <<= 1;
+	}
+
+	_items = realloc(_items, sizeof(id) * newCapacity);
+	_capacity = newCapacity;
+}
+
+- (void) removeItemAtIndex:(unsigned)index
+{
+	id *item = _items + index;
+	id object = *item;
+
+	// Close the gap before letting go of the object, its dealloc may change
+	// the list.
+	--_count;
+	memmove(item, item + 1, sizeof(id) * (_count - index));
+
+	if (_keepStrongReference)
+	{
+		[object release];
+	}
+}
+
+// MARK: Fast Enumeration
+
+// The list may be changed while it's being enumerated. The first call takes
+// a snapshot of the items, which keeps them alive until the loop's autorelease
+// pool drains, and the batches are copied out of it onto the stack.
+// state->state holds the index to continue from.
+- (NSUInteger) countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id *)stackbuf count:(NSUInteger)len
+{
+	NSArray *snapshot = nil;
+
+	if (state->state == 0)
+	{
+		if (_count == 0)
+		{
+			return 0;
+		}
+
+		snapshot = [NSArray arrayWithObjects:_items count:_count];
+
+		state->extra[0] = (unsigned long)snapshot;
+		// The snapshot never changes, so neither does this.
+		state->mutationsPtr = &state->extra[1];
+	}
+	else
+	{
+		snapshot = (NSArray *)(state->extra[0]);
+	}
+
+	unsigned long index = state->state;
+	NSUInteger snapshotCount = [snapshot count];
+
+	if (index >= snapshotCount)
+	{
+		return 0;
+	}
+
+	NSUInteger batchCount = snapshotCount - index;
+	if (batchCount > len)
+		batchCount = len;
+
+	[snapshot getObjects:stackbuf range:NSMakeRange(index, batchCount)];
+
+	state->state = index + batchCount;
+	state->itemsPtr = stackbuf;
+
+	return batchCount;
+}
+
+// MARK: Exporting
+
+/**
+ * Creates and returns a C array containing pointers to all the objects
+ * in the list.  The array's length is equal to the `count`
+ * property's value.
+ *
+ * It is the caller's responsibility to call `free()`
+ * on the returned array.
+ *
+ * Notice that the objects contained in the returned array aren't retained
+ * _again_ and as such this method should be used with caution.
+ *
+ * _**Complexity:** O(n)_
+ *
+ * @return A C array containing pointers to all of the objects in the list.
+ * returns 0 if the list is empty.
+ */
+- (id *)cArray
+{
+	if (_count == 0)
+		return NULL;
+
+	id *cArray = malloc(sizeof(id) * _count);
+	memcpy(cArray, _items, sizeof(id) * _count);
+
+	return cArray;
+}
+
+/**
+ * Returns a new list containing the same objects as this list, and in the same
+ * order.
+ * The individual items in the list aren't duplicated, only their reference is.
+ * 
+ * Note that the new list also retains each of the objects as long as
+ * #weakReferences is set to `NO` (default).
+ */
+// Implemented so that we can comment it
+- (id) copy
+{
+	return [super copy];
+}
+- (id) copyWithZone:(NSZone *)zone
+{
+	PXArrayList *list = [[[self class] allocWithZone:zone] initWithWeakReferences:!_keepStrongReference
+																		  capacity:_count];
+
+	[list addObjectsFromList:self];
+
+	return list;
+}
+
+/**
+ * Creates an array list with strong references.
+ *
+ * @return The created array list.
+ */
++ (PXArrayList *)arrayList
+{
+	return [[[PXArrayList alloc] init] autorelease];
+}
+
+/**
+ * Creates an array list.
+ *
+ * @param weakReferences `YES` if the list should not retain added elements;
+ * `NO` if it should. Setting this to `YES` is only
+ * useful in very rare circumstances and should be used with caution. The
+ * default value is `NO`.
+ *
+ * @return The created array list.
+ */
++ (PXArrayList *)arrayListWithWeakReferences:(BOOL)weakReferences
+{
+	return [[[PXArrayList alloc] initWithWeakReferences:weakReferences] autorelease];
+}
+
+@end
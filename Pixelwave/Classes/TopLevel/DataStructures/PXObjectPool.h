@@ -38,9 +38,27 @@
  */
 
 #include "PXSettings.h"
+#include <libkern/OSAtomic.h>
 
 @class PXObjectPool;
 
+/**
+ * A snapshot of the usage counters that a PXObjectPool keeps for a class.
+ *
+ * - `hits` - The number of objects that were handed out of the pool.
+ * - `misses` - The number of objects that had to be allocated because the pool
+ * was empty.
+ * - `live` - The number of objects handed out that haven't been returned yet.
+ * - `pooled` - The number of objects currently sitting in the pool.
+ */
+typedef struct
+{
+	unsigned hits;
+	unsigned misses;
+	unsigned live;
+	unsigned pooled;
+} PXObjectPoolStatistics;
+
 /**
  * An optional protocol, used to customize the behaviour of a PXObjectPool.
  */
@@ -50,6 +68,8 @@
  * a new object. You should return the object you'd like to pass back to the
  * user, or `nil` if you'd like the pool to instantiate the object
  * with the default consructor.
+ *
+ * This method is invoked on whichever thread asked the pool for the object.
  */
 //-- ScriptIgnore
 - (id) objectPool:(PXObjectPool *)objectPool newObjectForType:(Class)type;
@@ -60,7 +80,13 @@
 @private
 	id<PXObjectPoolDelegate> delegate;
 
-	NSMutableDictionary *pools;
+	// Singly linked, new slots are only ever added to the front and never
+	// removed until the pool goes away. This lets lookups run without a lock.
+	struct _PXObjectPoolSlot *slots;
+	struct _PXObjectPoolSlot *lastSlot;
+	OSSpinLock slotsLock;
+
+	unsigned maxObjectsPerClass;
 }
 
 /**
@@ -69,11 +95,25 @@
  */
 @property(nonatomic, retain) id<PXObjectPoolDelegate> delegate;
 
+/**
+ * The most unused objects the pool will hold on to for any single class.
+ * Objects returned to a pool that is already full are simply released.
+ *
+ * **Default:** 512
+ */
+@property(nonatomic) unsigned maxObjectsPerClass;
+
 //-- ScriptName: newObject
 - (id) newObjectUsingClass:(Class)typeClass;
 //-- ScriptName: releaseObject
 - (void) releaseObject:(id)object;
 
+//-- ScriptName: warm
+- (void) warmWithClass:(Class)typeClass count:(unsigned)count;
+
+//-- ScriptIgnore
+- (PXObjectPoolStatistics) statisticsForClass:(Class)typeClass;
+
 //-- ScriptName: clean
 - (void) purgeCachedData;
 
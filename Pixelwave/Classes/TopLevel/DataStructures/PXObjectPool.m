@@ -38,11 +38,46 @@
  */
 
 #import "PXObjectPool.h"
-#import "PXLinkedList.h"
 #import "PXPooledObject.h"
+#import "PXExceptionUtils.h"
+
+#define PX_OBJECT_POOL_DEFAULT_MAX_OBJECTS_PER_CLASS 512
+
+/*
+ * Every class the pool has seen gets its own slot, holding a stack of unused
+ * objects. Only the stack itself is guarded by a (per slot) spin lock, and
+ * only for the few instructions it takes to push or pop. The counters are
+ * updated atomically outside of it.
+ */
+typedef struct _PXObjectPoolSlot
+{
+	Class typeClass;
+	// Cached once, instead of asking the runtime on every release
+	BOOL resetOnRelease;
+
+	OSSpinLock lock;
+	id *objects;
+	unsigned count;
+	unsigned size;
+
+	volatile int32_t hits;
+	volatile int32_t misses;
+	volatile int32_t live;
+
+	struct _PXObjectPoolSlot *next;
+} _PXObjectPoolSlot;
 
 static PXObjectPool *pxSharedObjectPool = nil;
 
+PXInline _PXObjectPoolSlot *PXObjectPoolSlotFind(_PXObjectPoolSlot *slot, Class typeClass);
+PXInline id PXObjectPoolSlotPop(_PXObjectPoolSlot *slot);
+PXInline BOOL PXObjectPoolSlotPush(_PXObjectPoolSlot *slot, id object, unsigned maxCount);
+
+@interface PXObjectPool(Private)
+- (_PXObjectPoolSlot *)slotForClass:(Class)typeClass;
+- (id) allocateObjectUsingClass:(Class)typeClass;
+@end
+
 /**
  * An abstract object pool, capable of pooling multiple types of objects.
  * You should use an object pool in situations where the same type of class
@@ -54,11 +89,15 @@ static PXObjectPool *pxSharedObjectPool = nil;
  * can also use the global shared object pool to quickly access pooled object
  * across the entire application.
  *
+ * A pool may be used from multiple threads at once, so loader threads can
+ * share it with the main thread.
+ *
  * @see sharedObjectPool
  */
 @implementation PXObjectPool
 
 @synthesize delegate;
+@synthesize maxObjectsPerClass;
 
 - (id) init
 {
@@ -66,7 +105,12 @@ static PXObjectPool *pxSharedObjectPool = nil;
 
 	if (self)
 	{
-		pools = nil;
+		slots = NULL;
+		lastSlot = NULL;
+		slotsLock = OS_SPINLOCK_INIT;
+
+		maxObjectsPerClass = PX_OBJECT_POOL_DEFAULT_MAX_OBJECTS_PER_CLASS;
+
 		delegate = nil;
 	}
 
@@ -76,6 +120,20 @@ static PXObjectPool *pxSharedObjectPool = nil;
 - (void) dealloc
 {
 	[self purgeCachedData];
+
+	_PXObjectPoolSlot *slot = slots;
+	_PXObjectPoolSlot *next;
+
+	while (slot)
+	{
+		next = slot->next;
+		free(slot);
+		slot = next;
+	}
+
+	slots = NULL;
+	lastSlot = NULL;
+
 	self.delegate = nil;
 	[super dealloc];
 }
@@ -88,12 +146,32 @@ static PXObjectPool *pxSharedObjectPool = nil;
  */
 - (void) purgeCachedData
 {
-	// Get rid of everything
-	if (pools)
+	_PXObjectPoolSlot *slot;
+
+	id *objects;
+	unsigned count;
+	unsigned index;
+
+	for (slot = slots; slot; slot = slot->next)
 	{
-		[pools removeAllObjects];
-		[pools release];
-		pools = nil;
+		// Take the stack out of the slot, and release its objects once the
+		// lock is no longer held.
+		OSSpinLockLock(&slot->lock);
+		objects = slot->objects;
+		count = slot->count;
+
+		slot->objects = NULL;
+		slot->count = 0;
+		slot->size = 0;
+		OSSpinLockUnlock(&slot->lock);
+
+		for (index = 0; index < count; ++index)
+		{
+			[objects[index] release];
+		}
+
+		if (objects)
+			free(objects);
 	}
 }
 
@@ -116,42 +194,68 @@ static PXObjectPool *pxSharedObjectPool = nil;
  */
 - (id) newObjectUsingClass:(Class)typeClass
 {
-	if (!pools)
+	if (!typeClass)
+		return nil;
+
+	_PXObjectPoolSlot *slot = [self slotForClass:typeClass];
+
+	id retObject = PXObjectPoolSlotPop(slot);
+
+	if (retObject)
+	{
+		OSAtomicIncrement32(&slot->hits);
+	}
+	else
 	{
-		pools = [NSMutableDictionary new];
+		OSAtomicIncrement32(&slot->misses);
+		retObject = [self allocateObjectUsingClass:typeClass];
 	}
 
-	PXLinkedList *list = [pools objectForKey:typeClass];
-	if (!list)
+	if (retObject)
 	{
-		list = [[PXLinkedList alloc] init];
-		[pools setObject:list forKey:typeClass];
-		[list release];
+		OSAtomicIncrement32(&slot->live);
 	}
 
-	id retObject = nil;
+	return retObject;
+}
 
-	if (list.count > 0)
+/**
+ * Fills the pool with new objects of the given class ahead of time, so that
+ * later calls to #newObjectUsingClass: don't have to allocate any. Useful
+ * right before a burst of activity, such as spawning a particle system.
+ *
+ * The pool won't grow past #maxObjectsPerClass.
+ *
+ * @param typeClass The class from which instances should be created.
+ * @param count The number of objects to create.
+ */
+- (void) warmWithClass:(Class)typeClass count:(unsigned)count
+{
+	if (!typeClass)
 	{
-		retObject = list.lastObject;
-		[retObject retain];
-		[list removeLastObject];
+		PXThrowNilParam(typeClass);
+		return;
 	}
-	else
+
+	_PXObjectPoolSlot *slot = [self slotForClass:typeClass];
+
+	id object;
+	unsigned index;
+
+	for (index = 0; index < count; ++index)
 	{
-		if (delegate)
-		{
-			//[delegate poolDelegateCreateObjectForClass:typeClass retObject:&retObject];
-			retObject = [delegate objectPool:self newObjectForType:typeClass];
-		}
+		object = [self allocateObjectUsingClass:typeClass];
 
-		if (!retObject && typeClass)
+		if (!object)
+			break;
+
+		if (!PXObjectPoolSlotPush(slot, object, maxObjectsPerClass))
 		{
-			retObject = [typeClass new];
+			// The pool is full
+			[object release];
+			break;
 		}
 	}
-
-	return retObject;
 }
 
 // MARK: Returning Objects to pool
@@ -184,30 +288,56 @@ static PXObjectPool *pxSharedObjectPool = nil;
 // Releases the object
 - (void) releaseObject:(id)object
 {
-	if (!pools)
+	if (!object)
 		return;
 
-	Class typeClass = [object class];
+	_PXObjectPoolSlot *slot = [self slotForClass:[object class]];
+
+	OSAtomicDecrement32(&slot->live);
 
-	PXLinkedList *list = (PXLinkedList *)[pools objectForKey:typeClass];
-	if (!list)
+	if (slot->resetOnRelease)
 	{
-		list = [[PXLinkedList alloc] init];
-		[pools setObject:list forKey:typeClass];
-		[list release];
+		[((id<PXPooledObject>)object) reset];
 	}
 
-	[list addObject:object];
+	// The pool takes over the caller's retain, unless it's full.
+	if (!PXObjectPoolSlotPush(slot, object, maxObjectsPerClass))
+	{
+		[object release];
+	}
+}
+
+// MARK: Statistics
+
+/**
+ * Returns the usage counters of the pool for the given class, or the sum over
+ * every class if `Nil` is given.
+ *
+ * The counters are read without stopping other threads, so the values may be
+ * slightly out of step with each other while the pool is in use.
+ */
+- (PXObjectPoolStatistics) statisticsForClass:(Class)typeClass
+{
+	PXObjectPoolStatistics statistics = {0, 0, 0, 0};
 
-	[object release];
+	_PXObjectPoolSlot *slot;
+	int32_t live;
 
-	if ([object conformsToProtocol:@protocol(PXPooledObject)])
+	for (slot = slots; slot; slot = slot->next)
 	{
-		if ([object respondsToSelector:@selector(reset)])
-		{
-			[((id<PXPooledObject>)object) reset];
-		}
+		if (typeClass && slot->typeClass != typeClass)
+			continue;
+
+		live = slot->live;
+
+		statistics.hits += slot->hits;
+		statistics.misses += slot->misses;
+		// Objects that never came from the pool may still be returned to it
+		statistics.live += (live > 0 ? live : 0);
+		statistics.pooled += slot->count;
 	}
+
+	return statistics;
 }
 
 // MARK: Static Methods
@@ -230,11 +360,158 @@ static PXObjectPool *pxSharedObjectPool = nil;
 
 - (NSString *)description
 {
-	NSMutableString *str = [NSMutableString new];
+	unsigned numTypes = 0;
+	_PXObjectPoolSlot *slot;
+
+	for (slot = slots; slot; slot = slot->next)
+	{
+		++numTypes;
+	}
 
-	[str appendFormat:@"[ObjectPool numTypes = %i]"];
+	PXObjectPoolStatistics statistics = [self statisticsForClass:Nil];
 
-	return [str autorelease];
+	return [NSString stringWithFormat:@"[ObjectPool numTypes = %u hits = %u misses = %u live = %u pooled = %u]",
+			numTypes,
+			statistics.hits,
+			statistics.misses,
+			statistics.live,
+			statistics.pooled];
 }
 
 @end
+
+@implementation PXObjectPool(Private)
+
+- (_PXObjectPoolSlot *)slotForClass:(Class)typeClass
+{
+	// Most of the time the same class is asked for over and over again
+	_PXObjectPoolSlot *slot = lastSlot;
+
+	if (slot && slot->typeClass == typeClass)
+		return slot;
+
+	slot = PXObjectPoolSlotFind(slots, typeClass);
+
+	if (!slot)
+	{
+		// Fill in the slot before taking the lock, so that the runtime isn't
+		// queried while holding it.
+		_PXObjectPoolSlot *newSlot = calloc(1, sizeof(_PXObjectPoolSlot));
+
+		newSlot->typeClass = typeClass;
+		newSlot->resetOnRelease = [typeClass conformsToProtocol:@protocol(PXPooledObject)] &&
+		                          [typeClass instancesRespondToSelector:@selector(reset)];
+		newSlot->lock = OS_SPINLOCK_INIT;
+
+		OSSpinLockLock(&slotsLock);
+
+		// Another thread may have added it in the meantime
+		slot = PXObjectPoolSlotFind(slots, typeClass);
+
+		if (!slot)
+		{
+			newSlot->next = slots;
+
+			// Publish the slot only once it's filled in
+			OSMemoryBarrier();
+			slots = newSlot;
+
+			slot = newSlot;
+			newSlot = NULL;
+		}
+
+		OSSpinLockUnlock(&slotsLock);
+
+		if (newSlot)
+			free(newSlot);
+	}
+
+	lastSlot = slot;
+
+	return slot;
+}
+
+- (id) allocateObjectUsingClass:(Class)typeClass
+{
+	id retObject = nil;
+
+	if (delegate)
+	{
+		retObject = [delegate objectPool:self newObjectForType:typeClass];
+	}
+
+	if (!retObject)
+	{
+		retObject = [typeClass new];
+	}
+
+	return retObject;
+}
+
+@end
+
+// MARK: Slots
+
+PXInline _PXObjectPoolSlot *PXObjectPoolSlotFind(_PXObjectPoolSlot *slot, Class typeClass)
+{
+	for (; slot; slot = slot->next)
+	{
+		if (slot->typeClass == typeClass)
+			return slot;
+	}
+
+	return NULL;
+}
+
+PXInline id PXObjectPoolSlotPop(_PXObjectPoolSlot *slot)
+{
+	id object = nil;
+
+	OSSpinLockLock(&slot->lock);
+
+	if (slot->count > 0)
+	{
+		object = slot->objects[--(slot->count)];
+	}
+
+	OSSpinLockUnlock(&slot->lock);
+
+	return object;
+}
+
+/*
+ * Returns NO if the slot already holds maxCount objects, in which case the
+ * object isn't taken.
+ */
+PXInline BOOL PXObjectPoolSlotPush(_PXObjectPoolSlot *slot, id object, unsigned maxCount)
+{
+	BOOL pushed = NO;
+
+	OSSpinLockLock(&slot->lock);
+
+	if (slot->count < maxCount)
+	{
+		if (slot->count == slot->size)
+		{
+			// Grows rarely, and never past maxCount
+			unsigned size = MIN(MAX(slot->size << 1, 8), maxCount);
+			id *objects = realloc(slot->objects, sizeof(id) * size);
+
+			if (objects)
+			{
+				slot->objects = objects;
+				slot->size = size;
+			}
+		}
+
+		if (slot->count < slot->size)
+		{
+			slot->objects[(slot->count)++] = object;
+			pushed = YES;
+		}
+	}
+
+	OSSpinLockUnlock(&slot->lock);
+
+	return pushed;
+}
@@ -75,6 +75,13 @@
 //-- ScriptName: logErrors
 + (BOOL) logErrors;
 
+//-- ScriptName: setChecksGLErrorsSynchronously
++ (void) setChecksGLErrorsSynchronously:(BOOL)val;
+//-- ScriptName: checksGLErrorsSynchronously
++ (BOOL) checksGLErrorsSynchronously;
+//-- ScriptName: glErrorCount
++ (unsigned) glErrorCount;
+
 //-- ScriptName: getTimeBetweenFrames
 + (float) timeBetweenFrames;
 //-- ScriptName: getTimeBetweenLogic
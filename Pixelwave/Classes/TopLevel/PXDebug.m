@@ -41,6 +41,7 @@
 #import "PXDebugUtils.h"
 #import "PXEngine.h"
 
+#include "PXGLErrorUtils.h"
 #include "PXPrivateUtils.h"
 #include "PXSettings.h"
 
@@ -203,6 +204,39 @@ PXInline_c void PXDebugLog(NSString *format, ...)
 	return (BOOL)(PXDebugIsEnabled(PXDebugSetting_LogErrors));
 }
 
++ (void) setChecksGLErrorsSynchronously:(BOOL)val
+{
+	if (val)
+	{
+		PXDebugEnableSetting(PXDebugSetting_SynchronousGLErrors);
+	}
+	else
+	{
+		PXDebugDisableSetting(PXDebugSetting_SynchronousGLErrors);
+	}
+}
+/**
+ * When turned on, OpenGL is asked for errors right after each texture upload,
+ * so that a failed upload is reported by the call that caused it. This makes
+ * the CPU wait on the GPU every time.
+ *
+ * When turned off, errors are collected once per frame and logged along with
+ * the last few operations performed. This is the only mode available when
+ * `PX_DEBUG_MODE` isn't defined.
+ */
++ (BOOL) checksGLErrorsSynchronously
+{
+	return (BOOL)(PXDebugIsEnabled(PXDebugSetting_SynchronousGLErrors));
+}
+
+/**
+ * The amount of OpenGL errors found since the engine started.
+ */
++ (unsigned) glErrorCount
+{
+	return PXGLErrorGetCount();
+}
+
 /**
  * The amount of time in seconds that passed between the last two frames.
  * This value can be used to calculate the framerate of the
@@ -48,6 +48,7 @@
 #import "PXGLException.h"
 
 // DataStructures
+#import "PXArrayList.h"
 #import "PXLinkedList.h"
 #import "PXObjectPool.h"
 
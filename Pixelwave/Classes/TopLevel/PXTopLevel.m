@@ -48,6 +48,7 @@
 // PXParser - Texture
 #import "PXCGTextureParser.h"
 #import "PXPVRTextureParser.h"
+#import "PXETCTextureParser.h"
 
 #if(PX_TEXTURE_PARSER_USE_LIBPNG)
 #import "PXPNGTextureParser.h"
@@ -65,6 +66,7 @@
 // PXParser - TextureAtlas
 #import "PXTPAtlasParser.h"
 #import "PXZwopAtlasParser.h"
+#import "PXBinaryAtlasParser.h"
 
 // Font Fusers
 #import "PXFontFuser.h"
@@ -93,6 +95,7 @@ void _PXTopLevelInitialize( )
 
 	[PXParser registerParser:[PXCGTextureParser class]		forBaseClass:[PXTextureParser class]];
 	[PXParser registerParser:[PXPVRTextureParser class]		forBaseClass:[PXTextureParser class]];
+	[PXParser registerParser:[PXETCTextureParser class]		forBaseClass:[PXTextureParser class]];
 #if(PX_TEXTURE_PARSER_USE_LIBPNG)
 	[PXParser registerParser:[PXPNGTextureParser class]		forBaseClass:[PXTextureParser class]];
 #endif
@@ -106,6 +109,7 @@ void _PXTopLevelInitialize( )
 
 	[PXParser registerParser:[PXTPAtlasParser class]		forBaseClass:[PXTextureAtlasParser class]];
 	[PXParser registerParser:[PXZwopAtlasParser class]		forBaseClass:[PXTextureAtlasParser class]];
+	[PXParser registerParser:[PXBinaryAtlasParser class]	forBaseClass:[PXTextureAtlasParser class]];
 
 	////////////////////////////// Add the Fusers \\\\\\\\\\\\\\\\\\\\\\\\\\\\\\
 
@@ -43,5 +43,16 @@
 
 //-- ScriptName: modifierMono
 + (id<PXSoundModifier>) soundModifierToMono;
+//-- ScriptName: modifier8Bit
++ (id<PXSoundModifier>) soundModifierTo8Bit;
+//-- ScriptName: modifierFrequency
++ (id<PXSoundModifier>) soundModifierToFrequency:(int)freq;
+//-- ScriptName: modifierNormalize
+//-- ScriptArg[0]: 1.0f
++ (id<PXSoundModifier>) soundModifierToNormalizeWithPeak:(float)peak;
+//-- ScriptName: modifierADPCM
++ (id<PXSoundModifier>) soundModifierToADPCM;
+//-- ScriptName: modifierChain
++ (id<PXSoundModifier>) soundModifierWithModifiers:(NSArray *)modifiers;
 
 @end
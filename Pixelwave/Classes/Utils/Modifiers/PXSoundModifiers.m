@@ -40,6 +40,11 @@
 #import "PXSoundModifiers.h"
 
 #import "PXSoundModifierToMono.h"
+#import "PXSoundModifierTo8Bit.h"
+#import "PXSoundModifierResample.h"
+#import "PXSoundModifierNormalize.h"
+#import "PXSoundModifierChain.h"
+#import "PXSoundModifierToADPCM.h"
 
 /**
  * PXSoundModifiers creates a sound modifier from a premade list of modifiers.
@@ -56,4 +61,81 @@
 	return [[[PXSoundModifierToMono alloc] init] autorelease];
 }
 
+/**
+ * Makes a sound modifier that will convert your sound to 8 bits per sample,
+ * halving the memory it uses.
+ *
+ * @return A sound modifier that will convert your sound to 8 bit.
+ */
++ (id<PXSoundModifier>) soundModifierTo8Bit
+{
+	return [[[PXSoundModifierTo8Bit alloc] init] autorelease];
+}
+
+/**
+ * Makes a sound modifier that will resample your sound to the given
+ * frequency.
+ *
+ * @param freq The sample rate, in hertz, to convert the sound to.
+ *
+ * @return A sound modifier that will resample your sound.
+ *
+ * **Example:**
+ *	// 44.1k to 22.05k
+ *	id<PXSoundModifier> modifier = [PXSoundModifiers soundModifierToFrequency:22050];
+ */
++ (id<PXSoundModifier>) soundModifierToFrequency:(int)freq
+{
+	return [[[PXSoundModifierResample alloc] initWithFrequency:freq] autorelease];
+}
+
+/**
+ * Makes a sound modifier that will scale your sound so that its loudest
+ * sample reaches the given amplitude.
+ *
+ * @param peak The amplitude, between 0.0f and 1.0f, of the loudest sample.
+ *
+ * @return A sound modifier that will normalize your sound.
+ */
++ (id<PXSoundModifier>) soundModifierToNormalizeWithPeak:(float)peak
+{
+	return [[[PXSoundModifierNormalize alloc] initWithPeak:peak] autorelease];
+}
+
+/**
+ * Makes a sound modifier that will compress your sound to IMA ADPCM. The
+ * sound stays compressed in memory, using about a quarter of the space of 16
+ * bit PCM, and is decoded a little at a time as it plays.
+ *
+ * When used in a chain, this should be the last modifier; the other built in
+ * modifiers leave compressed sounds untouched.
+ *
+ * @return A sound modifier that will compress your sound.
+ */
++ (id<PXSoundModifier>) soundModifierToADPCM
+{
+	return [[[PXSoundModifierToADPCM alloc] init] autorelease];
+}
+
+/**
+ * Makes a sound modifier that will run each of the given modifiers, in order.
+ * Consecutive modifiers made by PXSoundModifiers are fused and run as a single
+ * pass over your sound.
+ *
+ * @param modifiers A list of objects conforming to the PXSoundModifier
+ * protocol.
+ *
+ * @return A sound modifier that runs all of the given modifiers.
+ *
+ * **Example:**
+ *	NSArray *list = [NSArray arrayWithObjects:[PXSoundModifiers soundModifierToMono],
+ *	                                          [PXSoundModifiers soundModifierToFrequency:22050],
+ *	                                          nil];
+ *	[PXSoundLoader setDefaultModifier:[PXSoundModifiers soundModifierWithModifiers:list]];
+ */
++ (id<PXSoundModifier>) soundModifierWithModifiers:(NSArray *)modifiers
+{
+	return [[[PXSoundModifierChain alloc] initWithModifiers:modifiers] autorelease];
+}
+
 @end
@@ -38,6 +38,7 @@
  */
 
 #import "PXTextureDataPixelFormat.h"
+#include "PXTextureDither.h"
 
 @protocol PXTextureModifier;
 
@@ -45,5 +46,6 @@
 
 //-- ScriptName: modifierToFormat
 + (id<PXTextureModifier>) textureModifierToPixelFormat:(PXTextureDataPixelFormat)format;
++ (id<PXTextureModifier>) textureModifierToPixelFormat:(PXTextureDataPixelFormat)format dither:(PXTextureDither)dither;
 
 @end
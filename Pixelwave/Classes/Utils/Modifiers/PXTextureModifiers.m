@@ -67,17 +67,37 @@
  * @return A texture modifier that will convert your texture to the desired format.
  */
 + (id<PXTextureModifier>) textureModifierToPixelFormat:(PXTextureDataPixelFormat)format
+{
+	return [PXTextureModifiers textureModifierToPixelFormat:format dither:PXTextureDither_None];
+}
+
+/**
+ * Makes a texture modifier that will convert your texture to the desired
+ * format, dithering the result when the format has fewer bits per channel
+ * than the source. Dithering is only used by the RGBA4444, RGBA5551 and
+ * RGB565 formats.
+ *
+ * @param format The desired texture format.
+ * @param dither How to dither the bits that are dropped.
+ *
+ * @return A texture modifier that will convert your texture to the desired format.
+ *
+ * **Example:**
+ *	id<PXTextureModifier> modifier = [PXTextureModifiers textureModifierToPixelFormat:PXTextureDataPixelFormat_RGBA4444 dither:PXTextureDither_Ordered];
+ *	PXTextureData *textureData = [PXTextureData textureDataWithContentsOfFile:@"sky.png" modifier:modifier];
+ */
++ (id<PXTextureModifier>) textureModifierToPixelFormat:(PXTextureDataPixelFormat)format dither:(PXTextureDither)dither
 {
 	switch (format)
 	{
 		case PXTextureDataPixelFormat_RGBA8888:
 			return [[[PXTextureModifier8888 alloc] init] autorelease];
 		case PXTextureDataPixelFormat_RGBA4444:
-			return [[[PXTextureModifier4444 alloc] init] autorelease];
+			return [[[PXTextureModifier4444 alloc] initWithDither:dither] autorelease];
 		case PXTextureDataPixelFormat_RGBA5551:
-			return [[[PXTextureModifier5551 alloc] init] autorelease];
+			return [[[PXTextureModifier5551 alloc] initWithDither:dither] autorelease];
 		case PXTextureDataPixelFormat_RGB565:
-			return [[[PXTextureModifier565 alloc] init] autorelease];
+			return [[[PXTextureModifier565 alloc] initWithDither:dither] autorelease];
 		case PXTextureDataPixelFormat_RGB888:
 			return [[[PXTextureModifier888 alloc] init] autorelease];
 		case PXTextureDataPixelFormat_L8:
@@ -94,6 +114,8 @@
 			break;
 		case PXTextureDataPixelFormat_RGBA_PVRTC4:
 			break;
+		case PXTextureDataPixelFormat_RGB_ETC1:
+			break;
 	}
 
 	PXDebugLog(@"Converting to the pixel format [%d] is not supported at this time.\n", format);
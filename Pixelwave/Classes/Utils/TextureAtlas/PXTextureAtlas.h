@@ -44,6 +44,9 @@
 
 @protocol PXTextureModifier;
 
+// Returned by frameIDForName: when there is no frame by that name
+#define PXTextureAtlasNoFrameID -1
+
 //
 //                    +NMMMMMMMMMMN~       
 //                  :MMMMMMMMMMMMMMM8,     
@@ -88,10 +91,35 @@
 // MMMN           MMMM    ,    ?$=:        
 // ?DNZ                                    
 
+/*
+ * Makes the frames of an atlas when they're first asked for, so that loading
+ * an atlas doesn't have to make thousands of them up front.
+ */
+@protocol PXTextureAtlasFrameSource <NSObject>
+- (NSArray *)frameNames;
+- (PXAtlasFrame *)newFrameWithName:(NSString *)name;
+@end
+
 @interface PXTextureAtlas : NSObject
 {
 @private
-	NSMutableDictionary *frames;
+	// Name -> frame ID
+	CFMutableDictionaryRef frameIDs;
+
+	// Frame ID -> name and frame. A removed frame leaves a NULL name behind,
+	// so that the other IDs stay the same. Frames of the source are NULL
+	// until they're first asked for.
+	NSString **frameNames;
+	PXAtlasFrame **frameList;
+	int frameCount;
+	int frameCapacity;
+
+	// Lowercased prefix and suffix -> the frames in the sequence, sorted by
+	// number
+	CFMutableDictionaryRef sequences;
+
+	// Makes the frames which haven't been asked for yet, if any
+	id<PXTextureAtlasFrameSource> frameSource;
 }
 
 /**
@@ -121,6 +149,11 @@
 
 - (PXAtlasFrame *)frameWithName:(NSString *)name;
 
+// Frame IDs
+- (int) frameIDForName:(NSString *)name;
+- (PXAtlasFrame *)frameWithID:(int)frameID;
+- (void) setFrameWithID:(int)frameID toTexture:(PXTexture *)texture;
+
 /////////////
 // Utility //
 /////////////
@@ -145,6 +178,10 @@
 + (PXTextureAtlas *)textureAtlasWithContentsOfFile:(NSString *)path modifier:(id<PXTextureModifier>)modifier;
 @end
 
+@interface PXTextureAtlas (PrivateButPublic)
+- (void) _setFrameSource:(id<PXTextureAtlasFrameSource>)frameSource;
+@end
+
 @class PXRegexPattern;
 
 @interface PXTextureAtlas (Utils)
@@ -152,5 +189,6 @@
 - (NSArray *)framesWithPattern:(PXRegexPattern *)pattern;
 - (NSArray *)sequentialFramesWithPrefix:(NSString *)prefix suffix:(NSString *)suffix;
 - (NSArray *)sequentialFramesWithPrefix:(NSString *)prefix suffix:(NSString *)suffix inRange:(NSRange)range;
+- (unsigned) getFrameIDs:(int *)frameIDs maxCount:(unsigned)maxCount withPrefix:(NSString *)prefix suffix:(NSString *)suffix inRange:(NSRange)range;
 // TODO: Add a [sequentialFramesWithPattern:range:] which will sort the list with all the groups in the pattern.
 @end
@@ -51,13 +51,166 @@
 #import "PXRegexPattern.h"
 #import "PXRegexMatcher.h"
 
+// The most digits in a row that are read as the number of a frame in a
+// sequence. Longer runs of digits are left out.
+#define PX_TEXTURE_ATLAS_MAX_SEQUENCE_DIGITS 9
+#define PX_TEXTURE_ATLAS_MAX_SEQUENCE_NUMBER 999999999
+
+// Names at most this long are scanned for numbers without allocating
+#define PX_TEXTURE_ATLAS_NAME_BUFFER_SIZE 128
+
+// A frame in a sequence, which are kept sorted by number, then ID.
+typedef struct
+{
+	int number;
+	int frameID;
+} _PXTextureAtlasSequenceEntry;
+
+// The lowercased text before and after the number of the frames in a
+// sequence. Looked up in place, copied into a single block when a sequence is
+// added.
+typedef struct
+{
+	const unichar *prefix;
+	NSUInteger prefixLength;
+	const unichar *suffix;
+	NSUInteger suffixLength;
+} _PXTextureAtlasSequenceKey;
+
 @interface PXTextureAtlas(Private)
 - (id) initWithData:(NSData *)data
 		scaleFactor:(float)scaleFactor
 		   modifier:(id<PXTextureModifier>)modifier
 			 origin:(NSString *)origin;
+- (int) _addName:(NSString *)name frame:(PXAtlasFrame *)frame;
+- (void) _updateSequencesForName:(NSString *)name frameID:(int)frameID adding:(BOOL)adding;
+- (NSMutableData *)_sequenceWithKey:(const _PXTextureAtlasSequenceKey *)key create:(BOOL)create;
+- (unsigned) _getSequenceEntries:(const _PXTextureAtlasSequenceEntry **)entries
+					  withPrefix:(NSString *)prefix
+						  suffix:(NSString *)suffix
+						 inRange:(NSRange)range;
+- (void) _buildAllFrames;
 @end
 
+/*
+ * The index of the first entry that doesn't come before the given number and
+ * ID.
+ */
+PXInline NSUInteger _PXTextureAtlasSequenceLowerBound(const _PXTextureAtlasSequenceEntry *entries, NSUInteger count, int number, int frameID)
+{
+	NSUInteger low = 0;
+	NSUInteger high = count;
+	NSUInteger middle;
+
+	const _PXTextureAtlasSequenceEntry *entry;
+
+	while (low < high)
+	{
+		middle = (low + high) >> 1;
+		entry = &entries[middle];
+
+		if (entry->number < number || (entry->number == number && entry->frameID < frameID))
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+/*
+ * Points to the lowercased characters of the string, which are put in the
+ * buffer if they fit and in a malloc'd block otherwise; free it if it isn't
+ * the buffer. ASCII is lowercased in place, anything else is left to
+ * Foundation.
+ */
+PXInline unichar *_PXTextureAtlasGetLowercaseCharacters(NSString *string, unichar *buffer, NSUInteger bufferSize, NSUInteger *outLength)
+{
+	NSUInteger length = [string length];
+	unichar *characters = (length > bufferSize) ? malloc(sizeof(unichar) * length) : buffer;
+	NSUInteger index;
+	unichar character;
+
+	[string getCharacters:characters range:NSMakeRange(0, length)];
+
+	for (index = 0; index < length; ++index)
+	{
+		character = characters[index];
+
+		if (character >= 'A' && character <= 'Z')
+			characters[index] = character + ('a' - 'A');
+		else if (character >= 0x80)
+			break;
+	}
+
+	if (index < length)
+	{
+		// Lowercasing may change the length of the string
+		if (characters != buffer)
+			free(characters);
+
+		string = [string lowercaseString];
+		length = [string length];
+		characters = (length > bufferSize) ? malloc(sizeof(unichar) * length) : buffer;
+
+		[string getCharacters:characters range:NSMakeRange(0, length)];
+	}
+
+	*outLength = length;
+	return characters;
+}
+
+const void *_PXTextureAtlasSequenceKeyRetain(CFAllocatorRef allocator, const void *value)
+{
+	const _PXTextureAtlasSequenceKey *key = value;
+
+	_PXTextureAtlasSequenceKey *copy = malloc(sizeof(_PXTextureAtlasSequenceKey) + sizeof(unichar) * (key->prefixLength + key->suffixLength));
+	unichar *characters = (unichar *)(copy + 1);
+
+	memcpy(characters, key->prefix, sizeof(unichar) * key->prefixLength);
+	memcpy(characters + key->prefixLength, key->suffix, sizeof(unichar) * key->suffixLength);
+
+	copy->prefix = characters;
+	copy->prefixLength = key->prefixLength;
+	copy->suffix = characters + key->prefixLength;
+	copy->suffixLength = key->suffixLength;
+
+	return copy;
+}
+
+void _PXTextureAtlasSequenceKeyRelease(CFAllocatorRef allocator, const void *value)
+{
+	free((void *)value);
+}
+
+Boolean _PXTextureAtlasSequenceKeyEqual(const void *value1, const void *value2)
+{
+	const _PXTextureAtlasSequenceKey *key1 = value1;
+	const _PXTextureAtlasSequenceKey *key2 = value2;
+
+	// Comparing the lengths keeps "a1" + "2b" apart from "a" + "12b"
+	return key1->prefixLength == key2->prefixLength &&
+		   key1->suffixLength == key2->suffixLength &&
+		   memcmp(key1->prefix, key2->prefix, sizeof(unichar) * key1->prefixLength) == 0 &&
+		   memcmp(key1->suffix, key2->suffix, sizeof(unichar) * key1->suffixLength) == 0;
+}
+
+CFHashCode _PXTextureAtlasSequenceKeyHash(const void *value)
+{
+	const _PXTextureAtlasSequenceKey *key = value;
+
+	// FNV-1a
+	CFHashCode hash = 2166136261U ^ key->prefixLength;
+	NSUInteger index;
+
+	for (index = 0; index < key->prefixLength; ++index)
+		hash = (hash ^ key->prefix[index]) * 16777619U;
+	for (index = 0; index < key->suffixLength; ++index)
+		hash = (hash ^ key->suffix[index]) * 16777619U;
+
+	return hash;
+}
+
 /**
  * Abstracts the concept of a texture atlas
  * (several images arranged into one larger image) into
@@ -81,6 +234,8 @@
  *
  * - Zwoptex (.plist)
  * - TexturePacker (.json)
+ * - Pixelwave binary atlas (.pxa), made from either of the above with the
+ * pxatlas tool. Its frames are only created once they're asked for.
  *
  * *USAGE*
  *
@@ -115,7 +270,21 @@
 
 	if (self)
 	{
-		frames = [NSMutableDictionary new];
+		frameIDs = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+
+		frameNames = NULL;
+		frameList = NULL;
+		frameCount = 0;
+		frameCapacity = 0;
+
+		CFDictionaryKeyCallBacks sequenceKeyCallBacks = {0,
+			_PXTextureAtlasSequenceKeyRetain,
+			_PXTextureAtlasSequenceKeyRelease,
+			NULL,
+			_PXTextureAtlasSequenceKeyEqual,
+			_PXTextureAtlasSequenceKeyHash};
+
+		sequences = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &sequenceKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
 	}
 
 	return self;
@@ -170,8 +339,9 @@
 	float scaleFactor = 1.0f;
 	path = [PXLoader pathForRetinaVersionOfFile:path retScale:&scaleFactor];
 
-	// Load the data from the HD
-	NSData *data = [NSData dataWithContentsOfFile:path];
+	// Load the data from the HD. It's mapped rather than read, so that binary
+	// atlases only page in the parts that get used.
+	NSData *data = [NSData dataWithContentsOfMappedFile:path];
 
 	return [self initWithData:data
 				  scaleFactor:scaleFactor
@@ -232,8 +402,27 @@
 
 - (void) dealloc
 {
-	[frames release];
-	frames = nil;
+	int frameID;
+
+	for (frameID = 0; frameID < frameCount; ++frameID)
+	{
+		[frameNames[frameID] release];
+		[frameList[frameID] release];
+	}
+
+	free(frameNames);
+	frameNames = NULL;
+	free(frameList);
+	frameList = NULL;
+
+	CFRelease(frameIDs);
+	frameIDs = NULL;
+
+	CFRelease(sequences);
+	sequences = NULL;
+
+	[frameSource release];
+	frameSource = nil;
 
 	[super dealloc];
 }
@@ -246,11 +435,43 @@
 
 - (NSArray *)allNames
 {
-	return [frames allKeys];
+	NSMutableArray *names = [[NSMutableArray alloc] initWithCapacity:CFDictionaryGetCount(frameIDs)];
+
+	int frameID;
+	NSString *name;
+
+	for (frameID = 0; frameID < frameCount; ++frameID)
+	{
+		name = frameNames[frameID];
+
+		if (name)
+		{
+			[names addObject:name];
+		}
+	}
+
+	return [names autorelease];
 }
 - (NSArray *)allFrames
 {
-	return [frames allValues];
+	[self _buildAllFrames];
+
+	NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:CFDictionaryGetCount(frameIDs)];
+
+	int frameID;
+	PXAtlasFrame *frame;
+
+	for (frameID = 0; frameID < frameCount; ++frameID)
+	{
+		frame = frameList[frameID];
+
+		if (frame)
+		{
+			[array addObject:frame];
+		}
+	}
+
+	return [array autorelease];
 }
 
 - (NSArray *)textureDatas
@@ -260,12 +481,9 @@
 
 	NSMutableArray *arr = [NSMutableArray new];
 
-	NSEnumerator *e = [frames objectEnumerator];
-
-	PXAtlasFrame *frame;
 	PXTextureData *td;
 
-	while ((frame = [e nextObject]))
+	for (PXAtlasFrame *frame in [self allFrames])
 	{
 		td = frame.textureData;
 
@@ -295,7 +513,7 @@
  * @param name The name to associate the given frame with. This is the name
  * used to dereference the frame later on. If the name specified
  * is already associated with a different frame, that frame is
- * removed and is replaced by the one passed in.
+ * replaced by the one passed in, which takes over its frame ID.
  *
  * @see initWithContentsOfFile:
  * @see addFrameWithName:clipRect:textureData:
@@ -303,15 +521,28 @@
  */
 - (void) addFrame:(PXAtlasFrame *)frame withName:(NSString *)name
 {
-	// If one already exists, remove it
-	[self removeFrame:name];
+	if (!frame || !name)
+		return;
 
-	[frames setObject:frame forKey:name];
+	int frameID = [self frameIDForName:name];
+
+	// If one already exists, replace it
+	if (frameID != PXTextureAtlasNoFrameID)
+	{
+		[frame retain];
+		[frameList[frameID] release];
+		frameList[frameID] = frame;
+
+		return;
+	}
+
+	[self _addName:name frame:frame];
 }
 
 /**
  * Removes the frame associated with the given name. If a frame with that
- * name doesn't exist, nothing happens.
+ * name doesn't exist, nothing happens. The ID of the frame isn't given to
+ * any other frame.
  *
  * Note: Once a frame is removed from the texture atlas, the atlas's retain on it is released.
  * If you need to keep a reference to the frame you're about to remove, it's best to get the
@@ -319,22 +550,337 @@
  */
 - (void) removeFrame:(NSString *)name
 {
-	PXAtlasFrame *frame = (PXAtlasFrame *)[frames objectForKey:name];
+	int frameID = [self frameIDForName:name];
 
-	if (frame == nil)
+	if (frameID == PXTextureAtlasNoFrameID)
 		return;
 
-	[frames removeObjectForKey:name];
+	NSString *frameName = frameNames[frameID];
+
+	[self _updateSequencesForName:frameName frameID:frameID adding:NO];
+	CFDictionaryRemoveValue(frameIDs, frameName);
+
+	[frameList[frameID] release];
+	frameList[frameID] = nil;
+
+	frameNames[frameID] = nil;
+	[frameName release];
 }
 
 /**
  * Returns the frame associated with the given name.
  * returns `nil` if the given name isn't associated with
  * any frame.
+ *
+ * @see frameWithID:
  */
 - (PXAtlasFrame *)frameWithName:(NSString *)name
 {
-	return (PXAtlasFrame *)[frames objectForKey:name];
+	return [self frameWithID:[self frameIDForName:name]];
+}
+
+// MARK: Frame IDs
+
+/**
+ * Returns the ID of the frame associated with the given name, or
+ * `PXTextureAtlasNoFrameID` if the name isn't associated with any frame.
+ *
+ * Every frame in the atlas has an ID, which stays the same for as long as
+ * the frame is in the atlas. Looking a frame up by its ID is as fast as
+ * reading an array, which makes it the better choice for anything done
+ * every frame, such as flipping through an animation.
+ *
+ * @see frameWithID:
+ * @see setFrameWithID:toTexture:
+ */
+- (int) frameIDForName:(NSString *)name
+{
+	const void *value;
+
+	if (!name || !CFDictionaryGetValueIfPresent(frameIDs, name, &value))
+		return PXTextureAtlasNoFrameID;
+
+	return (int)(intptr_t)value;
+}
+
+/**
+ * Returns the frame with the given ID, or `nil` if there isn't one.
+ *
+ * @see frameIDForName:
+ */
+- (PXAtlasFrame *)frameWithID:(int)frameID
+{
+	if (frameID < 0 || frameID >= frameCount)
+		return nil;
+
+	PXAtlasFrame *frame = frameList[frameID];
+
+	if (frame == nil && frameSource != nil && frameNames[frameID] != nil)
+	{
+		// Retained by the list
+		frame = [frameSource newFrameWithName:frameNames[frameID]];
+		frameList[frameID] = frame;
+	}
+
+	return frame;
+}
+
+/**
+ * Modifies the given PXTexture object to represent the frame with the given
+ * ID. If there isn't a frame with that ID, nothing happens.
+ *
+ * **Example:**
+ *	// Once
+ *	walkFrameCount = [atlas getFrameIDs:walkFrameIDs
+ *							   maxCount:32
+ *							 withPrefix:@"walk_"
+ *								 suffix:@".png"
+ *								inRange:NSMakeRange(NSNotFound, 0)];
+ *
+ *	// Every tick
+ *	[atlas setFrameWithID:walkFrameIDs[tick % walkFrameCount] toTexture:texture];
+ *
+ * @see getFrameIDs:maxCount:withPrefix:suffix:inRange:
+ */
+- (void) setFrameWithID:(int)frameID toTexture:(PXTexture *)texture
+{
+	PXAtlasFrame *frame = [self frameWithID:frameID];
+
+	if (frame != nil)
+	{
+		[frame setToTexture:texture];
+	}
+}
+
+/*
+ * Gives the frame an ID, interns its name and puts it in the sequences its
+ * name belongs to.
+ */
+- (int) _addName:(NSString *)name frame:(PXAtlasFrame *)frame
+{
+	if (frameCount >= frameCapacity)
+	{
+		frameCapacity = frameCapacity > 0 ? frameCapacity << 1 : 16;
+
+		frameNames = realloc(frameNames, sizeof(NSString *) * frameCapacity);
+		frameList = realloc(frameList, sizeof(PXAtlasFrame *) * frameCapacity);
+	}
+
+	int frameID = frameCount;
+	++frameCount;
+
+	// The dictionary and the sequences share the atlas's copy
+	name = [name copy];
+
+	frameNames[frameID] = name;
+	frameList[frameID] = [frame retain];
+
+	CFDictionarySetValue(frameIDs, name, (const void *)(intptr_t)frameID);
+	[self _updateSequencesForName:name frameID:frameID adding:YES];
+
+	return frameID;
+}
+
+// MARK: Sequences
+
+/*
+ * Adds the frame to, or removes it from, the sequences its name belongs to.
+ * A name belongs to one sequence per run of digits in it: the one made of
+ * the text before the digits and the text after them.
+ */
+- (void) _updateSequencesForName:(NSString *)name frameID:(int)frameID adding:(BOOL)adding
+{
+	NSUInteger length;
+
+	unichar buffer[PX_TEXTURE_ATLAS_NAME_BUFFER_SIZE];
+	unichar *characters = _PXTextureAtlasGetLowercaseCharacters(name, buffer, PX_TEXTURE_ATLAS_NAME_BUFFER_SIZE, &length);
+
+	_PXTextureAtlasSequenceKey key;
+
+	NSUInteger start;
+	NSUInteger end;
+	NSUInteger index;
+
+	int number;
+
+	NSMutableData *sequence;
+	_PXTextureAtlasSequenceEntry entry;
+	_PXTextureAtlasSequenceEntry *entries;
+	NSUInteger entryCount;
+
+	for (start = 0; start < length; start = end)
+	{
+		end = start + 1;
+
+		if (characters[start] < '0' || characters[start] > '9')
+			continue;
+
+		while (end < length && characters[end] >= '0' && characters[end] <= '9')
+			++end;
+
+		if (end - start > PX_TEXTURE_ATLAS_MAX_SEQUENCE_DIGITS)
+			continue;
+
+		number = 0;
+		for (index = start; index < end; ++index)
+		{
+			number = number * 10 + (characters[index] - '0');
+		}
+
+		key.prefix = characters;
+		key.prefixLength = start;
+		key.suffix = characters + end;
+		key.suffixLength = length - end;
+
+		sequence = [self _sequenceWithKey:&key create:adding];
+
+		if (!sequence)
+			continue;
+
+		entries = [sequence mutableBytes];
+		entryCount = [sequence length] / sizeof(_PXTextureAtlasSequenceEntry);
+		index = _PXTextureAtlasSequenceLowerBound(entries, entryCount, number, frameID);
+
+		if (adding)
+		{
+			entry.number = number;
+			entry.frameID = frameID;
+
+			[sequence replaceBytesInRange:NSMakeRange(index * sizeof(_PXTextureAtlasSequenceEntry), 0)
+								withBytes:&entry
+								   length:sizeof(_PXTextureAtlasSequenceEntry)];
+		}
+		else if (index < entryCount && entries[index].number == number && entries[index].frameID == frameID)
+		{
+			[sequence replaceBytesInRange:NSMakeRange(index * sizeof(_PXTextureAtlasSequenceEntry), sizeof(_PXTextureAtlasSequenceEntry))
+								withBytes:NULL
+								   length:0];
+		}
+	}
+
+	if (characters != buffer)
+	{
+		free(characters);
+	}
+}
+
+/*
+ * The sequence of frames named with the given (lowercased) prefix and suffix
+ * around their number.
+ */
+- (NSMutableData *)_sequenceWithKey:(const _PXTextureAtlasSequenceKey *)key create:(BOOL)create
+{
+	NSMutableData *sequence = (NSMutableData *)CFDictionaryGetValue(sequences, key);
+
+	if (!sequence && create)
+	{
+		sequence = [[NSMutableData alloc] init];
+		CFDictionarySetValue(sequences, key, sequence);
+		[sequence release];
+	}
+
+	return sequence;
+}
+
+/*
+ * Points to the entries of the sequence which are within the (inclusive)
+ * range, without copying them.
+ *
+ * @return The amount of entries.
+ */
+- (unsigned) _getSequenceEntries:(const _PXTextureAtlasSequenceEntry **)entries
+					  withPrefix:(NSString *)prefix
+						  suffix:(NSString *)suffix
+						 inRange:(NSRange)range
+{
+	*entries = NULL;
+
+	// The prefix and suffix are compared without regard to case
+	unichar prefixBuffer[PX_TEXTURE_ATLAS_NAME_BUFFER_SIZE];
+	unichar suffixBuffer[PX_TEXTURE_ATLAS_NAME_BUFFER_SIZE];
+
+	_PXTextureAtlasSequenceKey key;
+	unichar *prefixCharacters = _PXTextureAtlasGetLowercaseCharacters(prefix, prefixBuffer, PX_TEXTURE_ATLAS_NAME_BUFFER_SIZE, &key.prefixLength);
+	unichar *suffixCharacters = _PXTextureAtlasGetLowercaseCharacters(suffix, suffixBuffer, PX_TEXTURE_ATLAS_NAME_BUFFER_SIZE, &key.suffixLength);
+
+	key.prefix = prefixCharacters;
+	key.suffix = suffixCharacters;
+
+	NSMutableData *sequence = [self _sequenceWithKey:&key create:NO];
+
+	if (prefixCharacters != prefixBuffer)
+		free(prefixCharacters);
+	if (suffixCharacters != suffixBuffer)
+		free(suffixCharacters);
+
+	if (!sequence)
+		return 0;
+
+	const _PXTextureAtlasSequenceEntry *first = [sequence bytes];
+	NSUInteger count = [sequence length] / sizeof(_PXTextureAtlasSequenceEntry);
+
+	if (range.location != NSNotFound)
+	{
+		if (range.location > PX_TEXTURE_ATLAS_MAX_SEQUENCE_NUMBER)
+			return 0;
+
+		NSUInteger startIndex = _PXTextureAtlasSequenceLowerBound(first, count, (int)range.location, INT_MIN);
+		NSUInteger endIndex = count;
+
+		if (range.length < PX_TEXTURE_ATLAS_MAX_SEQUENCE_NUMBER - range.location)
+		{
+			endIndex = _PXTextureAtlasSequenceLowerBound(first, count, (int)(range.location + range.length) + 1, INT_MIN);
+		}
+
+		first += startIndex;
+		count = endIndex - startIndex;
+	}
+
+	*entries = first;
+	return (unsigned)count;
+}
+
+// MARK: Frame source
+
+/*
+ * Lets the atlas create the frames of the given source as they're asked for,
+ * rather than holding all of them from the start. Their names (and IDs) are
+ * known right away. Frames added to the atlas take the place of the ones in
+ * the source with the same name.
+ */
+- (void) _setFrameSource:(id<PXTextureAtlasFrameSource>)_frameSource
+{
+	[_frameSource retain];
+	[frameSource release];
+	frameSource = _frameSource;
+
+	for (NSString *name in [frameSource frameNames])
+	{
+		if ([self frameIDForName:name] != PXTextureAtlasNoFrameID)
+			continue;
+
+		[self _addName:name frame:nil];
+	}
+}
+
+/*
+ * Creates every frame the source has yet to create, and lets go of it. Used
+ * by the methods which need all of the frames.
+ */
+- (void) _buildAllFrames
+{
+	if (!frameSource)
+		return;
+
+	int frameID;
+
+	for (frameID = 0; frameID < frameCount; ++frameID)
+	{
+		[self frameWithID:frameID];
+	}
+
+	[frameSource release];
+	frameSource = nil;
 }
 
 // MARK: Utility
@@ -480,20 +1026,6 @@
 
 @end
 
-// Used in the sequentialFramesWithPrefix:suffix:inRange method
-NSInteger pxAtlasFrameSorter(NSDictionary *frameA, NSDictionary *frameB, void *context)
-{
-	int indexA = [((NSNumber *)[frameA objectForKey:@"index"]) intValue];
-	int indexB = [((NSNumber *)[frameB objectForKey:@"index"]) intValue];
-
-	if (indexA > indexB)
-		return 1;
-	if (indexA < indexB)
-		return -1;
-
-	return 0;
-}
-
 @implementation PXTextureAtlas (Utils)
 
 /**
@@ -547,16 +1079,24 @@ NSInteger pxAtlasFrameSorter(NSDictionary *frameA, NSDictionary *frameB, void *c
 
 	NSMutableArray *array = [[NSMutableArray alloc] init];
 	PXAtlasFrame *frame;
+	NSString *frameName;
 
-	for (NSString *frameName in frames)
+	int frameID;
+
+	for (frameID = 0; frameID < frameCount; ++frameID)
 	{
+		frameName = frameNames[frameID];
+
+		if (frameName == nil)
+			continue;
+
 		matcher.input = frameName;
 		matched = [matcher next];
 
 		if (matched == NO)
 			continue;
 
-		frame = [self frameWithName:frameName];
+		frame = [self frameWithID:frameID];
 
 		// Just to be extra cautious:
 		if (frame == nil)
@@ -565,6 +1105,8 @@ NSInteger pxAtlasFrameSorter(NSDictionary *frameA, NSDictionary *frameB, void *c
 		[array addObject:frame];
 	}
 
+	[matcher release];
+
 	return [array autorelease];
 }
 
@@ -581,7 +1123,11 @@ NSInteger pxAtlasFrameSorter(NSDictionary *frameA, NSDictionary *frameB, void *c
  * numerical value between the `prefix` and `suffix`. If
  * the numerical value has any leading zeros they are safely ignored;
  * only the underlying integer value is used when sorting the list. Note
- * that this method assumes the numerical value is always an integer.
+ * that this method assumes the numerical value is always a whole run of
+ * (at most 9) digits, without a sign.
+ *
+ * The frames are indexed by prefix and suffix as they're added, so this
+ * doesn't look at the names of any other frames.
  *
  * @param prefix The string to the left of the numerical value in the
  * frame's name.
@@ -595,118 +1141,55 @@ NSInteger pxAtlasFrameSorter(NSDictionary *frameA, NSDictionary *frameB, void *c
  * and `suffix` provided. The list is sorted according to the numerical value
  * between the `prefix` and `suffix`. If no frame's name matches the pattern,
  * an empty list is returned.
+ *
+ * @see getFrameIDs:maxCount:withPrefix:suffix:inRange:
  */
 - (NSArray *)sequentialFramesWithPrefix:(NSString *)prefix suffix:(NSString *)suffix inRange:(NSRange)inRange
 {
-	BOOL checkRange = (inRange.location != NSNotFound);
+	const _PXTextureAtlasSequenceEntry *entry = NULL;
+	unsigned count = [self _getSequenceEntries:&entry withPrefix:prefix suffix:suffix inRange:inRange];
 
-	NSString *frameName;
+	NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:count];
 	PXAtlasFrame *frame;
 
-	NSRange range;
-
-	int numberStartIndex, numberEndIndex;
-	int frameNameLength;
-
-	NSString *numberString;
-	int frameIndex;
-
-	// For keeping the results
-	NSDictionary *dictionary;
-	NSNumber *frameIndexNumber;
-	NSMutableArray *arrayOfDicts = [[NSMutableArray alloc] init];
-
-	for (frameName in frames)
+	for (; count > 0; --count, ++entry)
 	{
-		// Find the location of the index string, if any.
-		if (prefix != nil)
-		{
-			range = [frameName rangeOfString:prefix options:(NSCaseInsensitiveSearch)];
-
-			if (range.location == NSNotFound)
-				continue;
-			if (range.location != 0)
-				continue;
-
-			numberStartIndex = range.location + range.length;
-		}
-		else
-		{
-			numberStartIndex = 0;
-		}
-
-		frameNameLength = [frameName length];
-
-		if (suffix != nil)
-		{
-			range = [frameName rangeOfString:suffix options:(NSCaseInsensitiveSearch | NSBackwardsSearch)];
+		frame = [self frameWithID:entry->frameID];
 
-			if (range.location == NSNotFound)
-				continue;
-			if (range.location + range.length != frameNameLength)
-				continue;
-
-			numberEndIndex = range.location;
-		}
-		else
-		{
-			numberEndIndex = frameNameLength;
-		}
-
-		// Get the index string given its location
-
-		range.location = numberStartIndex;
-		range.length = numberEndIndex - numberStartIndex;
-		numberString = [frameName substringWithRange:range];
-
-		// Convert the string to a number we can use
-
-		frameIndex = [numberString intValue];
-
-		if (frameIndex == 0 && ([numberString isEqualToString:@"0"] == NO || [numberString isEqualToString:@"-0"] == NO))
-		{
-			// Invalid number
-			continue;
-		}
-
-		// Check if the index is in range (inclusive)
-		if (checkRange && (frameIndex < inRange.location || frameIndex  > (inRange.location + inRange.length)))
+		if (frame != nil)
 		{
-			continue;
+			[array addObject:frame];
 		}
-
-		frame = [self frameWithName:frameName];
-
-		if (frame == nil)
-			continue;
-
-		// Found the frame. We wrap the frame inside a dictionary, along with its index.
-		// Then we add it to a list, which will be sorter at the end.
-
-		frameIndexNumber = [[NSNumber alloc] initWithInt:frameIndex];
-		dictionary = [[NSDictionary alloc] initWithObjectsAndKeys:frame, @"frame", frameIndexNumber, @"index", nil];
-
-		[arrayOfDicts addObject:dictionary];
-
-		[frameIndexNumber release];
-		[dictionary release];
 	}
 
-	// Sort the frame wrappers.
-	[arrayOfDicts sortUsingFunction:pxAtlasFrameSorter context:nil];
+	return [array autorelease];
+}
 
-	// Extract all the frames out of the sorted array of dictionaries
-	NSMutableArray *array = [[NSMutableArray alloc] init];
+/**
+ * Finds the IDs of the same frames, in the same order, as
+ * #sequentialFramesWithPrefix:suffix:inRange: does, without creating any
+ * objects.
+ *
+ * @param frameIDs The list to fill in with the IDs.
+ * @param maxCount The amount of IDs that fit in `frameIDs`.
+ *
+ * @return The amount of frames found, which may be more than `maxCount`.
+ *
+ * @see setFrameWithID:toTexture:
+ */
+- (unsigned) getFrameIDs:(int *)frameIDs maxCount:(unsigned)maxCount withPrefix:(NSString *)prefix suffix:(NSString *)suffix inRange:(NSRange)range
+{
+	const _PXTextureAtlasSequenceEntry *entries = NULL;
+	unsigned count = [self _getSequenceEntries:&entries withPrefix:prefix suffix:suffix inRange:range];
+
+	unsigned index;
 
-	for (dictionary in arrayOfDicts)
+	for (index = 0; index < count && index < maxCount; ++index)
 	{
-		//NSLog(@"%@", [dictionary objectForKey:@"index"]);
-		[array addObject:[dictionary objectForKey:@"frame"]];
+		frameIDs[index] = entries[index].frameID;
 	}
 
-	[arrayOfDicts release];
-
-	return [array autorelease];
+	return count;
 }
 
 @end
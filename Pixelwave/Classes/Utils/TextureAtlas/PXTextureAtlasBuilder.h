@@ -0,0 +1,111 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+@class PXTextureAtlas;
+@class PXTextureData;
+@class PXAtlasFrame;
+
+@interface PXTextureAtlasBuilder : NSObject
+{
+@private
+	PXTextureAtlas *textureAtlas;
+
+	// _PXTextureAtlasBuilderPage array
+	void *vPages;
+	unsigned pageCount;
+
+	unsigned maxPageWidth;
+	unsigned maxPageHeight;
+	float contentScaleFactor;
+
+	unsigned padding;
+	BOOL allowRotation;
+}
+
+/**
+ * The texture atlas which all of the added images are placed into.
+ */
+@property (nonatomic, readonly) PXTextureAtlas *textureAtlas;
+/**
+ * The pages (PXTextureData objects) the added images have been copied into,
+ * in the order they were created.
+ */
+@property (nonatomic, readonly) NSArray *textureDatas;
+/**
+ * The largest width a page can grow to, in pixels.
+ */
+@property (nonatomic, readonly) unsigned maxPageWidth;
+/**
+ * The largest height a page can grow to, in pixels.
+ */
+@property (nonatomic, readonly) unsigned maxPageHeight;
+/**
+ * The content scale factor of the pages.
+ */
+@property (nonatomic, readonly) float contentScaleFactor;
+/**
+ * The amount of empty pixels left between images on a page.
+ *
+ * **Default:** 2
+ */
+@property (nonatomic) unsigned padding;
+/**
+ * Whether images may be turned on their side to fit a page better.
+ *
+ * **Default:** NO
+ */
+@property (nonatomic) BOOL allowRotation;
+
+- (id) initWithMaxPageWidth:(unsigned)maxPageWidth
+			  maxPageHeight:(unsigned)maxPageHeight;
+- (id) initWithMaxPageWidth:(unsigned)maxPageWidth
+			  maxPageHeight:(unsigned)maxPageHeight
+		 contentScaleFactor:(float)contentScaleFactor;
+
+- (PXAtlasFrame *)addTextureData:(PXTextureData *)textureData withName:(NSString *)name;
+- (PXAtlasFrame *)addTextureData:(PXTextureData *)textureData
+						withName:(NSString *)name
+						 anchorX:(float)anchorX
+						 anchorY:(float)anchorY;
+
++ (PXTextureAtlasBuilder *)textureAtlasBuilder;
++ (PXTextureAtlasBuilder *)textureAtlasBuilderWithMaxPageWidth:(unsigned)maxPageWidth
+												 maxPageHeight:(unsigned)maxPageHeight;
+
+@end
@@ -0,0 +1,515 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#import "PXTextureAtlasBuilder.h"
+
+#import "PXTextureAtlas.h"
+#import "PXAtlasFrame.h"
+#import "PXTextureData.h"
+#import "PXClipRect.h"
+#import "PXMatrix.h"
+#import "PXPoint.h"
+
+#import "PXEngine.h"
+#import "PXDebug.h"
+
+#import "PXExceptionUtils.h"
+#include "PXMathUtils.h"
+#include "PXPrivateUtils.h"
+#include "PXMaxRectsUtils.h"
+
+// The smallest side a new page starts out with, in pixels.
+#define PX_TEXTURE_ATLAS_BUILDER_MIN_PAGE_SIZE 64
+
+// How much a rotated image is turned within its page, matching what the
+// texture atlas parsers use for rotated frames.
+#define PX_TEXTURE_ATLAS_BUILDER_ROTATION_AMOUNT 90.0f
+
+typedef struct
+{
+	PXTextureData *textureData;
+	// Every frame placed on this page, so they can be pointed at the new
+	// texture data when the page grows.
+	NSMutableArray *frames;
+
+	PXMaxRectsBin bin;
+	// The bin reaches this far past the right and bottom of the page, so the
+	// padding after the last image in a row or column doesn't need any room.
+	unsigned binPadding;
+} _PXTextureAtlasBuilderPage;
+
+PXInline bool _PXTextureAtlasBuilderPageInsert(_PXTextureAtlasBuilderPage *page,
+												unsigned width, unsigned height,
+												unsigned padding, BOOL allowRotation,
+												PXMaxRectsRect *retRect, bool *retRotated);
+
+@interface PXTextureAtlasBuilder(Private)
+- (PXAtlasFrame *)_addTextureData:(PXTextureData *)textureData
+						 withName:(NSString *)name
+						   anchor:(PXPoint *)anchor;
+- (_PXTextureAtlasBuilderPage *)_addPageWithWidth:(unsigned)width height:(unsigned)height;
+- (BOOL) _growPage:(_PXTextureAtlasBuilderPage *)page;
+- (PXTextureData *)_newPageTextureDataWithWidth:(unsigned)width height:(unsigned)height;
+@end
+
+/**
+ * Builds a PXTextureAtlas at runtime out of loose PXTextureData objects, such
+ * as downloaded or user generated images, so that they can be drawn from a
+ * few large textures instead of one texture each.
+ *
+ * Every added image is copied into a page (a PXTextureData owned by the
+ * builder) and a matching frame is added to the #textureAtlas. Images are
+ * placed one at a time with MaxRects packing, so adding an image never moves
+ * the ones that were added before it.
+ *
+ * Pages start out small and grow one side at a time (so they don't have to be
+ * square) until they reach #maxPageWidth by #maxPageHeight, after which a new
+ * page is started. When a page grows its contents are copied into a larger
+ * texture data, and the frames on it are updated to use the new one. PXTexture
+ * objects that were already showing one of those frames keep drawing from the
+ * old texture data until the frame is set to them again.
+ *
+ * Since the images are copied by rendering them, the engine must be running
+ * when images are added. Once added, the loose texture datas aren't retained
+ * and can be released.
+ *
+ * **Example:**
+ *	PXTextureAtlasBuilder *builder = [[PXTextureAtlasBuilder alloc] initWithMaxPageWidth:1024 maxPageHeight:1024];
+ *	builder.allowRotation = YES;
+ *
+ *	[builder addTextureData:avatarTextureData withName:@"avatar"];
+ *	[builder addTextureData:badgeTextureData withName:@"badge"];
+ *
+ *	PXTexture *avatar = [builder.textureAtlas textureForFrame:@"avatar"];
+ *
+ * @see PXTextureAtlas
+ */
+@implementation PXTextureAtlasBuilder
+
+@synthesize textureAtlas;
+@synthesize maxPageWidth, maxPageHeight;
+@synthesize contentScaleFactor;
+@synthesize padding;
+@synthesize allowRotation;
+
+- (id) init
+{
+	return [self initWithMaxPageWidth:1024 maxPageHeight:1024];
+}
+
+/**
+ * Initializes a builder whose pages use the engine's content scale factor.
+ *
+ * @param maxPageWidth The largest width a page can grow to, in pixels. Rounded
+ * up to the next power of two.
+ * @param maxPageHeight The largest height a page can grow to, in pixels.
+ * Rounded up to the next power of two.
+ */
+- (id) initWithMaxPageWidth:(unsigned)_maxPageWidth
+			  maxPageHeight:(unsigned)_maxPageHeight
+{
+	return [self initWithMaxPageWidth:_maxPageWidth
+						maxPageHeight:_maxPageHeight
+				   contentScaleFactor:PXEngineGetContentScaleFactor()];
+}
+
+/**
+ * Initializes a builder with an empty texture atlas.
+ *
+ * @param maxPageWidth The largest width a page can grow to, in pixels. Rounded
+ * up to the next power of two.
+ * @param maxPageHeight The largest height a page can grow to, in pixels.
+ * Rounded up to the next power of two.
+ * @param contentScaleFactor The content scale factor of the pages. Images with
+ * a different content scale factor are scaled to match it when added.
+ */
+- (id) initWithMaxPageWidth:(unsigned)_maxPageWidth
+			  maxPageHeight:(unsigned)_maxPageHeight
+		 contentScaleFactor:(float)_contentScaleFactor
+{
+	self = [super init];
+
+	if (self)
+	{
+		if (_maxPageWidth == 0 || _maxPageHeight == 0 || _contentScaleFactor <= 0.0f)
+		{
+			PXDebugLog(@"PXTextureAtlasBuilder: Invalid page size (%u x %u) or content scale factor (%f)",
+					   _maxPageWidth, _maxPageHeight, _contentScaleFactor);
+
+			[self release];
+			return nil;
+		}
+
+		// Texture datas are always a power of two in size.
+		maxPageWidth = PXMathNextPowerOfTwo(_maxPageWidth);
+		maxPageHeight = PXMathNextPowerOfTwo(_maxPageHeight);
+		contentScaleFactor = _contentScaleFactor;
+
+		padding = 2;
+		allowRotation = NO;
+
+		textureAtlas = [[PXTextureAtlas alloc] init];
+
+		vPages = NULL;
+		pageCount = 0;
+	}
+
+	return self;
+}
+
+- (void) dealloc
+{
+	_PXTextureAtlasBuilderPage *page = (_PXTextureAtlasBuilderPage *)vPages;
+	unsigned index;
+
+	for (index = 0; index < pageCount; ++index, ++page)
+	{
+		[page->textureData release];
+		[page->frames release];
+		PXMaxRectsBinFree(&page->bin);
+	}
+
+	free(vPages);
+	vPages = NULL;
+
+	[textureAtlas release];
+	textureAtlas = nil;
+
+	[super dealloc];
+}
+
+// MARK: Properties
+
+- (NSArray *)textureDatas
+{
+	NSMutableArray *textureDatas = [NSMutableArray arrayWithCapacity:pageCount];
+
+	_PXTextureAtlasBuilderPage *page = (_PXTextureAtlasBuilderPage *)vPages;
+	unsigned index;
+
+	for (index = 0; index < pageCount; ++index, ++page)
+	{
+		[textureDatas addObject:page->textureData];
+	}
+
+	return textureDatas;
+}
+
+// MARK: Adding
+
+/**
+ * Copies the given image into one of the builder's pages and adds a frame for
+ * it to the #textureAtlas.
+ *
+ * @param textureData The image to add.
+ * @param name The name to give the frame. Replaces any frame that already has
+ * this name, though the space taken by the old image isn't reused.
+ *
+ * @return The added frame, or `nil` if the image is larger than a page.
+ */
+- (PXAtlasFrame *)addTextureData:(PXTextureData *)textureData withName:(NSString *)name
+{
+	return [self _addTextureData:textureData withName:name anchor:nil];
+}
+
+/**
+ * Copies the given image into one of the builder's pages and adds a frame for
+ * it to the #textureAtlas.
+ *
+ * @param textureData The image to add.
+ * @param name The name to give the frame. Replaces any frame that already has
+ * this name, though the space taken by the old image isn't reused.
+ * @param anchorX The anchorX value (in percent) to set for the created frame.
+ * @param anchorY The anchorY value (in percent) to set for the created frame.
+ *
+ * @return The added frame, or `nil` if the image is larger than a page.
+ */
+- (PXAtlasFrame *)addTextureData:(PXTextureData *)textureData
+						withName:(NSString *)name
+						 anchorX:(float)anchorX
+						 anchorY:(float)anchorY
+{
+	PXPoint *anchor = [[PXPoint alloc] initWithX:anchorX y:anchorY];
+	PXAtlasFrame *frame = [self _addTextureData:textureData withName:name anchor:anchor];
+	[anchor release];
+
+	return frame;
+}
+
+// MARK: Private
+
+- (PXAtlasFrame *)_addTextureData:(PXTextureData *)textureData
+						 withName:(NSString *)name
+						   anchor:(PXPoint *)anchor
+{
+	if (!textureData)
+	{
+		PXThrowNilParam(textureData);
+		return nil;
+	}
+	if (!name)
+	{
+		PXThrowNilParam(name);
+		return nil;
+	}
+
+	// Work out how big the image is once it's on a page
+	float sourceScaleFactor = textureData.contentScaleFactor;
+
+	float pointWidth  = textureData.width  / sourceScaleFactor;
+	float pointHeight = textureData.height / sourceScaleFactor;
+
+	unsigned width  = ceilf(pointWidth  * contentScaleFactor);
+	unsigned height = ceilf(pointHeight * contentScaleFactor);
+
+	BOOL fitsUnrotated = width <= maxPageWidth && height <= maxPageHeight;
+	BOOL fitsRotated = allowRotation && height <= maxPageWidth && width <= maxPageHeight;
+
+	if (width == 0 || height == 0 || !(fitsUnrotated || fitsRotated))
+	{
+		PXDebugLog(@"PXTextureAtlasBuilder: Can't add '%@' (%u x %u) to pages of %u x %u",
+				   name, width, height, maxPageWidth, maxPageHeight);
+		return nil;
+	}
+
+	PXMaxRectsRect rect;
+	bool rotated = false;
+
+	_PXTextureAtlasBuilderPage *page = NULL;
+	_PXTextureAtlasBuilderPage *currentPage = (_PXTextureAtlasBuilderPage *)vPages;
+	unsigned index;
+
+	// Try every page as it is first, to fill in any gaps left behind
+	for (index = 0; index < pageCount; ++index, ++currentPage)
+	{
+		if (_PXTextureAtlasBuilderPageInsert(currentPage, width, height, padding, allowRotation, &rect, &rotated))
+		{
+			page = currentPage;
+			break;
+		}
+	}
+
+	// Then let the newest page grow. Older pages are always at their full size.
+	if (!page && pageCount > 0)
+	{
+		currentPage = ((_PXTextureAtlasBuilderPage *)vPages) + (pageCount - 1);
+
+		while ([self _growPage:currentPage])
+		{
+			if (_PXTextureAtlasBuilderPageInsert(currentPage, width, height, padding, allowRotation, &rect, &rotated))
+			{
+				page = currentPage;
+				break;
+			}
+		}
+	}
+
+	// Finally, spill over onto a new page
+	if (!page)
+	{
+		unsigned pageWidth  = (fitsUnrotated ? width  : height) + padding;
+		unsigned pageHeight = (fitsUnrotated ? height : width)  + padding;
+
+		pageWidth  = MIN(MAX(PXMathNextPowerOfTwo(pageWidth),  PX_TEXTURE_ATLAS_BUILDER_MIN_PAGE_SIZE), maxPageWidth);
+		pageHeight = MIN(MAX(PXMathNextPowerOfTwo(pageHeight), PX_TEXTURE_ATLAS_BUILDER_MIN_PAGE_SIZE), maxPageHeight);
+
+		page = [self _addPageWithWidth:pageWidth height:pageHeight];
+
+		if (!page || !_PXTextureAtlasBuilderPageInsert(page, width, height, padding, allowRotation, &rect, &rotated))
+		{
+			PXDebugLog(@"PXTextureAtlasBuilder: Couldn't make room for '%@'", name);
+			return nil;
+		}
+	}
+
+	// Copy the image into its spot on the page. Rendering is done in points.
+	float x = rect.x / contentScaleFactor;
+	float y = rect.y / contentScaleFactor;
+
+	PXMatrix *matrix;
+	PXClipRect *clipRect;
+
+	if (rotated)
+	{
+		// Turned a quarter turn clockwise. The clip rect's rotation turns it
+		// back when the frame is drawn.
+		matrix = [[PXMatrix alloc] initWithA:0.0f b:1.0f c:-1.0f d:0.0f tx:x + pointHeight ty:y];
+		clipRect = [[PXClipRect alloc] initWithX:x
+											   y:y
+										   width:pointHeight
+										  height:pointWidth
+										rotation:PX_TEXTURE_ATLAS_BUILDER_ROTATION_AMOUNT];
+	}
+	else
+	{
+		matrix = [[PXMatrix alloc] initWithA:1.0f b:0.0f c:0.0f d:1.0f tx:x ty:y];
+		clipRect = [[PXClipRect alloc] initWithX:x
+											   y:y
+										   width:pointWidth
+										  height:pointHeight
+										rotation:0.0f];
+	}
+
+	[page->textureData drawTextureData:textureData
+								matrix:matrix
+						colorTransform:nil
+							  clipRect:nil
+							 smoothing:!PXMathIsEqual(sourceScaleFactor, contentScaleFactor)
+						  clearTexture:NO];
+
+	PXAtlasFrame *frame = [[PXAtlasFrame alloc] initWithClipRect:clipRect
+													 textureData:page->textureData
+														  anchor:anchor];
+
+	[textureAtlas addFrame:frame withName:name];
+	[page->frames addObject:frame];
+
+	[frame release];
+	[clipRect release];
+	[matrix release];
+
+	return frame;
+}
+
+- (_PXTextureAtlasBuilderPage *)_addPageWithWidth:(unsigned)width height:(unsigned)height
+{
+	_PXTextureAtlasBuilderPage *pages = realloc(vPages, sizeof(_PXTextureAtlasBuilderPage) * (pageCount + 1));
+
+	if (!pages)
+		return NULL;
+
+	vPages = pages;
+
+	_PXTextureAtlasBuilderPage *page = &(pages[pageCount]);
+
+	page->binPadding = padding;
+
+	if (!PXMaxRectsBinInit(&page->bin, width + page->binPadding, height + page->binPadding))
+	{
+		PXMaxRectsBinFree(&page->bin);
+		return NULL;
+	}
+
+	page->textureData = [self _newPageTextureDataWithWidth:width height:height];
+	page->frames = [[NSMutableArray alloc] init];
+
+	++pageCount;
+
+	return page;
+}
+
+/*
+ * Doubles the shorter side of the page, as long as it isn't already at its
+ * largest, and copies the old contents over.
+ */
+- (BOOL) _growPage:(_PXTextureAtlasBuilderPage *)page
+{
+	unsigned width  = page->bin.width  - page->binPadding;
+	unsigned height = page->bin.height - page->binPadding;
+
+	if (width >= maxPageWidth && height >= maxPageHeight)
+		return NO;
+
+	if (height >= maxPageHeight || (width <= height && width < maxPageWidth))
+		width = MIN(width * 2, maxPageWidth);
+	else
+		height = MIN(height * 2, maxPageHeight);
+
+	if (!PXMaxRectsBinGrow(&page->bin, width + page->binPadding, height + page->binPadding))
+		return NO;
+
+	PXTextureData *textureData = [self _newPageTextureDataWithWidth:width height:height];
+
+	[textureData drawTextureData:page->textureData
+						  matrix:nil
+				  colorTransform:nil
+						clipRect:nil
+					   smoothing:NO
+					clearTexture:NO];
+
+	for (PXAtlasFrame *frame in page->frames)
+	{
+		frame.textureData = textureData;
+	}
+
+	[page->textureData release];
+	page->textureData = textureData;
+
+	return YES;
+}
+
+- (PXTextureData *)_newPageTextureDataWithWidth:(unsigned)width height:(unsigned)height
+{
+	return [[PXTextureData alloc] initWithWidth:width
+										 height:height
+								   transparency:YES
+									  fillColor:0x00000000
+							 contentScaleFactor:contentScaleFactor];
+}
+
+// MARK: Creation methods
+
++ (PXTextureAtlasBuilder *)textureAtlasBuilder
+{
+	return [[[PXTextureAtlasBuilder alloc] init] autorelease];
+}
+
++ (PXTextureAtlasBuilder *)textureAtlasBuilderWithMaxPageWidth:(unsigned)maxPageWidth
+												 maxPageHeight:(unsigned)maxPageHeight
+{
+	return [[[PXTextureAtlasBuilder alloc] initWithMaxPageWidth:maxPageWidth
+												  maxPageHeight:maxPageHeight] autorelease];
+}
+
+@end
+
+/*
+ * Each image takes up its size plus the padding on the page's bin. Since the
+ * bin reaches `binPadding` past the page, the padding used can't be any less
+ * than that or the image could hang off the edge of the page.
+ */
+PXInline bool _PXTextureAtlasBuilderPageInsert(_PXTextureAtlasBuilderPage *page,
+												unsigned width, unsigned height,
+												unsigned padding, BOOL allowRotation,
+												PXMaxRectsRect *retRect, bool *retRotated)
+{
+	padding = MAX(padding, page->binPadding);
+
+	return PXMaxRectsBinInsert(&page->bin, width + padding, height + padding, allowRotation, retRect, retRotated);
+}
@@ -91,6 +91,7 @@ extern "C" {
 #import "PXClipRect.h"
 #import "PXTexturePadding.h"
 #import "PXTextureData.h"
+#import "PXTextureMemory.h"
 #import "PXSimpleButton.h"
 
 // Events
@@ -98,6 +99,7 @@ extern "C" {
 #import "PXEvent.h"
 #import "PXTouchEvent.h"
 #import "PXStageOrientationEvent.h"
+#import "PXTextureMemoryEvent.h"
 
 // Geometry
 #import "PXTransform.h"
@@ -124,11 +126,13 @@ extern "C" {
 #import "PXTextureLoader.h"
 #import "PXSoundLoader.h"
 #import "PXFontLoader.h"
+#import "PXAssetCache.h"
 
 // Utils
 
 // - TextureAtlas
 #import "PXTextureAtlas.h"
+#import "PXTextureAtlasBuilder.h"
 #import "PXAtlasFrame.h"
 
 // - Modifiers
@@ -136,6 +140,7 @@ extern "C" {
 #import "PXTextureModifier.h"
 #import "PXSoundModifiers.h"
 #import "PXTextureModifiers.h"
+#import "PXTextureDither.h"
 
 // - Regex
 #import "PXRegexMatcher.h"
@@ -0,0 +1,210 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+
+#import "BenchmarksRoot.h"
+
+#import "PXTimeUtils.h"
+
+// How many sprites deep the touch target sits
+#define BENCHMARKS_TOUCH_DEPTH 20
+// How many times each touch is dispatched
+#define BENCHMARKS_TOUCH_COUNT 10000
+// How many times the label's text is set
+#define BENCHMARKS_TEXT_COUNT 1000
+
+@interface BenchmarksRoot(Private)
+- (void) runTouchBenchmarks;
+- (void) testTouch:(NSString *)name event:(PXTouchEvent *)event target:(PXDisplayObject *)target;
+- (void) runTextBenchmarks;
+- (void) reportTest:(NSString *)name seconds:(double)seconds count:(unsigned)count;
+- (void) onTouch:(PXTouchEvent *)event;
+@end
+
+/*
+ * Every test runs once, as soon as the app has started. Each result is logged
+ * to the console and shown on the screen as it finishes. Run a release build
+ * on a device for numbers worth comparing.
+ */
+@implementation BenchmarksRoot
+
+- (void) initializeAsRoot
+{
+	[self runTouchBenchmarks];
+	[self runTextBenchmarks];
+}
+
+// MARK: Touch dispatch
+
+- (void) runTouchBenchmarks
+{
+	PXSprite *sprites[BENCHMARKS_TOUCH_DEPTH];
+	unsigned index;
+
+	// A chain of sprites, with the target of the touch at the bottom. It is
+	// never added to the stage, as the event flow only needs the parents.
+	for (index = 0; index < BENCHMARKS_TOUCH_DEPTH; ++index)
+	{
+		sprites[index] = [[PXSprite alloc] init];
+
+		if (index > 0)
+		{
+			[sprites[index - 1] addChild:sprites[index]];
+			[sprites[index] release];
+		}
+	}
+
+	PXSprite *top = sprites[0];
+	PXSprite *target = sprites[BENCHMARKS_TOUCH_DEPTH - 1];
+
+	// A move event is used, as down and up events also make the target keep
+	// track of the touch.
+	PXTouchEvent *event = [[PXTouchEvent alloc] initWithType:PXTouchEvent_TouchMove
+												 nativeTouch:nil
+													  stageX:0.0f
+													  stageY:0.0f
+													tapCount:1];
+
+	[self testTouch:@"touch, no listeners" event:event target:target];
+
+	[target addEventListenerOfType:PXTouchEvent_TouchMove listener:PXListener(onTouch:)];
+	[self testTouch:@"touch, target listens" event:event target:target];
+
+	for (index = 0; index < BENCHMARKS_TOUCH_DEPTH - 1; ++index)
+	{
+		[sprites[index] addEventListenerOfType:PXTouchEvent_TouchMove listener:PXListener(onTouch:)];
+	}
+	[self testTouch:@"touch, all bubble" event:event target:target];
+
+	for (index = 0; index < BENCHMARKS_TOUCH_DEPTH - 1; ++index)
+	{
+		[sprites[index] addEventListenerOfType:PXTouchEvent_TouchMove
+									  listener:PXListener(onTouch:)
+									useCapture:YES
+									  priority:0];
+	}
+	[self testTouch:@"touch, all capture and bubble" event:event target:target];
+
+	[event release];
+	[top release];
+}
+
+- (void) testTouch:(NSString *)name event:(PXTouchEvent *)event target:(PXDisplayObject *)target
+{
+	unsigned index;
+
+	// Dispatch it once before timing, so the flow's lists are already made.
+	[target dispatchEvent:event];
+
+	listenerCalls = 0;
+	uint64_t start = PXTimeGetTicks();
+
+	for (index = 0; index < BENCHMARKS_TOUCH_COUNT; ++index)
+	{
+		[target dispatchEvent:event];
+	}
+
+	double seconds = PXTimeTicksToSeconds(PXTimeGetTicks() - start);
+
+	NSString *testName = [NSString stringWithFormat:@"%@ (%u calls)", name, listenerCalls / BENCHMARKS_TOUCH_COUNT];
+	[self reportTest:testName seconds:seconds count:BENCHMARKS_TOUCH_COUNT];
+}
+
+- (void) onTouch:(PXTouchEvent *)event
+{
+	++listenerCalls;
+}
+
+// MARK: Text
+
+- (void) runTextBenchmarks
+{
+	PXFontOptions *fontOptions = [PXTextureFontOptions textureFontOptionsWithSize:20.0f
+																	characterSets:PXFontCharacterSet_AllLetters | PXFontCharacterSet_Numerals
+																specialCharacters:@" :."];
+
+	PXFont *font = [PXFont fontWithSystemFont:@"Helvetica" options:fontOptions];
+	[PXFont registerFont:font withName:@"benchmarksFont"];
+
+	PXTextField *label = [[PXTextField alloc] initWithFont:@"benchmarksFont"];
+
+	// Two labels of 32 characters, switched between so that every set has
+	// to lay the text out again, as a score or timer changing each frame does.
+	NSString *texts[2] = {@"Score: 00123456 Time: 01:23.4567", @"Score: 00123457 Time: 01:23.4568"};
+	unsigned index;
+
+	label.text = texts[1];
+	[label width];
+
+	uint64_t start = PXTimeGetTicks();
+
+	for (index = 0; index < BENCHMARKS_TEXT_COUNT; ++index)
+	{
+		label.text = texts[index & 1];
+
+		// Asking for the size makes the label validate the new text, the
+		// same as drawing it would.
+		[label width];
+	}
+
+	double seconds = PXTimeTicksToSeconds(PXTimeGetTicks() - start);
+	[self reportTest:@"setText, 32 characters" seconds:seconds count:BENCHMARKS_TEXT_COUNT];
+
+	[label release];
+	[PXFont unregisterFontWithName:@"benchmarksFont"];
+}
+
+// MARK: Results
+
+- (void) reportTest:(NSString *)name seconds:(double)seconds count:(unsigned)count
+{
+	NSString *line = [NSString stringWithFormat:@"%@: %.2f us", name, (seconds * 1000000.0) / count];
+
+	NSLog(@"%@", line);
+
+	PXTextField *txtResult = [[PXTextField alloc] init];
+	txtResult.text = line;
+	txtResult.fontSize = 14.0f;
+	txtResult.x = 10.0f;
+	txtResult.y = 10.0f + resultCount * 20.0f;
+	[self addChild:txtResult];
+	[txtResult release];
+
+	++resultCount;
+}
+
+@end
@@ -0,0 +1,398 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * pxadpcm - Encodes 16 bit sounds with PXADPCMUtils, the same way
+ * PXSoundLoader does, decodes them again and compares the result with the
+ * source. Also checks that decoding from any frame, as the sound channels do
+ * while streaming, gives the same samples as decoding everything at once.
+ *
+ * Usage: pxadpcm [input.wav ...]
+ *
+ * Without any input, a set of generated test signals is used.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "PXADPCMUtils.h"
+
+typedef struct
+{
+	int16_t *samples;
+	unsigned frameCount;
+	unsigned channelCount;
+} PXADPCMToolSound;
+
+typedef struct
+{
+	int32_t maxError;
+	double rmsError;
+} PXADPCMToolError;
+
+typedef enum
+{
+	PXADPCMToolSignal_Silence = 0,
+	PXADPCMToolSignal_Sine,
+	PXADPCMToolSignal_Sweep,
+	PXADPCMToolSignal_Square,
+	PXADPCMToolSignal_Noise,
+	PXADPCMToolSignal_StereoSine,
+
+	PXADPCMToolSignal_Count
+} PXADPCMToolSignal;
+
+static const char *pxADPCMToolSignalNames[PXADPCMToolSignal_Count] =
+{
+	"silence",
+	"sine 440hz",
+	"sweep 20hz-20khz",
+	"square 100hz",
+	"white noise",
+	"stereo sine"
+};
+
+#define PX_ADPCM_TOOL_SAMPLE_RATE 44100
+
+static bool PXADPCMToolSoundInit(PXADPCMToolSound *sound, unsigned frameCount, unsigned channelCount)
+{
+	sound->samples = calloc(frameCount * channelCount, sizeof(int16_t));
+	sound->frameCount = frameCount;
+	sound->channelCount = channelCount;
+
+	return sound->samples != NULL;
+}
+
+PXInline uint16_t PXADPCMToolRead16(const uint8_t *bytes)
+{
+	return bytes[0] | (bytes[1] << 8);
+}
+
+PXInline uint32_t PXADPCMToolRead32(const uint8_t *bytes)
+{
+	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)(bytes[3]) << 24);
+}
+
+/*
+ * Reads a mono or stereo, 16 bit PCM wav file.
+ */
+static bool PXADPCMToolReadWAV(const char *path, PXADPCMToolSound *sound)
+{
+	FILE *file = fopen(path, "rb");
+
+	if (!file)
+	{
+		fprintf(stderr, "pxadpcm: Couldn't open %s\n", path);
+		return false;
+	}
+
+	fseek(file, 0, SEEK_END);
+	long byteCount = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	uint8_t *bytes = malloc(byteCount > 0 ? byteCount : 1);
+	bool success = bytes && byteCount >= 12 && fread(bytes, 1, byteCount, file) == (size_t)byteCount;
+
+	fclose(file);
+
+	if (!success || memcmp(bytes, "RIFF", 4) != 0 || memcmp(bytes + 8, "WAVE", 4) != 0)
+	{
+		fprintf(stderr, "pxadpcm: %s isn't a wav file\n", path);
+		free(bytes);
+		return false;
+	}
+
+	unsigned channelCount = 0;
+	unsigned bitsPerSample = 0;
+	unsigned format = 0;
+	long offset = 12;
+
+	success = false;
+
+	while (offset + 8 <= byteCount)
+	{
+		uint32_t chunkByteCount = PXADPCMToolRead32(bytes + offset + 4);
+		const uint8_t *chunk = bytes + offset + 8;
+
+		if (chunkByteCount > byteCount - offset - 8)
+			break;
+
+		if (memcmp(bytes + offset, "fmt ", 4) == 0 && chunkByteCount >= 16)
+		{
+			format = PXADPCMToolRead16(chunk);
+			channelCount = PXADPCMToolRead16(chunk + 2);
+			bitsPerSample = PXADPCMToolRead16(chunk + 14);
+		}
+		else if (memcmp(bytes + offset, "data", 4) == 0)
+		{
+			if (format != 1 || bitsPerSample != 16 || channelCount < 1 || channelCount > 2)
+			{
+				fprintf(stderr, "pxadpcm: %s must be 16 bit PCM, mono or stereo\n", path);
+				break;
+			}
+
+			unsigned frameCount = chunkByteCount / (channelCount * 2);
+
+			if (!PXADPCMToolSoundInit(sound, frameCount, channelCount))
+				break;
+
+			unsigned index;
+			for (index = 0; index < frameCount * channelCount; ++index)
+			{
+				sound->samples[index] = (int16_t)PXADPCMToolRead16(chunk + (index << 1));
+			}
+
+			success = true;
+			break;
+		}
+
+		offset += 8 + ((chunkByteCount + 1) & ~1);
+	}
+
+	if (!success && !sound->samples)
+		fprintf(stderr, "pxadpcm: Couldn't read the samples of %s\n", path);
+
+	free(bytes);
+
+	return success;
+}
+
+/*
+ * Fills a sound with two seconds of a test signal.
+ */
+static bool PXADPCMToolMakeSignal(PXADPCMToolSignal signal, PXADPCMToolSound *sound)
+{
+	unsigned channelCount = (signal == PXADPCMToolSignal_StereoSine) ? 2 : 1;
+	unsigned frameCount = PX_ADPCM_TOOL_SAMPLE_RATE * 2;
+
+	if (!PXADPCMToolSoundInit(sound, frameCount, channelCount))
+		return false;
+
+	// A fixed seed, so every run measures the same thing
+	srand(1);
+
+	double duration = (double)frameCount / PX_ADPCM_TOOL_SAMPLE_RATE;
+	unsigned index;
+
+	for (index = 0; index < frameCount; ++index)
+	{
+		double time = (double)index / PX_ADPCM_TOOL_SAMPLE_RATE;
+		double value = 0.0;
+
+		switch (signal)
+		{
+			case PXADPCMToolSignal_Sine:
+			case PXADPCMToolSignal_StereoSine:
+				value = sin(2.0 * M_PI * 440.0 * time);
+				break;
+			case PXADPCMToolSignal_Sweep:
+				// Exponential, so each octave gets as long as the others
+				value = sin(2.0 * M_PI * 20.0 * duration / log(1000.0) * (pow(1000.0, time / duration) - 1.0));
+				break;
+			case PXADPCMToolSignal_Square:
+				value = (fmod(time * 100.0, 1.0) < 0.5) ? 1.0 : -1.0;
+				break;
+			case PXADPCMToolSignal_Noise:
+				value = ((double)rand() / RAND_MAX) * 2.0 - 1.0;
+				break;
+			default:
+				break;
+		}
+
+		sound->samples[index * channelCount] = (int16_t)(value * 0.8 * INT16_MAX);
+
+		if (channelCount == 2)
+		{
+			// Out of phase with the left channel
+			sound->samples[index * channelCount + 1] = -sound->samples[index * channelCount];
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Compares the decoded samples against the ones they were encoded from.
+ */
+static PXADPCMToolError PXADPCMToolMeasureError(const int16_t *decoded, const int16_t *samples, unsigned sampleCount)
+{
+	PXADPCMToolError error = {0, 0.0};
+	double sumOfSquares = 0.0;
+
+	unsigned index;
+	int32_t diff;
+
+	for (index = 0; index < sampleCount; ++index)
+	{
+		diff = abs((int32_t)(decoded[index]) - (int32_t)(samples[index]));
+
+		if (diff > error.maxError)
+			error.maxError = diff;
+
+		sumOfSquares += (double)diff * (double)diff;
+	}
+
+	if (sampleCount > 0)
+		error.rmsError = sqrt(sumOfSquares / sampleCount);
+
+	return error;
+}
+
+/*
+ * Decodes in uneven pieces that start in the middle of blocks and cross their
+ * boundaries, and checks the result against the straight decode. Returns the
+ * first frame that differs, or frameCount if none does.
+ */
+static unsigned PXADPCMToolCheckSeeking(const uint8_t *bytes, const int16_t *decoded, unsigned frameCount, unsigned channelCount)
+{
+	int16_t *piece = malloc(sizeof(int16_t) * PX_ADPCM_BLOCK_FRAMES * 3 * channelCount);
+	unsigned firstFrame = 0;
+	unsigned count = 1;
+
+	while (firstFrame < frameCount)
+	{
+		if (count > frameCount - firstFrame)
+			count = frameCount - firstFrame;
+
+		PXADPCMDecode(bytes, channelCount, firstFrame, count, piece);
+
+		if (memcmp(piece, decoded + firstFrame * channelCount, sizeof(int16_t) * count * channelCount) != 0)
+			break;
+
+		firstFrame += count;
+		// Pieces from a single frame up to almost three blocks
+		count = (count * 7 + 13) % (PX_ADPCM_BLOCK_FRAMES * 3) + 1;
+	}
+
+	free(piece);
+
+	return firstFrame;
+}
+
+/*
+ * Runs a sound through the codec and prints how far the result is from it.
+ * Returns false if decoding from the middle of the sound didn't match.
+ */
+static bool PXADPCMToolTest(const char *name, const PXADPCMToolSound *sound)
+{
+	unsigned byteCount = PXADPCMGetByteCount(sound->frameCount, sound->channelCount);
+	unsigned sampleCount = sound->frameCount * sound->channelCount;
+
+	uint8_t *bytes = malloc(byteCount > 0 ? byteCount : 1);
+	int16_t *decoded = malloc(sizeof(int16_t) * (sampleCount > 0 ? sampleCount : 1));
+
+	if (!bytes || !decoded)
+	{
+		free(bytes);
+		free(decoded);
+
+		fprintf(stderr, "pxadpcm: Out of memory\n");
+		return false;
+	}
+
+	PXADPCMEncode(sound->samples, sound->frameCount, sound->channelCount, bytes);
+	PXADPCMDecode(bytes, sound->channelCount, 0, sound->frameCount, decoded);
+
+	PXADPCMToolError error = PXADPCMToolMeasureError(decoded, sound->samples, sampleCount);
+	unsigned mismatch = PXADPCMToolCheckSeeking(bytes, decoded, sound->frameCount, sound->channelCount);
+
+	// Signal to noise ratio against a full scale sine
+	double snr = (error.rmsError > 0.0) ? 20.0 * log10((INT16_MAX / sqrt(2.0)) / error.rmsError) : INFINITY;
+
+	printf("%-24s %8u %2u %8d %10.2f %8.1f db  %s\n",
+	       name,
+	       sound->frameCount,
+	       sound->channelCount,
+	       error.maxError,
+	       error.rmsError,
+	       snr,
+	       (mismatch == sound->frameCount) ? "ok" : "SEEK MISMATCH");
+
+	if (mismatch != sound->frameCount)
+		fprintf(stderr, "pxadpcm: Decoding %s from frame %u doesn't match\n", name, mismatch);
+
+	free(bytes);
+	free(decoded);
+
+	return mismatch == sound->frameCount;
+}
+
+int main(int argc, char **argv)
+{
+	bool success = true;
+	PXADPCMToolSound sound;
+	int index;
+
+	printf("%-24s %8s %2s %8s %10s %11s  %s\n", "sound", "frames", "ch", "max err", "rms err", "snr", "seeking");
+
+	if (argc < 2)
+	{
+		PXADPCMToolSignal signal;
+
+		for (signal = 0; signal < PXADPCMToolSignal_Count; ++signal)
+		{
+			memset(&sound, 0, sizeof(PXADPCMToolSound));
+
+			if (!PXADPCMToolMakeSignal(signal, &sound))
+				return 1;
+
+			success = PXADPCMToolTest(pxADPCMToolSignalNames[signal], &sound) && success;
+			free(sound.samples);
+		}
+	}
+
+	for (index = 1; index < argc; ++index)
+	{
+		memset(&sound, 0, sizeof(PXADPCMToolSound));
+
+		if (!PXADPCMToolReadWAV(argv[index], &sound))
+		{
+			free(sound.samples);
+			success = false;
+			continue;
+		}
+
+		success = PXADPCMToolTest(argv[index], &sound) && success;
+		free(sound.samples);
+	}
+
+	return success ? 0 : 1;
+}
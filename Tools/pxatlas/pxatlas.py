@@ -0,0 +1,321 @@
+#!/usr/bin/env python3
+#
+# Converts TexturePacker (.json) and Zwoptex (.plist) atlases to the binary
+# atlas format (.pxa) read by PXBinaryAtlasParser. The layout is described in
+# Pixelwave/Classes/Support/Utils/PXBinaryAtlasUtils.h, which this has to be
+# kept in sync with.
+#
+# The frames come out exactly as PXTPAtlasParser and PXZwopAtlasParser would
+# read them, in pixels. The content scale factor is applied when the atlas is
+# loaded, so Atlas@2x.json converts to Atlas@2x.pxa like any other file.
+
+import argparse
+import json
+import os
+import plistlib
+import re
+import struct
+import sys
+
+MAGIC = b'PXAT'
+VERSION = 1
+
+# PXBinaryAtlasHeader and PXBinaryAtlasFrame
+HEADER = struct.Struct('<4sHH8I')
+FRAME = struct.Struct('<IIHHHH11f')
+
+FLAG_PADDING = 0x0001
+FLAG_ANCHOR = 0x0002
+
+# How much both tools rotate the image when they say 'rotated'
+ROTATION_AMOUNT = 90.0
+
+ZWOP_SIZE = re.compile(r'\{\s*([0-9-]+)\s*,\s*([0-9-]+)\s*\}')
+ZWOP_RECT = re.compile(r'\{\s*\{\s*([0-9-]+)\s*,\s*([0-9-]+)\s*\}\s*,\s*\{\s*([0-9-]+)\s*,\s*([0-9-]+)\s*\}\s*\}')
+
+
+class AtlasError(Exception):
+    pass
+
+
+class Frame(object):
+    def __init__(self, name, rect, rotated, padding=None, anchor=None):
+        self.name = name
+        self.rect = rect
+        self.rotation = ROTATION_AMOUNT if rotated else 0.0
+        self.padding = padding
+        self.anchor = anchor
+
+
+def fnv1a(data):
+    """Must match PXBinaryAtlasHash."""
+    h = 2166136261
+    for byte in bytearray(data):
+        h ^= byte
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def trim_padding(color_rect, source_size):
+    """Top, right, bottom and left, from where the trimmed image sits within
+    the original one."""
+    x, y, w, h = color_rect
+    sw, sh = source_size
+    return (y, sw - (x + w), sh - (y + h), x)
+
+
+# TexturePacker
+
+def tp_int(d, key, name):
+    value = d.get(key)
+    if isinstance(value, bool) or not isinstance(value, (int, float)):
+        raise AtlasError('frame "%s": "%s" is missing or not a number' % (name, key))
+    return int(value)
+
+
+def tp_rect(d, key, name):
+    value = d.get(key)
+    if not isinstance(value, dict):
+        raise AtlasError('frame "%s": "%s" is missing' % (name, key))
+    return tuple(tp_int(value, k, name) for k in ('x', 'y', 'w', 'h'))
+
+
+def tp_size(d, key, name):
+    value = d.get(key)
+    if not isinstance(value, dict):
+        raise AtlasError('frame "%s": "%s" is missing' % (name, key))
+    return tuple(tp_int(value, k, name) for k in ('w', 'h'))
+
+
+def tp_bool(d, key, name):
+    value = d.get(key)
+    if not isinstance(value, (bool, int)):
+        raise AtlasError('frame "%s": "%s" is missing' % (name, key))
+    return bool(value)
+
+
+def read_texturepacker(path, pivots):
+    with open(path, 'rb') as f:
+        doc = json.loads(f.read().decode('utf-8'))
+
+    frames = doc.get('frames') if isinstance(doc, dict) else None
+
+    # The hash flavor is what PXTPAtlasParser reads, the array one only
+    # moves the name into the frame.
+    if isinstance(frames, list):
+        items = [(f.get('filename'), f) for f in frames]
+    elif isinstance(frames, dict):
+        items = list(frames.items())
+    else:
+        raise AtlasError('no "frames" in %s' % path)
+
+    result = []
+
+    for name, d in items:
+        if not isinstance(name, str) or not isinstance(d, dict):
+            raise AtlasError('malformed frame in %s' % path)
+
+        x, y, w, h = tp_rect(d, 'frame', name)
+        rotated = tp_bool(d, 'rotated', name)
+        trimmed = tp_bool(d, 'trimmed', name)
+        sprite_source_size = tp_rect(d, 'spriteSourceSize', name)
+        source_size = tp_size(d, 'sourceSize', name)
+
+        # TexturePacker doesn't rotate the clip coordinates of rotated images
+        if rotated:
+            w, h = h, w
+
+        padding = trim_padding(sprite_source_size, source_size) if trimmed else None
+
+        anchor = None
+        pivot = d.get('pivot')
+        if pivots and isinstance(pivot, dict):
+            anchor = (float(pivot.get('x', 0.0)), float(pivot.get('y', 0.0)))
+
+        result.append(Frame(name, (x, y, w, h), rotated, padding, anchor))
+
+    return result
+
+
+# Zwoptex
+
+def zwop_match(pattern, d, key, name):
+    value = d.get(key)
+    match = pattern.search(value) if isinstance(value, str) else None
+    if not match:
+        raise AtlasError('frame "%s": "%s" is missing or malformed' % (name, key))
+    return tuple(int(group) for group in match.groups())
+
+
+def zwop_bool(d, key, name):
+    value = d.get(key)
+    if not isinstance(value, (bool, int)):
+        raise AtlasError('frame "%s": "%s" is missing' % (name, key))
+    return bool(value)
+
+
+def read_zwoptex(path, pivots):
+    with open(path, 'rb') as f:
+        if hasattr(plistlib, 'load'):
+            doc = plistlib.load(f)
+        else:
+            doc = plistlib.readPlist(f)
+
+    frames = doc.get('frames') if isinstance(doc, dict) else None
+    if not isinstance(frames, dict):
+        raise AtlasError('no "frames" in %s' % path)
+
+    result = []
+
+    for name, d in frames.items():
+        if not isinstance(d, dict):
+            raise AtlasError('malformed frame in %s' % path)
+
+        rect = zwop_match(ZWOP_RECT, d, 'textureRect', name)
+        rotated = zwop_bool(d, 'textureRotated', name)
+        trimmed = zwop_bool(d, 'spriteTrimmed', name)
+        color_rect = zwop_match(ZWOP_RECT, d, 'spriteColorRect', name)
+        source_size = zwop_match(ZWOP_SIZE, d, 'spriteSourceSize', name)
+
+        padding = trim_padding(color_rect, source_size) if trimmed else None
+
+        result.append(Frame(name, rect, rotated, padding))
+
+    return result
+
+
+# Writing
+
+def next_power_of_two(value):
+    result = 1
+    while result < value:
+        result <<= 1
+    return result
+
+
+def build(frames, image_name):
+    if not frames:
+        raise AtlasError('the atlas has no frames')
+
+    # The string table, with each string stored once
+    strings = bytearray()
+    string_offsets = {}
+
+    def add_string(s):
+        data = s.encode('utf-8')
+        if b'\0' in data:
+            raise AtlasError('"%s" has a 0 in it' % s)
+        if data not in string_offsets:
+            string_offsets[data] = len(strings)
+            strings.extend(data + b'\0')
+        return string_offsets[data], len(data)
+
+    image_offsets = [add_string(image_name)[0]]
+
+    names = set()
+    records = []
+
+    for frame in frames:
+        if frame.name in names:
+            raise AtlasError('frame "%s" appears twice' % frame.name)
+        names.add(frame.name)
+
+        name_offset, name_length = add_string(frame.name)
+        if name_length > 0xFFFF:
+            raise AtlasError('frame "%s" has too long a name' % frame.name)
+
+        flags = 0
+        padding = (0.0, 0.0, 0.0, 0.0)
+        anchor = (0.0, 0.0)
+
+        if frame.padding is not None:
+            flags |= FLAG_PADDING
+            padding = frame.padding
+        if frame.anchor is not None:
+            flags |= FLAG_ANCHOR
+            anchor = frame.anchor
+
+        name_hash = fnv1a(frame.name.encode('utf-8'))
+        records.append((name_hash, FRAME.pack(name_offset, name_hash, name_length, 0, flags, 0,
+                                              *(tuple(float(v) for v in frame.rect) +
+                                                (frame.rotation,) +
+                                                tuple(float(v) for v in padding) +
+                                                tuple(float(v) for v in anchor)))))
+
+    # Half full at most, so misses stop quickly
+    bucket_count = next_power_of_two(len(records) * 2)
+    mask = bucket_count - 1
+    buckets = [0] * bucket_count
+
+    for index, (name_hash, _) in enumerate(records):
+        bucket = name_hash & mask
+        while buckets[bucket]:
+            bucket = (bucket + 1) & mask
+        buckets[bucket] = index + 1
+
+    while len(strings) % 4:
+        strings.append(0)
+
+    images_offset = HEADER.size
+    frames_offset = images_offset + 4 * len(image_offsets)
+    buckets_offset = frames_offset + FRAME.size * len(records)
+    strings_offset = buckets_offset + 4 * bucket_count
+
+    out = bytearray()
+    out += HEADER.pack(MAGIC, VERSION, 0,
+                       len(records), len(image_offsets), bucket_count,
+                       images_offset, frames_offset, buckets_offset,
+                       strings_offset, len(strings))
+    out += struct.pack('<%dI' % len(image_offsets), *image_offsets)
+    for _, record in records:
+        out += record
+    out += struct.pack('<%dI' % bucket_count, *buckets)
+    out += strings
+
+    return bytes(out)
+
+
+READERS = {
+    '.json': read_texturepacker,
+    '.plist': read_zwoptex,
+}
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Converts TexturePacker (.json) and Zwoptex (.plist) '
+                                                 'atlases to Pixelwave binary atlases (.pxa).')
+    parser.add_argument('input', help='the .json or .plist atlas')
+    parser.add_argument('output', nargs='?', help='the .pxa file (default: the input with a .pxa extension)')
+    parser.add_argument('-i', '--image', default='',
+                        help='the atlas image, relative to the .pxa file (default: the image named '
+                             'like the atlas, as with the original formats)')
+    parser.add_argument('-p', '--pivots', action='store_true',
+                        help='store TexturePacker pivots as frame anchors')
+    parser.add_argument('-v', '--verbose', action='store_true', help='print what was written')
+    args = parser.parse_args(argv)
+
+    extension = os.path.splitext(args.input)[1].lower()
+    reader = READERS.get(extension)
+    if not reader:
+        parser.error('%s: unknown atlas format, expected .json or .plist' % args.input)
+
+    output = args.output or os.path.splitext(args.input)[0] + '.pxa'
+
+    try:
+        frames = reader(args.input, args.pivots)
+        data = build(frames, args.image)
+    except (AtlasError, ValueError, IOError) as e:
+        sys.stderr.write('pxatlas: %s: %s\n' % (args.input, e))
+        return 1
+
+    with open(output, 'wb') as f:
+        f.write(data)
+
+    if args.verbose:
+        print('%s: %d frames, %d bytes' % (output, len(frames), len(data)))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
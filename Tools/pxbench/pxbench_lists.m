@@ -0,0 +1,300 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * pxbench-lists - Times iterating, inserting into and removing from
+ * PXArrayList and PXLinkedList, at 10, 1k and 100k items.
+ *
+ * Usage: pxbench-lists
+ */
+
+#import <Foundation/Foundation.h>
+
+#import "PXArrayList.h"
+#import "PXLinkedList.h"
+
+#include "PXTimeUtils.h"
+
+#include <stdio.h>
+
+// Every test handles about this many items in total, repeating itself on the
+// shorter lists, so each one runs long enough to time.
+#define PX_BENCH_LISTS_ITEMS_PER_TEST 2000000
+
+typedef enum
+{
+	PXBenchListsTest_Append = 0,
+	PXBenchListsTest_InsertMiddle,
+	PXBenchListsTest_ForIn,
+	PXBenchListsTest_ForEach,
+	PXBenchListsTest_RemoveLast,
+	PXBenchListsTest_RemoveMiddle,
+
+	PXBenchListsTest_Count
+} PXBenchListsTest;
+
+static const char *pxBenchListsTestNames[PXBenchListsTest_Count] =
+{
+	"append",
+	"insert middle",
+	"for-in",
+	"ForEach macro",
+	"remove last",
+	"remove middle"
+};
+
+// The library logs through PXDebug, which brings the whole engine with it.
+void PXDebugLog(NSString *format, ...)
+{
+}
+
+static id pxBenchListsSink = nil;
+
+/*
+ * Fills the list with the first count objects.
+ */
+static void PXBenchListsFill(id list, id *objects, unsigned count)
+{
+	unsigned index;
+
+	for (index = 0; index < count; ++index)
+	{
+		[list addObject:objects[index]];
+	}
+}
+
+/*
+ * Runs the test once on an array list, and returns how long it took in
+ * seconds. Setting the list up isn't timed.
+ */
+static double PXBenchListsRunArrayList(PXBenchListsTest test, id *objects, unsigned count)
+{
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	PXArrayList *list = [[PXArrayList alloc] init];
+	id object = nil;
+	unsigned index;
+
+	if (test != PXBenchListsTest_Append && test != PXBenchListsTest_InsertMiddle)
+	{
+		PXBenchListsFill(list, objects, count);
+	}
+
+	uint64_t start = PXTimeGetTicks();
+
+	switch (test)
+	{
+		case PXBenchListsTest_Append:
+			PXBenchListsFill(list, objects, count);
+			break;
+		case PXBenchListsTest_InsertMiddle:
+			for (index = 0; index < count; ++index)
+			{
+				[list insertObject:objects[index] atIndex:index >> 1];
+			}
+			break;
+		case PXBenchListsTest_ForIn:
+			for (object in list)
+			{
+				pxBenchListsSink = object;
+			}
+			break;
+		case PXBenchListsTest_ForEach:
+		{
+			PXArrayListForEach(list, object)
+			{
+				pxBenchListsSink = object;
+			}
+			break;
+		}
+		case PXBenchListsTest_RemoveLast:
+			for (index = 0; index < count; ++index)
+			{
+				[list removeLastObject];
+			}
+			break;
+		case PXBenchListsTest_RemoveMiddle:
+			for (index = count; index > 0; --index)
+			{
+				[list removeObjectAtIndex:(index - 1) >> 1];
+			}
+			break;
+		default:
+			break;
+	}
+
+	double seconds = PXTimeTicksToSeconds(PXTimeGetTicks() - start);
+
+	[list release];
+	[pool release];
+
+	return seconds;
+}
+
+/*
+ * The same as PXBenchListsRunArrayList, on a linked list.
+ */
+static double PXBenchListsRunLinkedList(PXBenchListsTest test, id *objects, unsigned count)
+{
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+	PXLinkedList *list = [[PXLinkedList alloc] init];
+	id object = nil;
+	unsigned index;
+
+	if (test != PXBenchListsTest_Append && test != PXBenchListsTest_InsertMiddle)
+	{
+		PXBenchListsFill(list, objects, count);
+	}
+
+	uint64_t start = PXTimeGetTicks();
+
+	switch (test)
+	{
+		case PXBenchListsTest_Append:
+			PXBenchListsFill(list, objects, count);
+			break;
+		case PXBenchListsTest_InsertMiddle:
+			for (index = 0; index < count; ++index)
+			{
+				[list insertObject:objects[index] atIndex:index >> 1];
+			}
+			break;
+		case PXBenchListsTest_ForIn:
+			for (object in list)
+			{
+				pxBenchListsSink = object;
+			}
+			break;
+		case PXBenchListsTest_ForEach:
+		{
+			PXLinkedListForEach(list, object)
+			{
+				pxBenchListsSink = object;
+			}
+			break;
+		}
+		case PXBenchListsTest_RemoveLast:
+			for (index = 0; index < count; ++index)
+			{
+				[list removeLastObject];
+			}
+			break;
+		case PXBenchListsTest_RemoveMiddle:
+			for (index = count; index > 0; --index)
+			{
+				[list removeObjectAtIndex:(index - 1) >> 1];
+			}
+			break;
+		default:
+			break;
+	}
+
+	double seconds = PXTimeTicksToSeconds(PXTimeGetTicks() - start);
+
+	[list release];
+	[pool release];
+
+	return seconds;
+}
+
+int main(int argc, char **argv)
+{
+	NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+
+	const unsigned sizes[] = {10, 1000, 100000};
+	const unsigned sizeCount = sizeof(sizes) / sizeof(unsigned);
+	const unsigned maxSize = sizes[sizeCount - 1];
+
+	id *objects = malloc(sizeof(id) * maxSize);
+	unsigned index;
+
+	for (index = 0; index < maxSize; ++index)
+	{
+		objects[index] = [[NSObject alloc] init];
+	}
+
+	printf("%-16s %8s %14s %14s\n", "test", "items", "PXArrayList", "PXLinkedList");
+
+	PXBenchListsTest test;
+	unsigned sizeIndex;
+
+	for (test = 0; test < PXBenchListsTest_Count; ++test)
+	{
+		for (sizeIndex = 0; sizeIndex < sizeCount; ++sizeIndex)
+		{
+			unsigned count = sizes[sizeIndex];
+			unsigned repeats = PX_BENCH_LISTS_ITEMS_PER_TEST / count;
+			double arrayListSeconds = 0.0;
+			double linkedListSeconds = 0.0;
+
+			// Inserting into and removing from the middle of a long linked
+			// list walks half of it every time, so don't repeat those.
+			if (test == PXBenchListsTest_InsertMiddle || test == PXBenchListsTest_RemoveMiddle)
+			{
+				repeats = MAX(1, repeats / count);
+			}
+
+			unsigned repeat;
+			for (repeat = 0; repeat < repeats; ++repeat)
+			{
+				arrayListSeconds += PXBenchListsRunArrayList(test, objects, count);
+				linkedListSeconds += PXBenchListsRunLinkedList(test, objects, count);
+			}
+
+			// Nanoseconds per item
+			double scale = 1.0e9 / ((double)repeats * (double)count);
+
+			printf("%-16s %8u %11.2f ns %11.2f ns\n",
+			       pxBenchListsTestNames[test],
+			       count,
+			       arrayListSeconds * scale,
+			       linkedListSeconds * scale);
+		}
+	}
+
+	for (index = 0; index < maxSize; ++index)
+	{
+		[objects[index] release];
+	}
+
+	free(objects);
+
+	[pool release];
+
+	return 0;
+}
@@ -0,0 +1,227 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * pxbench-texformat - Times converting a 2048x2048 image from 8 bits per
+ * channel into the 16 bit texture formats, the way the texture modifiers do
+ * while a texture loads.
+ *
+ * Usage: pxbench-texformat
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "PXTextureFormatUtils.h"
+
+#define PX_BENCH_TEXFORMAT_SIZE 2048
+#define PX_BENCH_TEXFORMAT_RUNS 10
+
+typedef struct
+{
+	const char *name;
+	PXTextureDataPixelFormat srcFormat;
+	unsigned srcBpp;
+	PXTextureDataPixelFormat dstFormat;
+} PXBenchTexFormatPair;
+
+static const PXBenchTexFormatPair pxBenchTexFormatPairs[] =
+{
+	{"RGBA 8888 -> 4444", PXTextureDataPixelFormat_RGBA8888, 4, PXTextureDataPixelFormat_RGBA4444},
+	{"RGBA 8888 -> 5551", PXTextureDataPixelFormat_RGBA8888, 4, PXTextureDataPixelFormat_RGBA5551},
+	{"RGBA 8888 -> 565",  PXTextureDataPixelFormat_RGBA8888, 4, PXTextureDataPixelFormat_RGB565},
+	{"RGB 888 -> 565",    PXTextureDataPixelFormat_RGB888,   3, PXTextureDataPixelFormat_RGB565}
+};
+
+static const char *pxBenchTexFormatDitherNames[] = {"none", "ordered", "error diffusion"};
+
+static double PXBenchTexFormatGetSeconds()
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1.0e-9;
+}
+
+/*
+ * Smooth gradients, where banding shows, with a little noise on top so that
+ * no two rows are the same.
+ */
+static void PXBenchTexFormatFill(UInt8 *pixels, unsigned bpp)
+{
+	unsigned x;
+	unsigned y;
+	unsigned c;
+
+	srand(1);
+
+	for (y = 0; y < PX_BENCH_TEXFORMAT_SIZE; ++y)
+	{
+		for (x = 0; x < PX_BENCH_TEXFORMAT_SIZE; ++x, pixels += bpp)
+		{
+			pixels[0] = (x * 255) / (PX_BENCH_TEXFORMAT_SIZE - 1);
+			pixels[1] = (y * 255) / (PX_BENCH_TEXFORMAT_SIZE - 1);
+			pixels[2] = ((x + y) * 255) / ((PX_BENCH_TEXFORMAT_SIZE - 1) * 2);
+
+			if (bpp == 4)
+				pixels[3] = 255 - pixels[2];
+
+			for (c = 0; c < bpp; ++c)
+			{
+				int val = pixels[c] + (rand() & 3) - 1;
+				pixels[c] = val < 0 ? 0 : (val > 255 ? 255 : val);
+			}
+		}
+	}
+}
+
+/*
+ * The loop the modifiers ran before PXTextureFormatConvertTo16Bit, one call to
+ * the per pixel function each.
+ */
+static void PXBenchTexFormatConvertPerPixel(const PXBenchTexFormatPair *pair, const UInt8 *src, UInt16 *dst, unsigned pixelCount)
+{
+	switch (pair->dstFormat)
+	{
+		case PXTextureDataPixelFormat_RGBA4444:
+			_PXTextureFormatPixelsCopyWithFunc(src, dst, pixelCount, PXTF_RGBA_8888, PXTF_RGBA_4444_From_RGBA_8888);
+			break;
+		case PXTextureDataPixelFormat_RGBA5551:
+			_PXTextureFormatPixelsCopyWithFunc(src, dst, pixelCount, PXTF_RGBA_8888, PXTF_RGBA_5551_From_RGBA_8888);
+			break;
+		default:
+			if (pair->srcBpp == 4)
+			{
+				_PXTextureFormatPixelsCopyWithFunc(src, dst, pixelCount, PXTF_RGBA_8888, PXTF_RGB_565_From_RGBA_8888);
+			}
+			else
+			{
+				_PXTextureFormatPixelsCopyWithFunc(src, dst, pixelCount, PXTF_RGB_888, PXTF_RGB_565_From_RGB_888);
+			}
+			break;
+	}
+}
+
+/*
+ * Returns the fastest of a few runs, in milliseconds. A negative dither runs
+ * the per pixel loop instead.
+ */
+static double PXBenchTexFormatTime(const PXBenchTexFormatPair *pair, const UInt8 *src, UInt16 *dst, int dither)
+{
+	unsigned pixelCount = PX_BENCH_TEXFORMAT_SIZE * PX_BENCH_TEXFORMAT_SIZE;
+	double best = 0.0;
+	unsigned run;
+
+	for (run = 0; run < PX_BENCH_TEXFORMAT_RUNS; ++run)
+	{
+		double start = PXBenchTexFormatGetSeconds();
+
+		if (dither < 0)
+		{
+			PXBenchTexFormatConvertPerPixel(pair, src, dst, pixelCount);
+		}
+		else
+		{
+			PXTextureFormatConvertTo16Bit(src, pair->srcFormat, dst, pair->dstFormat,
+			                              PX_BENCH_TEXFORMAT_SIZE, PX_BENCH_TEXFORMAT_SIZE, (PXTextureDither)dither);
+		}
+
+		double time = (PXBenchTexFormatGetSeconds() - start) * 1000.0;
+
+		if (run == 0 || time < best)
+			best = time;
+	}
+
+	return best;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned pixelCount = PX_BENCH_TEXFORMAT_SIZE * PX_BENCH_TEXFORMAT_SIZE;
+	unsigned pairCount = sizeof(pxBenchTexFormatPairs) / sizeof(PXBenchTexFormatPair);
+
+	UInt8 *src = malloc(pixelCount * 4);
+	UInt16 *dst = malloc(pixelCount * sizeof(UInt16));
+	UInt16 *expected = malloc(pixelCount * sizeof(UInt16));
+
+	if (!src || !dst || !expected)
+	{
+		fprintf(stderr, "pxbench-texformat: Out of memory\n");
+		return 1;
+	}
+
+	bool matches = true;
+	unsigned pairIndex;
+	int dither;
+
+	printf("%dx%d, fastest of %d runs\n\n", PX_BENCH_TEXFORMAT_SIZE, PX_BENCH_TEXFORMAT_SIZE, PX_BENCH_TEXFORMAT_RUNS);
+	printf("%-20s %-16s %10s %12s\n", "formats", "dither", "time", "speed");
+
+	for (pairIndex = 0; pairIndex < pairCount; ++pairIndex)
+	{
+		const PXBenchTexFormatPair *pair = pxBenchTexFormatPairs + pairIndex;
+
+		PXBenchTexFormatFill(src, pair->srcBpp);
+
+		double time = PXBenchTexFormatTime(pair, src, expected, -1);
+		printf("%-20s %-16s %7.2f ms %7.1f Mpx/s\n", pair->name, "per pixel", time, pixelCount / (time * 1000.0));
+
+		for (dither = PXTextureDither_None; dither <= PXTextureDither_ErrorDiffusion; ++dither)
+		{
+			time = PXBenchTexFormatTime(pair, src, dst, dither);
+			printf("%-20s %-16s %7.2f ms %7.1f Mpx/s\n", pair->name, pxBenchTexFormatDitherNames[dither], time, pixelCount / (time * 1000.0));
+
+			// Without dithering, the block conversion must give the same
+			// pixels as the per pixel functions.
+			if (dither == PXTextureDither_None && memcmp(dst, expected, pixelCount * sizeof(UInt16)) != 0)
+			{
+				fprintf(stderr, "pxbench-texformat: %s doesn't match the per pixel functions\n", pair->name);
+				matches = false;
+			}
+		}
+	}
+
+	free(src);
+	free(dst);
+	free(expected);
+
+	return matches ? 0 : 1;
+}
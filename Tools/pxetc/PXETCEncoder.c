@@ -0,0 +1,730 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "PXETCEncoder.h"
+
+#include "PXMathUtils.h"
+
+/*
+ * The color modes only move each pixel along the gray axis, away from a base
+ * color, so the encoder's job is mostly picking good base colors. It starts
+ * from the average color of each sub block and searches the quantized colors
+ * around it; how far it looks depends on the quality.
+ *
+ * Errors are the sum of the squared differences of every channel.
+ */
+
+#define PX_ETC_ENCODER_MAX_ERROR 0xFFFFFFFF
+
+typedef struct
+{
+	unsigned error;
+
+	// Quantized to 4 or 5 bits
+	int color[3];
+	unsigned table;
+	// 0 and 1 add the small and large offset, 2 and 3 subtract them
+	unsigned indices[8];
+} PXETCSubBlockFit;
+
+typedef struct
+{
+	int pixels[8][3];
+	int average[3];
+} PXETCSubBlock;
+
+PXInline int PXETCEncoderClamp(int val)
+{
+	return (val < 0) ? 0 : ((val > 255) ? 255 : val);
+}
+
+PXInline int PXETCEncoderExtend(int val, unsigned bits)
+{
+	return (bits == 4) ? ((val << 4) | val) : ((val << 3) | (val >> 2));
+}
+
+PXInline int PXETCEncoderQuantize(int val, unsigned bits)
+{
+	int max = (1 << bits) - 1;
+
+	return (val * max + 127) / 255;
+}
+
+PXInline unsigned PXETCEncoderColorError(const int *a, int r, int g, int b)
+{
+	int dr = a[0] - r;
+	int dg = a[1] - g;
+	int db = a[2] - b;
+
+	return dr * dr + dg * dg + db * db;
+}
+
+/*
+ * The 8 pixels of a sub block, in the order their indices are stored (down
+ * the columns).
+ */
+PXInline void PXETCEncoderGetSubBlock(const uint8_t *pixels, unsigned pixelStride, unsigned rowStride, bool flip, unsigned subBlock, PXETCSubBlock *out)
+{
+	unsigned x, y;
+	unsigned index = 0;
+	const uint8_t *pixel;
+
+	out->average[0] = out->average[1] = out->average[2] = 0;
+
+	for (x = 0; x < 4; ++x)
+	{
+		for (y = 0; y < 4; ++y)
+		{
+			if ((flip ? (y >> 1) : (x >> 1)) != subBlock)
+				continue;
+
+			pixel = pixels + y * rowStride + x * pixelStride;
+
+			out->pixels[index][0] = pixel[0];
+			out->pixels[index][1] = pixel[1];
+			out->pixels[index][2] = pixel[2];
+
+			out->average[0] += pixel[0];
+			out->average[1] += pixel[1];
+			out->average[2] += pixel[2];
+
+			++index;
+		}
+	}
+
+	out->average[0] = (out->average[0] + 4) >> 3;
+	out->average[1] = (out->average[1] + 4) >> 3;
+	out->average[2] = (out->average[2] + 4) >> 3;
+}
+
+/*
+ * Finds the best table and indices for a quantized base color.
+ */
+static void PXETCEncoderFitColor(const PXETCSubBlock *subBlock, const int *color, unsigned bits, PXETCSubBlockFit *fit)
+{
+	int base[3] =
+	{
+		PXETCEncoderExtend(color[0], bits),
+		PXETCEncoderExtend(color[1], bits),
+		PXETCEncoderExtend(color[2], bits)
+	};
+
+	static const int signs[4] = {1, 1, -1, -1};
+	static const int columns[4] = {0, 1, 0, 1};
+
+	unsigned table;
+	unsigned pixelIndex;
+	unsigned index;
+	unsigned bestIndex;
+	unsigned error;
+	unsigned pixelError;
+	unsigned bestPixelError;
+	unsigned indices[8];
+	int offset;
+
+	for (table = 0; table < 8; ++table)
+	{
+		error = 0;
+
+		for (pixelIndex = 0; pixelIndex < 8; ++pixelIndex)
+		{
+			bestPixelError = PX_ETC_ENCODER_MAX_ERROR;
+			bestIndex = 0;
+
+			for (index = 0; index < 4; ++index)
+			{
+				offset = signs[index] * pxETCCodewordTable[table][columns[index]];
+				pixelError = PXETCEncoderColorError(subBlock->pixels[pixelIndex],
+													PXETCEncoderClamp(base[0] + offset),
+													PXETCEncoderClamp(base[1] + offset),
+													PXETCEncoderClamp(base[2] + offset));
+
+				if (pixelError < bestPixelError)
+				{
+					bestPixelError = pixelError;
+					bestIndex = index;
+				}
+			}
+
+			indices[pixelIndex] = bestIndex;
+			error += bestPixelError;
+
+			if (error >= fit->error)
+				break;
+		}
+
+		if (error < fit->error)
+		{
+			fit->error = error;
+			fit->color[0] = color[0];
+			fit->color[1] = color[1];
+			fit->color[2] = color[2];
+			fit->table = table;
+			memcpy(fit->indices, indices, sizeof(indices));
+		}
+	}
+}
+
+/*
+ * Tries every quantized color within radius steps of center (per channel),
+ * that is also within [lo, hi]. Returns whether the fit got better.
+ */
+static bool PXETCEncoderSearch(const PXETCSubBlock *subBlock, unsigned bits, const int *center, int radius, const int *lo, const int *hi, PXETCSubBlockFit *fit)
+{
+	unsigned startError = fit->error;
+	int color[3];
+	int min[3];
+	int max[3];
+	unsigned channel;
+
+	for (channel = 0; channel < 3; ++channel)
+	{
+		min[channel] = PXMathMax(center[channel] - radius, lo[channel]);
+		max[channel] = PXMathMin(center[channel] + radius, hi[channel]);
+
+		// The center itself may be out of range, use the closest valid color
+		if (min[channel] > max[channel])
+		{
+			min[channel] = max[channel] = (center[channel] < lo[channel]) ? lo[channel] : hi[channel];
+		}
+	}
+
+	for (color[0] = min[0]; color[0] <= max[0]; ++color[0])
+	{
+		for (color[1] = min[1]; color[1] <= max[1]; ++color[1])
+		{
+			for (color[2] = min[2]; color[2] <= max[2]; ++color[2])
+			{
+				PXETCEncoderFitColor(subBlock, color, bits, fit);
+			}
+		}
+	}
+
+	return fit->error < startError;
+}
+
+/*
+ * Fits a sub block with base colors limited to [lo, hi], starting from the
+ * sub block's average color.
+ */
+static void PXETCEncoderFitSubBlock(const PXETCSubBlock *subBlock, unsigned bits, const int *lo, const int *hi, PXETCQuality quality, PXETCSubBlockFit *fit)
+{
+	int center[3] =
+	{
+		PXETCEncoderQuantize(subBlock->average[0], bits),
+		PXETCEncoderQuantize(subBlock->average[1], bits),
+		PXETCEncoderQuantize(subBlock->average[2], bits)
+	};
+
+	fit->error = PX_ETC_ENCODER_MAX_ERROR;
+
+	if (quality == PXETCQuality_Fast)
+	{
+		PXETCEncoderSearch(subBlock, bits, center, 0, lo, hi, fit);
+		return;
+	}
+
+	PXETCEncoderSearch(subBlock, bits, center, 1, lo, hi, fit);
+
+	if (quality != PXETCQuality_High)
+		return;
+
+	// Keep walking towards better colors, and along the gray axis, where the
+	// offsets can make up for a base color that's too light or dark.
+	int iteration;
+	int step;
+	int shifted[3];
+	bool improved = true;
+
+	for (iteration = 0; improved && iteration < 4; ++iteration)
+	{
+		memcpy(center, fit->color, sizeof(center));
+		improved = PXETCEncoderSearch(subBlock, bits, center, 1, lo, hi, fit);
+
+		for (step = -3; step <= 3; ++step)
+		{
+			if (step >= -1 && step <= 1)
+				continue;
+
+			shifted[0] = center[0] + step;
+			shifted[1] = center[1] + step;
+			shifted[2] = center[2] + step;
+
+			if (PXETCEncoderSearch(subBlock, bits, shifted, 0, lo, hi, fit))
+				improved = true;
+		}
+	}
+}
+
+PXInline void PXETCEncoderStoreIndices(const PXETCSubBlockFit *fit, bool flip, unsigned subBlock, uint32_t *indices)
+{
+	unsigned x, y;
+	unsigned bit;
+	unsigned index;
+	unsigned pixelIndex = 0;
+
+	for (x = 0; x < 4; ++x)
+	{
+		for (y = 0; y < 4; ++y)
+		{
+			if ((flip ? (y >> 1) : (x >> 1)) != subBlock)
+				continue;
+
+			bit = (x << 2) | y;
+			index = fit->indices[pixelIndex++];
+
+			*indices |= ((index >> 1) << (bit + 16)) | ((index & 0x1) << bit);
+		}
+	}
+}
+
+PXInline void PXETCEncoderStoreWord(uint8_t *block, uint32_t word)
+{
+	block[0] = word >> 24;
+	block[1] = word >> 16;
+	block[2] = word >> 8;
+	block[3] = word;
+}
+
+/*
+ * The two ETC1 modes, for one orientation of the sub blocks. Returns the error
+ * of the best one, and writes it to block if it's better than bestError.
+ */
+static unsigned PXETCEncoderEncodeSubBlocks(const uint8_t *pixels, unsigned pixelStride, unsigned rowStride, bool flip, PXETCQuality quality, uint8_t *block, unsigned bestError)
+{
+	PXETCSubBlock subBlocks[2];
+	PXETCEncoderGetSubBlock(pixels, pixelStride, rowStride, flip, 0, &subBlocks[0]);
+	PXETCEncoderGetSubBlock(pixels, pixelStride, rowStride, flip, 1, &subBlocks[1]);
+
+	static const int lo[3] = {0, 0, 0};
+	static const int hi4[3] = {15, 15, 15};
+	static const int hi5[3] = {31, 31, 31};
+
+	PXETCSubBlockFit individual[2];
+	PXETCSubBlockFit differential[2];
+	PXETCSubBlockFit constrained[2];
+
+	// Individual mode, 444 colors that don't depend on each other
+	PXETCEncoderFitSubBlock(&subBlocks[0], 4, lo, hi4, quality, &individual[0]);
+	PXETCEncoderFitSubBlock(&subBlocks[1], 4, lo, hi4, quality, &individual[1]);
+
+	// Differential mode, 555 colors that are at most -4 to 3 steps apart.
+	// When they're further than that, either color can give way to the other.
+	PXETCEncoderFitSubBlock(&subBlocks[0], 5, lo, hi5, quality, &differential[0]);
+	PXETCEncoderFitSubBlock(&subBlocks[1], 5, lo, hi5, quality, &differential[1]);
+
+	int rangeLo[3];
+	int rangeHi[3];
+	unsigned channel;
+	bool isInRange = true;
+
+	for (channel = 0; channel < 3; ++channel)
+	{
+		int delta = differential[1].color[channel] - differential[0].color[channel];
+
+		if (delta < -4 || delta > 3)
+			isInRange = false;
+	}
+
+	if (!isInRange)
+	{
+		for (channel = 0; channel < 3; ++channel)
+		{
+			rangeLo[channel] = PXMathMax(differential[0].color[channel] - 4, 0);
+			rangeHi[channel] = PXMathMin(differential[0].color[channel] + 3, 31);
+		}
+		PXETCEncoderFitSubBlock(&subBlocks[1], 5, rangeLo, rangeHi, quality, &constrained[1]);
+
+		for (channel = 0; channel < 3; ++channel)
+		{
+			rangeLo[channel] = PXMathMax(differential[1].color[channel] - 3, 0);
+			rangeHi[channel] = PXMathMin(differential[1].color[channel] + 4, 31);
+		}
+		PXETCEncoderFitSubBlock(&subBlocks[0], 5, rangeLo, rangeHi, quality, &constrained[0]);
+
+		if (differential[0].error + constrained[1].error <= constrained[0].error + differential[1].error)
+		{
+			differential[1] = constrained[1];
+		}
+		else
+		{
+			differential[0] = constrained[0];
+		}
+	}
+
+	unsigned individualError = individual[0].error + individual[1].error;
+	unsigned differentialError = differential[0].error + differential[1].error;
+	bool isDifferential = (differentialError <= individualError);
+	unsigned error = isDifferential ? differentialError : individualError;
+
+	if (error >= bestError)
+		return error;
+
+	const PXETCSubBlockFit *fits = isDifferential ? differential : individual;
+	uint32_t high;
+	uint32_t indices = 0;
+
+	if (isDifferential)
+	{
+		high = (fits[0].color[0] << 27) | (((fits[1].color[0] - fits[0].color[0]) & 0x7) << 24) |
+			   (fits[0].color[1] << 19) | (((fits[1].color[1] - fits[0].color[1]) & 0x7) << 16) |
+			   (fits[0].color[2] << 11) | (((fits[1].color[2] - fits[0].color[2]) & 0x7) << 8) |
+			   0x2;
+	}
+	else
+	{
+		high = (fits[0].color[0] << 28) | (fits[1].color[0] << 24) |
+			   (fits[0].color[1] << 20) | (fits[1].color[1] << 16) |
+			   (fits[0].color[2] << 12) | (fits[1].color[2] << 8);
+	}
+
+	high |= (fits[0].table << 5) | (fits[1].table << 2) | (flip ? 0x1 : 0x0);
+
+	PXETCEncoderStoreIndices(&fits[0], flip, 0, &indices);
+	PXETCEncoderStoreIndices(&fits[1], flip, 1, &indices);
+
+	PXETCEncoderStoreWord(block, high);
+	PXETCEncoderStoreWord(block + 4, indices);
+
+	return error;
+}
+
+PXInline int PXETCEncoderSigned3(unsigned val)
+{
+	return (val & 0x4) ? ((int)val - 8) : (int)val;
+}
+
+PXInline bool PXETCEncoderOverflows(uint8_t byte)
+{
+	int sum = (byte >> 3) + PXETCEncoderSigned3(byte & 0x7);
+
+	return (sum < 0 || sum > 31);
+}
+
+/*
+ * The ETC2 planar mode, which fits smooth gradients much better than the ETC1
+ * modes. The three colors are fit with least squares, then quantized.
+ */
+static unsigned PXETCEncoderEncodePlanar(const uint8_t *pixels, unsigned pixelStride, unsigned rowStride, uint8_t *block, unsigned bestError)
+{
+	// Each pixel is o * (4 - x - y) / 4 + h * x / 4 + v * y / 4. The normal
+	// equations are the same for every channel; their matrix is constant.
+	float sums[3][3];
+	float matrix[3][3] = {{0.0f}};
+	unsigned x, y;
+	unsigned channel;
+	unsigned row, column;
+
+	memset(sums, 0, sizeof(sums));
+
+	for (y = 0; y < 4; ++y)
+	{
+		for (x = 0; x < 4; ++x)
+		{
+			float weights[3] = {(4.0f - x - y) * 0.25f, x * 0.25f, y * 0.25f};
+			const uint8_t *pixel = pixels + y * rowStride + x * pixelStride;
+
+			for (row = 0; row < 3; ++row)
+			{
+				for (column = 0; column < 3; ++column)
+				{
+					matrix[row][column] += weights[row] * weights[column];
+				}
+
+				for (channel = 0; channel < 3; ++channel)
+				{
+					sums[channel][row] += weights[row] * pixel[channel];
+				}
+			}
+		}
+	}
+
+	// Invert the matrix with Cramer's rule
+	float det = matrix[0][0] * (matrix[1][1] * matrix[2][2] - matrix[1][2] * matrix[2][1]) -
+				matrix[0][1] * (matrix[1][0] * matrix[2][2] - matrix[1][2] * matrix[2][0]) +
+				matrix[0][2] * (matrix[1][0] * matrix[2][1] - matrix[1][1] * matrix[2][0]);
+	float inverse[3][3];
+
+	for (row = 0; row < 3; ++row)
+	{
+		for (column = 0; column < 3; ++column)
+		{
+			unsigned r0 = (column + 1) % 3, r1 = (column + 2) % 3;
+			unsigned c0 = (row + 1) % 3, c1 = (row + 2) % 3;
+
+			inverse[row][column] = (matrix[r0][c0] * matrix[r1][c1] - matrix[r0][c1] * matrix[r1][c0]) / det;
+		}
+	}
+
+	// o, h and v per channel, quantized to 6, 7 and 6 bits
+	static const unsigned bits[3] = {6, 7, 6};
+	int quantized[3][3];
+	unsigned point;
+
+	for (channel = 0; channel < 3; ++channel)
+	{
+		int max = (1 << bits[channel]) - 1;
+
+		for (point = 0; point < 3; ++point)
+		{
+			float val = inverse[point][0] * sums[channel][0] + inverse[point][1] * sums[channel][1] + inverse[point][2] * sums[channel][2];
+			int q = (int)(val * max / 255.0f + 0.5f);
+
+			quantized[point][channel] = PXMathMax(0, PXMathMin(max, q));
+		}
+	}
+
+	const int *o = quantized[0];
+	const int *h = quantized[1];
+	const int *v = quantized[2];
+
+	uint8_t planar[8];
+
+	planar[0] = (o[0] << 1) | (o[1] >> 6);
+	planar[1] = ((o[1] & 0x3F) << 1) | (o[2] >> 5);
+	planar[2] = (((o[2] >> 3) & 0x3) << 3) | ((o[2] >> 1) & 0x3);
+	planar[3] = ((o[2] & 0x1) << 7) | ((h[0] >> 1) << 2) | 0x2 | (h[0] & 0x1);
+	planar[4] = (h[1] << 1) | (h[2] >> 5);
+	planar[5] = ((h[2] & 0x1F) << 3) | (v[0] >> 3);
+	planar[6] = ((v[0] & 0x7) << 5) | (v[1] >> 2);
+	planar[7] = ((v[1] & 0x3) << 6) | v[2];
+
+	// The unused bits have to make red and green stay in range, and blue
+	// overflow, or the block would be read as one of the other modes.
+	if (PXETCEncoderOverflows(planar[0]))
+		planar[0] |= 0x80;
+	if (PXETCEncoderOverflows(planar[1]))
+		planar[1] |= 0x80;
+
+	planar[2] |= 0x04;
+	if (!PXETCEncoderOverflows(planar[2]))
+		planar[2] = (planar[2] & ~0x04) | 0xE0;
+
+	uint8_t decoded[4 * 4 * 3];
+	PXETCDecodeColorBlock(planar, decoded, 3, 4 * 3, true);
+
+	unsigned error = 0;
+
+	for (y = 0; y < 4; ++y)
+	{
+		for (x = 0; x < 4; ++x)
+		{
+			const uint8_t *pixel = pixels + y * rowStride + x * pixelStride;
+			const uint8_t *result = decoded + (y * 4 + x) * 3;
+			int original[3] = {pixel[0], pixel[1], pixel[2]};
+
+			error += PXETCEncoderColorError(original, result[0], result[1], result[2]);
+		}
+	}
+
+	if (error < bestError)
+		memcpy(block, planar, sizeof(planar));
+
+	return error;
+}
+
+/**
+ * Encodes 4x4 pixels (only the first three channels are read) into an 8 byte
+ * color block.
+ *
+ * @param isETC2 Whether the ETC2 planar mode can be used. The block is valid
+ * ETC1 otherwise.
+ *
+ * @return The squared error of the block.
+ */
+unsigned PXETCEncodeColorBlock(const uint8_t *pixels, unsigned pixelStride, unsigned rowStride, uint8_t *block, PXETCQuality quality, bool isETC2)
+{
+	unsigned bestError = PX_ETC_ENCODER_MAX_ERROR;
+	unsigned error;
+
+	error = PXETCEncoderEncodeSubBlocks(pixels, pixelStride, rowStride, false, quality, block, bestError);
+	bestError = PXMathMin(error, bestError);
+
+	if (bestError > 0)
+	{
+		error = PXETCEncoderEncodeSubBlocks(pixels, pixelStride, rowStride, true, quality, block, bestError);
+		bestError = PXMathMin(error, bestError);
+	}
+
+	if (isETC2 && bestError > 0)
+	{
+		error = PXETCEncoderEncodePlanar(pixels, pixelStride, rowStride, block, bestError);
+		bestError = PXMathMin(error, bestError);
+	}
+
+	return bestError;
+}
+
+/*
+ * The error of an alpha block for one table, multiplier and base, with the
+ * best index for every pixel.
+ */
+PXInline unsigned PXETCEncoderFitAlpha(const int *alphas, int base, int multiplier, const int *modifiers, unsigned *indices, unsigned bestError)
+{
+	unsigned error = 0;
+	unsigned pixelIndex;
+	unsigned index;
+	unsigned pixelError;
+	unsigned bestPixelError;
+	int diff;
+
+	for (pixelIndex = 0; pixelIndex < 16; ++pixelIndex)
+	{
+		bestPixelError = PX_ETC_ENCODER_MAX_ERROR;
+
+		for (index = 0; index < 8; ++index)
+		{
+			diff = alphas[pixelIndex] - PXETCEncoderClamp(base + modifiers[index] * multiplier);
+			pixelError = diff * diff;
+
+			if (pixelError < bestPixelError)
+			{
+				bestPixelError = pixelError;
+				indices[pixelIndex] = index;
+			}
+		}
+
+		error += bestPixelError;
+
+		if (error >= bestError)
+			break;
+	}
+
+	return error;
+}
+
+/**
+ * Encodes the first channel of 4x4 pixels into an 8 byte EAC alpha block.
+ *
+ * @return The squared error of the block.
+ */
+unsigned PXETCEncodeAlphaBlock(const uint8_t *pixels, unsigned pixelStride, unsigned rowStride, uint8_t *block, PXETCQuality quality)
+{
+	// Down the columns, like the indices are stored
+	int alphas[16];
+	int min = 255;
+	int max = 0;
+	unsigned x, y;
+
+	for (x = 0; x < 4; ++x)
+	{
+		for (y = 0; y < 4; ++y)
+		{
+			int alpha = pixels[y * rowStride + x * pixelStride];
+
+			alphas[(x << 2) | y] = alpha;
+			min = PXMathMin(min, alpha);
+			max = PXMathMax(max, alpha);
+		}
+	}
+
+	unsigned bestError = PX_ETC_ENCODER_MAX_ERROR;
+	unsigned bestIndices[16];
+	int bestBase = min;
+	int bestMultiplier = 1;
+	unsigned bestTable = 13;
+
+	unsigned indices[16];
+	unsigned error;
+	unsigned table;
+	int multiplier;
+	int base;
+
+	// Table 13 has a zero offset, which is all a flat block needs
+	if (min == max)
+	{
+		bestError = 0;
+
+		for (x = 0; x < 16; ++x)
+			bestIndices[x] = 4;
+	}
+
+	int radius = (quality == PXETCQuality_Fast) ? 0 : ((quality == PXETCQuality_Medium) ? 1 : 2);
+
+	for (table = 0; bestError > 0 && table < 16; ++table)
+	{
+		const int *modifiers = pxETCAlphaModifierTable[table];
+		int span = modifiers[7] - modifiers[3];
+		int center = ((max - min) + (span >> 1)) / span;
+		int m;
+		int b;
+
+		// Stretch the table's offsets over the range of the block
+		for (m = center - radius; m <= center + radius; ++m)
+		{
+			multiplier = PXMathMax(1, PXMathMin(15, m));
+
+			int centerBase = min - modifiers[3] * multiplier;
+
+			for (b = -radius; b <= radius; ++b)
+			{
+				base = PXETCEncoderClamp(centerBase + b);
+
+				error = PXETCEncoderFitAlpha(alphas, base, multiplier, modifiers, indices, bestError);
+
+				if (error < bestError)
+				{
+					bestError = error;
+					bestBase = base;
+					bestMultiplier = multiplier;
+					bestTable = table;
+					memcpy(bestIndices, indices, sizeof(indices));
+				}
+			}
+		}
+	}
+
+	block[0] = bestBase;
+	block[1] = (bestMultiplier << 4) | bestTable;
+
+	uint64_t bits = 0;
+	unsigned index;
+
+	for (index = 0; index < 16; ++index)
+	{
+		bits |= (uint64_t)bestIndices[index] << (45 - index * 3);
+	}
+
+	for (index = 0; index < 6; ++index)
+	{
+		block[2 + index] = bits >> (40 - index * 8);
+	}
+
+	return bestError;
+}
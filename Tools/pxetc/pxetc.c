@@ -0,0 +1,802 @@
+/*
+ *  _____                       ___                                            
+ * /\  _ `\  __                /\_ \                                           
+ * \ \ \L\ \/\_\   __  _    ___\//\ \    __  __  __    ___     __  __    ___   
+ *  \ \  __/\/\ \ /\ \/ \  / __`\\ \ \  /\ \/\ \/\ \  / __`\  /\ \/\ \  / __`\ 
+ *   \ \ \/  \ \ \\/>  </ /\  __/ \_\ \_\ \ \_/ \_/ \/\ \L\ \_\ \ \_/ |/\  __/ 
+ *    \ \_\   \ \_\/\_/\_\\ \____\/\____\\ \___^___ /\ \__/|\_\\ \___/ \ \____\
+ *     \/_/    \/_/\//\/_/ \/____/\/____/ \/__//__ /  \/__/\/_/ \/__/   \/____/
+ *       
+ *           www.pixelwave.org + www.spiralstormgames.com
+ *                            ~;   
+ *                           ,/|\.           
+ *                         ,/  |\ \.                 Core Team: Oz Michaeli
+ *                       ,/    | |  \                           John Lattin
+ *                     ,/      | |   |
+ *                   ,/        |/    |
+ *                 ./__________|----'  .
+ *            ,(   ___.....-,~-''-----/   ,(            ,~            ,(        
+ * _.-~-.,.-'`  `_.\,.',.-'`  )_.-~-./.-'`  `_._,.',.-'`  )_.-~-.,.-'`  `_._._,.
+ * 
+ * Copyright (c) 2011 Spiralstorm Games http://www.spiralstormgames.com
+ * 
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ * 
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/*
+ * pxetc - Converts PNG images to ETC1 and ETC2 textures, stored in KTX or PKM
+ * files that PXETCTextureParser can load.
+ *
+ * Usage: pxetc [options] input.png output.ktx|output.pkm
+ */
+
+#include <stdio.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <png.h>
+
+#include "PXETCEncoder.h"
+#include "PXMathUtils.h"
+
+typedef enum
+{
+	PXETCToolFormat_ETC1 = 0,
+	// ETC1 colors, with the alpha in a second ETC1 image below them
+	PXETCToolFormat_ETC1AlphaPlane,
+	PXETCToolFormat_ETC2,
+	PXETCToolFormat_ETC2Alpha
+} PXETCToolFormat;
+
+typedef struct
+{
+	uint8_t *pixels;
+	unsigned width;
+	unsigned height;
+} PXETCToolImage;
+
+typedef struct
+{
+	// In
+	const PXETCToolImage *image;
+	PXETCToolFormat format;
+	PXETCQuality quality;
+	uint8_t *blocks;
+
+	// Shared between the threads
+	pthread_mutex_t mutex;
+	unsigned nextBlockRow;
+} PXETCToolJob;
+
+#define PX_ETC_TOOL_MAX_LEVEL_COUNT 16
+
+static const uint8_t pxETCToolKTXIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+// MARK: -
+// MARK: Images
+// MARK: -
+
+static bool PXETCToolImageInit(PXETCToolImage *image, unsigned width, unsigned height)
+{
+	image->width = width;
+	image->height = height;
+	image->pixels = malloc(width * height * 4);
+
+	return image->pixels != NULL;
+}
+
+static bool PXETCToolReadPNG(const char *path, PXETCToolImage *image)
+{
+	png_image png;
+	memset(&png, 0, sizeof(png_image));
+	png.version = PNG_IMAGE_VERSION;
+
+	if (!png_image_begin_read_from_file(&png, path))
+	{
+		fprintf(stderr, "pxetc: couldn't read %s: %s\n", path, png.message);
+		return false;
+	}
+
+	png.format = PNG_FORMAT_RGBA;
+
+	if (!PXETCToolImageInit(image, png.width, png.height))
+	{
+		png_image_free(&png);
+		return false;
+	}
+
+	if (!png_image_finish_read(&png, NULL, image->pixels, 0, NULL))
+	{
+		fprintf(stderr, "pxetc: couldn't decode %s: %s\n", path, png.message);
+		free(image->pixels);
+		image->pixels = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+/*
+ * Copies an image into a larger one, and fills the rest by repeating the last
+ * column and row; the same as PXTextureData's edge expansion does, so that
+ * the padding doesn't bleed into the image when it's smoothed.
+ */
+static bool PXETCToolPad(const PXETCToolImage *src, unsigned width, unsigned height, PXETCToolImage *dst)
+{
+	if (!PXETCToolImageInit(dst, width, height))
+		return false;
+
+	unsigned x, y;
+	unsigned srcX, srcY;
+
+	for (y = 0; y < height; ++y)
+	{
+		srcY = PXMathMin(y, src->height - 1);
+
+		for (x = 0; x < width; ++x)
+		{
+			srcX = PXMathMin(x, src->width - 1);
+
+			memcpy(dst->pixels + (y * width + x) * 4, src->pixels + (srcY * src->width + srcX) * 4, 4);
+		}
+	}
+
+	return true;
+}
+
+/*
+ * The next mipmap level, a 2x2 box filter. Colors are weighted by alpha so
+ * that invisible colors don't bleed into the visible ones.
+ */
+static bool PXETCToolHalve(const PXETCToolImage *src, PXETCToolImage *dst)
+{
+	unsigned width = PXMathMax(src->width >> 1, 1);
+	unsigned height = PXMathMax(src->height >> 1, 1);
+
+	if (!PXETCToolImageInit(dst, width, height))
+		return false;
+
+	unsigned x, y;
+	unsigned sampleX, sampleY;
+	unsigned channel;
+
+	for (y = 0; y < height; ++y)
+	{
+		for (x = 0; x < width; ++x)
+		{
+			unsigned sums[3] = {0, 0, 0};
+			unsigned alphaSum = 0;
+			unsigned plainSums[3] = {0, 0, 0};
+			uint8_t *out = dst->pixels + (y * width + x) * 4;
+
+			for (sampleY = 0; sampleY < 2; ++sampleY)
+			{
+				for (sampleX = 0; sampleX < 2; ++sampleX)
+				{
+					unsigned srcX = PXMathMin((x << 1) + sampleX, src->width - 1);
+					unsigned srcY = PXMathMin((y << 1) + sampleY, src->height - 1);
+					const uint8_t *pixel = src->pixels + (srcY * src->width + srcX) * 4;
+
+					for (channel = 0; channel < 3; ++channel)
+					{
+						sums[channel] += pixel[channel] * pixel[3];
+						plainSums[channel] += pixel[channel];
+					}
+
+					alphaSum += pixel[3];
+				}
+			}
+
+			for (channel = 0; channel < 3; ++channel)
+			{
+				out[channel] = alphaSum ? ((sums[channel] + (alphaSum >> 1)) / alphaSum) : ((plainSums[channel] + 2) >> 2);
+			}
+
+			out[3] = (alphaSum + 2) >> 2;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * The alpha of an image, as a gray image.
+ */
+static bool PXETCToolAlphaToGray(const PXETCToolImage *src, PXETCToolImage *dst)
+{
+	if (!PXETCToolImageInit(dst, src->width, src->height))
+		return false;
+
+	unsigned index;
+	unsigned count = src->width * src->height;
+
+	for (index = 0; index < count; ++index)
+	{
+		uint8_t alpha = src->pixels[(index << 2) + 3];
+		uint8_t *out = dst->pixels + (index << 2);
+
+		out[0] = out[1] = out[2] = alpha;
+		out[3] = 0xFF;
+	}
+
+	return true;
+}
+
+PXInline unsigned PXETCToolNextPowerOfTwo(unsigned val)
+{
+	unsigned result = 1;
+
+	while (result < val)
+		result <<= 1;
+
+	return result;
+}
+
+// MARK: -
+// MARK: Encoding
+// MARK: -
+
+static void *PXETCToolWorker(void *arg)
+{
+	PXETCToolJob *job = arg;
+
+	const PXETCToolImage *image = job->image;
+	unsigned blockRowCount = image->height >> 2;
+	unsigned blockColumnCount = image->width >> 2;
+	bool isETC2 = (job->format == PXETCToolFormat_ETC2 || job->format == PXETCToolFormat_ETC2Alpha);
+	bool hasAlpha = (job->format == PXETCToolFormat_ETC2Alpha);
+	unsigned blockByteCount = hasAlpha ? 16 : 8;
+	unsigned rowStride = image->width * 4;
+
+	unsigned blockRow;
+	unsigned blockColumn;
+
+	while (true)
+	{
+		pthread_mutex_lock(&job->mutex);
+		blockRow = job->nextBlockRow++;
+		pthread_mutex_unlock(&job->mutex);
+
+		if (blockRow >= blockRowCount)
+			break;
+
+		for (blockColumn = 0; blockColumn < blockColumnCount; ++blockColumn)
+		{
+			const uint8_t *pixels = image->pixels + (blockRow << 2) * rowStride + (blockColumn << 4);
+			uint8_t *block = job->blocks + (blockRow * blockColumnCount + blockColumn) * blockByteCount;
+
+			if (hasAlpha)
+			{
+				PXETCEncodeAlphaBlock(pixels + 3, 4, rowStride, block, job->quality);
+				block += 8;
+			}
+
+			PXETCEncodeColorBlock(pixels, 4, rowStride, block, job->quality, isETC2);
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Encodes an image whose sides are multiples of 4, spreading the rows of
+ * blocks over the threads.
+ */
+static bool PXETCToolEncode(const PXETCToolImage *image, PXETCToolFormat format, PXETCQuality quality, unsigned threadCount, uint8_t *blocks)
+{
+	PXETCToolJob job;
+	job.image = image;
+	job.format = format;
+	job.quality = quality;
+	job.blocks = blocks;
+	job.nextBlockRow = 0;
+	pthread_mutex_init(&job.mutex, NULL);
+
+	pthread_t threads[64];
+	unsigned index;
+	unsigned startedCount = 0;
+
+	threadCount = PXMathMax(1, PXMathMin(threadCount, 64));
+
+	// The calling thread does its share too
+	for (index = 1; index < threadCount; ++index)
+	{
+		if (pthread_create(&threads[startedCount], NULL, PXETCToolWorker, &job) == 0)
+			++startedCount;
+	}
+
+	PXETCToolWorker(&job);
+
+	for (index = 0; index < startedCount; ++index)
+	{
+		pthread_join(threads[index], NULL);
+	}
+
+	pthread_mutex_destroy(&job.mutex);
+
+	return true;
+}
+
+/*
+ * Encodes one level, padding it to whole blocks first. Returns the encoded
+ * bytes, which the caller frees.
+ */
+static uint8_t *PXETCToolEncodeLevel(const PXETCToolImage *level, PXETCToolFormat format, PXETCQuality quality, unsigned threadCount, unsigned *byteCount)
+{
+	PXETCToolImage padded;
+
+	if (!PXETCToolPad(level, (level->width + 3) & ~3, (level->height + 3) & ~3, &padded))
+		return NULL;
+
+	PXETCFormat etcFormat = (format == PXETCToolFormat_ETC2Alpha) ? PXETCFormat_ETC2_RGBA :
+							((format == PXETCToolFormat_ETC2) ? PXETCFormat_ETC2_RGB : PXETCFormat_ETC1);
+	unsigned colorByteCount = PXETCGetImageByteCount(etcFormat, padded.width, padded.height);
+
+	*byteCount = colorByteCount;
+
+	if (format == PXETCToolFormat_ETC1AlphaPlane)
+		*byteCount *= 2;
+
+	uint8_t *blocks = malloc(*byteCount);
+
+	if (blocks)
+	{
+		PXETCToolEncode(&padded, format, quality, threadCount, blocks);
+
+		if (format == PXETCToolFormat_ETC1AlphaPlane)
+		{
+			PXETCToolImage gray;
+
+			if (PXETCToolAlphaToGray(&padded, &gray))
+			{
+				PXETCToolEncode(&gray, PXETCToolFormat_ETC1, quality, threadCount, blocks + colorByteCount);
+				free(gray.pixels);
+			}
+			else
+			{
+				free(blocks);
+				blocks = NULL;
+			}
+		}
+	}
+
+	free(padded.pixels);
+
+	return blocks;
+}
+
+/*
+ * The peak signal to noise ratio of the encoded image, over the part that
+ * came from the original.
+ */
+static double PXETCToolPSNR(const PXETCToolImage *original, const uint8_t *blocks, PXETCToolFormat format, unsigned width, unsigned height)
+{
+	uint8_t *decoded = malloc(width * height * 4);
+
+	if (!decoded)
+		return 0.0;
+
+	if (format == PXETCToolFormat_ETC1AlphaPlane)
+	{
+		PXETCDecodeImageWithAlphaPlane(blocks, width, height, decoded);
+	}
+	else
+	{
+		PXETCFormat etcFormat = (format == PXETCToolFormat_ETC2Alpha) ? PXETCFormat_ETC2_RGBA :
+								((format == PXETCToolFormat_ETC2) ? PXETCFormat_ETC2_RGB : PXETCFormat_ETC1);
+
+		PXETCDecodeImage(blocks, etcFormat, width, height, decoded, 4);
+	}
+
+	bool hasAlpha = (format == PXETCToolFormat_ETC1AlphaPlane || format == PXETCToolFormat_ETC2Alpha);
+	unsigned channelCount = hasAlpha ? 4 : 3;
+	double error = 0.0;
+	unsigned x, y;
+	unsigned channel;
+
+	for (y = 0; y < original->height; ++y)
+	{
+		for (x = 0; x < original->width; ++x)
+		{
+			const uint8_t *a = original->pixels + (y * original->width + x) * 4;
+			const uint8_t *b = decoded + (y * width + x) * 4;
+
+			for (channel = 0; channel < channelCount; ++channel)
+			{
+				double diff = (double)a[channel] - b[channel];
+				error += diff * diff;
+			}
+		}
+	}
+
+	free(decoded);
+
+	if (error == 0.0)
+		return INFINITY;
+
+	double mse = error / (original->width * original->height * channelCount);
+
+	return 10.0 * log10(255.0 * 255.0 / mse);
+}
+
+// MARK: -
+// MARK: Containers
+// MARK: -
+
+PXInline void PXETCToolWrite32(FILE *file, uint32_t val)
+{
+	// KTX files are written in the byte order of the machine, and say which
+	// order that is.
+	fwrite(&val, sizeof(uint32_t), 1, file);
+}
+
+PXInline void PXETCToolWrite16BE(FILE *file, unsigned val)
+{
+	uint8_t bytes[2] = {(val >> 8) & 0xFF, val & 0xFF};
+	fwrite(bytes, 1, 2, file);
+}
+
+/*
+ * KTX 1.1. The size of the image before padding is stored under the
+ * PXContentSize key, and ETC1 alpha planes are marked with PXAlphaPlane.
+ */
+static bool PXETCToolWriteKTX(FILE *file, PXETCToolFormat format, unsigned width, unsigned height, unsigned contentWidth, unsigned contentHeight,
+							  uint8_t **levels, const unsigned *levelByteCounts, unsigned levelCount)
+{
+	static const uint32_t glRGB = 0x1907;
+	static const uint32_t glRGBA = 0x1908;
+
+	uint32_t internalFormat;
+	uint32_t baseInternalFormat = glRGB;
+	bool hasAlphaPlane = (format == PXETCToolFormat_ETC1AlphaPlane);
+
+	switch (format)
+	{
+		case PXETCToolFormat_ETC2:
+			internalFormat = PX_GL_COMPRESSED_RGB8_ETC2;
+			break;
+		case PXETCToolFormat_ETC2Alpha:
+			internalFormat = PX_GL_COMPRESSED_RGBA8_ETC2_EAC;
+			baseInternalFormat = glRGBA;
+			break;
+		default:
+			internalFormat = PX_GL_ETC1_RGB8_OES;
+			break;
+	}
+
+	// Key value pairs, each padded to 4 bytes
+	char keyValues[128] = {0};
+	unsigned keyValueByteCount = 0;
+	char pair[64];
+	int pairLength;
+
+	pairLength = snprintf(pair, sizeof(pair), "PXContentSize%c%ux%u", '\0', contentWidth, contentHeight) + 1;
+	memcpy(keyValues, &pairLength, sizeof(uint32_t));
+	memcpy(keyValues + 4, pair, pairLength);
+	keyValueByteCount = (4 + pairLength + 3) & ~3;
+
+	if (hasAlphaPlane)
+	{
+		pairLength = snprintf(pair, sizeof(pair), "PXAlphaPlane%cbottom", '\0') + 1;
+		memset(keyValues + keyValueByteCount, 0, 4 + ((pairLength + 3) & ~3));
+		memcpy(keyValues + keyValueByteCount, &pairLength, sizeof(uint32_t));
+		memcpy(keyValues + keyValueByteCount + 4, pair, pairLength);
+		keyValueByteCount += (4 + pairLength + 3) & ~3;
+	}
+
+	fwrite(pxETCToolKTXIdentifier, 1, sizeof(pxETCToolKTXIdentifier), file);
+	PXETCToolWrite32(file, 0x04030201);
+	PXETCToolWrite32(file, 0); // glType
+	PXETCToolWrite32(file, 1); // glTypeSize
+	PXETCToolWrite32(file, 0); // glFormat
+	PXETCToolWrite32(file, internalFormat);
+	PXETCToolWrite32(file, baseInternalFormat);
+	PXETCToolWrite32(file, width);
+	PXETCToolWrite32(file, hasAlphaPlane ? height << 1 : height);
+	PXETCToolWrite32(file, 0); // pixelDepth
+	PXETCToolWrite32(file, 0); // numberOfArrayElements
+	PXETCToolWrite32(file, 1); // numberOfFaces
+	PXETCToolWrite32(file, levelCount);
+	PXETCToolWrite32(file, keyValueByteCount);
+	fwrite(keyValues, 1, keyValueByteCount, file);
+
+	unsigned index;
+
+	// The blocks are always multiples of 8 bytes, so there's no padding
+	for (index = 0; index < levelCount; ++index)
+	{
+		PXETCToolWrite32(file, levelByteCounts[index]);
+		fwrite(levels[index], 1, levelByteCounts[index], file);
+	}
+
+	return !ferror(file);
+}
+
+/*
+ * PKM files hold a single image, and the sizes before and after padding.
+ */
+static bool PXETCToolWritePKM(FILE *file, PXETCToolFormat format, unsigned width, unsigned height, unsigned contentWidth, unsigned contentHeight,
+							  const uint8_t *blocks, unsigned byteCount)
+{
+	bool isETC2 = (format == PXETCToolFormat_ETC2 || format == PXETCToolFormat_ETC2Alpha);
+
+	fwrite(isETC2 ? "PKM 20" : "PKM 10", 1, 6, file);
+	PXETCToolWrite16BE(file, (format == PXETCToolFormat_ETC2Alpha) ? 3 : (isETC2 ? 1 : 0));
+	PXETCToolWrite16BE(file, width);
+	PXETCToolWrite16BE(file, height);
+	PXETCToolWrite16BE(file, contentWidth);
+	PXETCToolWrite16BE(file, contentHeight);
+	fwrite(blocks, 1, byteCount, file);
+
+	return !ferror(file);
+}
+
+// MARK: -
+// MARK: Main
+// MARK: -
+
+static void PXETCToolPrintUsage()
+{
+	fprintf(stderr,
+			"Usage: pxetc [options] input.png output.ktx|output.pkm\n"
+			"\n"
+			"  -f, --format FORMAT    etc1, etc1a, etc2 or etc2a (default: etc1, or etc1a\n"
+			"                         if the image has alpha; etc2a for PKM files)\n"
+			"                           etc1   ETC1, no alpha\n"
+			"                           etc1a  ETC1, with the alpha in a second ETC1 image\n"
+			"                                  (KTX only)\n"
+			"                           etc2   ETC2 RGB\n"
+			"                           etc2a  ETC2 RGBA, with EAC alpha\n"
+			"  -q, --quality QUALITY  fast, medium or high (default: medium)\n"
+			"  -m, --mipmaps          Store a full chain of mipmaps (KTX only)\n"
+			"  -n, --no-pot           Don't pad the image to power of two sides\n"
+			"  -j, --threads COUNT    Threads to encode with (default: one per cpu)\n"
+			"  -v, --verbose          Print the quality of the result\n"
+			"  -h, --help             Print this\n");
+}
+
+static bool PXETCToolHasAlpha(const PXETCToolImage *image)
+{
+	unsigned index;
+	unsigned count = image->width * image->height;
+
+	for (index = 0; index < count; ++index)
+	{
+		if (image->pixels[(index << 2) + 3] != 0xFF)
+			return true;
+	}
+
+	return false;
+}
+
+int main(int argc, char **argv)
+{
+	static const struct option options[] =
+	{
+		{"format",  required_argument, NULL, 'f'},
+		{"quality", required_argument, NULL, 'q'},
+		{"mipmaps", no_argument,       NULL, 'm'},
+		{"no-pot",  no_argument,       NULL, 'n'},
+		{"threads", required_argument, NULL, 'j'},
+		{"verbose", no_argument,       NULL, 'v'},
+		{"help",    no_argument,       NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	int format = -1;
+	PXETCQuality quality = PXETCQuality_Medium;
+	bool generatesMipmaps = false;
+	bool padsToPowerOfTwo = true;
+	bool isVerbose = false;
+	long threadCount = sysconf(_SC_NPROCESSORS_ONLN);
+	int option;
+
+	while ((option = getopt_long(argc, argv, "f:q:mnj:vh", options, NULL)) != -1)
+	{
+		switch (option)
+		{
+			case 'f':
+				if (strcmp(optarg, "etc1") == 0)
+					format = PXETCToolFormat_ETC1;
+				else if (strcmp(optarg, "etc1a") == 0)
+					format = PXETCToolFormat_ETC1AlphaPlane;
+				else if (strcmp(optarg, "etc2") == 0)
+					format = PXETCToolFormat_ETC2;
+				else if (strcmp(optarg, "etc2a") == 0)
+					format = PXETCToolFormat_ETC2Alpha;
+				else
+				{
+					fprintf(stderr, "pxetc: unknown format %s\n", optarg);
+					return 1;
+				}
+				break;
+			case 'q':
+				if (strcmp(optarg, "fast") == 0)
+					quality = PXETCQuality_Fast;
+				else if (strcmp(optarg, "medium") == 0)
+					quality = PXETCQuality_Medium;
+				else if (strcmp(optarg, "high") == 0)
+					quality = PXETCQuality_High;
+				else
+				{
+					fprintf(stderr, "pxetc: unknown quality %s\n", optarg);
+					return 1;
+				}
+				break;
+			case 'm':
+				generatesMipmaps = true;
+				break;
+			case 'n':
+				padsToPowerOfTwo = false;
+				break;
+			case 'j':
+				threadCount = atol(optarg);
+				break;
+			case 'v':
+				isVerbose = true;
+				break;
+			case 'h':
+				PXETCToolPrintUsage();
+				return 0;
+			default:
+				PXETCToolPrintUsage();
+				return 1;
+		}
+	}
+
+	if (argc - optind != 2)
+	{
+		PXETCToolPrintUsage();
+		return 1;
+	}
+
+	const char *inputPath = argv[optind];
+	const char *outputPath = argv[optind + 1];
+	const char *extension = strrchr(outputPath, '.');
+	bool isPKM = (extension && strcasecmp(extension, ".pkm") == 0);
+
+	if (!extension || (!isPKM && strcasecmp(extension, ".ktx") != 0))
+	{
+		fprintf(stderr, "pxetc: the output has to be a .ktx or .pkm file\n");
+		return 1;
+	}
+
+	PXETCToolImage image;
+
+	if (!PXETCToolReadPNG(inputPath, &image))
+		return 1;
+
+	if (format < 0)
+	{
+		if (PXETCToolHasAlpha(&image))
+			format = isPKM ? PXETCToolFormat_ETC2Alpha : PXETCToolFormat_ETC1AlphaPlane;
+		else
+			format = PXETCToolFormat_ETC1;
+	}
+
+	if (isPKM && format == PXETCToolFormat_ETC1AlphaPlane)
+	{
+		fprintf(stderr, "pxetc: PKM files can't hold an alpha plane, use a .ktx file or the etc2a format\n");
+		return 1;
+	}
+
+	if (isPKM && generatesMipmaps)
+	{
+		fprintf(stderr, "pxetc: PKM files can't hold mipmaps, ignoring --mipmaps\n");
+		generatesMipmaps = false;
+	}
+
+	// Images with an alpha plane are decoded when they're loaded; their
+	// mipmaps are made then.
+	if (format == PXETCToolFormat_ETC1AlphaPlane && generatesMipmaps)
+	{
+		fprintf(stderr, "pxetc: the etc1a format can't hold mipmaps, ignoring --mipmaps\n");
+		generatesMipmaps = false;
+	}
+
+	unsigned width = padsToPowerOfTwo ? PXETCToolNextPowerOfTwo(PXMathMax(image.width, 4)) : ((image.width + 3) & ~3);
+	unsigned height = padsToPowerOfTwo ? PXETCToolNextPowerOfTwo(PXMathMax(image.height, 4)) : ((image.height + 3) & ~3);
+
+	PXETCToolImage base;
+
+	if (!PXETCToolPad(&image, width, height, &base))
+		return 1;
+
+	uint8_t *levels[PX_ETC_TOOL_MAX_LEVEL_COUNT];
+	unsigned levelByteCounts[PX_ETC_TOOL_MAX_LEVEL_COUNT];
+	unsigned levelCount = 0;
+
+	PXETCToolImage level = base;
+	PXETCToolImage next;
+
+	while (levelCount < PX_ETC_TOOL_MAX_LEVEL_COUNT)
+	{
+		levels[levelCount] = PXETCToolEncodeLevel(&level, format, quality, threadCount, &levelByteCounts[levelCount]);
+
+		if (!levels[levelCount])
+		{
+			fprintf(stderr, "pxetc: out of memory\n");
+			return 1;
+		}
+
+		++levelCount;
+
+		if (!generatesMipmaps || (level.width == 1 && level.height == 1))
+			break;
+
+		if (!PXETCToolHalve(&level, &next))
+		{
+			fprintf(stderr, "pxetc: out of memory\n");
+			return 1;
+		}
+
+		if (level.pixels != base.pixels)
+			free(level.pixels);
+
+		level = next;
+	}
+
+	if (level.pixels != base.pixels)
+		free(level.pixels);
+
+	FILE *file = fopen(outputPath, "wb");
+
+	if (!file)
+	{
+		fprintf(stderr, "pxetc: couldn't open %s for writing\n", outputPath);
+		return 1;
+	}
+
+	bool success;
+
+	if (isPKM)
+		success = PXETCToolWritePKM(file, format, width, height, image.width, image.height, levels[0], levelByteCounts[0]);
+	else
+		success = PXETCToolWriteKTX(file, format, width, height, image.width, image.height, levels, levelByteCounts, levelCount);
+
+	if (fclose(file) != 0)
+		success = false;
+
+	if (!success)
+	{
+		fprintf(stderr, "pxetc: couldn't write %s\n", outputPath);
+		return 1;
+	}
+
+	if (isVerbose)
+	{
+		unsigned byteCount = 0;
+		unsigned index;
+
+		for (index = 0; index < levelCount; ++index)
+			byteCount += levelByteCounts[index];
+
+		printf("%s: %ux%u (padded to %ux%u), %u level(s), %u bytes, PSNR %.2f dB\n",
+			   outputPath, image.width, image.height, width, height, levelCount, byteCount,
+			   PXETCToolPSNR(&image, levels[0], format, width, height));
+	}
+
+	unsigned index;
+
+	for (index = 0; index < levelCount; ++index)
+		free(levels[index]);
+
+	free(base.pixels);
+	free(image.pixels);
+
+	return 0;
+}